@@ -272,6 +272,7 @@ char* buildCtbNameByGroupId(const char* stbName, uint64_t groupId);
 int32_t buildCtbNameByGroupIdImpl(const char* stbName, uint64_t groupId, char* pBuf);
 
 void trimDataBlock(SSDataBlock* pBlock, int32_t totalRows, const bool* pBoolList);
+int32_t trimDataBlockBySel(SSDataBlock* pBlock, const int32_t* pSel, int32_t numOfSel, const bool* pUnusedCols);
 
 #ifdef __cplusplus
 }
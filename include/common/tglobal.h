@@ -56,6 +56,8 @@ extern int32_t tsNumOfRpcSessions;
 extern int32_t tsTimeToGetAvailableConn;
 extern int32_t tsKeepAliveIdle;
 extern int32_t tsNumOfCommitThreads;
+extern int32_t tsNumOfDecodeThreads;
+extern int32_t tsNumOfApplyThreads;
 extern int32_t tsNumOfTaskQueueThreads;
 extern int32_t tsNumOfMnodeQueryThreads;
 extern int32_t tsNumOfMnodeFetchThreads;
@@ -75,6 +77,9 @@ extern int32_t tsElectInterval;
 extern int32_t tsHeartbeatInterval;
 extern int32_t tsHeartbeatTimeout;
 extern int32_t tsSnapReplMaxWaitN;
+extern int32_t tsSyncLogReplBatchSize;
+extern bool    tsSyncLeaderLease;
+extern bool    tsSyncFollowerRead;
 
 // vnode
 extern int64_t tsVndCommitMaxIntervalMs;
@@ -129,6 +134,14 @@ extern char *   tsSvrCrashReportUri;
 extern int32_t tsQueryBufferSize;  // maximum allowed usage buffer size in MB for each data node during query processing
 extern int64_t tsQueryBufferSizeBytes;    // maximum allowed usage buffer size in byte for each data node
 extern int32_t tsCacheLazyLoadThreshold;  // cost threshold for last/last_row loading cache as much as possible
+extern int32_t tsDecodeParallelCols;      // min number of columns with values to decompress a data block in parallel
+extern int32_t tsBlockSmaCacheSize;       // memory in MB of each vnode to cache the SMA of file blocks
+extern int32_t tsApplyParallelTables;     // min number of tables to apply a submit request in parallel
+extern bool    tsMemTableChunk;           // keep in-order appends in memtable chunks instead of skiplist nodes
+extern bool    tsBufPoolHugePage;         // back the vnode write buffer pools with huge pages
+extern bool    tsBufPoolNumaBind;         // bind the buffer pools and apply threads of a vnode to a NUMA node
+extern bool    tsTagColumnCache;          // serve tag scans of super tables from per column tag vectors
+extern bool    tsVarDictEncode;           // write low-cardinality var columns of data blocks as a dictionary
 
 // query client
 extern int32_t tsQueryPolicy;
@@ -197,6 +210,9 @@ extern int32_t tmqMaxTopicNum;
 
 // wal
 extern int64_t tsWalFsyncDataSizeLimit;
+extern int64_t tsWalGroupCommitSize;
+extern int32_t tsWalGroupCommitLatency;
+extern int32_t tsAsyncWriteDepth;
 
 // internal
 extern int32_t tsTransPullupInterval;
@@ -113,6 +113,32 @@ typedef struct SMCtbCursor {
   int      lock;
 } SMCtbCursor;
 
+// one tag column of a super table, row i holds the tag of child table SMetaTagCols.aUid[i]
+typedef struct SMetaTagColumn {
+  int16_t  cid;
+  int8_t   type;
+  int32_t  bytes;        // width of a fixed length value
+  uint8_t* pNull;        // bit i is set when row i has no value
+  char*    pData;        // fixed length values, bytes per row
+  int32_t* aCode;        // var length values, dictionary code per row
+  char*    pDict;        // distinct var length values, each with its var string header
+  int32_t* aDictOffset;  // offset of each distinct value in pDict
+  int32_t  nDict;
+} SMetaTagColumn;
+
+// tags of all child tables of a super table stored column by column, immutable once acquired
+typedef struct SMetaTagCols {
+  tb_uid_t        suid;
+  int32_t         sver;
+  int32_t         nRows;
+  tb_uid_t*       aUid;  // in ctb.idx order
+  int32_t         nCols;
+  SMetaTagColumn* aCol;
+  int32_t         nRef;
+} SMetaTagCols;
+
+#define META_TAG_COL_IS_NULL(_col, _row) (((_col)->pNull[(_row) >> 3] >> ((_row)&7)) & 1)
+
 typedef struct SRowBuffPos {
   void* pRowBuff;
   void* pKey;
@@ -185,6 +211,7 @@ typedef struct TsdReader {
 
   void         (*tsdSetFilesetDelimited)(void* pReader);
   void         (*tsdSetSetNotifyCb)(void* pReader, TsdReaderNotifyCbFn notifyFn, void* param);
+  void         (*tsdSetFilter)(void* pReader, void* pFilterInfo);
 } TsdReader;
 
 typedef struct SStoreCacheReader {
@@ -258,9 +285,9 @@ typedef struct SStoreMeta {
                                    int32_t payloadLen);
 
   int32_t (*getCachedTableList)(void* pVnode, tb_uid_t suid, const uint8_t* pKey, int32_t keyLen, SArray* pList1,
-                                bool* acquireRes);
+                                SArray* pChanged, int64_t* pVer, bool* acquireRes);
   int32_t (*putCachedTableList)(void* pVnode, uint64_t suid, const void* pKey, int32_t keyLen, void* pPayload,
-                                int32_t payloadLen, double selectivityRatio);
+                                int32_t payloadLen, double selectivityRatio, int64_t ver);
 
   void* (*storeGetIndexInfo)();
   void* (*getInvertIndex)(void* pVnode);
@@ -277,6 +304,9 @@ typedef struct SStoreMeta {
   void (*pauseCtbCursor)(SMCtbCursor* pCtbCur);
   void (*closeCtbCursor)(SMCtbCursor* pCtbCur);
   tb_uid_t (*ctbCursorNext)(SMCtbCursor* pCur);
+
+  SMetaTagCols* (*acquireTagCols)(void* pVnode, tb_uid_t suid);  // NULL if the tags can not be served by columns
+  void (*releaseTagCols)(void* pVnode, SMetaTagCols* pTagCols);
 } SStoreMeta;
 
 typedef struct SStoreMetaReader {
@@ -172,10 +172,41 @@ typedef struct {
 } SMonDiskInfo;
 
 typedef struct {
-  SMonDiskInfo tfs;
-  SVnodesStat  vstat;
-  SMonSysInfo  sys;
-  SMonLogs     log;
+  char    pool[24];
+  int32_t id;
+  int32_t queues;
+  int64_t processed;
+  int64_t stolen;
+  int64_t busy;  // us
+} SMonWorkerDesc;
+
+typedef struct {
+  SArray *workers;  // array of SMonWorkerDesc
+} SMonWorkerInfo;
+
+typedef struct {
+  int32_t vgId;
+  int32_t id;
+  int32_t numaNode;
+  int8_t  hugePage;
+  int64_t capacity;
+  int64_t used;
+  int64_t allocs;
+  int64_t overflows;
+  int64_t overflowSize;
+} SMonBufPoolDesc;
+
+typedef struct {
+  SArray *pools;  // array of SMonBufPoolDesc
+} SMonBufPoolInfo;
+
+typedef struct {
+  SMonDiskInfo    tfs;
+  SVnodesStat     vstat;
+  SMonWorkerInfo  worker;
+  SMonBufPoolInfo bufPool;
+  SMonSysInfo     sys;
+  SMonLogs        log;
 } SMonVmInfo;
 
 typedef struct {
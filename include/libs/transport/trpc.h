@@ -151,6 +151,9 @@ void  rpcCloseImpl(void *);
 void *rpcMallocCont(int64_t contLen);
 void  rpcFreeCont(void *pCont);
 void *rpcReallocCont(void *ptr, int64_t contLen);
+// share a cont between modules without copying it, the last rpcFreeCont releases it. A shared cont is for local
+// hand-off only, it can neither be sent nor reallocated.
+void *rpcRefCont(void *pCont);
 
 // Because taosd supports multi-process mode
 // These functions should not be used on the server side
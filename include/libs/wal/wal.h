@@ -43,6 +43,7 @@ extern "C" {
 #define WAL_FILE_LEN      (WAL_PATH_LEN + 32)
 #define WAL_MAGIC         0xFAFBFCFDF4F3F2F1ULL
 #define WAL_SCAN_BUF_SIZE (1024 * 1024 * 3)
+#define WAL_AIO_BUF_SIZE  (16 * 1024)
 
 typedef enum {
   TAOS_WAL_WRITE = 1,
@@ -113,9 +114,13 @@ typedef struct SWal {
   // status
   int64_t totSize;
   int64_t lastRollSeq;
+  // group commit
+  int64_t pendingSyncSize;  // bytes appended since the last fsync of the log file
+  int64_t pendingSyncTs;    // us, when the first of them was appended
   // ctl
   int64_t       refId;
   TdThreadMutex mutex;
+  TdFileAioPtr  pAio;  // async writer, NULL when written synchronously
   // ref
   SHashObj *pRefHash;  // refId -> SWalRef
   // path
@@ -178,6 +183,8 @@ int32_t walWriteWithSyncInfo(SWal *, int64_t index, tmsg_t msgType, SWalSyncInfo
 int64_t walAppendLog(SWal *, int64_t index, tmsg_t msgType, SWalSyncInfo syncMeta, const void *body, int32_t bodyLen);
 
 void walFsync(SWal *, bool force);
+// fsync appends deferred by group commit, if any
+void walFsyncPending(SWal *);
 
 // apis for lifecycle management
 int32_t walCommit(SWal *, int64_t ver);
@@ -121,6 +121,18 @@ int32_t taosLinkFile(char *src, char *dst);
 
 bool lastErrorIsFileNotExist();
 
+// Batched asynchronous writes, backed by io_uring with registered buffers when the kernel supports it. Otherwise each
+// write is done synchronously. Data is copied into one of depth slots of szBuf bytes, so the caller may reuse buf
+// right after the call. An offset < 0 appends, in queue order. Errors of queued writes are reported by taosAioFlush and
+// taosAioClose.
+typedef struct TdFileAio *TdFileAioPtr;
+
+int32_t taosAioOpen(int32_t depth, int32_t szBuf, TdFileAioPtr *ppAio);
+int32_t taosAioClose(TdFileAioPtr *ppAio);
+bool    taosAioIsAsync(TdFileAioPtr pAio);
+int32_t taosAioPWriteFile(TdFileAioPtr pAio, TdFilePtr pFile, const void *buf, int64_t count, int64_t offset);
+int32_t taosAioFlush(TdFileAioPtr pAio);
+
 #ifdef __cplusplus
 }
 #endif
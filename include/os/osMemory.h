@@ -52,6 +52,8 @@ int64_t taosMemorySize(void *ptr);
 void    taosPrintBackTrace();
 void    taosMemoryTrim(int32_t size);
 void   *taosMemoryMallocAlign(uint32_t alignment, int64_t size);
+void   *taosMemoryMapPages(int64_t size, bool hugePage, int32_t numaNode, int64_t *pMapSize);
+void    taosMemoryUnmapPages(void *ptr, int64_t mapSize);
 
 #define taosMemoryFreeClear(ptr)   \
   do {                             \
@@ -53,6 +53,8 @@ void    taosKillSystem();
 int32_t taosGetSystemUUID(char *uid, int32_t uidlen);
 char   *taosGetCmdlineByPID(int32_t pid);
 void    taosSetCoreDump(bool enable);
+int32_t taosGetNumaNodes();
+int32_t taosBindThreadToNumaNode(int32_t node);
 
 #if !defined(LINUX)
 
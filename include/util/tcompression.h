@@ -55,6 +55,10 @@ extern "C" {
 #define HEAD_MODE(x) x % 2
 #define HEAD_ALGO(x) x / 2
 
+// Encodings that older versions cannot decode are written only once enabled, they are always decoded.
+extern bool tsIntForCodec;      // frame-of-reference bit-packing for smallint/int/bigint
+extern bool tsFloatChimpCodec;  // chimp128 for lossless float/double
+
 #ifdef TD_TSZ
 extern bool lossyFloat;
 extern bool lossyDouble;
@@ -135,10 +139,18 @@ int32_t tsDecompressBigint(void *pIn, int32_t nIn, int32_t nEle, void *pOut, int
                            int32_t nBuf);
 // for internal usage
 int32_t getWordLength(char type);
+int32_t tsCompressFloatXorImp(const char *const input, const int32_t nelements, char *const output);
+int32_t tsCompressDoubleXorImp(const char *const input, const int32_t nelements, char *const output);
+int32_t tsCompressChimpImp(const char *const input, const int32_t nelements, char *const output, int32_t limit,
+                           int32_t nBits);
+int32_t tsDecompressChimpImp(const char *const input, const int32_t nelements, char *const output, int32_t nBits);
 
 int32_t tsDecompressIntImpl_Hw(const char *const input, const int32_t nelements, char *const output, const char type);
+int32_t tsDecompressINTForUnpackAvx2(const uint8_t *const input, int32_t nBytes, int32_t nelements, int32_t bits,
+                                    int64_t ref, int64_t *const output);
 int32_t tsDecompressFloatImplAvx512(const char *const input, const int32_t nelements, char *const output);
 int32_t tsDecompressFloatImplAvx2(const char *const input, const int32_t nelements, char *const output);
+int32_t tsDecompressDoubleImplAvx2(const char *const input, const int32_t nelements, char *const output);
 int32_t tsDecompressTimestampAvx512(const char* const input, const int32_t nelements, char *const output, bool bigEndian);
 int32_t tsDecompressTimestampAvx2(const char* const input, const int32_t nelements, char *const output, bool bigEndian);
 
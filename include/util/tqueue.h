@@ -102,8 +102,11 @@ void       taosQsetThreadResume(STaosQset *qset);
 int32_t    taosAddIntoQset(STaosQset *qset, STaosQueue *queue, void *ahandle);
 void       taosRemoveFromQset(STaosQset *qset, STaosQueue *queue);
 int32_t    taosGetQueueNumber(STaosQset *qset);
+int32_t    taosQsetItemSize(STaosQset *qset);
+STaosQset *taosQueueGetQset(STaosQueue *queue);
 
 int32_t taosReadQitemFromQset(STaosQset *qset, void **ppItem, SQueueInfo *qinfo);
+int32_t taosTryReadQitemFromQset(STaosQset *qset, void **ppItem, SQueueInfo *qinfo);  // never blocks
 int32_t taosReadAllQitemsFromQset(STaosQset *qset, STaosQall *qall, SQueueInfo *qinfo);
 void    taosResetQsetThread(STaosQset *qset, void *pItem);
 void    taosQueueSetThreadId(STaosQueue *pQueue, int64_t threadId);
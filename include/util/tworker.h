@@ -50,6 +50,36 @@ typedef struct SAutoQWorkerPool {
   TdThreadMutex mutex;
 } SAutoQWorkerPool;
 
+typedef struct SStealQWorker {
+  int32_t    id;      // worker id
+  int64_t    pid;     // thread pid
+  TdThread   thread;  // thread id
+  STaosQset *qset;    // queues with affinity to this worker
+  int8_t     idle;
+  int64_t    numOfProcessed;
+  int64_t    numOfStolen;
+  int64_t    busyTime;  // us
+  void      *pool;
+} SStealQWorker;
+
+// each queue is bound to one worker, a worker serves its own queues first and steals from the others when idle
+typedef struct SStealQWorkerPool {
+  int32_t        max;  // number of workers
+  int32_t        num;  // number of launched workers
+  int8_t         stop;
+  const char    *name;
+  SStealQWorker *workers;
+  TdThreadMutex  mutex;
+} SStealQWorkerPool;
+
+typedef struct {
+  int32_t id;
+  int32_t numOfQueues;
+  int64_t numOfProcessed;  // counters are totals since the worker started
+  int64_t numOfStolen;
+  int64_t busyTime;  // us
+} SStealQWorkerStat;
+
 typedef struct SWWorker {
   int32_t       id;      // worker id
   int64_t       pid;     // thread pid
@@ -78,6 +108,13 @@ void        tAutoQWorkerCleanup(SAutoQWorkerPool *pool);
 STaosQueue *tAutoQWorkerAllocQueue(SAutoQWorkerPool *pool, void *ahandle, FItem fp);
 void        tAutoQWorkerFreeQueue(SAutoQWorkerPool *pool, STaosQueue *queue);
 
+int32_t     tStealQWorkerInit(SStealQWorkerPool *pool);
+void        tStealQWorkerCleanup(SStealQWorkerPool *pool);
+STaosQueue *tStealQWorkerAllocQueue(SStealQWorkerPool *pool, void *ahandle, FItem fp);
+void        tStealQWorkerFreeQueue(SStealQWorkerPool *pool, STaosQueue *queue);
+int32_t     tStealQWorkerWriteQitem(SStealQWorkerPool *pool, STaosQueue *queue, void *pItem);
+void        tStealQWorkerGetStat(SStealQWorkerPool *pool, SArray *pStats);
+
 int32_t     tWWorkerInit(SWWorkerPool *pool);
 void        tWWorkerCleanup(SWWorkerPool *pool);
 STaosQueue *tWWorkerAllocQueue(SWWorkerPool *pool, void *ahandle, FItems fp);
@@ -2546,6 +2546,130 @@ void trimDataBlock(SSDataBlock* pBlock, int32_t totalRows, const bool* pBoolList
   }
 }
 
+#define TRIM_GATHER_BY_SEL(_t, _p, _sel, _n)   \
+  do {                                         \
+    _t* _d = (_t*)(_p);                        \
+    for (int32_t _k = 0; _k < (_n); ++_k) {    \
+      _d[_k] = _d[(_sel)[_k]];                 \
+    }                                          \
+  } while (0)
+
+// The selection vector is strictly ascending, so sel[k] >= k and every element can be moved in place: a slot is only
+// overwritten after the row that lived there has already been read.
+static void colDataTrimFixedBySel(SColumnInfoData* pDst, const int32_t* pSel, int32_t numOfSel) {
+  switch (pDst->info.bytes) {
+    case sizeof(int64_t):
+      TRIM_GATHER_BY_SEL(int64_t, pDst->pData, pSel, numOfSel);
+      break;
+    case sizeof(int32_t):
+      TRIM_GATHER_BY_SEL(int32_t, pDst->pData, pSel, numOfSel);
+      break;
+    case sizeof(int16_t):
+      TRIM_GATHER_BY_SEL(int16_t, pDst->pData, pSel, numOfSel);
+      break;
+    case sizeof(int8_t):
+      TRIM_GATHER_BY_SEL(int8_t, pDst->pData, pSel, numOfSel);
+      break;
+    default: {
+      int32_t bytes = pDst->info.bytes;
+      for (int32_t k = 0; k < numOfSel; ++k) {
+        if (pSel[k] != k) {
+          memcpy(pDst->pData + (int64_t)k * bytes, pDst->pData + (int64_t)pSel[k] * bytes, bytes);
+        }
+      }
+      break;
+    }
+  }
+
+  // rebuild the null bitmap one byte at a time; the byte being written only covers rows that have been read already
+  char* bm = pDst->nullbitmap;
+  for (int32_t k = 0; k < numOfSel; k += 8) {
+    int32_t end = TMIN(k + 8, numOfSel);
+    uint8_t v = 0;
+    for (int32_t j = k; j < end; ++j) {
+      if (colDataIsNull_f(bm, pSel[j])) {
+        v |= (uint8_t)(1u << (7 - (j & 7)));
+      }
+    }
+    bm[k >> NBIT] = (char)v;
+  }
+}
+
+static int32_t colDataTrimVarBySel(SColumnInfoData* pDst, const int32_t* pSel, int32_t numOfSel) {
+  int32_t* offset = pDst->varmeta.offset;
+  int32_t  len = 0;
+  for (int32_t k = 0; k < numOfSel; ++k) {
+    if (offset[pSel[k]] != -1) {
+      char* p = pDst->pData + offset[pSel[k]];
+      len += (pDst->info.type == TSDB_DATA_TYPE_JSON) ? getJsonValueLen(p) : varDataTLen(p);
+    }
+  }
+
+  char* pData = NULL;
+  if (len > 0) {
+    pData = taosMemoryMalloc(len);
+    if (pData == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+  }
+
+  int32_t pos = 0;
+  for (int32_t k = 0; k < numOfSel; ++k) {
+    int32_t o = offset[pSel[k]];
+    if (o == -1) {
+      offset[k] = -1;
+      continue;
+    }
+
+    char*   p = pDst->pData + o;
+    int32_t l = (pDst->info.type == TSDB_DATA_TYPE_JSON) ? getJsonValueLen(p) : varDataTLen(p);
+    memcpy(pData + pos, p, l);
+    offset[k] = pos;
+    pos += l;
+  }
+
+  taosMemoryFree(pDst->pData);
+  pDst->pData = pData;
+  pDst->varmeta.allocLen = len;
+  pDst->varmeta.length = len;
+  return TSDB_CODE_SUCCESS;
+}
+
+int32_t trimDataBlockBySel(SSDataBlock* pBlock, const int32_t* pSel, int32_t numOfSel, const bool* pUnusedCols) {
+  size_t numOfCols = taosArrayGetSize(pBlock->pDataBlock);
+  for (int32_t i = 0; i < numOfCols; ++i) {
+    SColumnInfoData* pDst = taosArrayGet(pBlock->pDataBlock, i);
+    // it is a reserved column for scalar function, and no data in this column yet.
+    if (pDst->pData == NULL || (IS_VAR_DATA_TYPE(pDst->info.type) && pDst->varmeta.length == 0)) {
+      continue;
+    }
+
+    // columns that are only referenced by the filter are not moved at all, their surviving rows are set to NULL.
+    if (pUnusedCols != NULL && pUnusedCols[i]) {
+      if (IS_VAR_DATA_TYPE(pDst->info.type)) {
+        memset(pDst->varmeta.offset, 0xFF, sizeof(int32_t) * numOfSel);
+        pDst->varmeta.length = 0;
+      } else {
+        memset(pDst->nullbitmap, 0xFF, BitmapLen(numOfSel));
+      }
+      pDst->hasNull = true;
+      continue;
+    }
+
+    if (IS_VAR_DATA_TYPE(pDst->info.type)) {
+      int32_t code = colDataTrimVarBySel(pDst, pSel, numOfSel);
+      if (code != TSDB_CODE_SUCCESS) {
+        return code;
+      }
+    } else {
+      colDataTrimFixedBySel(pDst, pSel, numOfSel);
+    }
+  }
+
+  pBlock->info.rows = numOfSel;
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t blockGetEncodeSize(const SSDataBlock* pBlock) {
   return blockDataGetSerialMetaSize(taosArrayGetSize(pBlock->pDataBlock)) + blockDataGetSize(pBlock);
 }
@@ -17,6 +17,7 @@
 #include "tglobal.h"
 #include "defines.h"
 #include "os.h"
+#include "tcompression.h"
 #include "tconfig.h"
 #include "tgrant.h"
 #include "tlog.h"
@@ -53,6 +54,8 @@ int32_t tsTimeToGetAvailableConn = 500000;
 int32_t tsKeepAliveIdle = 60;
 
 int32_t tsNumOfCommitThreads = 2;
+int32_t tsNumOfDecodeThreads = 0;
+int32_t tsNumOfApplyThreads = 0;
 int32_t tsNumOfTaskQueueThreads = 4;
 int32_t tsNumOfMnodeQueryThreads = 4;
 int32_t tsNumOfMnodeFetchThreads = 1;
@@ -73,6 +76,13 @@ int32_t tsElectInterval = 25 * 1000;
 int32_t tsHeartbeatInterval = 1000;
 int32_t tsHeartbeatTimeout = 20 * 1000;
 int32_t tsSnapReplMaxWaitN = 128;
+// max bytes of consecutive log entries packed into one append entries msg, 0 to send entries one by one.
+// dnodes of older versions take a packed msg as a single entry, so only enable it once all dnodes are upgraded
+int32_t tsSyncLogReplBatchSize = 0;
+// leader serves reads under a heartbeat lease, voters refuse to vote within it. must be the same on all dnodes
+bool    tsSyncLeaderLease = false;
+// followers serve queries after confirming the commit index of the leader, requires syncLeaderLease
+bool    tsSyncFollowerRead = false;
 
 // mnode
 int64_t tsMndSdbWriteDelta = 200;
@@ -200,6 +210,30 @@ int32_t tsQueryBufferSize = -1;
 int64_t tsQueryBufferSizeBytes = -1;
 int32_t tsCacheLazyLoadThreshold = 500;
 
+// columns of a data block are decompressed in parallel when at least this number of them carry values, 0 to disable
+int32_t tsDecodeParallelCols = 32;
+
+// memory in MB of each vnode to keep the decoded SMA of file blocks, 0 to disable
+int32_t tsBlockSmaCacheSize = 0;
+
+// tables of a submit request are applied to the memtable in parallel when there are at least this number of them
+int32_t tsApplyParallelTables = 64;
+
+// rows appended in order to a table are kept in chunks of the memtable instead of skiplist nodes
+bool tsMemTableChunk = false;
+
+// back the vnode write buffer pools with 2MB huge pages
+bool tsBufPoolHugePage = false;
+
+// place the write buffer pools of each vnode on one NUMA node and run its apply threads there
+bool tsBufPoolNumaBind = false;
+
+// keep the tags of the child tables of a super table column by column for tag scans and tag filters
+bool tsTagColumnCache = false;
+
+// dictionary-encode low-cardinality var columns of tsdb data blocks, older versions cannot read such blocks
+bool tsVarDictEncode = false;
+
 int32_t  tsDiskCfgNum = 0;
 SDiskCfg tsDiskCfg[TFS_MAX_DISKS] = {0};
 int64_t  tsMinDiskFreeSize = TFS_MIN_DISK_FREE_SIZE;
@@ -243,6 +277,13 @@ bool    tsStartUdfd = true;
 // wal
 int64_t tsWalFsyncDataSizeLimit = (100 * 1024 * 1024L);
 
+// wal group commit: appends of one sync batch share one fsync, bounded by bytes and latency(us)
+int64_t tsWalGroupCommitSize = (1024 * 1024L);
+int32_t tsWalGroupCommitLatency = 2000;
+
+// number of in-flight asynchronous(io_uring) writes of each wal and tsdb data file, 0 to write synchronously
+int32_t tsAsyncWriteDepth = 0;
+
 // ttl
 bool    tsTtlChangeOnWrite = false;  // if true, ttl delete time changes on last write
 int32_t tsTtlFlushThreshold = 100;   /* maximum number of dirty items in memory.
@@ -620,6 +661,12 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
   if (cfgAddInt32(pCfg, "numOfCommitThreads", tsNumOfCommitThreads, 1, 1024, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0)
     return -1;
 
+  if (cfgAddInt32(pCfg, "numOfDecodeThreads", tsNumOfDecodeThreads, 0, 1024, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0)
+    return -1;
+
+  if (cfgAddInt32(pCfg, "numOfApplyThreads", tsNumOfApplyThreads, 0, 1024, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0)
+    return -1;
+
   tsNumOfMnodeReadThreads = tsNumOfCores / 8;
   tsNumOfMnodeReadThreads = TRANGE(tsNumOfMnodeReadThreads, 1, 4);
   if (cfgAddInt32(pCfg, "numOfMnodeReadThreads", tsNumOfMnodeReadThreads, 1, 1024, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0)
@@ -686,6 +733,11 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
   if (cfgAddInt32(pCfg, "syncSnapReplMaxWaitN", tsSnapReplMaxWaitN, 16,
                   (TSDB_SYNC_SNAP_BUFFER_SIZE >> 2), CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0)
     return -1;
+  if (cfgAddInt32(pCfg, "syncLogReplBatchSize", tsSyncLogReplBatchSize, 0, 16 * 1024 * 1024, CFG_SCOPE_SERVER,
+                  CFG_DYN_NONE) != 0)
+    return -1;
+  if (cfgAddBool(pCfg, "syncLeaderLease", tsSyncLeaderLease, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
+  if (cfgAddBool(pCfg, "syncFollowerRead", tsSyncFollowerRead, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
 
   if (cfgAddInt64(pCfg, "mndSdbWriteDelta", tsMndSdbWriteDelta, 20, 10000, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER) != 0)
     return -1;
@@ -755,6 +807,14 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
   if (cfgAddInt64(pCfg, "walFsyncDataSizeLimit", tsWalFsyncDataSizeLimit, 100 * 1024 * 1024, INT64_MAX,
                   CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0)
     return -1;
+  if (cfgAddInt64(pCfg, "walGroupCommitSize", tsWalGroupCommitSize, 0, 1024 * 1024 * 1024, CFG_SCOPE_SERVER,
+                  CFG_DYN_ENT_SERVER) != 0)
+    return -1;
+  if (cfgAddInt32(pCfg, "walGroupCommitLatency", tsWalGroupCommitLatency, 0, 1000000, CFG_SCOPE_SERVER,
+                  CFG_DYN_ENT_SERVER) != 0)
+    return -1;
+  if (cfgAddInt32(pCfg, "asyncWriteDepth", tsAsyncWriteDepth, 0, 4096, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0)
+    return -1;
 
   if (cfgAddBool(pCfg, "udf", tsStartUdfd, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
   if (cfgAddString(pCfg, "udfdResFuncs", tsUdfdResFuncs, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
@@ -774,6 +834,20 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
   if (cfgAddInt32(pCfg, "cacheLazyLoadThreshold", tsCacheLazyLoadThreshold, 0, 100000, CFG_SCOPE_SERVER,
                   CFG_DYN_ENT_SERVER) != 0)
     return -1;
+  if (cfgAddInt32(pCfg, "decodeParallelCols", tsDecodeParallelCols, 0, 4096, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER) != 0)
+    return -1;
+  if (cfgAddInt32(pCfg, "blockSmaCacheSize", tsBlockSmaCacheSize, 0, 65536, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0)
+    return -1;
+  if (cfgAddInt32(pCfg, "applyParallelTables", tsApplyParallelTables, 0, 1000000, CFG_SCOPE_SERVER,
+                  CFG_DYN_ENT_SERVER) != 0)
+    return -1;
+  if (cfgAddBool(pCfg, "memTableChunk", tsMemTableChunk, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER) != 0) return -1;
+  if (cfgAddBool(pCfg, "bufPoolHugePage", tsBufPoolHugePage, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
+  if (cfgAddBool(pCfg, "bufPoolNumaBind", tsBufPoolNumaBind, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
+  if (cfgAddBool(pCfg, "tagColumnCache", tsTagColumnCache, CFG_SCOPE_SERVER, CFG_DYN_ENT_SERVER) != 0) return -1;
+  if (cfgAddBool(pCfg, "intForCodec", tsIntForCodec, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
+  if (cfgAddBool(pCfg, "floatChimpCodec", tsFloatChimpCodec, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
+  if (cfgAddBool(pCfg, "varDictEncode", tsVarDictEncode, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
 
   if (cfgAddString(pCfg, "lossyColumns", tsLossyColumns, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
   if (cfgAddFloat(pCfg, "fPrecision", tsFPrecision, 0.0f, 100000.0f, CFG_SCOPE_SERVER, CFG_DYN_NONE) != 0) return -1;
@@ -1150,6 +1224,8 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   tsTimeToGetAvailableConn = cfgGetItem(pCfg, "timeToGetAvailableConn")->i32;
 
   tsNumOfCommitThreads = cfgGetItem(pCfg, "numOfCommitThreads")->i32;
+  tsNumOfDecodeThreads = cfgGetItem(pCfg, "numOfDecodeThreads")->i32;
+  tsNumOfApplyThreads = cfgGetItem(pCfg, "numOfApplyThreads")->i32;
   tsNumOfMnodeReadThreads = cfgGetItem(pCfg, "numOfMnodeReadThreads")->i32;
   tsNumOfVnodeQueryThreads = cfgGetItem(pCfg, "numOfVnodeQueryThreads")->i32;
   tsRatioOfVnodeStreamThreads = cfgGetItem(pCfg, "ratioOfVnodeStreamThreads")->fval;
@@ -1204,11 +1280,17 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   tsTimeSeriesThreshold = cfgGetItem(pCfg, "timeseriesThreshold")->i32;
 
   tsWalFsyncDataSizeLimit = cfgGetItem(pCfg, "walFsyncDataSizeLimit")->i64;
+  tsWalGroupCommitSize = cfgGetItem(pCfg, "walGroupCommitSize")->i64;
+  tsWalGroupCommitLatency = cfgGetItem(pCfg, "walGroupCommitLatency")->i32;
+  tsAsyncWriteDepth = cfgGetItem(pCfg, "asyncWriteDepth")->i32;
 
   tsElectInterval = cfgGetItem(pCfg, "syncElectInterval")->i32;
   tsHeartbeatInterval = cfgGetItem(pCfg, "syncHeartbeatInterval")->i32;
   tsHeartbeatTimeout = cfgGetItem(pCfg, "syncHeartbeatTimeout")->i32;
   tsSnapReplMaxWaitN = cfgGetItem(pCfg, "syncSnapReplMaxWaitN")->i32;
+  tsSyncLogReplBatchSize = cfgGetItem(pCfg, "syncLogReplBatchSize")->i32;
+  tsSyncLeaderLease = cfgGetItem(pCfg, "syncLeaderLease")->bval;
+  tsSyncFollowerRead = cfgGetItem(pCfg, "syncFollowerRead")->bval;
 
   tsMndSdbWriteDelta = cfgGetItem(pCfg, "mndSdbWriteDelta")->i64;
   tsMndLogRetention = cfgGetItem(pCfg, "mndLogRetention")->i64;
@@ -1224,6 +1306,16 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   }
 
   tsCacheLazyLoadThreshold = cfgGetItem(pCfg, "cacheLazyLoadThreshold")->i32;
+  tsDecodeParallelCols = cfgGetItem(pCfg, "decodeParallelCols")->i32;
+  tsBlockSmaCacheSize = cfgGetItem(pCfg, "blockSmaCacheSize")->i32;
+  tsApplyParallelTables = cfgGetItem(pCfg, "applyParallelTables")->i32;
+  tsMemTableChunk = cfgGetItem(pCfg, "memTableChunk")->bval;
+  tsBufPoolHugePage = cfgGetItem(pCfg, "bufPoolHugePage")->bval;
+  tsBufPoolNumaBind = cfgGetItem(pCfg, "bufPoolNumaBind")->bval;
+  tsTagColumnCache = cfgGetItem(pCfg, "tagColumnCache")->bval;
+  tsIntForCodec = cfgGetItem(pCfg, "intForCodec")->bval;
+  tsFloatChimpCodec = cfgGetItem(pCfg, "floatChimpCodec")->bval;
+  tsVarDictEncode = cfgGetItem(pCfg, "varDictEncode")->bval;
 
   tstrncpy(tsLossyColumns, cfgGetItem(pCfg, "lossyColumns")->str, sizeof(tsLossyColumns));
   tsFPrecision = cfgGetItem(pCfg, "fPrecision")->fval;
@@ -1504,6 +1596,10 @@ static int32_t taosCfgDynamicOptionsForServer(SConfig *pCfg, char *name) {
                                          {"minDiskFreeSize", &tsMinDiskFreeSize},
 
                                          {"cacheLazyLoadThreshold", &tsCacheLazyLoadThreshold},
+                                         {"decodeParallelCols", &tsDecodeParallelCols},
+                                         {"applyParallelTables", &tsApplyParallelTables},
+                                         {"memTableChunk", &tsMemTableChunk},
+                                         {"tagColumnCache", &tsTagColumnCache},
                                          {"checkpointInterval", &tsStreamCheckpointInterval},
                                          {"keepAliveIdle", &tsKeepAliveIdle},
                                          {"logKeepDays", &tsLogKeepDays},
@@ -1524,6 +1620,8 @@ static int32_t taosCfgDynamicOptionsForServer(SConfig *pCfg, char *name) {
                                          {"s3PageCacheSize", &tsS3PageCacheSize},
                                          {"s3UploadDelaySec", &tsS3UploadDelaySec},
                                          {"supportVnodes", &tsNumOfSupportVnodes},
+                                         {"walGroupCommitSize", &tsWalGroupCommitSize},
+                                         {"walGroupCommitLatency", &tsWalGroupCommitLatency},
                                          {"experimental", &tsExperimental}};
 
     if (taosCfgSetOption(debugOptions, tListLen(debugOptions), pItem, true) != 0) {
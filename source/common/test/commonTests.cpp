@@ -408,6 +408,92 @@ TEST(testCase, var_dataBlock_split_test) {
   }
 }
 
+TEST(testCase, trim_dataBlock_by_sel_test) {
+  int32_t numOfRows = 1000;
+
+  SSDataBlock* b = createDataBlock();
+
+  SColumnInfoData infoData = createColumnInfoData(TSDB_DATA_TYPE_BIGINT, 8, 1);
+  blockDataAppendColInfo(b, &infoData);
+
+  SColumnInfoData infoData1 = createColumnInfoData(TSDB_DATA_TYPE_SMALLINT, 2, 2);
+  blockDataAppendColInfo(b, &infoData1);
+
+  SColumnInfoData infoData2 = createColumnInfoData(TSDB_DATA_TYPE_BINARY, 40, 3);
+  blockDataAppendColInfo(b, &infoData2);
+
+  SColumnInfoData infoData3 = createColumnInfoData(TSDB_DATA_TYPE_INT, 4, 4);
+  blockDataAppendColInfo(b, &infoData3);
+
+  blockDataEnsureCapacity(b, numOfRows);
+
+  char buf[41] = {0};
+  char varbuf[64] = {0};
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    int64_t v = i * 3;
+    int16_t s = i;
+    colDataSetVal((SColumnInfoData*)taosArrayGet(b->pDataBlock, 0), i, (const char*)&v, (i % 7) == 0);
+    colDataSetVal((SColumnInfoData*)taosArrayGet(b->pDataBlock, 1), i, (const char*)&s, (i % 5) == 0);
+
+    sprintf(buf, "row:%d", i);
+    STR_TO_VARSTR(varbuf, buf)
+    colDataSetVal((SColumnInfoData*)taosArrayGet(b->pDataBlock, 2), i, varbuf, (i % 3) == 0);
+    colDataSetVal((SColumnInfoData*)taosArrayGet(b->pDataBlock, 3), i, (const char*)&i, false);
+    b->info.rows++;
+  }
+
+  SSDataBlock* pExpect = createOneDataBlock(b, true);
+
+  bool*    pBoolList = (bool*)taosMemoryCalloc(numOfRows, sizeof(bool));
+  int32_t* pSel = (int32_t*)taosMemoryCalloc(numOfRows, sizeof(int32_t));
+  int32_t  numOfSel = 0;
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    pBoolList[i] = ((i * 13) % 11) < 4;
+    if (pBoolList[i]) {
+      pSel[numOfSel++] = i;
+    }
+  }
+
+  trimDataBlock(pExpect, numOfRows, pBoolList);
+
+  // the last column is only referenced by the filter
+  bool unused[4] = {false, false, false, true};
+  ASSERT_EQ(trimDataBlockBySel(b, pSel, numOfSel, unused), TSDB_CODE_SUCCESS);
+  ASSERT_EQ(b->info.rows, numOfSel);
+  ASSERT_EQ(pExpect->info.rows, numOfSel);
+
+  for (int32_t c = 0; c < 3; ++c) {
+    SColumnInfoData* p0 = (SColumnInfoData*)taosArrayGet(b->pDataBlock, c);
+    SColumnInfoData* p1 = (SColumnInfoData*)taosArrayGet(pExpect->pDataBlock, c);
+    for (int32_t i = 0; i < numOfSel; ++i) {
+      bool isNull = colDataIsNull(p1, numOfSel, i, nullptr);
+      ASSERT_EQ(colDataIsNull(p0, numOfSel, i, nullptr), isNull);
+      if (isNull) {
+        continue;
+      }
+
+      char* d0 = colDataGetData(p0, i);
+      char* d1 = colDataGetData(p1, i);
+      if (IS_VAR_DATA_TYPE(p0->info.type)) {
+        ASSERT_EQ(varDataLen(d0), varDataLen(d1));
+        ASSERT_EQ(memcmp(varDataVal(d0), varDataVal(d1), varDataLen(d0)), 0);
+      } else {
+        ASSERT_EQ(memcmp(d0, d1, p0->info.bytes), 0);
+      }
+    }
+  }
+
+  SColumnInfoData* pUnused = (SColumnInfoData*)taosArrayGet(b->pDataBlock, 3);
+  for (int32_t i = 0; i < numOfSel; ++i) {
+    ASSERT_EQ(colDataIsNull_f(pUnused->nullbitmap, i), true);
+  }
+
+  taosMemoryFree(pBoolList);
+  taosMemoryFree(pSel);
+  blockDataDestroy(pExpect);
+  blockDataDestroy(b);
+}
+
 void check_tm(const STm* tm, int32_t y, int32_t mon, int32_t d, int32_t h, int32_t m, int32_t s, int64_t fsec) {
   ASSERT_EQ(tm->tm.tm_year, y);
   ASSERT_EQ(tm->tm.tm_mon, mon);
@@ -26,20 +26,21 @@ extern "C" {
 #endif
 
 typedef struct SVnodeMgmt {
-  SDnodeData      *pData;
-  SMsgCb           msgCb;
-  const char      *path;
-  const char      *name;
-  SQWorkerPool     queryPool;
-  SAutoQWorkerPool streamPool;
-  SWWorkerPool     fetchPool;
-  SSingleWorker    mgmtWorker;
-  SHashObj        *hash;
-  TdThreadRwlock   lock;
-  SVnodesStat      state;
-  STfs            *pTfs;
-  TdThread         thread;
-  bool             stop;
+  SDnodeData       *pData;
+  SMsgCb            msgCb;
+  const char       *path;
+  const char       *name;
+  SStealQWorkerPool queryPool;
+  SArray           *queryStats;  // SStealQWorkerStat of the last monitor report
+  SAutoQWorkerPool  streamPool;
+  SWWorkerPool      fetchPool;
+  SSingleWorker     mgmtWorker;
+  SHashObj         *hash;
+  TdThreadRwlock    lock;
+  SVnodesStat       state;
+  STfs             *pTfs;
+  TdThread          thread;
+  bool              stop;
 } SVnodeMgmt;
 
 typedef struct {
@@ -66,6 +66,76 @@ void vmGetVnodeLoadsLite(SVnodeMgmt *pMgmt, SMonVloadInfo *pInfo) {
   taosThreadRwlockUnlock(&pMgmt->lock);
 }
 
+// the pool counters are totals, the report carries what changed since the last one
+static void vmGetWorkerMonitorInfo(SVnodeMgmt *pMgmt, SMonWorkerInfo *pInfo) {
+  SStealQWorkerPool *pPool = &pMgmt->queryPool;
+  SArray            *pStats = taosArrayInit(16, sizeof(SStealQWorkerStat));
+  pInfo->workers = taosArrayInit(16, sizeof(SMonWorkerDesc));
+  if (pStats == NULL || pInfo->workers == NULL) {
+    taosArrayDestroy(pStats);
+    return;
+  }
+
+  tStealQWorkerGetStat(pPool, pStats);
+  for (int32_t i = 0; i < taosArrayGetSize(pStats); ++i) {
+    SStealQWorkerStat *pStat = taosArrayGet(pStats, i);
+    SStealQWorkerStat  last = {0};
+    if (pMgmt->queryStats != NULL && i < taosArrayGetSize(pMgmt->queryStats)) {
+      last = *(SStealQWorkerStat *)taosArrayGet(pMgmt->queryStats, i);
+    }
+
+    SMonWorkerDesc desc = {
+        .id = pStat->id,
+        .queues = pStat->numOfQueues,
+        .processed = pStat->numOfProcessed - last.numOfProcessed,
+        .stolen = pStat->numOfStolen - last.numOfStolen,
+        .busy = pStat->busyTime - last.busyTime,
+    };
+    tstrncpy(desc.pool, pPool->name, sizeof(desc.pool));
+    taosArrayPush(pInfo->workers, &desc);
+  }
+
+  taosArrayDestroy(pMgmt->queryStats);
+  pMgmt->queryStats = pStats;
+}
+
+static void vmGetBufPoolMonitorInfo(SVnodeMgmt *pMgmt, SMonBufPoolInfo *pInfo) {
+  SArray *pStats = taosArrayInit(16, sizeof(SVBufPoolStat));
+  pInfo->pools = taosArrayInit(16, sizeof(SMonBufPoolDesc));
+  if (pStats == NULL || pInfo->pools == NULL) {
+    taosArrayDestroy(pStats);
+    return;
+  }
+
+  taosThreadRwlockRdlock(&pMgmt->lock);
+  void *pIter = taosHashIterate(pMgmt->hash, NULL);
+  while (pIter) {
+    SVnodeObj *pVnode = *(SVnodeObj **)pIter;
+    if (pVnode != NULL && !pVnode->failed && pVnode->pImpl != NULL) {
+      vnodeGetBufPoolStat(pVnode->pImpl, pStats);
+    }
+    pIter = taosHashIterate(pMgmt->hash, pIter);
+  }
+  taosThreadRwlockUnlock(&pMgmt->lock);
+
+  for (int32_t i = 0; i < taosArrayGetSize(pStats); ++i) {
+    SVBufPoolStat  *pStat = taosArrayGet(pStats, i);
+    SMonBufPoolDesc desc = {
+        .vgId = pStat->vgId,
+        .id = pStat->id,
+        .numaNode = pStat->numaNode,
+        .hugePage = pStat->hugePage,
+        .capacity = pStat->capacity,
+        .used = pStat->used,
+        .allocs = pStat->nAlloc,
+        .overflows = pStat->nOverflow,
+        .overflowSize = pStat->szOverflow,
+    };
+    taosArrayPush(pInfo->pools, &desc);
+  }
+  taosArrayDestroy(pStats);
+}
+
 void vmGetMonitorInfo(SVnodeMgmt *pMgmt, SMonVmInfo *pInfo) {
   SMonVloadInfo vloads = {0};
   vmGetVnodeLoads(pMgmt, &vloads, true);
@@ -109,6 +179,9 @@ void vmGetMonitorInfo(SVnodeMgmt *pMgmt, SMonVmInfo *pInfo) {
 
   tfsGetMonitorInfo(pMgmt->pTfs, &pInfo->tfs);
   taosArrayDestroy(pVloads);
+
+  vmGetWorkerMonitorInfo(pMgmt, &pInfo->worker);
+  vmGetBufPoolMonitorInfo(pMgmt, &pInfo->bufPool);
 }
 
 static void vmGenerateVnodeCfg(SCreateVnodeReq *pCreate, SVnodeCfg *pCfg) {
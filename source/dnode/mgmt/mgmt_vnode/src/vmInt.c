@@ -505,6 +505,7 @@ static void vmCleanup(SVnodeMgmt *pMgmt) {
   vmStopWorker(pMgmt);
   vnodeCleanup();
   taosThreadRwlockDestroy(&pMgmt->lock);
+  taosArrayDestroy(pMgmt->queryStats);
   taosMemoryFree(pMgmt);
 }
 
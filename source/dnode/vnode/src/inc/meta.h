@@ -24,9 +24,10 @@
 extern "C" {
 #endif
 
-typedef struct SMetaIdx   SMetaIdx;
-typedef struct SMetaDB    SMetaDB;
-typedef struct SMetaCache SMetaCache;
+typedef struct SMetaIdx         SMetaIdx;
+typedef struct SMetaDB          SMetaDB;
+typedef struct SMetaCache       SMetaCache;
+typedef struct SMetaTagColCache SMetaTagColCache;
 
 // metaDebug ==================
 // clang-format off
@@ -42,6 +43,7 @@ typedef struct SMetaCache SMetaCache;
 int32_t metaRLock(SMeta* pMeta);
 int32_t metaWLock(SMeta* pMeta);
 int32_t metaULock(SMeta* pMeta);
+int     metaTagIdxKeyCmpr(const void* pKey1, int kLen1, const void* pKey2, int kLen2);
 
 // metaEntry ==================
 int metaEncodeEntry(SEncoder* pCoder, const SMetaEntry* pME);
@@ -73,6 +75,16 @@ int32_t metaStatsCacheDrop(SMeta* pMeta, int64_t uid);
 int32_t metaStatsCacheGet(SMeta* pMeta, int64_t uid, SMetaStbStats* pInfo);
 void    metaUpdateStbStats(SMeta* pMeta, int64_t uid, int64_t deltaCtb, int32_t deltaCol);
 int32_t metaUidFilterCacheGet(SMeta* pMeta, uint64_t suid, const void* pKey, int32_t keyLen, LRUHandle** pHandle);
+void    metaUidCachePrepareCheckpoint(SMeta* pMeta, int64_t version);
+int32_t metaUidCacheSaveCheckpoint(SMeta* pMeta);
+void    metaUidCacheDropCheckpoint(SMeta* pMeta);
+int32_t metaUidCacheRestore(SMeta* pMeta, int64_t version);
+
+// metaTagCol ==================
+int32_t metaTagColCacheOpen(SMeta* pMeta);
+void    metaTagColCacheClose(SMeta* pMeta);
+void    metaTagColsUpdate(SMeta* pMeta, tb_uid_t suid, tb_uid_t uid);
+void    metaTagColsDrop(SMeta* pMeta, tb_uid_t suid);
 
 struct SMeta {
   TdThreadRwlock lock;
@@ -104,7 +116,8 @@ struct SMeta {
 
   SMetaIdx* pIdx;
 
-  SMetaCache* pCache;
+  SMetaCache*       pCache;
+  SMetaTagColCache* pTagColCache;
 };
 
 typedef struct {
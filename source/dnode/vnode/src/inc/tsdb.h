@@ -80,6 +80,10 @@ typedef struct STFileSystem     STFileSystem;
 #define TSDBROW_COL_FMT ((int8_t)0x1)
 
 #define TSDB_FILE_DLMT ((uint32_t)0xF00AFA0F)
+
+// SBlockCol smaOn byte on disk
+#define TSDB_BLOCK_COL_SMA_ON ((int8_t)0x1)
+#define TSDB_BLOCK_COL_DICT   ((int8_t)0x2)
 #define TSDB_FHDR_SIZE 512
 
 #define VERSION_MIN 0
@@ -172,6 +176,7 @@ int32_t tBlockDataUpdateRow(SBlockData *pBlockData, TSDBROW *pRow, STSchema *pTS
 int32_t tBlockDataTryUpsertRow(SBlockData *pBlockData, TSDBROW *pRow, int64_t uid);
 int32_t tBlockDataUpsertRow(SBlockData *pBlockData, TSDBROW *pRow, STSchema *pTSchema, int64_t uid);
 void    tBlockDataClear(SBlockData *pBlockData);
+int32_t tBlockDataMoveColData(SBlockData *pBlockData, SBlockData *pBlockDataFrom);
 void    tBlockDataGetColData(SBlockData *pBlockData, int16_t cid, SColData **ppColData);
 int32_t tCmprBlockData(SBlockData *pBlockData, int8_t cmprAlg, uint8_t **ppOut, int32_t *szOut, uint8_t *aBuf[],
                        int32_t aBufN[]);
@@ -363,6 +368,7 @@ struct STsdb {
   TdThreadMutex        bMutex;
   SLRUCache           *pgCache;
   TdThreadMutex        pgMutex;
+  SLRUCache           *smaCache;  // decoded SMA of file blocks, keyed by the sma file and the block offset
   struct STFileSystem *pFS;  // new
   SRocksCache          rCache;
   // compact monitor
@@ -393,6 +399,22 @@ typedef struct SMemSkipList {
   SMemSkipListNode *pTail;
 } SMemSkipList;
 
+// rows appended in order after all rows of a table, kept as submitted without skiplist nodes
+typedef struct SMemChunk SMemChunk;
+struct SMemChunk {
+  int8_t     flag;  // TSDBROW_ROW_FMT for aRow, TSDBROW_COL_FMT for pBlockData
+  int32_t    nRow;
+  int64_t    version;
+  TSKEY      minKey;
+  TSKEY      maxKey;
+  SMemChunk *prev;
+  SMemChunk *next;
+  union {
+    SRow      **aRow;
+    SBlockData *pBlockData;
+  };
+};
+
 struct STbData {
   tb_uid_t     suid;
   tb_uid_t     uid;
@@ -401,7 +423,10 @@ struct STbData {
   SRWLatch     lock;
   SDelData    *pHead;
   SDelData    *pTail;
-  SMemSkipList sl;
+  SMemSkipList sl;  // rows out of order, or all rows when chunks are disabled
+  SMemChunk   *pChunkHead;
+  SMemChunk   *pChunkTail;
+  int64_t      nChunkRow;
   STbData     *next;
   SRBTreeNode  rbtn[1];
 };
@@ -455,6 +480,7 @@ struct SBlockCol {
   int16_t cid;
   int8_t  type;
   int8_t  smaOn;
+  int8_t  dict;      // var data saved as per-row codes (offset) and a dictionary (value)
   int8_t  flag;      // HAS_NONE|HAS_NULL|HAS_VALUE
   int32_t szOrigin;  // original column value size (only save for variant data type)
   int32_t szBitmap;  // bitmap size, 0 only for flag == HAS_VAL
@@ -533,6 +559,9 @@ struct STbDataIter {
   STbData          *pTbData;
   int8_t            backward;
   SMemSkipListNode *pNode;
+  SMemChunk        *pChunk;
+  int32_t           iChunkRow;
+  int8_t            fromChunk;  // pRow is at the chunk cursor
   TSDBROW          *pRow;
   TSDBROW           row;
 };
@@ -629,19 +658,20 @@ struct SRowMerger {
 };
 
 typedef struct {
-  char       *path;
-  int32_t     szPage;
-  int32_t     flag;
-  TdFilePtr   pFD;
-  int64_t     pgno;
-  uint8_t    *pBuf;
-  int64_t     szFile;
-  STsdb      *pTsdb;
-  const char *objName;
-  uint8_t     s3File;
-  int32_t     fid;
-  int64_t     cid;
-  int64_t     blkno;
+  char        *path;
+  int32_t      szPage;
+  int32_t      flag;
+  TdFilePtr    pFD;
+  TdFileAioPtr pAio;  // async page writes, NULL when written synchronously
+  int64_t      pgno;
+  uint8_t     *pBuf;
+  int64_t      szFile;
+  STsdb       *pTsdb;
+  const char  *objName;
+  uint8_t      s3File;
+  int32_t      fid;
+  int64_t      cid;
+  int64_t      blkno;
 } STsdbFD;
 
 struct SDelFWriter {
@@ -913,6 +943,15 @@ int32_t tsdbBICacheRelease(SLRUCache *pCache, LRUHandle *h);
 int32_t tsdbCacheGetBlockS3(SLRUCache *pCache, STsdbFD *pFD, LRUHandle **handle);
 int32_t tsdbCacheGetPageS3(SLRUCache *pCache, STsdbFD *pFD, int64_t pgno, LRUHandle **handle);
 int32_t tsdbCacheSetPageS3(SLRUCache *pCache, STsdbFD *pFD, int64_t pgno, uint8_t *pPage);
+
+typedef struct {
+  int32_t        nSma;
+  SColumnDataAgg aSma[];
+} SBlockSmaCacheVal;
+
+int32_t tsdbCacheGetBlockSma(STsdb *pTsdb, int32_t fid, int64_t cid, int64_t offset, LRUHandle **handle);
+int32_t tsdbCacheSetBlockSma(STsdb *pTsdb, int32_t fid, int64_t cid, int64_t offset, const SColumnDataAgg *aSma,
+                             int32_t nSma);
 int32_t tsdbCacheRelease(SLRUCache *pCache, LRUHandle *h);
 
 int32_t tsdbCacheDeleteLastrow(SLRUCache *pCache, tb_uid_t uid, TSKEY eKey);
@@ -942,6 +981,14 @@ static FORCE_INLINE int32_t tsdbKeyCmprFn(const void *p1, const void *p2) {
 // #define SL_NODE_FORWARD(n, l)  ((n)->forwards[l])
 // #define SL_NODE_BACKWARD(n, l) ((n)->forwards[(n)->level + (l)])
 
+static FORCE_INLINE TSDBROW tsdbMemChunkGetRow(SMemChunk *pChunk, int32_t iRow) {
+  if (pChunk->flag == TSDBROW_ROW_FMT) {
+    return tsdbRowFromTSRow(pChunk->version, pChunk->aRow[iRow]);
+  } else {
+    return tsdbRowFromBlockData(pChunk->pBlockData, iRow);
+  }
+}
+
 static FORCE_INLINE TSDBROW *tsdbTbDataIterGet(STbDataIter *pIter) {
   if (pIter == NULL) return NULL;
 
@@ -949,23 +996,43 @@ static FORCE_INLINE TSDBROW *tsdbTbDataIterGet(STbDataIter *pIter) {
     return pIter->pRow;
   }
 
+  bool hasNode;
   if (pIter->backward) {
-    if (pIter->pNode == pIter->pTbData->sl.pHead) {
-      return NULL;
-    }
+    hasNode = (pIter->pNode != pIter->pTbData->sl.pHead);
   } else {
-    if (pIter->pNode == pIter->pTbData->sl.pTail) {
-      return NULL;
-    }
+    hasNode = (pIter->pNode != pIter->pTbData->sl.pTail);
+  }
+
+  if (!hasNode && pIter->pChunk == NULL) {
+    return NULL;
   }
 
   pIter->pRow = &pIter->row;
-  if (pIter->pNode->flag == TSDBROW_ROW_FMT) {
-    pIter->row = tsdbRowFromTSRow(pIter->pNode->version, pIter->pNode->pData);
-  } else if (pIter->pNode->flag == TSDBROW_COL_FMT) {
-    pIter->row = tsdbRowFromBlockData(pIter->pNode->pData, pIter->pNode->iRow);
-  } else {
-    ASSERT(0);
+  pIter->fromChunk = 0;
+  if (hasNode) {
+    if (pIter->pNode->flag == TSDBROW_ROW_FMT) {
+      pIter->row = tsdbRowFromTSRow(pIter->pNode->version, (SRow *)pIter->pNode->pData);
+    } else if (pIter->pNode->flag == TSDBROW_COL_FMT) {
+      pIter->row = tsdbRowFromBlockData((SBlockData *)pIter->pNode->pData, pIter->pNode->iRow);
+    } else {
+      ASSERT(0);
+    }
+  }
+
+  // merge the chunk cursor with the skiplist cursor
+  if (pIter->pChunk) {
+    TSDBROW chunkRow = tsdbMemChunkGetRow(pIter->pChunk, pIter->iChunkRow);
+    if (!hasNode) {
+      pIter->fromChunk = 1;
+    } else {
+      TSDBKEY nodeKey = TSDBROW_KEY(&pIter->row);
+      TSDBKEY chunkKey = TSDBROW_KEY(&chunkRow);
+      int32_t c = tsdbKeyCmprFn(&chunkKey, &nodeKey);
+      pIter->fromChunk = pIter->backward ? (c > 0) : (c < 0);
+    }
+    if (pIter->fromChunk) {
+      pIter->row = chunkRow;
+    }
   }
 
   return pIter->pRow;
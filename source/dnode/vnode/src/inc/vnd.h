@@ -73,7 +73,7 @@ int32_t vnodeACancel(SVAsync* async, int64_t taskId);
 int32_t vnodeAsyncSetWorkers(SVAsync* async, int32_t numWorkers);
 
 // vnodeModule.c
-extern SVAsync* vnodeAsyncHandle[2];
+extern SVAsync* vnodeAsyncHandle[4];
 
 // vnodeBufPool.c
 typedef struct SVBufPoolNode SVBufPoolNode;
@@ -101,7 +101,16 @@ struct SVBufPool {
   int64_t           size;
   uint8_t*          ptr;
   SVBufPoolNode*    pTail;
-  SVBufPoolNode     node;
+
+  // memory placement and allocation statistics
+  int64_t mapSize;  // size of the mapping backing the pool, 0 if allocated from the heap
+  int32_t numaNode;
+  bool    hugePage;
+  int64_t nAlloc;
+  int64_t nOverflow;
+  int64_t szOverflow;
+
+  SVBufPoolNode node;
 };
 
 int32_t vnodeOpenBufPool(SVnode* pVnode);
@@ -109,6 +118,8 @@ int32_t vnodeCloseBufPool(SVnode* pVnode);
 void    vnodeBufPoolReset(SVBufPool* pPool);
 void    vnodeBufPoolAddToFreeList(SVBufPool* pPool);
 int32_t vnodeBufPoolRecycle(SVBufPool* pPool);
+int32_t vnodeBufPoolNumaNode(SVnode* pVnode);
+void    vnodeBufPoolBindThread(SVnode* pVnode);
 
 // vnodeOpen.c
 int32_t vnodeGetPrimaryDir(const char* relPath, int32_t diskPrimary, STfs* pTfs, char* buf, size_t bufLen);
@@ -132,12 +143,18 @@ int32_t vnodeSyncCommit(SVnode* pVnode);
 int32_t vnodeAsyncCommit(SVnode* pVnode);
 bool    vnodeShouldRollback(SVnode* pVnode);
 
+// vnodeSvr.c
+int32_t vnodeApplySubmitTbData(SVnode* pVnode, int64_t ver, SSubmitReq2* pSubmitReq, int32_t* affectedRows);
+
 // vnodeSync.c
 int32_t vnodeSyncOpen(SVnode* pVnode, char* path, int32_t vnodeVersion);
 int32_t vnodeSyncStart(SVnode* pVnode);
 void    vnodeSyncPreClose(SVnode* pVnode);
 void    vnodeSyncPostClose(SVnode* pVnode);
 void    vnodeSyncClose(SVnode* pVnode);
+void    vnodeNotifyApplied(SVnode* pVnode);
+int32_t vnodeWaitApplied(SVnode* pVnode, int64_t index, int64_t timeoutMs);
+int32_t vnodeReadIndex(SVnode* pVnode);
 void    vnodeRedirectRpcMsg(SVnode* pVnode, SRpcMsg* pMsg, int32_t code);
 bool    vnodeIsLeader(SVnode* pVnode);
 bool    vnodeIsRoleLeader(SVnode* pVnode);
@@ -174,6 +174,8 @@ int             metaCreateSTable(SMeta* pMeta, int64_t version, SVCreateStbReq*
 int             metaAlterSTable(SMeta* pMeta, int64_t version, SVCreateStbReq* pReq);
 int             metaDropSTable(SMeta* pMeta, int64_t verison, SVDropStbReq* pReq, SArray* tbUidList);
 int             metaCreateTable(SMeta* pMeta, int64_t version, SVCreateTbReq* pReq, STableMetaRsp** pMetaRsp);
+int             metaCreateTables(SMeta* pMeta, int64_t version, SVCreateTbReq** ppReqs, int32_t nReqs, int32_t* pCodes,
+                                 STableMetaRsp** ppMetaRsp);
 int             metaDropTable(SMeta* pMeta, int64_t version, SVDropTbReq* pReq, SArray* tbUids, int64_t* tbUid);
 int32_t         metaTrimTables(SMeta* pMeta);
 void            metaDropTables(SMeta* pMeta, SArray* tbUids);
@@ -187,6 +189,7 @@ int             metaGetTableEntryByName(SMetaReader* pReader, const char* name);
 int             metaAlterCache(SMeta* pMeta, int32_t nPage);
 
 int32_t metaUidCacheClear(SMeta* pMeta, uint64_t suid);
+int32_t metaUidCacheUpdate(SMeta* pMeta, uint64_t suid, uint64_t uid);
 int32_t metaTbGroupCacheClear(SMeta* pMeta, uint64_t suid);
 
 int metaAddIndexToSTable(SMeta* pMeta, int64_t version, SVCreateStbReq* pReq);
@@ -505,6 +508,9 @@ struct SVnode {
   tsem_t        syncSem;
   int32_t       blockSec;
   int64_t       blockSeq;
+  TdThreadMutex applyMutex;
+  TdThreadCond  applyCond;     // signaled on apply while follower reads wait for their read index
+  int32_t       applyWaiters;
   SQHandle*     pQuery;
   SVMonitorObj  monitor;
 };
@@ -21,9 +21,11 @@ extern const int   tkLogStbNum;
 extern const int   tkAuditStbNum;
 #endif
 
-#define TAG_FILTER_RES_KEY_LEN  32
-#define META_CACHE_BASE_BUCKET  1024
-#define META_CACHE_STATS_BUCKET 16
+#define TAG_FILTER_RES_KEY_LEN     32
+#define TAG_FILTER_RES_MAX_CHANGES 1024
+#define TAG_FILTER_RES_CKPT_FNAME  "tag_filter.ckpt"
+#define META_CACHE_BASE_BUCKET     1024
+#define META_CACHE_STATS_BUCKET    16
 
 // (uid , suid) : child table
 // (uid,     0) : normal table
@@ -42,8 +44,18 @@ typedef struct SMetaStbStatsEntry {
 typedef struct STagFilterResEntry {
   SList    list;      // the linked list of md5 digest, extracted from the serialized tag query condition
   uint32_t hitTimes;  // queried times for current super table
+  int64_t  ver;       // bumped by each child table created, dropped or retagged of current super table
 } STagFilterResEntry;
 
+// the uid list of a tag filter condition, valid as of the version ver of its super table. the child tables changed
+// after ver are recorded in order, and the list is patched for them on the next lookup instead of being rebuilt.
+typedef struct STagFilterResValue {
+  int64_t ver;
+  SArray* pChanged;  // uid of the child tables changed after ver, ver + size(pChanged) equals the version of the entry
+  int32_t payloadLen;
+  void*   pPayload;  // numOfTables(int32_t) + uid list, built by the executor
+} STagFilterResValue;
+
 struct SMetaCache {
   // child, normal, super, table entry cache
   struct SEntryCache {
@@ -65,6 +77,9 @@ struct SMetaCache {
     uint32_t      accTimes;
     SHashObj*     pTableEntry;
     SLRUCache*    pUidResCache;
+    int64_t       ckptVer;  // the version of the pending checkpoint
+    void*         pCkpt;    // the pending checkpoint, taken when commit begins and saved when commit finishes
+    int32_t       ckptLen;
   } sTagFilterResCache;
 
   struct STbGroupResCache {
@@ -153,6 +168,9 @@ int32_t metaCacheOpen(SMeta* pMeta) {
   }
 
   pCache->sTagFilterResCache.accTimes = 0;
+  pCache->sTagFilterResCache.ckptVer = 0;
+  pCache->sTagFilterResCache.pCkpt = NULL;
+  pCache->sTagFilterResCache.ckptLen = 0;
   pCache->sTagFilterResCache.pTableEntry =
       taosHashInit(1024, taosGetDefaultHashFunction(TSDB_DATA_TYPE_VARCHAR), false, HASH_NO_LOCK);
   if (pCache->sTagFilterResCache.pTableEntry == NULL) {
@@ -213,6 +231,7 @@ void metaCacheClose(SMeta* pMeta) {
     taosLRUCacheCleanup(pMeta->pCache->sTagFilterResCache.pUidResCache);
     taosThreadMutexDestroy(&pMeta->pCache->sTagFilterResCache.lock);
     taosHashCleanup(pMeta->pCache->sTagFilterResCache.pTableEntry);
+    taosMemoryFree(pMeta->pCache->sTagFilterResCache.pCkpt);
 
     taosLRUCacheCleanup(pMeta->pCache->STbGroupResCache.pResCache);
     taosThreadMutexDestroy(&pMeta->pCache->STbGroupResCache.lock);
@@ -525,10 +544,13 @@ static void initCacheKey(uint64_t* buf, const SHashObj* pHashMap, uint64_t suid,
   ASSERT(keyLen == sizeof(uint64_t) * 2);
 }
 
+static int32_t addNewEntry(SHashObj* pTableEntry, const void* pKey, int32_t keyLen, uint64_t suid);
+
 int32_t metaGetCachedTableUidList(void* pVnode, tb_uid_t suid, const uint8_t* pKey, int32_t keyLen, SArray* pList1,
-                                  bool* acquireRes) {
+                                  SArray* pChanged, int64_t* pVer, bool* acquireRes) {
   SMeta*  pMeta = ((SVnode*)pVnode)->pMeta;
   int32_t vgId = TD_VID(pMeta->pVnode);
+  int32_t code = TSDB_CODE_SUCCESS;
 
   // generate the composed key for LRU cache
   SLRUCache*     pCache = pMeta->pCache->sTagFilterResCache.pUidResCache;
@@ -536,32 +558,40 @@ int32_t metaGetCachedTableUidList(void* pVnode, tb_uid_t suid, const uint8_t* pK
   TdThreadMutex* pLock = &pMeta->pCache->sTagFilterResCache.lock;
 
   *acquireRes = 0;
+  *pVer = 0;
   uint64_t key[4];
   initCacheKey(key, pTableMap, suid, (const char*)pKey, keyLen);
 
   taosThreadMutexLock(pLock);
   pMeta->pCache->sTagFilterResCache.accTimes += 1;
 
+  STagFilterResEntry** pEntry = taosHashGet(pTableMap, &suid, sizeof(uint64_t));
+  if (pEntry == NULL) {
+    // register the super table, so the child tables changed while the list is built are counted in its version
+    code = addNewEntry(pTableMap, NULL, keyLen, suid);
+    taosThreadMutexUnlock(pLock);
+    return code;
+  }
+
+  *pVer = (*pEntry)->ver;
+
   LRUHandle* pHandle = taosLRUCacheLookup(pCache, key, TAG_FILTER_RES_KEY_LEN);
   if (pHandle == NULL) {
     taosThreadMutexUnlock(pLock);
     return TSDB_CODE_SUCCESS;
   }
 
-  // do some book mark work after acquiring the filter result from cache
-  STagFilterResEntry** pEntry = taosHashGet(pTableMap, &suid, sizeof(uint64_t));
-  if (NULL == pEntry) {
-    metaError("meta/cache: pEntry should not be NULL.");
-    return TSDB_CODE_FAILED;
-  }
-
   *acquireRes = 1;
 
-  const char* p = taosLRUCacheValue(pCache, pHandle);
-  int32_t     size = *(int32_t*)p;
+  const STagFilterResValue* pValue = taosLRUCacheValue(pCache, pHandle);
+  const char*               p = pValue->pPayload;
+  int32_t                   size = *(int32_t*)p;
 
-  // set the result into the buffer
+  // set the result into the buffer, along with the child tables it is to be patched for
   taosArrayAddBatch(pList1, p + sizeof(int32_t), size);
+  if (taosArrayGetSize(pValue->pChanged) > 0) {
+    taosArrayAddAll(pChanged, pValue->pChanged);
+  }
 
   (*pEntry)->hitTimes += 1;
 
@@ -578,6 +608,12 @@ int32_t metaGetCachedTableUidList(void* pVnode, tb_uid_t suid, const uint8_t* pK
   return TSDB_CODE_SUCCESS;
 }
 
+static void destroyTagFilterResValue(STagFilterResValue* pValue) {
+  taosArrayDestroy(pValue->pChanged);
+  taosMemoryFree(pValue->pPayload);
+  taosMemoryFree(pValue);
+}
+
 static void freeUidCachePayload(const void* key, size_t keyLen, void* value, void* ud) {
   (void)ud;
   if (value == NULL) {
@@ -615,7 +651,7 @@ static void freeUidCachePayload(const void* key, size_t keyLen, void* value, voi
     }
   }
 
-  taosMemoryFree(value);
+  destroyTagFilterResValue(value);
 }
 
 static int32_t addNewEntry(SHashObj* pTableEntry, const void* pKey, int32_t keyLen, uint64_t suid) {
@@ -625,15 +661,19 @@ static int32_t addNewEntry(SHashObj* pTableEntry, const void* pKey, int32_t keyL
   }
 
   p->hitTimes = 0;
+  p->ver = 0;
   tdListInit(&p->list, keyLen);
   taosHashPut(pTableEntry, &suid, sizeof(uint64_t), &p, POINTER_BYTES);
-  tdListAppend(&p->list, pKey);
+  if (pKey != NULL) {
+    tdListAppend(&p->list, pKey);
+  }
   return 0;
 }
 
-// check both the payload size and selectivity ratio
+// check both the payload size and selectivity ratio. ver is the version of the super table the list is valid as of,
+// which is returned by metaGetCachedTableUidList before the list is built or patched.
 int32_t metaUidFilterCachePut(void* pVnode, uint64_t suid, const void* pKey, int32_t keyLen, void* pPayload,
-                              int32_t payloadLen, double selectivityRatio) {
+                              int32_t payloadLen, double selectivityRatio, int64_t ver) {
   int32_t code = 0;
   SMeta*  pMeta = ((SVnode*)pVnode)->pMeta;
   int32_t vgId = TD_VID(pMeta->pVnode);
@@ -654,6 +694,21 @@ int32_t metaUidFilterCachePut(void* pVnode, uint64_t suid, const void* pKey, int
     return TSDB_CODE_SUCCESS;
   }
 
+  STagFilterResValue* pValue = taosMemoryCalloc(1, sizeof(STagFilterResValue));
+  if (pValue == NULL) {
+    taosMemoryFree(pPayload);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pValue->ver = ver;
+  pValue->payloadLen = payloadLen;
+  pValue->pPayload = pPayload;
+  pValue->pChanged = taosArrayInit(4, sizeof(uint64_t));
+  if (pValue->pChanged == NULL) {
+    destroyTagFilterResValue(pValue);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
   SLRUCache*     pCache = pMeta->pCache->sTagFilterResCache.pUidResCache;
   SHashObj*      pTableEntry = pMeta->pCache->sTagFilterResCache.pTableEntry;
   TdThreadMutex* pLock = &pMeta->pCache->sTagFilterResCache.lock;
@@ -663,40 +718,100 @@ int32_t metaUidFilterCachePut(void* pVnode, uint64_t suid, const void* pKey, int
 
   taosThreadMutexLock(pLock);
   STagFilterResEntry** pEntry = taosHashGet(pTableEntry, &suid, sizeof(uint64_t));
-  if (pEntry == NULL) {
-    code = addNewEntry(pTableEntry, pKey, keyLen, suid);
-    if (code != TSDB_CODE_SUCCESS) {
-      goto _end;
+  if (pEntry == NULL || ver > (*pEntry)->ver) {
+    goto _outdated;
+  }
+
+  if (ver < (*pEntry)->ver) {
+    // child tables are changed while the list is built or patched. they are recorded by the list cached before, if it
+    // is still in cache and not newer than this one.
+    LRUHandle* pHandle = taosLRUCacheLookup(pCache, key, TAG_FILTER_RES_KEY_LEN);
+    if (pHandle == NULL) {
+      goto _outdated;
     }
-  } else {  // check if it exists or not
-    size_t size = listNEles(&(*pEntry)->list);
-    if (size == 0) {
-      tdListAppend(&(*pEntry)->list, pKey);
-    } else {
-      SListNode* pNode = listHead(&(*pEntry)->list);
-      uint64_t*  p = (uint64_t*)pNode->data;
-      if (p[1] == ((uint64_t*)pKey)[1] && p[0] == ((uint64_t*)pKey)[0]) {
-        // we have already found the existed items, no need to added to cache anymore.
-        taosThreadMutexUnlock(pLock);
-        return TSDB_CODE_SUCCESS;
-      } else {  // not equal, append it
-        tdListAppend(&(*pEntry)->list, pKey);
-      }
+
+    STagFilterResValue* pOld = taosLRUCacheValue(pCache, pHandle);
+    int32_t             numOfChanged = taosArrayGetSize(pOld->pChanged);
+    int64_t             start = ver - pOld->ver;
+    bool                carried = start >= 0 && start < numOfChanged &&
+                   taosArrayAddBatch(pValue->pChanged, taosArrayGet(pOld->pChanged, start), numOfChanged - start) != NULL;
+    taosLRUCacheRelease(pCache, pHandle, false);
+    if (!carried) {
+      goto _outdated;
     }
   }
 
+  // the list cached before for the same condition is replaced, and its digest is removed from the linked list
+  tdListAppend(&(*pEntry)->list, pKey);
+
   // add to cache.
-  taosLRUCacheInsert(pCache, key, TAG_FILTER_RES_KEY_LEN, pPayload, payloadLen, freeUidCachePayload, NULL,
+  taosLRUCacheInsert(pCache, key, TAG_FILTER_RES_KEY_LEN, pValue, payloadLen, freeUidCachePayload, NULL,
                      TAOS_LRU_PRIORITY_LOW, NULL);
-_end:
   taosThreadMutexUnlock(pLock);
   metaDebug("vgId:%d, suid:%" PRIu64 " list cache added into cache, total:%d, tables:%d", vgId, suid,
             (int32_t)taosLRUCacheGetUsage(pCache), taosHashGetSize(pTableEntry));
 
   return code;
+
+_outdated:
+  taosThreadMutexUnlock(pLock);
+  metaDebug("vgId:%d, suid:%" PRIu64 " failed to add to uid list cache, due to list of version %" PRId64 " outdated",
+            vgId, suid, ver);
+  destroyTagFilterResValue(pValue);
+  return TSDB_CODE_SUCCESS;
 }
 
-// remove the lru cache that are expired due to the tags value update, or creating, or dropping, of child tables
+// record the child table created, dropped or retagged into the cached uid lists of its super table, so the lists are
+// patched for it on the next lookup. a list is removed instead, once too many child tables are recorded for it.
+int32_t metaUidCacheUpdate(SMeta* pMeta, uint64_t suid, uint64_t uid) {
+  uint64_t   p[4] = {0};
+  int32_t    vgId = TD_VID(pMeta->pVnode);
+  SLRUCache* pCache = pMeta->pCache->sTagFilterResCache.pUidResCache;
+  SHashObj*  pEntryHashMap = pMeta->pCache->sTagFilterResCache.pTableEntry;
+
+  uint64_t dummy[2] = {0};
+  initCacheKey(p, pEntryHashMap, suid, (char*)&dummy[0], 16);
+
+  TdThreadMutex* pLock = &pMeta->pCache->sTagFilterResCache.lock;
+  taosThreadMutexLock(pLock);
+
+  STagFilterResEntry** pEntry = taosHashGet(pEntryHashMap, &suid, sizeof(uint64_t));
+  if (pEntry == NULL) {
+    taosThreadMutexUnlock(pLock);
+    return TSDB_CODE_SUCCESS;
+  }
+
+  (*pEntry)->ver += 1;
+
+  SListIter iter = {0};
+  tdListInitIter(&(*pEntry)->list, &iter, TD_LIST_FORWARD);
+
+  SListNode* pNode = NULL;
+  while ((pNode = tdListNext(&iter)) != NULL) {
+    setMD5DigestInKey(p, pNode->data, 2 * sizeof(uint64_t));
+    LRUHandle* pHandle = taosLRUCacheLookup(pCache, p, TAG_FILTER_RES_KEY_LEN);
+    if (pHandle == NULL) {
+      continue;
+    }
+
+    STagFilterResValue* pValue = taosLRUCacheValue(pCache, pHandle);
+    bool                recorded = taosArrayGetSize(pValue->pChanged) < TAG_FILTER_RES_MAX_CHANGES &&
+                    taosArrayPush(pValue->pChanged, &uid) != NULL;
+    taosLRUCacheRelease(pCache, pHandle, false);
+
+    if (!recorded) {
+      // the node is popped by the deleter, the iterator has moved on already
+      taosLRUCacheErase(pCache, p, TAG_FILTER_RES_KEY_LEN);
+      metaDebug("vgId:%d suid:%" PRId64 " cached tag filter uid list removed, too many child tables changed", vgId,
+                suid);
+    }
+  }
+
+  taosThreadMutexUnlock(pLock);
+  return TSDB_CODE_SUCCESS;
+}
+
+// remove the lru cache that are expired due to the super table dropped
 int32_t metaUidCacheClear(SMeta* pMeta, uint64_t suid) {
   uint64_t  p[4] = {0};
   int32_t   vgId = TD_VID(pMeta->pVnode);
@@ -709,7 +824,14 @@ int32_t metaUidCacheClear(SMeta* pMeta, uint64_t suid) {
   taosThreadMutexLock(pLock);
 
   STagFilterResEntry** pEntry = taosHashGet(pEntryHashMap, &suid, sizeof(uint64_t));
-  if (pEntry == NULL || listNEles(&(*pEntry)->list) == 0) {
+  if (pEntry == NULL) {
+    taosThreadMutexUnlock(pLock);
+    return TSDB_CODE_SUCCESS;
+  }
+
+  // the lists being built are outdated as well
+  (*pEntry)->ver += 1;
+  if (listNEles(&(*pEntry)->list) == 0) {
     taosThreadMutexUnlock(pLock);
     return TSDB_CODE_SUCCESS;
   }
@@ -732,6 +854,378 @@ int32_t metaUidCacheClear(SMeta* pMeta, uint64_t suid) {
   return TSDB_CODE_SUCCESS;
 }
 
+// a cached uid list taken into a checkpoint. the handle keeps the payload alive while the checkpoint is encoded
+// outside the lock, the changed uids are copied since the cached ones keep growing meanwhile
+typedef struct STagFilterResCkptItem {
+  uint64_t            suid;
+  int64_t             entryVer;
+  uint64_t            digest[2];
+  int64_t             ver;
+  SArray*             pChanged;
+  LRUHandle*          pHandle;
+  STagFilterResValue* pValue;
+} STagFilterResCkptItem;
+
+static void metaUidCacheReleaseSnapshot(SMeta* pMeta, SArray* pItems) {
+  SLRUCache* pCache = pMeta->pCache->sTagFilterResCache.pUidResCache;
+
+  // a list evicted meanwhile is freed by the release, its deleter updates the entry under the lock
+  taosThreadMutexLock(&pMeta->pCache->sTagFilterResCache.lock);
+  for (int32_t i = 0; i < taosArrayGetSize(pItems); i++) {
+    STagFilterResCkptItem* pItem = taosArrayGet(pItems, i);
+    taosLRUCacheRelease(pCache, pItem->pHandle, false);
+  }
+  taosThreadMutexUnlock(&pMeta->pCache->sTagFilterResCache.lock);
+
+  for (int32_t i = 0; i < taosArrayGetSize(pItems); i++) {
+    taosArrayDestroy(((STagFilterResCkptItem*)taosArrayGet(pItems, i))->pChanged);
+  }
+  taosArrayDestroy(pItems);
+}
+
+static int32_t metaUidCacheSnapshot(SMeta* pMeta, SArray** ppItems) {
+  SLRUCache* pCache = pMeta->pCache->sTagFilterResCache.pUidResCache;
+  SHashObj*  pTableEntry = pMeta->pCache->sTagFilterResCache.pTableEntry;
+  uint64_t   key[4] = {0};
+  uint64_t   dummy[2] = {0};
+  int32_t    code = 0;
+
+  SArray* pItems = taosArrayInit(16, sizeof(STagFilterResCkptItem));
+  if (pItems == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  taosThreadMutexLock(&pMeta->pCache->sTagFilterResCache.lock);
+  void* pIter = NULL;
+  while (code == 0 && (pIter = taosHashIterate(pTableEntry, pIter)) != NULL) {
+    STagFilterResEntry* pEntry = *(STagFilterResEntry**)pIter;
+    uint64_t            suid = *(uint64_t*)taosHashGetKey(pIter, NULL);
+    initCacheKey(key, pTableEntry, suid, (char*)&dummy[0], 16);
+
+    SListIter iter = {0};
+    tdListInitIter(&pEntry->list, &iter, TD_LIST_FORWARD);
+
+    SListNode* pNode = NULL;
+    while ((pNode = tdListNext(&iter)) != NULL) {
+      setMD5DigestInKey(key, pNode->data, 2 * sizeof(uint64_t));
+      LRUHandle* pHandle = taosLRUCacheLookup(pCache, key, TAG_FILTER_RES_KEY_LEN);
+      if (pHandle == NULL) {
+        continue;
+      }
+
+      STagFilterResValue*   pValue = taosLRUCacheValue(pCache, pHandle);
+      STagFilterResCkptItem item = {.suid = suid,
+                                    .entryVer = pEntry->ver,
+                                    .digest = {key[2], key[3]},
+                                    .ver = pValue->ver,
+                                    .pChanged = taosArrayDup(pValue->pChanged, NULL),
+                                    .pHandle = pHandle,
+                                    .pValue = pValue};
+      if (item.pChanged == NULL || taosArrayPush(pItems, &item) == NULL) {
+        taosArrayDestroy(item.pChanged);
+        taosLRUCacheRelease(pCache, pHandle, false);
+        taosHashCancelIterate(pTableEntry, pIter);
+        code = TSDB_CODE_OUT_OF_MEMORY;
+        break;
+      }
+    }
+  }
+  taosThreadMutexUnlock(&pMeta->pCache->sTagFilterResCache.lock);
+
+  if (code) {
+    metaUidCacheReleaseSnapshot(pMeta, pItems);
+    return code;
+  }
+
+  *ppItems = pItems;
+  return 0;
+}
+
+// the checkpoint of the cached uid lists:
+// |<-version->|<-more->|<-suid->|<-entry ver->|<-digest->|<-list ver->|<-numOfChanged->|<-changed uids->|<-payload->| ...
+// |<-more(0)->|<-checksum->|
+static int32_t metaEncodeUidCache(SEncoder* pEncoder, const SArray* pItems, int64_t version) {
+  if (tEncodeI64(pEncoder, version) < 0) return -1;
+
+  for (int32_t i = 0; i < taosArrayGetSize(pItems); i++) {
+    const STagFilterResCkptItem* pItem = taosArrayGet(pItems, i);
+    int32_t                      numOfChanged = taosArrayGetSize(pItem->pChanged);
+
+    if (tEncodeI8(pEncoder, 1) < 0 || tEncodeU64(pEncoder, pItem->suid) < 0 ||
+        tEncodeI64(pEncoder, pItem->entryVer) < 0 || tEncodeU64(pEncoder, pItem->digest[0]) < 0 ||
+        tEncodeU64(pEncoder, pItem->digest[1]) < 0 || tEncodeI64(pEncoder, pItem->ver) < 0 ||
+        tEncodeI32(pEncoder, numOfChanged) < 0) {
+      return -1;
+    }
+    for (int32_t j = 0; j < numOfChanged; j++) {
+      if (tEncodeU64(pEncoder, *(uint64_t*)taosArrayGet(pItem->pChanged, j)) < 0) return -1;
+    }
+    if (tEncodeBinary(pEncoder, pItem->pValue->pPayload, pItem->pValue->payloadLen) < 0) return -1;
+  }
+
+  if (tEncodeI8(pEncoder, 0) < 0) return -1;
+  return 0;
+}
+
+static void metaUidCacheCkptName(SMeta* pMeta, char* fname) {
+  snprintf(fname, TSDB_FILENAME_LEN, "%s%s%s", pMeta->path, TD_DIRSEP, TAG_FILTER_RES_CKPT_FNAME);
+}
+
+// take the checkpoint of the cached uid lists when the commit of version begins, it is saved when the commit finishes.
+// only the snapshot of the lists is taken under the cache lock, lookups and puts go on while it is encoded
+void metaUidCachePrepareCheckpoint(SMeta* pMeta, int64_t version) {
+  struct STagFilterResCache* pResCache = &pMeta->pCache->sTagFilterResCache;
+  SEncoder                   encoder = {0};
+  SArray*                    pItems = NULL;
+  uint8_t*                   pBuf = NULL;
+  int32_t                    len = 0;
+  int32_t                    code = 0;
+
+  taosMemoryFreeClear(pResCache->pCkpt);
+  pResCache->ckptLen = 0;
+  if (!tsTagFilterCache) {
+    return;
+  }
+
+  code = metaUidCacheSnapshot(pMeta, &pItems);
+  if (code == 0) {
+    tEncoderInit(&encoder, NULL, 0);
+    code = metaEncodeUidCache(&encoder, pItems, version);
+    len = encoder.pos;
+    tEncoderClear(&encoder);
+  }
+
+  if (code == 0) {
+    pBuf = taosMemoryMalloc(len + sizeof(TSCKSUM));
+    if (pBuf == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+    } else {
+      tEncoderInit(&encoder, pBuf, len);
+      code = metaEncodeUidCache(&encoder, pItems, version);
+      tEncoderClear(&encoder);
+    }
+  }
+  if (pItems) {
+    metaUidCacheReleaseSnapshot(pMeta, pItems);
+  }
+
+  if (code != 0) {
+    metaError("vgId:%d, failed to take tag filter cache checkpoint of version %" PRId64 " since %s",
+              TD_VID(pMeta->pVnode), version, tstrerror(code < 0 ? TSDB_CODE_FAILED : code));
+    taosMemoryFree(pBuf);
+    return;
+  }
+
+  taosCalcChecksumAppend(0, pBuf, len + sizeof(TSCKSUM));
+  pResCache->ckptVer = version;
+  pResCache->pCkpt = pBuf;
+  pResCache->ckptLen = len + sizeof(TSCKSUM);
+}
+
+// save the checkpoint taken when the commit began, the commit is finished so the meta is at its version on disk
+int32_t metaUidCacheSaveCheckpoint(SMeta* pMeta) {
+  struct STagFilterResCache* pResCache = &pMeta->pCache->sTagFilterResCache;
+  TdFilePtr                  pFile = NULL;
+  char                       fname[TSDB_FILENAME_LEN] = {0};
+  char                       tfname[TSDB_FILENAME_LEN] = {0};
+  int32_t                    code = 0;
+
+  if (pResCache->pCkpt == NULL) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  metaUidCacheCkptName(pMeta, fname);
+  snprintf(tfname, TSDB_FILENAME_LEN, "%s.tmp", fname);
+
+  pFile = taosOpenFile(tfname, TD_FILE_CREATE | TD_FILE_WRITE | TD_FILE_TRUNC);
+  if (pFile == NULL) {
+    code = TAOS_SYSTEM_ERROR(errno);
+    goto _exit;
+  }
+
+  if (taosWriteFile(pFile, pResCache->pCkpt, pResCache->ckptLen) < 0 || taosFsyncFile(pFile) < 0) {
+    code = TAOS_SYSTEM_ERROR(errno);
+    goto _exit;
+  }
+  taosCloseFile(&pFile);
+
+  if (taosRenameFile(tfname, fname) < 0) {
+    code = TAOS_SYSTEM_ERROR(errno);
+    goto _exit;
+  }
+
+_exit:
+  if (code) {
+    metaError("vgId:%d, failed to save tag filter cache checkpoint of version %" PRId64 " since %s",
+              TD_VID(pMeta->pVnode), pResCache->ckptVer, tstrerror(code));
+    taosCloseFile(&pFile);
+  } else {
+    metaDebug("vgId:%d, tag filter cache checkpoint of version %" PRId64 " saved, size:%d", TD_VID(pMeta->pVnode),
+              pResCache->ckptVer, pResCache->ckptLen);
+  }
+  taosMemoryFreeClear(pResCache->pCkpt);
+  pResCache->ckptLen = 0;
+  return code;
+}
+
+// the meta is not at the version of the checkpoint saved any more, e.g. it is replaced by a snapshot of the leader
+void metaUidCacheDropCheckpoint(SMeta* pMeta) {
+  char fname[TSDB_FILENAME_LEN] = {0};
+
+  taosMemoryFreeClear(pMeta->pCache->sTagFilterResCache.pCkpt);
+  pMeta->pCache->sTagFilterResCache.ckptLen = 0;
+
+  metaUidCacheCkptName(pMeta, fname);
+  taosRemoveFile(fname);
+}
+
+static int32_t metaDecodeUidCacheRes(SDecoder* pDecoder, SMeta* pMeta) {
+  SLRUCache* pCache = pMeta->pCache->sTagFilterResCache.pUidResCache;
+  SHashObj*  pTableEntry = pMeta->pCache->sTagFilterResCache.pTableEntry;
+  uint64_t   suid = 0;
+  int64_t    entryVer = 0;
+  uint64_t   digest[2] = {0};
+  int32_t    numOfChanged = 0;
+  uint64_t   payloadLen = 0;
+
+  STagFilterResValue* pValue = taosMemoryCalloc(1, sizeof(STagFilterResValue));
+  if (pValue == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  if (tDecodeU64(pDecoder, &suid) < 0 || tDecodeI64(pDecoder, &entryVer) < 0 || tDecodeU64(pDecoder, &digest[0]) < 0 ||
+      tDecodeU64(pDecoder, &digest[1]) < 0 || tDecodeI64(pDecoder, &pValue->ver) < 0 ||
+      tDecodeI32(pDecoder, &numOfChanged) < 0 || numOfChanged < 0 || pValue->ver + numOfChanged != entryVer) {
+    goto _corrupted;
+  }
+
+  if ((pValue->pChanged = taosArrayInit(numOfChanged + 1, sizeof(uint64_t))) == NULL) {
+    destroyTagFilterResValue(pValue);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  for (int32_t i = 0; i < numOfChanged; i++) {
+    uint64_t uid = 0;
+    if (tDecodeU64(pDecoder, &uid) < 0) goto _corrupted;
+    taosArrayPush(pValue->pChanged, &uid);
+  }
+
+  if (tDecodeBinaryAlloc(pDecoder, &pValue->pPayload, &payloadLen) < 0 || payloadLen < sizeof(int32_t) ||
+      payloadLen != sizeof(int32_t) + *(int32_t*)pValue->pPayload * sizeof(uint64_t)) {
+    goto _corrupted;
+  }
+  pValue->payloadLen = payloadLen;
+
+  STagFilterResEntry** pEntry = taosHashGet(pTableEntry, &suid, sizeof(uint64_t));
+  if (pEntry == NULL) {
+    if (addNewEntry(pTableEntry, NULL, sizeof(digest), suid) != 0 ||
+        (pEntry = taosHashGet(pTableEntry, &suid, sizeof(uint64_t))) == NULL) {
+      destroyTagFilterResValue(pValue);
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+  }
+  (*pEntry)->ver = entryVer;
+
+  uint64_t key[4] = {0};
+  initCacheKey(key, pTableEntry, suid, (const char*)digest, sizeof(digest));
+  tdListAppend(&(*pEntry)->list, digest);
+  taosLRUCacheInsert(pCache, key, TAG_FILTER_RES_KEY_LEN, pValue, pValue->payloadLen, freeUidCachePayload, NULL,
+                     TAOS_LRU_PRIORITY_LOW, NULL);
+  return TSDB_CODE_SUCCESS;
+
+_corrupted:
+  destroyTagFilterResValue(pValue);
+  return TSDB_CODE_FILE_CORRUPTED;
+}
+
+// warm the cache up with the checkpoint saved by the last commit, if the meta opened is at its version
+int32_t metaUidCacheRestore(SMeta* pMeta, int64_t version) {
+  TdFilePtr pFile = NULL;
+  uint8_t*  pBuf = NULL;
+  int64_t   size = 0;
+  int64_t   ckptVer = -1;
+  int32_t   numOfRes = 0;
+  int32_t   code = 0;
+  char      fname[TSDB_FILENAME_LEN] = {0};
+  SDecoder  decoder = {0};
+
+  if (!tsTagFilterCache) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  metaUidCacheCkptName(pMeta, fname);
+  pFile = taosOpenFile(fname, TD_FILE_READ);
+  if (pFile == NULL) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  if (taosFStatFile(pFile, &size, NULL) < 0) {
+    code = TAOS_SYSTEM_ERROR(errno);
+    goto _exit;
+  }
+
+  if (size <= sizeof(TSCKSUM)) {
+    code = TSDB_CODE_FILE_CORRUPTED;
+    goto _exit;
+  }
+
+  if ((pBuf = taosMemoryMalloc(size)) == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  if (taosReadFile(pFile, pBuf, size) != size) {
+    code = TAOS_SYSTEM_ERROR(errno);
+    goto _exit;
+  }
+
+  if (!taosCheckChecksumWhole(pBuf, size)) {
+    code = TSDB_CODE_FILE_CORRUPTED;
+    goto _exit;
+  }
+
+  tDecoderInit(&decoder, pBuf, size - sizeof(TSCKSUM));
+  if (tDecodeI64(&decoder, &ckptVer) < 0) {
+    code = TSDB_CODE_FILE_CORRUPTED;
+    goto _exit;
+  }
+
+  if (ckptVer != version) {
+    metaInfo("vgId:%d, tag filter cache checkpoint of version %" PRId64 " skipped, meta version:%" PRId64,
+             TD_VID(pMeta->pVnode), ckptVer, version);
+    goto _exit;
+  }
+
+  taosThreadMutexLock(&pMeta->pCache->sTagFilterResCache.lock);
+  for (;;) {
+    int8_t more = 0;
+    if (tDecodeI8(&decoder, &more) < 0) {
+      code = TSDB_CODE_FILE_CORRUPTED;
+      break;
+    }
+    if (!more) break;
+
+    code = metaDecodeUidCacheRes(&decoder, pMeta);
+    if (code) break;
+    numOfRes++;
+  }
+  taosThreadMutexUnlock(&pMeta->pCache->sTagFilterResCache.lock);
+
+_exit:
+  if (code) {
+    // the lists restored are consistent on their own, the cache stays usable
+    metaError("vgId:%d, failed to restore tag filter cache checkpoint since %s, restored:%d", TD_VID(pMeta->pVnode),
+              tstrerror(code), numOfRes);
+  } else if (ckptVer == version) {
+    metaInfo("vgId:%d, tag filter cache restored from checkpoint of version %" PRId64 ", lists:%d",
+             TD_VID(pMeta->pVnode), version, numOfRes);
+  }
+  tDecoderClear(&decoder);
+  taosCloseFile(&pFile);
+  taosMemoryFree(pBuf);
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t metaGetCachedTbGroup(void* pVnode, tb_uid_t suid, const uint8_t* pKey, int32_t keyLen, SArray** pList) {
   SMeta*  pMeta = ((SVnode*)pVnode)->pMeta;
   int32_t vgId = TD_VID(pMeta->pVnode);
@@ -48,7 +48,13 @@ int metaBegin(SMeta *pMeta, int8_t heap) {
 // commit the meta txn
 TXN *metaGetTxn(SMeta *pMeta) { return pMeta->txn; }
 int  metaCommit(SMeta *pMeta, TXN *txn) { return tdbCommit(pMeta->pEnv, txn); }
-int  metaFinishCommit(SMeta *pMeta, TXN *txn) { return tdbPostCommit(pMeta->pEnv, txn); }
+int  metaFinishCommit(SMeta *pMeta, TXN *txn) {
+  int code = tdbPostCommit(pMeta->pEnv, txn);
+  if (code == 0) {
+    metaUidCacheSaveCheckpoint(pMeta);
+  }
+  return code;
+}
 int  metaPrepareAsyncCommit(SMeta *pMeta) {
    // return tdbPrepareAsyncCommit(pMeta->pEnv, pMeta->txn);
   int code = 0;
@@ -57,6 +63,7 @@ int  metaPrepareAsyncCommit(SMeta *pMeta) {
   metaULock(pMeta);
   code = tdbCommit(pMeta->pEnv, pMeta->txn);
   pMeta->changed = false;
+  metaUidCachePrepareCheckpoint(pMeta, pMeta->pVnode->state.applied);
   return code;
 }
 
@@ -170,6 +170,7 @@ int32_t metaSnapWriterClose(SMetaSnapWriter** ppWriter, int8_t rollback) {
              code);
     if (code) goto _err;
   } else {
+    metaUidCacheDropCheckpoint(pWriter->pMeta);
     code = metaCommit(pWriter->pMeta, pWriter->pMeta->txn);
     if (code) goto _err;
     code = metaFinishCommit(pWriter->pMeta, pWriter->pMeta->txn);
@@ -23,11 +23,14 @@ static int  metaSaveToTbDb(SMeta *pMeta, const SMetaEntry *pME);
 static int  metaUpdateUidIdx(SMeta *pMeta, const SMetaEntry *pME);
 static int  metaUpdateNameIdx(SMeta *pMeta, const SMetaEntry *pME);
 static int  metaUpdateTtl(SMeta *pMeta, const SMetaEntry *pME);
+static int  metaDeleteTtl(SMeta *pMeta, const SMetaEntry *pME);
 static int  metaUpdateChangeTime(SMeta *pMeta, tb_uid_t uid, int64_t changeTimeMs);
 static int  metaSaveToSkmDb(SMeta *pMeta, const SMetaEntry *pME);
 static int  metaUpdateCtbIdx(SMeta *pMeta, const SMetaEntry *pME);
 static int  metaUpdateSuidIdx(SMeta *pMeta, const SMetaEntry *pME);
 static int  metaUpdateTagIdx(SMeta *pMeta, const SMetaEntry *pCtbEntry);
+static int  metaBuildTagIdxKey(const SMetaEntry *pCtbEntry, const SSchema *pTagColumn, STagIdxKey **ppTagIdxKey,
+                               int32_t *nTagIdxKey);
 static int  metaDropTableByUid(SMeta *pMeta, tb_uid_t uid, int *type, tb_uid_t *pSuid, int8_t *pSysTbl);
 static void metaDestroyTagIdxKey(STagIdxKey *pTagIdxKey);
 // opt ins_tables query
@@ -322,6 +325,7 @@ _drop_super_table:
   tdbTbDelete(pMeta->pSuidIdx, &pReq->suid, sizeof(tb_uid_t), pMeta->txn);
 
   metaStatsCacheDrop(pMeta, pReq->suid);
+  metaTagColsDrop(pMeta, pReq->suid);
 
   metaULock(pMeta);
 
@@ -480,6 +484,9 @@ int metaAlterSTable(SMeta *pMeta, int64_t version, SVCreateStbReq *pReq) {
 
   // metaStatsCacheDrop(pMeta, nStbEntry.uid);
 
+  // a tag added, dropped or resized changes the layout of the tag columns
+  metaTagColsDrop(pMeta, pReq->suid);
+
   if (updStat) {
     metaUpdateStbStats(pMeta, pReq->suid, 0, deltaCol);
   }
@@ -895,7 +902,6 @@ int metaCreateTable(SMeta *pMeta, int64_t ver, SVCreateTbReq *pReq, STableMetaRs
 
     metaWLock(pMeta);
     metaUpdateStbStats(pMeta, me.ctbEntry.suid, 1, 0);
-    metaUidCacheClear(pMeta, me.ctbEntry.suid);
     metaTbGroupCacheClear(pMeta, me.ctbEntry.suid);
     metaULock(pMeta);
 
@@ -948,6 +954,489 @@ _err:
   return -1;
 }
 
+// the indexes of a child table, in the order the batch writes them
+enum {
+  META_BATCH_TB_DB = 1,
+  META_BATCH_UID_IDX,
+  META_BATCH_TTL,
+  META_BATCH_NAME_IDX,
+  META_BATCH_BTIME_IDX,
+  META_BATCH_CTB_IDX,
+  META_BATCH_TAG_IDX,
+};
+
+typedef struct {
+  int32_t    iReq;
+  int32_t    iStb;    // super table of the entry in the batch
+  int32_t    code;    // set once the entry failed, it is skipped by the following steps
+  int8_t     nSteps;  // steps done for the entry
+  SMetaEntry me;
+} SMetaBatchEntry;
+
+typedef struct {
+  tb_uid_t    suid;
+  int32_t     nCols;
+  int32_t     nCreated;
+  SMetaReader mr;  // super table entry, read once for the whole group
+} SMetaBatchStb;
+
+typedef struct {
+  STagIdxKey      *pTagIdxKey;
+  SMetaBatchEntry *pEntry;
+} SMetaBatchTagIdxKey;
+
+static int metaBatchEntryUidCmpr(const void *p1, const void *p2) {
+  const SMetaBatchEntry *pEntry1 = *(const SMetaBatchEntry **)p1;
+  const SMetaBatchEntry *pEntry2 = *(const SMetaBatchEntry **)p2;
+
+  if (pEntry1->me.uid > pEntry2->me.uid) {
+    return 1;
+  } else if (pEntry1->me.uid < pEntry2->me.uid) {
+    return -1;
+  }
+  return 0;
+}
+
+static int metaBatchEntryCtbCmpr(const void *p1, const void *p2) {
+  const SMetaBatchEntry *pEntry1 = *(const SMetaBatchEntry **)p1;
+  const SMetaBatchEntry *pEntry2 = *(const SMetaBatchEntry **)p2;
+
+  if (pEntry1->me.ctbEntry.suid > pEntry2->me.ctbEntry.suid) {
+    return 1;
+  } else if (pEntry1->me.ctbEntry.suid < pEntry2->me.ctbEntry.suid) {
+    return -1;
+  }
+  return metaBatchEntryUidCmpr(p1, p2);
+}
+
+static int metaBatchEntryNameCmpr(const void *p1, const void *p2) {
+  const SMetaBatchEntry *pEntry1 = *(const SMetaBatchEntry **)p1;
+  const SMetaBatchEntry *pEntry2 = *(const SMetaBatchEntry **)p2;
+
+  return strcmp(pEntry1->me.name, pEntry2->me.name);
+}
+
+static int metaBatchEntryBtimeCmpr(const void *p1, const void *p2) {
+  const SMetaBatchEntry *pEntry1 = *(const SMetaBatchEntry **)p1;
+  const SMetaBatchEntry *pEntry2 = *(const SMetaBatchEntry **)p2;
+
+  if (pEntry1->me.ctbEntry.btime > pEntry2->me.ctbEntry.btime) {
+    return 1;
+  } else if (pEntry1->me.ctbEntry.btime < pEntry2->me.ctbEntry.btime) {
+    return -1;
+  }
+  return metaBatchEntryUidCmpr(p1, p2);
+}
+
+static int metaBatchTagIdxKeyCmpr(const void *p1, const void *p2) {
+  const SMetaBatchTagIdxKey *pKey1 = (const SMetaBatchTagIdxKey *)p1;
+  const SMetaBatchTagIdxKey *pKey2 = (const SMetaBatchTagIdxKey *)p2;
+
+  return metaTagIdxKeyCmpr(pKey1->pTagIdxKey, 0, pKey2->pTagIdxKey, 0);
+}
+
+static void metaBatchDeleteTagIdx(SMeta *pMeta, const SMetaEntry *pME, const SSchemaWrapper *pTagSchema) {
+  if (pTagSchema->pSchema == NULL) return;
+
+  if (pTagSchema->nCols == 1 && pTagSchema->pSchema[0].type == TSDB_DATA_TYPE_JSON) {
+    metaDelJsonVarFromIdx(pMeta, pME, &pTagSchema->pSchema[0]);
+    return;
+  }
+
+  for (int32_t iCol = 0; iCol < pTagSchema->nCols; iCol++) {
+    STagIdxKey *pTagIdxKey = NULL;
+    int32_t     nTagIdxKey = 0;
+
+    if (!IS_IDX_ON(&pTagSchema->pSchema[iCol])) continue;
+
+    if (metaBuildTagIdxKey(pME, &pTagSchema->pSchema[iCol], &pTagIdxKey, &nTagIdxKey) == 0) {
+      tdbTbDelete(pMeta->pTagIdx, pTagIdxKey, nTagIdxKey, pMeta->txn);
+    }
+    metaDestroyTagIdxKey(pTagIdxKey);
+  }
+}
+
+// undo the steps done for an entry that failed. the tag step is undone once it is started, as it may have written
+// some of the keys of the entry before failing
+static void metaBatchFailEntry(SMeta *pMeta, SMetaBatchEntry *pEntry, SArray *pStbs, int32_t code) {
+  const SMetaEntry *pME = &pEntry->me;
+
+  pEntry->code = code ? code : TSDB_CODE_FAILED;
+  metaError("vgId:%d, failed to create table:%s uid:%" PRId64 " in batch since %s, steps done:%d",
+            TD_VID(pMeta->pVnode), pME->name, pME->uid, tstrerror(pEntry->code), pEntry->nSteps);
+
+  if (pEntry->nSteps >= META_BATCH_CTB_IDX) {
+    SMetaBatchStb *pStb = taosArrayGet(pStbs, pEntry->iStb);
+    metaBatchDeleteTagIdx(pMeta, pME, &pStb->mr.me.stbEntry.schemaTag);
+    tdbTbDelete(pMeta->pCtbIdx, &(SCtbIdxKey){.suid = pME->ctbEntry.suid, .uid = pME->uid}, sizeof(SCtbIdxKey),
+                pMeta->txn);
+  }
+  if (pEntry->nSteps >= META_BATCH_BTIME_IDX) {
+    metaDeleteBtimeIdx(pMeta, pME);
+  }
+  if (pEntry->nSteps >= META_BATCH_NAME_IDX) {
+    tdbTbDelete(pMeta->pNameIdx, pME->name, strlen(pME->name) + 1, pMeta->txn);
+  }
+  if (pEntry->nSteps >= META_BATCH_TTL) {
+    metaDeleteTtl(pMeta, pME);
+  }
+  if (pEntry->nSteps >= META_BATCH_UID_IDX) {
+    tdbTbDelete(pMeta->pUidIdx, &pME->uid, sizeof(tb_uid_t), pMeta->txn);
+    metaCacheDrop(pMeta, pME->uid);
+  }
+  if (pEntry->nSteps >= META_BATCH_TB_DB) {
+    tdbTbDelete(pMeta->pTbDb, &(STbDbKey){.version = pME->version, .uid = pME->uid}, sizeof(STbDbKey), pMeta->txn);
+  }
+}
+
+static void metaBatchDoStep(SMeta *pMeta, SArray *pOrder, SArray *pStbs, int8_t step,
+                            int (*fp)(SMeta *, const SMetaEntry *)) {
+  for (int32_t i = 0; i < taosArrayGetSize(pOrder); i++) {
+    SMetaBatchEntry *pEntry = *(SMetaBatchEntry **)taosArrayGet(pOrder, i);
+
+    if (pEntry->code) continue;
+
+    terrno = TSDB_CODE_SUCCESS;
+    if (fp(pMeta, &pEntry->me) < 0) {
+      metaBatchFailEntry(pMeta, pEntry, pStbs, terrno);
+      continue;
+    }
+    pEntry->nSteps = step;
+  }
+}
+
+static void metaBatchUpdateTagIdx(SMeta *pMeta, SArray *pOrder, SArray *pStbs) {
+  SArray *pKeys = taosArrayInit(taosArrayGetSize(pOrder), sizeof(SMetaBatchTagIdxKey));
+
+  for (int32_t i = 0; i < taosArrayGetSize(pOrder); i++) {
+    SMetaBatchEntry *pEntry = *(SMetaBatchEntry **)taosArrayGet(pOrder, i);
+    SSchemaWrapper  *pTagSchema = &((SMetaBatchStb *)taosArrayGet(pStbs, pEntry->iStb))->mr.me.stbEntry.schemaTag;
+
+    if (pEntry->code) continue;
+
+    if (pKeys == NULL) {
+      metaBatchFailEntry(pMeta, pEntry, pStbs, TSDB_CODE_OUT_OF_MEMORY);
+      continue;
+    }
+
+    if (pTagSchema->pSchema == NULL) continue;
+
+    if (pTagSchema->nCols == 1 && pTagSchema->pSchema[0].type == TSDB_DATA_TYPE_JSON) {
+      terrno = TSDB_CODE_SUCCESS;
+      if (metaSaveJsonVarToIdx(pMeta, &pEntry->me, &pTagSchema->pSchema[0]) < 0) {
+        metaBatchFailEntry(pMeta, pEntry, pStbs, terrno);
+      }
+      continue;
+    }
+
+    for (int32_t iCol = 0; iCol < pTagSchema->nCols; iCol++) {
+      SMetaBatchTagIdxKey key = {.pEntry = pEntry};
+      int32_t             nTagIdxKey = 0;
+
+      if (!IS_IDX_ON(&pTagSchema->pSchema[iCol])) continue;
+
+      if (metaBuildTagIdxKey(&pEntry->me, &pTagSchema->pSchema[iCol], &key.pTagIdxKey, &nTagIdxKey) < 0) {
+        metaBatchFailEntry(pMeta, pEntry, pStbs, terrno);
+        break;
+      }
+      if (taosArrayPush(pKeys, &key) == NULL) {
+        metaDestroyTagIdxKey(key.pTagIdxKey);
+        metaBatchFailEntry(pMeta, pEntry, pStbs, TSDB_CODE_OUT_OF_MEMORY);
+        break;
+      }
+    }
+  }
+
+  taosArraySort(pKeys, metaBatchTagIdxKeyCmpr);
+  for (int32_t i = 0; i < taosArrayGetSize(pKeys); i++) {
+    SMetaBatchTagIdxKey *pKey = taosArrayGet(pKeys, i);
+    STagIdxKey          *pTagIdxKey = pKey->pTagIdxKey;
+    // same length as computed by metaCreateTagIdxKey
+    int32_t              nTagIdxKey = sizeof(STagIdxKey) + sizeof(tb_uid_t);
+
+    // the keys built before an entry failed are left behind in the array
+    if (pKey->pEntry->code) continue;
+
+    if (IS_VAR_DATA_TYPE(pTagIdxKey->type)) {
+      nTagIdxKey += varDataTLen(pTagIdxKey->data);
+    } else {
+      nTagIdxKey += tDataTypes[pTagIdxKey->type].bytes;
+    }
+    terrno = TSDB_CODE_SUCCESS;
+    if (tdbTbUpsert(pMeta->pTagIdx, pTagIdxKey, nTagIdxKey, NULL, 0, pMeta->txn) < 0) {
+      metaBatchFailEntry(pMeta, pKey->pEntry, pStbs, terrno);
+    }
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pOrder); i++) {
+    SMetaBatchEntry *pEntry = *(SMetaBatchEntry **)taosArrayGet(pOrder, i);
+    if (pEntry->code == 0) pEntry->nSteps = META_BATCH_TAG_IDX;
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pKeys); i++) {
+    metaDestroyTagIdxKey(((SMetaBatchTagIdxKey *)taosArrayGet(pKeys, i))->pTagIdxKey);
+  }
+  taosArrayDestroy(pKeys);
+}
+
+// an entry failing in a step is undone and skipped by the following steps, the others of the batch go on
+static void metaBatchHandleEntries(SMeta *pMeta, SArray *pOrder, SArray *pStbs) {
+  int32_t nEntry = taosArrayGetSize(pOrder);
+  int32_t nFailed = 0;
+
+  metaWLock(pMeta);
+
+  // every index is written in its own key order, so consecutive keys land on the same leaf pages and each tree is
+  // walked once from left to right instead of being probed at random
+  taosArraySort(pOrder, metaBatchEntryUidCmpr);
+  metaBatchDoStep(pMeta, pOrder, pStbs, META_BATCH_TB_DB, metaSaveToTbDb);
+  metaBatchDoStep(pMeta, pOrder, pStbs, META_BATCH_UID_IDX, metaUpdateUidIdx);
+  metaBatchDoStep(pMeta, pOrder, pStbs, META_BATCH_TTL, metaUpdateTtl);
+
+  taosArraySort(pOrder, metaBatchEntryNameCmpr);
+  metaBatchDoStep(pMeta, pOrder, pStbs, META_BATCH_NAME_IDX, metaUpdateNameIdx);
+
+  taosArraySort(pOrder, metaBatchEntryBtimeCmpr);
+  metaBatchDoStep(pMeta, pOrder, pStbs, META_BATCH_BTIME_IDX, metaUpdateBtimeIdx);
+
+  taosArraySort(pOrder, metaBatchEntryCtbCmpr);
+  metaBatchDoStep(pMeta, pOrder, pStbs, META_BATCH_CTB_IDX, metaUpdateCtbIdx);
+
+  metaBatchUpdateTagIdx(pMeta, pOrder, pStbs);
+
+  metaULock(pMeta);
+
+  for (int32_t i = 0; i < nEntry; i++) {
+    if ((*(SMetaBatchEntry **)taosArrayGet(pOrder, i))->code) nFailed++;
+  }
+  metaDebug("vgId:%d, handle %d meta entries in batch, failed:%d", TD_VID(pMeta->pVnode), nEntry, nFailed);
+}
+
+int metaCreateTables(SMeta *pMeta, int64_t ver, SVCreateTbReq **ppReqs, int32_t nReqs, int32_t *pCodes,
+                     STableMetaRsp **ppMetaRsp) {
+  int32_t      code = 0;
+  int32_t      nCreated = 0;
+  SArray      *pEntries = NULL;
+  SArray      *pOrder = NULL;
+  SArray      *pStbs = NULL;
+  SHashObj    *pNames = NULL;
+  SVnodeStats *pStats = &pMeta->pVnode->config.vndStats;
+  SMetaReader  mr = {0};
+  const char  *stbName = NULL;
+  tb_uid_t     stbUid = 0;
+
+  for (int32_t iReq = 0; iReq < nReqs; iReq++) {
+    pCodes[iReq] = TSDB_CODE_SUCCESS;
+    if (ppMetaRsp) ppMetaRsp[iReq] = NULL;
+  }
+
+  pEntries = taosArrayInit(nReqs, sizeof(SMetaBatchEntry));
+  pOrder = taosArrayInit(nReqs, sizeof(SMetaBatchEntry *));
+  pStbs = taosArrayInit(1, sizeof(SMetaBatchStb));
+  pNames = taosHashInit(nReqs, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), false, HASH_NO_LOCK);
+  if (pEntries == NULL || pOrder == NULL || pStbs == NULL || pNames == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  // validate and build entries, the checks are the same as metaCreateTable
+  for (int32_t iReq = 0; iReq < nReqs; iReq++) {
+    SVCreateTbReq *pReq = ppReqs[iReq];
+    int32_t       *pFirst = taosHashGet(pNames, pReq->name, strlen(pReq->name));
+
+    if (pFirst != NULL) {
+      // a table created by an earlier request of the same batch
+      SVCreateTbReq *pFirstReq = ppReqs[*pFirst];
+      if (pReq->type == TSDB_CHILD_TABLE &&
+          (pFirstReq->type != TSDB_CHILD_TABLE || pReq->ctb.suid != pFirstReq->ctb.suid)) {
+        pCodes[iReq] = TSDB_CODE_TDB_TABLE_IN_OTHER_STABLE;
+        continue;
+      }
+      pReq->uid = pFirstReq->uid;
+      pCodes[iReq] = TSDB_CODE_TDB_TABLE_ALREADY_EXIST;
+      continue;
+    }
+
+    if (pReq->type != TSDB_CHILD_TABLE) {
+      // normal tables are rare in a batch, create them one by one
+      if (metaCreateTable(pMeta, ver, pReq, ppMetaRsp ? &ppMetaRsp[iReq] : NULL) < 0) {
+        pCodes[iReq] = terrno;
+      } else if (taosHashPut(pNames, pReq->name, strlen(pReq->name), &iReq, sizeof(iReq)) < 0) {
+        code = TSDB_CODE_OUT_OF_MEMORY;
+        goto _exit;
+      }
+      continue;
+    }
+
+    if (stbName == NULL || strcmp(stbName, pReq->ctb.stbName) != 0) {
+      stbName = pReq->ctb.stbName;
+      stbUid = metaGetTableEntryUidByName(pMeta, stbName);
+    }
+    if (stbUid != pReq->ctb.suid) {
+      pCodes[iReq] = TSDB_CODE_PAR_TABLE_NOT_EXIST;
+      continue;
+    }
+
+    metaReaderDoInit(&mr, pMeta, 0);
+    if (metaGetTableEntryByName(&mr, pReq->name) == 0) {
+      if (pReq->ctb.suid != mr.me.ctbEntry.suid) {
+        pCodes[iReq] = TSDB_CODE_TDB_TABLE_IN_OTHER_STABLE;
+      } else {
+        pReq->uid = mr.me.uid;
+        pReq->ctb.suid = mr.me.ctbEntry.suid;
+        pCodes[iReq] = TSDB_CODE_TDB_TABLE_ALREADY_EXIST;
+      }
+      metaReaderClear(&mr);
+      continue;
+    } else if (terrno == TSDB_CODE_PAR_TABLE_NOT_EXIST) {
+      terrno = TSDB_CODE_SUCCESS;
+    }
+    metaReaderClear(&mr);
+
+    SMetaBatchEntry entry = {.iReq = iReq};
+    entry.me.version = ver;
+    entry.me.type = pReq->type;
+    entry.me.uid = pReq->uid;
+    entry.me.name = pReq->name;
+    entry.me.ctbEntry.btime = pReq->btime;
+    entry.me.ctbEntry.ttlDays = pReq->ttl;
+    entry.me.ctbEntry.commentLen = pReq->commentLen;
+    entry.me.ctbEntry.comment = pReq->comment;
+    entry.me.ctbEntry.suid = pReq->ctb.suid;
+    entry.me.ctbEntry.pTags = pReq->ctb.pTag;
+
+    if (taosArrayPush(pEntries, &entry) == NULL ||
+        taosHashPut(pNames, pReq->name, strlen(pReq->name), &iReq, sizeof(iReq)) < 0) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _exit;
+    }
+  }
+
+  if (taosArrayGetSize(pEntries) == 0) goto _exit;
+
+  for (int32_t i = 0; i < taosArrayGetSize(pEntries); i++) {
+    SMetaBatchEntry *pEntry = taosArrayGet(pEntries, i);
+    if (taosArrayPush(pOrder, &pEntry) == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _exit;
+    }
+  }
+
+  // group by super table, so the super table is read once for the whole group
+  taosArraySort(pOrder, metaBatchEntryCtbCmpr);
+  for (int32_t i = 0; i < taosArrayGetSize(pOrder); i++) {
+    SMetaBatchEntry *pEntry = *(SMetaBatchEntry **)taosArrayGet(pOrder, i);
+    SMetaBatchStb   *pStb = taosArrayGetLast(pStbs);
+
+    if (pStb == NULL || pStb->suid != pEntry->me.ctbEntry.suid) {
+      SMetaBatchStb stb = {.suid = pEntry->me.ctbEntry.suid};
+      if ((pStb = taosArrayPush(pStbs, &stb)) == NULL) {
+        code = TSDB_CODE_OUT_OF_MEMORY;
+        goto _exit;
+      }
+
+      metaReaderDoInit(&pStb->mr, pMeta, 0);
+      if (metaReaderGetTableEntryByUid(&pStb->mr, pStb->suid) < 0) {
+        metaError("vgId:%d, failed to get stable suid:%" PRId64 " for batch create. version:%" PRId64,
+                  TD_VID(pMeta->pVnode), pStb->suid, ver);
+      }
+      metaReaderReleaseLock(&pStb->mr);
+
+      // loads the stats cache before the batch is written, the tables created are added to it afterwards
+      metaGetStbStats(pMeta->pVnode, pStb->suid, 0, &pStb->nCols);
+    }
+
+    pEntry->iStb = taosArrayGetSize(pStbs) - 1;
+    if (pStb->mr.me.uid != pStb->suid) {
+      pEntry->code = TSDB_CODE_TDB_INVALID_TABLE_ID;
+    }
+  }
+
+  metaBatchHandleEntries(pMeta, pOrder, pStbs);
+
+  // stats, caches and responses only count the tables created
+  for (int32_t i = 0; i < taosArrayGetSize(pEntries); i++) {
+    SMetaBatchEntry *pEntry = taosArrayGet(pEntries, i);
+    SVCreateTbReq   *pReq = ppReqs[pEntry->iReq];
+
+    if (pEntry->code) {
+      pCodes[pEntry->iReq] = pEntry->code;
+      continue;
+    }
+
+    ((SMetaBatchStb *)taosArrayGet(pStbs, pEntry->iStb))->nCreated++;
+    nCreated++;
+
+    if (!TSDB_CACHE_NO(pMeta->pVnode->config)) {
+      tsdbCacheNewTable(pMeta->pVnode->pTsdb, pEntry->me.uid, pEntry->me.ctbEntry.suid, NULL);
+    }
+
+    if (ppMetaRsp) {
+      STableMetaRsp *pMetaRsp = taosMemoryCalloc(1, sizeof(STableMetaRsp));
+      if (pMetaRsp) {
+        pMetaRsp->tableType = TSDB_CHILD_TABLE;
+        pMetaRsp->tuid = pReq->uid;
+        pMetaRsp->suid = pReq->ctb.suid;
+        strcpy(pMetaRsp->tbName, pReq->name);
+      }
+      ppMetaRsp[pEntry->iReq] = pMetaRsp;
+    }
+  }
+
+  // a request naming the same table as an earlier failed one fails the same way
+  for (int32_t iReq = 0; iReq < nReqs; iReq++) {
+    SVCreateTbReq *pReq = ppReqs[iReq];
+    int32_t       *pFirst = taosHashGet(pNames, pReq->name, strlen(pReq->name));
+
+    if (pCodes[iReq] == TSDB_CODE_TDB_TABLE_ALREADY_EXIST && pFirst != NULL && *pFirst != iReq &&
+        pCodes[*pFirst] != TSDB_CODE_SUCCESS) {
+      pCodes[iReq] = pCodes[*pFirst];
+    }
+  }
+
+  for (int32_t iStb = 0; iStb < taosArrayGetSize(pStbs); iStb++) {
+    SMetaBatchStb *pStb = taosArrayGet(pStbs, iStb);
+
+    if (pStb->nCreated == 0) continue;
+
+    pStats->numOfCTables += pStb->nCreated;
+    if (!metaTbInFilterCache(pMeta, pStb->mr.me.name, 1)) {
+      pStats->numOfTimeSeries += (int64_t)pStb->nCreated * (pStb->nCols - 1);
+    }
+
+    metaWLock(pMeta);
+    metaUpdateStbStats(pMeta, pStb->suid, pStb->nCreated, 0);
+    metaTbGroupCacheClear(pMeta, pStb->suid);
+    metaULock(pMeta);
+  }
+
+  if (nCreated > 0) {
+    metaTimeSeriesNotifyCheck(pMeta);
+    pMeta->changed = true;
+  }
+  metaDebug("vgId:%d, %d of %d child tables are created in batch, version:%" PRId64, TD_VID(pMeta->pVnode), nCreated,
+            (int32_t)taosArrayGetSize(pEntries), ver);
+
+_exit:
+  if (code) {
+    // requests not yet finished when the batch failed
+    for (int32_t i = 0; i < taosArrayGetSize(pEntries); i++) {
+      SMetaBatchEntry *pEntry = taosArrayGet(pEntries, i);
+      pCodes[pEntry->iReq] = code;
+    }
+    metaError("vgId:%d, failed to create %d tables in batch since %s", TD_VID(pMeta->pVnode), nReqs, tstrerror(code));
+  }
+  for (int32_t iStb = 0; iStb < taosArrayGetSize(pStbs); iStb++) {
+    metaReaderClear(&((SMetaBatchStb *)taosArrayGet(pStbs, iStb))->mr);
+  }
+  taosArrayDestroy(pStbs);
+  taosArrayDestroy(pOrder);
+  taosArrayDestroy(pEntries);
+  taosHashCleanup(pNames);
+  terrno = code;
+  return code ? -1 : 0;
+}
+
 int metaDropTable(SMeta *pMeta, int64_t version, SVDropTbReq *pReq, SArray *tbUids, tb_uid_t *tbUid) {
   void    *pData = NULL;
   int      nData = 0;
@@ -1265,10 +1754,11 @@ static int metaDropTableByUid(SMeta *pMeta, tb_uid_t uid, int *type, tb_uid_t *p
 
   if (e.type == TSDB_CHILD_TABLE) {
     tdbTbDelete(pMeta->pCtbIdx, &(SCtbIdxKey){.suid = e.ctbEntry.suid, .uid = uid}, sizeof(SCtbIdxKey), pMeta->txn);
+    metaTagColsUpdate(pMeta, e.ctbEntry.suid, uid);
 
     --pMeta->pVnode->config.vndStats.numOfCTables;
     metaUpdateStbStats(pMeta, e.ctbEntry.suid, -1, 0);
-    metaUidCacheClear(pMeta, e.ctbEntry.suid);
+    metaUidCacheUpdate(pMeta, e.ctbEntry.suid, uid);
     metaTbGroupCacheClear(pMeta, e.ctbEntry.suid);
     /*
     if (!TSDB_CACHE_NO(pMeta->pVnode->config)) {
@@ -1293,6 +1783,7 @@ static int metaDropTableByUid(SMeta *pMeta, tb_uid_t uid, int *type, tb_uid_t *p
     metaStatsCacheDrop(pMeta, uid);
     metaUidCacheClear(pMeta, uid);
     metaTbGroupCacheClear(pMeta, uid);
+    metaTagColsDrop(pMeta, uid);
     --pMeta->pVnode->config.vndStats.numOfSTables;
   }
 
@@ -1746,8 +2237,9 @@ static int metaUpdateTableTagVal(SMeta *pMeta, int64_t version, SVAlterTbReq *pA
   SCtbIdxKey ctbIdxKey = {.suid = ctbEntry.ctbEntry.suid, .uid = uid};
   tdbTbUpsert(pMeta->pCtbIdx, &ctbIdxKey, sizeof(ctbIdxKey), ctbEntry.ctbEntry.pTags,
               ((STag *)(ctbEntry.ctbEntry.pTags))->len, pMeta->txn);
+  metaTagColsUpdate(pMeta, ctbEntry.ctbEntry.suid, uid);
 
-  metaUidCacheClear(pMeta, ctbEntry.ctbEntry.suid);
+  metaUidCacheUpdate(pMeta, ctbEntry.ctbEntry.suid, uid);
   metaTbGroupCacheClear(pMeta, ctbEntry.ctbEntry.suid);
 
   metaUpdateChangeTime(pMeta, ctbEntry.uid, pAlterTbReq->ctimeMs);
@@ -2260,6 +2752,9 @@ int metaUpdateChangeTimeWithLock(SMeta *pMeta, tb_uid_t uid, int64_t changeTimeM
 static int metaUpdateCtbIdx(SMeta *pMeta, const SMetaEntry *pME) {
   SCtbIdxKey ctbIdxKey = {.suid = pME->ctbEntry.suid, .uid = pME->uid};
 
+  // under the same write lock as the entry, so the cached uid lists are never patched before the entry is saved
+  metaTagColsUpdate(pMeta, pME->ctbEntry.suid, pME->uid);
+  metaUidCacheUpdate(pMeta, pME->ctbEntry.suid, pME->uid);
   return tdbTbUpsert(pMeta->pCtbIdx, &ctbIdxKey, sizeof(ctbIdxKey), pME->ctbEntry.pTags,
                      ((STag *)(pME->ctbEntry.pTags))->len, pMeta->txn);
 }
@@ -2300,6 +2795,30 @@ static void metaDestroyTagIdxKey(STagIdxKey *pTagIdxKey) {
   if (pTagIdxKey) taosMemoryFree(pTagIdxKey);
 }
 
+static int metaBuildTagIdxKey(const SMetaEntry *pCtbEntry, const SSchema *pTagColumn, STagIdxKey **ppTagIdxKey,
+                              int32_t *nTagIdxKey) {
+  const void *pTagData = NULL;
+  int32_t     nTagData = 0;
+
+  STagVal tagVal = {.cid = pTagColumn->colId};
+  if (tTagGet((const STag *)pCtbEntry->ctbEntry.pTags, &tagVal)) {
+    if (IS_VAR_DATA_TYPE(pTagColumn->type)) {
+      pTagData = tagVal.pData;
+      nTagData = (int32_t)tagVal.nData;
+    } else {
+      pTagData = &(tagVal.i64);
+      nTagData = tDataTypes[pTagColumn->type].bytes;
+    }
+  } else {
+    if (!IS_VAR_DATA_TYPE(pTagColumn->type)) {
+      nTagData = tDataTypes[pTagColumn->type].bytes;
+    }
+  }
+
+  return metaCreateTagIdxKey(pCtbEntry->ctbEntry.suid, pTagColumn->colId, pTagData, nTagData, pTagColumn->type,
+                             pCtbEntry->uid, ppTagIdxKey, nTagIdxKey);
+}
+
 static int metaUpdateTagIdx(SMeta *pMeta, const SMetaEntry *pCtbEntry) {
   void          *pData = NULL;
   int            nData = 0;
@@ -2308,8 +2827,6 @@ static int metaUpdateTagIdx(SMeta *pMeta, const SMetaEntry *pCtbEntry) {
   STagIdxKey    *pTagIdxKey = NULL;
   int32_t        nTagIdxKey;
   const SSchema *pTagColumn;
-  const void    *pTagData = NULL;
-  int32_t        nTagData = 0;
   SDecoder       dc = {0};
   int32_t        ret = 0;
   // get super table
@@ -2337,35 +2854,14 @@ static int metaUpdateTagIdx(SMeta *pMeta, const SMetaEntry *pCtbEntry) {
   SSchemaWrapper *pTagSchema = &stbEntry.stbEntry.schemaTag;
   if (pTagSchema->nCols == 1 && pTagSchema->pSchema[0].type == TSDB_DATA_TYPE_JSON) {
     pTagColumn = &stbEntry.stbEntry.schemaTag.pSchema[0];
-    STagVal tagVal = {.cid = pTagColumn->colId};
-
-    pTagData = pCtbEntry->ctbEntry.pTags;
-    nTagData = ((const STag *)pCtbEntry->ctbEntry.pTags)->len;
     ret = metaSaveJsonVarToIdx(pMeta, pCtbEntry, pTagColumn);
     goto end;
   } else {
     for (int i = 0; i < pTagSchema->nCols; i++) {
-      pTagData = NULL;
-      nTagData = 0;
       pTagColumn = &pTagSchema->pSchema[i];
       if (!IS_IDX_ON(pTagColumn)) continue;
 
-      STagVal tagVal = {.cid = pTagColumn->colId};
-      if (tTagGet((const STag *)pCtbEntry->ctbEntry.pTags, &tagVal)) {
-        if (IS_VAR_DATA_TYPE(pTagColumn->type)) {
-          pTagData = tagVal.pData;
-          nTagData = (int32_t)tagVal.nData;
-        } else {
-          pTagData = &(tagVal.i64);
-          nTagData = tDataTypes[pTagColumn->type].bytes;
-        }
-      } else {
-        if (!IS_VAR_DATA_TYPE(pTagColumn->type)) {
-          nTagData = tDataTypes[pTagColumn->type].bytes;
-        }
-      }
-      if (metaCreateTagIdxKey(pCtbEntry->ctbEntry.suid, pTagColumn->colId, pTagData, nTagData, pTagColumn->type,
-                              pCtbEntry->uid, &pTagIdxKey, &nTagIdxKey) < 0) {
+      if (metaBuildTagIdxKey(pCtbEntry, pTagColumn, &pTagIdxKey, &nTagIdxKey) < 0) {
         ret = -1;
         goto end;
       }
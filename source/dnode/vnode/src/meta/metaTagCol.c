@@ -0,0 +1,721 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "meta.h"
+
+// tags of the child tables of a super table kept column by column: a null bitmap per tag column, fixed length
+// values packed back to back and var length values encoded as codes into a dictionary of distinct values. the
+// vectors are built from ctb.idx on first use, in batches so that the meta lock is not held for the whole scan. a
+// change of a child table only records its uid, and the next reader applies the recorded uids to the vectors in
+// place, or to a copy of them while a query still reads them.
+
+#define META_TAG_COLS_MIN_ROWS    1024
+#define META_TAG_COLS_MIN_CHANGES 1024
+#define META_TAG_COLS_BUILD_BATCH 4096
+#define META_TAG_COLS_BUILD_TRIES 2
+
+#define META_TAG_COL_SET_NULL(_col, _row)   ((_col)->pNull[(_row) >> 3] |= (uint8_t)(1 << ((_row)&7)))
+#define META_TAG_COL_CLEAR_NULL(_col, _row) ((_col)->pNull[(_row) >> 3] &= (uint8_t)(~(1 << ((_row)&7))))
+
+typedef struct SMetaTagColBuilder {
+  int32_t   nDictCap;   // entries allocated in aDictOffset
+  int32_t   szDict;     // bytes used in pDict
+  int32_t   szDictCap;  // bytes allocated in pDict
+  SHashObj* pDictIdx;   // distinct value -> code, only while rows are written
+} SMetaTagColBuilder;
+
+typedef struct SMetaTagColsBuilder {
+  SMetaTagCols*       pCols;
+  int32_t             capRows;
+  SMetaTagColBuilder* aBuilder;
+} SMetaTagColsBuilder;
+
+typedef struct SMetaTagColsEntry {
+  SMetaTagColsBuilder builder;   // builder.pCols is NULL while the vectors are being built
+  SHashObj*           pChanged;  // uids of the child tables created, dropped or retagged since the last apply
+  int64_t             nApplied;  // changes applied since the build, the dictionaries keep the values they replaced
+  int64_t             buildId;   // tells a build whether the entry it was started for is still cached
+} SMetaTagColsEntry;
+
+struct SMetaTagColCache {
+  TdThreadMutex lock;
+  SHashObj*     pStbs;  // suid -> SMetaTagColsEntry
+  int64_t       buildId;
+};
+
+typedef struct SMetaTagColsNewRow {
+  tb_uid_t uid;
+  STag*    pTag;
+} SMetaTagColsNewRow;
+
+static void metaTagColsFree(SMetaTagCols* pCols) {
+  if (pCols == NULL) return;
+
+  for (int32_t iCol = 0; iCol < pCols->nCols; iCol++) {
+    SMetaTagColumn* pCol = &pCols->aCol[iCol];
+    taosMemoryFree(pCol->pNull);
+    taosMemoryFree(pCol->pData);
+    taosMemoryFree(pCol->aCode);
+    taosMemoryFree(pCol->pDict);
+    taosMemoryFree(pCol->aDictOffset);
+  }
+  taosMemoryFree(pCols->aCol);
+  taosMemoryFree(pCols->aUid);
+  taosMemoryFree(pCols);
+}
+
+static void metaTagColsUnref(SMetaTagCols* pCols) {
+  if (pCols && atomic_sub_fetch_32(&pCols->nRef, 1) == 0) {
+    metaTagColsFree(pCols);
+  }
+}
+
+static void metaTagColsBuilderDestroy(SMetaTagColsBuilder* pBuilder) {
+  if (pBuilder->aBuilder) {
+    for (int32_t iCol = 0; iCol < pBuilder->pCols->nCols; iCol++) {
+      taosHashCleanup(pBuilder->aBuilder[iCol].pDictIdx);
+    }
+    taosMemoryFreeClear(pBuilder->aBuilder);
+  }
+}
+
+// the dictionary indexes are only needed while rows are written, the capacities are kept for the next apply
+static void metaTagColsBuilderReset(SMetaTagColsBuilder* pBuilder) {
+  for (int32_t iCol = 0; iCol < pBuilder->pCols->nCols; iCol++) {
+    taosHashCleanup(pBuilder->aBuilder[iCol].pDictIdx);
+    pBuilder->aBuilder[iCol].pDictIdx = NULL;
+  }
+}
+
+static void metaTagColsEntryFree(void* param) {
+  SMetaTagColsEntry* pEntry = param;
+  metaTagColsBuilderDestroy(&pEntry->builder);
+  metaTagColsUnref(pEntry->builder.pCols);
+  taosHashCleanup(pEntry->pChanged);
+}
+
+int32_t metaTagColCacheOpen(SMeta* pMeta) {
+  SMetaTagColCache* pCache = taosMemoryCalloc(1, sizeof(*pCache));
+  if (pCache == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pCache->pStbs = taosHashInit(16, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT), false, HASH_NO_LOCK);
+  if (pCache->pStbs == NULL) {
+    taosMemoryFree(pCache);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  taosHashSetFreeFp(pCache->pStbs, metaTagColsEntryFree);
+  taosThreadMutexInit(&pCache->lock, NULL);
+
+  pMeta->pTagColCache = pCache;
+  return 0;
+}
+
+void metaTagColCacheClose(SMeta* pMeta) {
+  if (pMeta->pTagColCache) {
+    taosHashCleanup(pMeta->pTagColCache->pStbs);
+    taosThreadMutexDestroy(&pMeta->pTagColCache->lock);
+    taosMemoryFree(pMeta->pTagColCache);
+    pMeta->pTagColCache = NULL;
+  }
+}
+
+static int32_t metaTagColsBuilderAlloc(SMetaTagColsBuilder* pBuilder, tb_uid_t suid, int32_t sver, int32_t nCols) {
+  SMetaTagCols* pCols = taosMemoryCalloc(1, sizeof(*pCols));
+  if (pCols == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pCols->suid = suid;
+  pCols->sver = sver;
+  pCols->nRef = 1;
+  pCols->aCol = taosMemoryCalloc(nCols, sizeof(SMetaTagColumn));
+  pBuilder->pCols = pCols;
+  pBuilder->capRows = 0;
+  pBuilder->aBuilder = taosMemoryCalloc(nCols, sizeof(SMetaTagColBuilder));
+  if (pCols->aCol == NULL || pBuilder->aBuilder == NULL) {
+    metaTagColsBuilderDestroy(pBuilder);
+    metaTagColsFree(pCols);
+    pBuilder->pCols = NULL;
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  pCols->nCols = nCols;
+
+  return 0;
+}
+
+static int32_t metaTagColsBuilderInit(SMetaTagColsBuilder* pBuilder, tb_uid_t suid, const SSchemaWrapper* pTagSchema) {
+  int32_t code = metaTagColsBuilderAlloc(pBuilder, suid, pTagSchema->version, pTagSchema->nCols);
+  if (code) return code;
+
+  for (int32_t iCol = 0; iCol < pTagSchema->nCols; iCol++) {
+    SSchema*        pSchema = &pTagSchema->pSchema[iCol];
+    SMetaTagColumn* pCol = &pBuilder->pCols->aCol[iCol];
+
+    pCol->cid = pSchema->colId;
+    pCol->type = pSchema->type;
+    pCol->bytes = IS_VAR_DATA_TYPE(pSchema->type) ? pSchema->bytes : tDataTypes[pSchema->type].bytes;
+  }
+
+  return 0;
+}
+
+static int32_t metaTagColsDup(void** ppDst, const void* pSrc, int64_t size) {
+  if (size == 0) return 0;
+
+  *ppDst = taosMemoryMalloc(size);
+  if (*ppDst == NULL) return TSDB_CODE_OUT_OF_MEMORY;
+  memcpy(*ppDst, pSrc, size);
+  return 0;
+}
+
+// a copy of vectors still read by queries, the changes are then applied to the copy
+static int32_t metaTagColsBuilderClone(SMetaTagColsBuilder* pBuilder, const SMetaTagColsBuilder* pFrom) {
+  const SMetaTagCols* pOld = pFrom->pCols;
+
+  int32_t code = metaTagColsBuilderAlloc(pBuilder, pOld->suid, pOld->sver, pOld->nCols);
+  if (code) return code;
+
+  SMetaTagCols* pCols = pBuilder->pCols;
+  pCols->nRows = pOld->nRows;
+  pBuilder->capRows = pOld->nRows;
+  code = metaTagColsDup((void**)&pCols->aUid, pOld->aUid, sizeof(tb_uid_t) * pOld->nRows);
+
+  for (int32_t iCol = 0; code == 0 && iCol < pOld->nCols; iCol++) {
+    const SMetaTagColumn*     pOldCol = &pOld->aCol[iCol];
+    const SMetaTagColBuilder* pOldColBuilder = &pFrom->aBuilder[iCol];
+    SMetaTagColumn*           pCol = &pCols->aCol[iCol];
+    SMetaTagColBuilder*       pColBuilder = &pBuilder->aBuilder[iCol];
+
+    pCol->cid = pOldCol->cid;
+    pCol->type = pOldCol->type;
+    pCol->bytes = pOldCol->bytes;
+
+    code = metaTagColsDup((void**)&pCol->pNull, pOldCol->pNull, BitmapLen(pOld->nRows));
+    if (code) break;
+
+    if (!IS_VAR_DATA_TYPE(pCol->type)) {
+      code = metaTagColsDup((void**)&pCol->pData, pOldCol->pData, (int64_t)pCol->bytes * pOld->nRows);
+      continue;
+    }
+
+    code = metaTagColsDup((void**)&pCol->aCode, pOldCol->aCode, sizeof(int32_t) * pOld->nRows);
+    if (code == 0) {
+      code = metaTagColsDup((void**)&pCol->pDict, pOldCol->pDict, pOldColBuilder->szDict);
+    }
+    if (code == 0) {
+      code = metaTagColsDup((void**)&pCol->aDictOffset, pOldCol->aDictOffset, sizeof(int32_t) * pOldCol->nDict);
+    }
+    if (code) break;
+
+    pCol->nDict = pOldCol->nDict;
+    pColBuilder->nDictCap = pOldCol->nDict;
+    pColBuilder->szDict = pOldColBuilder->szDict;
+    pColBuilder->szDictCap = pOldColBuilder->szDict;
+  }
+
+  if (code) {
+    metaTagColsBuilderDestroy(pBuilder);
+    metaTagColsFree(pCols);
+    pBuilder->pCols = NULL;
+  }
+  return code;
+}
+
+static int32_t metaTagColsReserve(SMetaTagColsBuilder* pBuilder, int32_t nRows) {
+  SMetaTagCols* pCols = pBuilder->pCols;
+  if (nRows <= pBuilder->capRows) return 0;
+
+  int32_t capRows = pBuilder->capRows ? pBuilder->capRows * 2 : META_TAG_COLS_MIN_ROWS;
+  capRows = TMAX(capRows, nRows);
+
+  tb_uid_t* aUid = taosMemoryRealloc(pCols->aUid, sizeof(tb_uid_t) * capRows);
+  if (aUid == NULL) return TSDB_CODE_OUT_OF_MEMORY;
+  pCols->aUid = aUid;
+
+  for (int32_t iCol = 0; iCol < pCols->nCols; iCol++) {
+    SMetaTagColumn* pCol = &pCols->aCol[iCol];
+
+    uint8_t* pNull = taosMemoryRealloc(pCol->pNull, BitmapLen(capRows));
+    if (pNull == NULL) return TSDB_CODE_OUT_OF_MEMORY;
+    pCol->pNull = pNull;
+
+    if (IS_VAR_DATA_TYPE(pCol->type)) {
+      int32_t* aCode = taosMemoryRealloc(pCol->aCode, sizeof(int32_t) * capRows);
+      if (aCode == NULL) return TSDB_CODE_OUT_OF_MEMORY;
+      pCol->aCode = aCode;
+    } else {
+      char* pData = taosMemoryRealloc(pCol->pData, (int64_t)pCol->bytes * capRows);
+      if (pData == NULL) return TSDB_CODE_OUT_OF_MEMORY;
+      pCol->pData = pData;
+    }
+  }
+
+  pBuilder->capRows = capRows;
+  return 0;
+}
+
+// find or add a var length value in the dictionary of the column, the value is first written to the tail of the
+// dictionary and kept there only if it is new
+static int32_t metaTagColDictPut(SMetaTagColumn* pCol, SMetaTagColBuilder* pColBuilder, const uint8_t* pData,
+                                 uint32_t nData, int32_t* pCode) {
+  if (pColBuilder->pDictIdx == NULL) {
+    pColBuilder->pDictIdx = taosHashInit(pCol->nDict + 64, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true,
+                                         HASH_NO_LOCK);
+    if (pColBuilder->pDictIdx == NULL) return TSDB_CODE_OUT_OF_MEMORY;
+
+    for (int32_t iDict = 0; iDict < pCol->nDict; iDict++) {
+      char* pVal = pCol->pDict + pCol->aDictOffset[iDict];
+      if (taosHashPut(pColBuilder->pDictIdx, pVal, varDataTLen(pVal), &iDict, sizeof(iDict)) < 0) {
+        return TSDB_CODE_OUT_OF_MEMORY;
+      }
+    }
+  }
+
+  int32_t szVal = VARSTR_HEADER_SIZE + nData;
+  if (pColBuilder->szDict + szVal > pColBuilder->szDictCap) {
+    int32_t szDictCap = TMAX(pColBuilder->szDictCap * 2, pColBuilder->szDict + szVal);
+    szDictCap = TMAX(szDictCap, 4096);
+
+    char* pDict = taosMemoryRealloc(pCol->pDict, szDictCap);
+    if (pDict == NULL) return TSDB_CODE_OUT_OF_MEMORY;
+    pCol->pDict = pDict;
+    pColBuilder->szDictCap = szDictCap;
+  }
+
+  char* pVal = pCol->pDict + pColBuilder->szDict;
+  varDataSetLen(pVal, nData);
+  if (nData > 0) memcpy(varDataVal(pVal), pData, nData);
+
+  int32_t* pFound = taosHashGet(pColBuilder->pDictIdx, pVal, szVal);
+  if (pFound) {
+    *pCode = *pFound;
+    return 0;
+  }
+
+  if (pCol->nDict >= pColBuilder->nDictCap) {
+    int32_t  nDictCap = pColBuilder->nDictCap ? pColBuilder->nDictCap * 2 : 64;
+    int32_t* aDictOffset = taosMemoryRealloc(pCol->aDictOffset, sizeof(int32_t) * nDictCap);
+    if (aDictOffset == NULL) return TSDB_CODE_OUT_OF_MEMORY;
+    pCol->aDictOffset = aDictOffset;
+    pColBuilder->nDictCap = nDictCap;
+  }
+
+  *pCode = pCol->nDict;
+  if (taosHashPut(pColBuilder->pDictIdx, pVal, szVal, pCode, sizeof(int32_t)) < 0) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  pCol->aDictOffset[pCol->nDict++] = pColBuilder->szDict;
+  pColBuilder->szDict += szVal;
+  return 0;
+}
+
+static int32_t metaTagColsSetTag(SMetaTagColsBuilder* pBuilder, int32_t iRow, tb_uid_t uid, const STag* pTag) {
+  SMetaTagCols* pCols = pBuilder->pCols;
+
+  for (int32_t iCol = 0; iCol < pCols->nCols; iCol++) {
+    SMetaTagColumn* pCol = &pCols->aCol[iCol];
+    STagVal         tagVal = {.cid = pCol->cid};
+
+    if (!tTagGet(pTag, &tagVal)) {
+      META_TAG_COL_SET_NULL(pCol, iRow);
+      if (IS_VAR_DATA_TYPE(pCol->type)) {
+        pCol->aCode[iRow] = -1;
+      } else {
+        memset(pCol->pData + (int64_t)pCol->bytes * iRow, 0, pCol->bytes);
+      }
+      continue;
+    }
+
+    META_TAG_COL_CLEAR_NULL(pCol, iRow);
+    if (IS_VAR_DATA_TYPE(pCol->type)) {
+      int32_t code = metaTagColDictPut(pCol, &pBuilder->aBuilder[iCol], tagVal.pData, tagVal.nData, &pCol->aCode[iRow]);
+      if (code) return code;
+    } else {
+      memcpy(pCol->pData + (int64_t)pCol->bytes * iRow, &tagVal.i64, pCol->bytes);
+    }
+  }
+
+  pCols->aUid[iRow] = uid;
+  return 0;
+}
+
+static int32_t metaTagColsAppendTag(SMetaTagColsBuilder* pBuilder, tb_uid_t uid, const STag* pTag) {
+  int32_t code = metaTagColsReserve(pBuilder, pBuilder->pCols->nRows + 1);
+  if (code) return code;
+
+  code = metaTagColsSetTag(pBuilder, pBuilder->pCols->nRows, uid, pTag);
+  if (code) return code;
+
+  pBuilder->pCols->nRows++;
+  return 0;
+}
+
+static void metaTagColsMoveRow(SMetaTagCols* pCols, int32_t iDst, int32_t iSrc) {
+  for (int32_t iCol = 0; iCol < pCols->nCols; iCol++) {
+    SMetaTagColumn* pCol = &pCols->aCol[iCol];
+
+    if (META_TAG_COL_IS_NULL(pCol, iSrc)) {
+      META_TAG_COL_SET_NULL(pCol, iDst);
+    } else {
+      META_TAG_COL_CLEAR_NULL(pCol, iDst);
+    }
+
+    if (IS_VAR_DATA_TYPE(pCol->type)) {
+      pCol->aCode[iDst] = pCol->aCode[iSrc];
+    } else {
+      memcpy(pCol->pData + (int64_t)pCol->bytes * iDst, pCol->pData + (int64_t)pCol->bytes * iSrc, pCol->bytes);
+    }
+  }
+
+  pCols->aUid[iDst] = pCols->aUid[iSrc];
+}
+
+// reads ctb.idx in batches, the read lock is released between them. a batch resumes after the last key read, so a
+// key before it seen again after a drop is skipped, and the changes made meanwhile are applied once published
+static int32_t metaTagColsBuild(SMeta* pMeta, tb_uid_t suid, const SSchemaWrapper* pTagSchema,
+                                SMetaTagColsBuilder* pBuilder) {
+  int32_t code = metaTagColsBuilderInit(pBuilder, suid, pTagSchema);
+  if (code) return code;
+
+  SMCtbCursor* pCur = metaOpenCtbCursor(pMeta->pVnode, suid, 1);
+  if (pCur == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _err;
+  }
+
+  tb_uid_t lastUid = INT64_MIN;
+  for (int32_t nRead = 1;; nRead++) {
+    tb_uid_t uid = metaCtbCursorNext(pCur);
+    if (uid == 0) break;
+
+    if (((SCtbIdxKey*)pCur->pKey)->suid == suid && uid > lastUid) {
+      code = metaTagColsAppendTag(pBuilder, uid, pCur->pVal);
+      if (code) goto _err;
+      lastUid = uid;
+    }
+
+    if (nRead % META_TAG_COLS_BUILD_BATCH == 0) {
+      metaPauseCtbCursor(pCur);
+      if (metaResumeCtbCursor(pCur, 0) < 0) {
+        pCur = NULL;
+        code = TSDB_CODE_OUT_OF_MEMORY;
+        goto _err;
+      }
+    }
+  }
+
+  metaCloseCtbCursor(pCur);
+  metaTagColsBuilderReset(pBuilder);
+  return 0;
+
+_err:
+  if (pCur) metaCloseCtbCursor(pCur);
+  metaTagColsBuilderDestroy(pBuilder);
+  metaTagColsFree(pBuilder->pCols);
+  pBuilder->pCols = NULL;
+  return code;
+}
+
+static int32_t metaTagColsUidCmpr(const void* p1, const void* p2) {
+  tb_uid_t uid1 = *(tb_uid_t*)p1;
+  tb_uid_t uid2 = *(tb_uid_t*)p2;
+
+  if (uid1 < uid2) return -1;
+  if (uid1 > uid2) return 1;
+  return 0;
+}
+
+static int32_t metaTagColsFindRow(const SMetaTagCols* pCols, tb_uid_t uid) {
+  int32_t lidx = 0;
+  int32_t ridx = pCols->nRows - 1;
+
+  while (lidx <= ridx) {
+    int32_t midx = (lidx + ridx) >> 1;
+    if (pCols->aUid[midx] < uid) {
+      lidx = midx + 1;
+    } else if (pCols->aUid[midx] > uid) {
+      ridx = midx - 1;
+    } else {
+      return midx;
+    }
+  }
+  return -1;
+}
+
+// applies the changed uids to the vectors in place, rows are kept in ctb.idx order: a retagged child table is
+// rewritten in its row, the rows of the dropped ones are compacted away and the created ones are merged in from
+// the tail. called with the meta read lock and the cache lock held
+static int32_t metaTagColsApply(SMeta* pMeta, SMetaTagColsEntry* pEntry) {
+  SMetaTagColsBuilder* pBuilder = &pEntry->builder;
+  SArray*              aChanged = NULL;
+  SArray*              aNew = NULL;
+  void*                pVal = NULL;
+  int32_t              nVal = 0;
+  int32_t              nChanged = taosHashGetSize(pEntry->pChanged);
+  int32_t              code = 0;
+
+  if (atomic_load_32(&pBuilder->pCols->nRef) > 1) {
+    SMetaTagColsBuilder clone = {0};
+
+    code = metaTagColsBuilderClone(&clone, pBuilder);
+    if (code) return code;
+
+    metaTagColsBuilderDestroy(pBuilder);
+    metaTagColsUnref(pBuilder->pCols);
+    *pBuilder = clone;
+  }
+
+  SMetaTagCols* pCols = pBuilder->pCols;
+
+  aChanged = taosArrayInit(nChanged, sizeof(tb_uid_t));
+  aNew = taosArrayInit(nChanged, sizeof(SMetaTagColsNewRow));
+  if (aChanged == NULL || aNew == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  void* pIter = taosHashIterate(pEntry->pChanged, NULL);
+  while (pIter) {
+    taosArrayPush(aChanged, taosHashGetKey(pIter, NULL));
+    pIter = taosHashIterate(pEntry->pChanged, pIter);
+  }
+  taosArraySort(aChanged, metaTagColsUidCmpr);
+
+  // rewrite the retagged rows, mark the dropped ones and collect the created ones
+  int32_t nDropped = 0;
+  for (int32_t i = 0; i < nChanged; i++) {
+    tb_uid_t   uid = *(tb_uid_t*)taosArrayGet(aChanged, i);
+    int32_t    iRow = metaTagColsFindRow(pCols, uid);
+    SCtbIdxKey ctbIdxKey = {.suid = pCols->suid, .uid = uid};
+    bool       exist = tdbTbGet(pMeta->pCtbIdx, &ctbIdxKey, sizeof(ctbIdxKey), &pVal, &nVal) == 0;
+
+    if (iRow >= 0 && exist) {
+      code = metaTagColsSetTag(pBuilder, iRow, uid, pVal);
+    } else if (iRow >= 0) {
+      pCols->aUid[iRow] = 0;
+      nDropped++;
+    } else if (exist) {
+      SMetaTagColsNewRow row = {.uid = uid, .pTag = taosMemoryMalloc(nVal)};
+      if (row.pTag == NULL || taosArrayPush(aNew, &row) == NULL) {
+        taosMemoryFree(row.pTag);
+        code = TSDB_CODE_OUT_OF_MEMORY;
+      } else {
+        memcpy(row.pTag, pVal, nVal);
+      }
+    }
+    if (code) goto _exit;
+  }
+
+  if (nDropped > 0) {
+    int32_t nRows = 0;
+    for (int32_t iRow = 0; iRow < pCols->nRows; iRow++) {
+      if (pCols->aUid[iRow] == 0) continue;
+      if (nRows < iRow) metaTagColsMoveRow(pCols, nRows, iRow);
+      nRows++;
+    }
+    pCols->nRows = nRows;
+  }
+
+  int32_t nNew = taosArrayGetSize(aNew);
+  if (nNew > 0) {
+    code = metaTagColsReserve(pBuilder, pCols->nRows + nNew);
+    if (code) goto _exit;
+
+    int32_t iOld = pCols->nRows - 1;
+    int32_t iNew = nNew - 1;
+    for (int32_t iRow = pCols->nRows + nNew - 1; iNew >= 0; iRow--) {
+      SMetaTagColsNewRow* pRow = taosArrayGet(aNew, iNew);
+      if (iOld >= 0 && pCols->aUid[iOld] > pRow->uid) {
+        metaTagColsMoveRow(pCols, iRow, iOld--);
+      } else {
+        code = metaTagColsSetTag(pBuilder, iRow, pRow->uid, pRow->pTag);
+        if (code) goto _exit;
+        iNew--;
+      }
+    }
+    pCols->nRows += nNew;
+  }
+
+  pEntry->nApplied += nChanged;
+  taosHashClear(pEntry->pChanged);
+
+_exit:
+  tdbFree(pVal);
+  for (int32_t i = 0; i < taosArrayGetSize(aNew); i++) {
+    taosMemoryFree(((SMetaTagColsNewRow*)taosArrayGet(aNew, i))->pTag);
+  }
+  taosArrayDestroy(aNew);
+  taosArrayDestroy(aChanged);
+  metaTagColsBuilderReset(pBuilder);
+  return code;
+}
+
+// with the meta read lock and the cache lock held: the published vectors with the pending changes applied, or
+// NULL while they are built by another reader or if applying failed
+static SMetaTagCols* metaTagColsGet(SMeta* pMeta, SMetaTagColsEntry* pEntry) {
+  SMetaTagColCache* pCache = pMeta->pTagColCache;
+  tb_uid_t          suid = pEntry->builder.pCols->suid;
+  int32_t           nChanged = taosHashGetSize(pEntry->pChanged);
+
+  if (nChanged > 0) {
+    int32_t code = metaTagColsApply(pMeta, pEntry);
+    if (code) {
+      metaError("vgId:%d, failed to apply %d changed tables to tag columns of suid:%" PRId64 " since %s",
+                TD_VID(pMeta->pVnode), nChanged, suid, tstrerror(code));
+      taosHashRemove(pCache->pStbs, &suid, sizeof(suid));
+      return NULL;
+    }
+    metaDebug("vgId:%d, apply %d changed tables to tag columns of suid:%" PRId64 ", rows:%d", TD_VID(pMeta->pVnode),
+              nChanged, suid, pEntry->builder.pCols->nRows);
+  }
+
+  atomic_add_fetch_32(&pEntry->builder.pCols->nRef, 1);
+  return pEntry->builder.pCols;
+}
+
+SMetaTagCols* metaAcquireTagCols(void* pVnode, tb_uid_t suid) {
+  SMeta*            pMeta = ((SVnode*)pVnode)->pMeta;
+  SMetaTagColCache* pCache = pMeta->pTagColCache;
+  SMetaTagCols*     pCols = NULL;
+  SMetaReader       mr = {0};
+  int32_t           code = 0;
+
+  if (!tsTagColumnCache) {
+    return NULL;
+  }
+
+  for (int32_t nTry = 0; nTry < META_TAG_COLS_BUILD_TRIES; nTry++) {
+    SMetaTagColsEntry   entry = {0};
+    SMetaTagColsBuilder builder = {0};
+
+    // the schema and the state of the cache are read under the meta read lock, the ctb.idx scan is not
+    metaRLock(pMeta);
+    metaReaderDoInit(&mr, pMeta, META_READER_NOLOCK);
+    if (metaReaderGetTableEntryByUid(&mr, suid) < 0 || mr.me.type != TSDB_SUPER_TABLE ||
+        mr.me.stbEntry.schemaTag.nCols == 0 || mr.me.stbEntry.schemaTag.pSchema[0].type == TSDB_DATA_TYPE_JSON) {
+      metaReaderClear(&mr);
+      metaULock(pMeta);
+      return NULL;
+    }
+
+    taosThreadMutexLock(&pCache->lock);
+
+    SMetaTagColsEntry* pEntry = taosHashGet(pCache->pStbs, &suid, sizeof(suid));
+    if (pEntry && pEntry->builder.pCols && pEntry->builder.pCols->sver != mr.me.stbEntry.schemaTag.version) {
+      taosHashRemove(pCache->pStbs, &suid, sizeof(suid));
+      pEntry = NULL;
+    }
+
+    if (pEntry) {
+      // published, or being built by another reader whom this one does not wait for
+      if (pEntry->builder.pCols) pCols = metaTagColsGet(pMeta, pEntry);
+      taosThreadMutexUnlock(&pCache->lock);
+      metaReaderClear(&mr);
+      metaULock(pMeta);
+      return pCols;
+    }
+
+    // an entry without vectors records the changes made while they are built
+    entry.buildId = ++pCache->buildId;
+    entry.pChanged = taosHashInit(64, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT), true, HASH_NO_LOCK);
+    if (entry.pChanged == NULL || taosHashPut(pCache->pStbs, &suid, sizeof(suid), &entry, sizeof(entry)) < 0) {
+      taosHashCleanup(entry.pChanged);
+      code = TSDB_CODE_OUT_OF_MEMORY;
+    }
+    taosThreadMutexUnlock(&pCache->lock);
+    metaULock(pMeta);
+
+    if (code == 0) {
+      code = metaTagColsBuild(pMeta, suid, &mr.me.stbEntry.schemaTag, &builder);
+    }
+    metaReaderClear(&mr);
+
+    metaRLock(pMeta);
+    taosThreadMutexLock(&pCache->lock);
+
+    pEntry = taosHashGet(pCache->pStbs, &suid, sizeof(suid));
+    if (pEntry && pEntry->buildId == entry.buildId) {
+      if (code == 0) {
+        pEntry->builder = builder;
+        builder.pCols = NULL;
+        metaDebug("vgId:%d, build tag columns of suid:%" PRId64 ", rows:%d, cols:%d", TD_VID(pMeta->pVnode), suid,
+                  pEntry->builder.pCols->nRows, pEntry->builder.pCols->nCols);
+        pCols = metaTagColsGet(pMeta, pEntry);
+      } else {
+        taosHashRemove(pCache->pStbs, &suid, sizeof(suid));
+      }
+    }
+
+    taosThreadMutexUnlock(&pCache->lock);
+    metaULock(pMeta);
+
+    // the entry was dropped or rebuilt meanwhile, e.g. by a schema change or too many changes
+    if (builder.pCols) {
+      metaTagColsBuilderDestroy(&builder);
+      metaTagColsFree(builder.pCols);
+    }
+
+    if (code) {
+      metaError("vgId:%d, failed to build tag columns of suid:%" PRId64 " since %s", TD_VID(pMeta->pVnode), suid,
+                tstrerror(code));
+      return NULL;
+    }
+    if (pCols) {
+      return pCols;
+    }
+  }
+
+  return NULL;
+}
+
+void metaReleaseTagCols(void* pVnode, SMetaTagCols* pTagCols) { metaTagColsUnref(pTagCols); }
+
+// called with the meta write lock held
+void metaTagColsUpdate(SMeta* pMeta, tb_uid_t suid, tb_uid_t uid) {
+  SMetaTagColCache* pCache = pMeta->pTagColCache;
+  if (pCache == NULL) return;
+
+  taosThreadMutexLock(&pCache->lock);
+
+  SMetaTagColsEntry* pEntry = taosHashGet(pCache->pStbs, &suid, sizeof(suid));
+  if (pEntry == NULL) {
+    goto _exit;
+  }
+
+  if (pEntry->pChanged == NULL) {
+    pEntry->pChanged = taosHashInit(64, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT), true, HASH_NO_LOCK);
+  }
+
+  // once a good part of the super table has changed since the build, building the vectors again is cheaper than
+  // applying the changes and drops the dictionary values no row uses any more
+  int32_t nRows = pEntry->builder.pCols ? pEntry->builder.pCols->nRows : 0;
+  if (pEntry->pChanged == NULL || taosHashPut(pEntry->pChanged, &uid, sizeof(uid), NULL, 0) < 0 ||
+      pEntry->nApplied + taosHashGetSize(pEntry->pChanged) > TMAX(META_TAG_COLS_MIN_CHANGES, nRows / 4)) {
+    taosHashRemove(pCache->pStbs, &suid, sizeof(suid));
+  }
+
+_exit:
+  taosThreadMutexUnlock(&pCache->lock);
+}
+
+void metaTagColsDrop(SMeta* pMeta, tb_uid_t suid) {
+  SMetaTagColCache* pCache = pMeta->pTagColCache;
+  if (pCache == NULL) return;
+
+  taosThreadMutexLock(&pCache->lock);
+  taosHashRemove(pCache->pStbs, &suid, sizeof(suid));
+  taosThreadMutexUnlock(&pCache->lock);
+}
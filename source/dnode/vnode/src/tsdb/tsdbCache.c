@@ -125,6 +125,42 @@ static void tsdbClosePgCache(STsdb *pTsdb) {
   }
 }
 
+static int32_t tsdbOpenSmaCache(STsdb *pTsdb) {
+  int32_t code = 0;
+
+  pTsdb->smaCache = NULL;
+  if (tsBlockSmaCacheSize <= 0) {
+    return code;
+  }
+
+  SLRUCache *pCache = taosLRUCacheInit((int64_t)tsBlockSmaCacheSize * 1024 * 1024, 0, .5);
+  if (pCache == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _err;
+  }
+
+  taosLRUCacheSetStrictCapacity(pCache, false);
+
+  pTsdb->smaCache = pCache;
+
+_err:
+  return code;
+}
+
+static void tsdbCloseSmaCache(STsdb *pTsdb) {
+  SLRUCache *pCache = pTsdb->smaCache;
+  if (pCache) {
+    int32_t elems = taosLRUCacheGetElems(pCache);
+    tsdbTrace("vgId:%d, elems: %d", TD_VID(pTsdb->pVnode), elems);
+    taosLRUCacheEraseUnrefEntries(pCache);
+    elems = taosLRUCacheGetElems(pCache);
+    tsdbTrace("vgId:%d, elems: %d", TD_VID(pTsdb->pVnode), elems);
+
+    taosLRUCacheCleanup(pCache);
+    pTsdb->smaCache = NULL;
+  }
+}
+
 #define ROCKS_KEY_LEN (sizeof(tb_uid_t) + sizeof(int16_t) + sizeof(int8_t))
 
 typedef struct {
@@ -1649,6 +1685,12 @@ int32_t tsdbOpenCache(STsdb *pTsdb) {
     goto _err;
   }
 
+  code = tsdbOpenSmaCache(pTsdb);
+  if (code != TSDB_CODE_SUCCESS) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _err;
+  }
+
   code = tsdbOpenRocksCache(pTsdb);
   if (code != TSDB_CODE_SUCCESS) {
     code = TSDB_CODE_OUT_OF_MEMORY;
@@ -1682,6 +1724,7 @@ void tsdbCloseCache(STsdb *pTsdb) {
 #endif
   tsdbCloseBCache(pTsdb);
   tsdbClosePgCache(pTsdb);
+  tsdbCloseSmaCache(pTsdb);
   tsdbCloseRocksCache(pTsdb);
 }
 
@@ -3670,3 +3713,79 @@ int32_t tsdbCacheSetPageS3(SLRUCache *pCache, STsdbFD *pFD, int64_t pgno, uint8_
 
   return code;
 }
+
+// Block SMA cache ===========================================================================================
+// Files are never rewritten in place under the same commit id, so the SMA of a block is identified by the fid and
+// cid of the sma file together with its offset. Commit ids are not reused while the tsdb is open, so the entries of a
+// removed file are never looked up again and just age out of the LRU instead of being searched for on each removal.
+static void getBlockSmaCacheKey(int32_t fid, int64_t cid, int64_t offset, char *key, int *len) {
+  struct {
+    int32_t fid;
+    int64_t cid;
+    int64_t offset;
+  } smaKey = {0};
+
+  smaKey.fid = fid;
+  smaKey.cid = cid;
+  smaKey.offset = offset;
+
+  *len = sizeof(smaKey);
+  memcpy(key, &smaKey, *len);
+}
+
+static void deleteBlockSmaCache(const void *key, size_t keyLen, void *value, void *ud) {
+  (void)ud;
+  taosMemoryFree(value);
+}
+
+int32_t tsdbCacheGetBlockSma(STsdb *pTsdb, int32_t fid, int64_t cid, int64_t offset, LRUHandle **handle) {
+  int32_t code = 0;
+  char    key[128] = {0};
+  int     keyLen = 0;
+
+  *handle = NULL;
+  if (pTsdb->smaCache == NULL) {
+    return code;
+  }
+
+  getBlockSmaCacheKey(fid, cid, offset, key, &keyLen);
+  *handle = taosLRUCacheLookup(pTsdb->smaCache, key, keyLen);
+
+  return code;
+}
+
+int32_t tsdbCacheSetBlockSma(STsdb *pTsdb, int32_t fid, int64_t cid, int64_t offset, const SColumnDataAgg *aSma,
+                             int32_t nSma) {
+  int32_t    code = 0;
+  char       key[128] = {0};
+  int        keyLen = 0;
+  LRUHandle *handle = NULL;
+
+  if (pTsdb->smaCache == NULL) {
+    return code;
+  }
+
+  size_t             charge = sizeof(SBlockSmaCacheVal) + sizeof(SColumnDataAgg) * nSma;
+  SBlockSmaCacheVal *pVal = taosMemoryMalloc(charge);
+  if (pVal == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pVal->nSma = nSma;
+  if (nSma > 0) {
+    memcpy(pVal->aSma, aSma, sizeof(SColumnDataAgg) * nSma);
+  }
+
+  getBlockSmaCacheKey(fid, cid, offset, key, &keyLen);
+  LRUStatus status = taosLRUCacheInsert(pTsdb->smaCache, key, keyLen, pVal, charge, deleteBlockSmaCache, &handle,
+                                        TAOS_LRU_PRIORITY_LOW, NULL);
+  if (status != TAOS_LRU_STATUS_OK) {
+    // ignore cache updating if not ok
+  }
+
+  if (handle) {
+    tsdbCacheRelease(pTsdb->smaCache, handle);
+  }
+
+  return code;
+}
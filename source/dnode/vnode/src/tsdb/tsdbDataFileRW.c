@@ -14,6 +14,7 @@
  */
 
 #include "tsdbDataFileRW.h"
+#include "vnd.h"
 
 // SDataFileReader =============================================
 struct SDataFileReader {
@@ -247,10 +248,98 @@ _exit:
   return code;
 }
 
+// parallel column decode =============================================
+typedef struct {
+  SColData *colData;
+  SBlockCol blockCol;
+  uint8_t  *pIn;
+} STsdbColDecode;
+
+typedef struct {
+  STsdbColDecode *items;
+  int32_t         nItem;
+  int32_t         start;
+  int32_t         step;
+  int8_t          cmprAlg;
+  int32_t         nRow;
+  bool            done;
+  int32_t         code;
+} STsdbColDecodeTask;
+
+static int32_t tsdbColDecodeTaskExec(void *arg) {
+  STsdbColDecodeTask *task = (STsdbColDecodeTask *)arg;
+  uint8_t            *buf = NULL;
+
+  for (int32_t i = task->start; i < task->nItem && task->code == 0; i += task->step) {
+    STsdbColDecode *item = &task->items[i];
+    task->code = tsdbDecmprColData(item->pIn, &item->blockCol, task->cmprAlg, task->nRow, item->colData, &buf);
+  }
+
+  tFree(buf);
+  task->done = true;
+  return task->code;
+}
+
+// Decompress the column payloads that have been read into memory. The columns are independent, so they are spread
+// over the vnode-decode workers in a round robin way and the calling thread takes one share itself before joining.
+static int32_t tsdbDecmprColDataBatch(STsdbColDecode *items, int32_t nItem, int8_t cmprAlg, int32_t nRow) {
+  int32_t code = 0;
+  int32_t nTask = 1;
+
+  if (vnodeAsyncHandle[2] != NULL && tsDecodeParallelCols > 0 && nItem >= tsDecodeParallelCols) {
+    nTask = TMIN(tsNumOfDecodeThreads + 1, nItem);
+  }
+
+  STsdbColDecodeTask  task0 = {0};
+  STsdbColDecodeTask *tasks = &task0;
+  int64_t            *taskIds = NULL;
+  if (nTask > 1) {
+    tasks = taosMemoryCalloc(nTask, sizeof(STsdbColDecodeTask) + sizeof(int64_t));
+    if (tasks == NULL) {
+      tasks = &task0;
+      nTask = 1;
+    } else {
+      taskIds = (int64_t *)(tasks + nTask);
+    }
+  }
+
+  for (int32_t i = 0; i < nTask; i++) {
+    tasks[i] = (STsdbColDecodeTask){
+        .items = items, .nItem = nItem, .start = i, .step = nTask, .cmprAlg = cmprAlg, .nRow = nRow};
+  }
+
+  for (int32_t i = 1; i < nTask; i++) {
+    if (vnodeAsyncC(vnodeAsyncHandle[2], 0, EVA_PRIORITY_HIGH, tsdbColDecodeTaskExec, NULL, &tasks[i], &taskIds[i]) !=
+        0) {
+      taskIds[i] = 0;
+      tsdbColDecodeTaskExec(&tasks[i]);
+    }
+  }
+
+  tsdbColDecodeTaskExec(&tasks[0]);
+
+  for (int32_t i = 0; i < nTask; i++) {
+    if (i > 0 && VNODE_ASYNC_VALID_TASK_ID(taskIds[i])) {
+      vnodeAWait(vnodeAsyncHandle[2], taskIds[i]);
+    }
+
+    if (code == 0) {
+      code = tasks[i].done ? tasks[i].code : TSDB_CODE_APP_IS_STOPPING;
+    }
+  }
+
+  if (tasks != &task0) {
+    taosMemoryFree(tasks);
+  }
+  return code;
+}
+
 int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRecord *record, SBlockData *bData,
                                           STSchema *pTSchema, int16_t cids[], int32_t ncid) {
-  int32_t code = 0;
-  int32_t lino = 0;
+  int32_t         code = 0;
+  int32_t         lino = 0;
+  STsdbColDecode *decodeList = NULL;
+  int32_t         nDecode = 0;
 
   code = tBlockDataInit(bData, (TABLEID *)record, pTSchema, cids, ncid);
   TSDB_CHECK_CODE(code, lino, _exit);
@@ -341,6 +430,15 @@ int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRe
     SBlockCol  bc[1] = {{.cid = 0}};
     SBlockCol *blockCol = bc;
 
+    // wide blocks: read all column payloads first, and decompress them together on the vnode-decode pool afterwards
+    if (vnodeAsyncHandle[2] != NULL && tsDecodeParallelCols > 0 && bData->nColData >= tsDecodeParallelCols) {
+      decodeList = taosMemoryCalloc(bData->nColData, sizeof(STsdbColDecode));
+      if (decodeList == NULL) {
+        code = TSDB_CODE_OUT_OF_MEMORY;
+        TSDB_CHECK_CODE(code, lino, _exit);
+      }
+    }
+
     size = 0;
     for (int32_t i = 0; i < bData->nColData; i++) {
       SColData *colData = tBlockDataGetColDataByIdx(bData, i);
@@ -368,6 +466,20 @@ int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRe
             code = tColDataAppendValue(colData, &COL_VAL_NULL(blockCol->cid, blockCol->type));
             TSDB_CHECK_CODE(code, lino, _exit);
           }
+        } else if (decodeList != NULL) {
+          STsdbColDecode *item = &decodeList[nDecode++];
+          int32_t         size1 = blockCol->szBitmap + blockCol->szOffset + blockCol->szValue;
+
+          item->colData = colData;
+          item->blockCol = *blockCol;
+
+          code = tRealloc(&item->pIn, size1);
+          TSDB_CHECK_CODE(code, lino, _exit);
+
+          code = tsdbReadFile(reader->fd[TSDB_FTYPE_DATA],
+                              record->blockOffset + record->blockKeySize + hdr->szBlkCol + blockCol->offset, item->pIn,
+                              size1, i > 0 ? 0 : szHint);
+          TSDB_CHECK_CODE(code, lino, _exit);
         } else {
           int32_t size1 = blockCol->szBitmap + blockCol->szOffset + blockCol->szValue;
 
@@ -385,12 +497,23 @@ int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRe
         }
       }
     }
+
+    if (nDecode > 0) {
+      code = tsdbDecmprColDataBatch(decodeList, nDecode, hdr->cmprAlg, hdr->nRow);
+      TSDB_CHECK_CODE(code, lino, _exit);
+    }
   }
 
 _exit:
   if (code) {
     TSDB_ERROR_LOG(TD_VID(reader->config->tsdb->pVnode), lino, code);
   }
+  if (decodeList != NULL) {
+    for (int32_t i = 0; i < nDecode; i++) {
+      tFree(decodeList[i].pIn);
+    }
+    taosMemoryFree(decodeList);
+  }
   return code;
 }
 
@@ -401,6 +524,26 @@ int32_t tsdbDataFileReadBlockSma(SDataFileReader *reader, const SBrinRecord *rec
 
   TARRAY2_CLEAR(columnDataAggArray, NULL);
   if (record->smaSize > 0) {
+    STsdb        *tsdb = reader->config->tsdb;
+    const STFile *smaFile = &reader->config->files[TSDB_FTYPE_SMA].file;
+    LRUHandle    *handle = NULL;
+
+    // repeated aggregations over the same blocks take the decoded sma from cache
+    code = tsdbCacheGetBlockSma(tsdb, smaFile->fid, smaFile->cid, record->smaOffset, &handle);
+    TSDB_CHECK_CODE(code, lino, _exit);
+
+    if (handle) {
+      SBlockSmaCacheVal *pVal = taosLRUCacheValue(tsdb->smaCache, handle);
+      for (int32_t i = 0; i < pVal->nSma; i++) {
+        code = TARRAY2_APPEND_PTR(columnDataAggArray, &pVal->aSma[i]);
+        if (code) break;
+      }
+
+      tsdbCacheRelease(tsdb->smaCache, handle);
+      TSDB_CHECK_CODE(code, lino, _exit);
+      goto _exit;
+    }
+
     code = tRealloc(&reader->config->bufArr[0], record->smaSize);
     TSDB_CHECK_CODE(code, lino, _exit);
 
@@ -418,6 +561,10 @@ int32_t tsdbDataFileReadBlockSma(SDataFileReader *reader, const SBrinRecord *rec
       TSDB_CHECK_CODE(code, lino, _exit);
     }
     ASSERT(size == record->smaSize);
+
+    code = tsdbCacheSetBlockSma(tsdb, smaFile->fid, smaFile->cid, record->smaOffset,
+                                TARRAY2_DATA(columnDataAggArray), TARRAY2_SIZE(columnDataAggArray));
+    TSDB_CHECK_CODE(code, lino, _exit);
   }
 
 _exit:
@@ -38,6 +38,9 @@ static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData,
 static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData, int64_t version,
                                         SSubmitTbData *pSubmitTbData, int32_t *affectedRows);
 
+static int32_t tsdbAppendRowChunk(SMemTable *pMemTable, STbData *pTbData, int64_t version, SRow **aRow, int32_t nRow);
+static int32_t tsdbAppendColChunk(SMemTable *pMemTable, STbData *pTbData, int64_t version, SBlockData *pBlockData);
+
 static int32_t tTbDataCmprFn(const SRBTreeNode *n1, const SRBTreeNode *n2) {
   STbData *tbData1 = TCONTAINER_OF(n1, STbData, rbtn);
   STbData *tbData2 = TCONTAINER_OF(n2, STbData, rbtn);
@@ -115,6 +118,15 @@ STbData *tsdbGetTbDataFromMemTable(SMemTable *pMemTable, tb_uid_t suid, tb_uid_t
   return pTbData;
 }
 
+// the tables of one submit request may be applied by several threads, so the memtable wide states are updated latched
+static void tsdbMemTableUpdateStat(SMemTable *pMemTable, STbData *pTbData, int64_t nRow) {
+  taosWLockLatch(&pMemTable->latch);
+  pMemTable->minKey = TMIN(pMemTable->minKey, pTbData->minKey);
+  pMemTable->maxKey = TMAX(pMemTable->maxKey, pTbData->maxKey);
+  pMemTable->nRow += nRow;
+  taosWUnLockLatch(&pMemTable->latch);
+}
+
 int32_t tsdbInsertTableData(STsdb *pTsdb, int64_t version, SSubmitTbData *pSubmitTbData, int32_t *affectedRows) {
   int32_t    code = 0;
   SMemTable *pMemTable = pTsdb->mem;
@@ -137,8 +149,10 @@ int32_t tsdbInsertTableData(STsdb *pTsdb, int64_t version, SSubmitTbData *pSubmi
   if (code) goto _err;
 
   // update
+  taosWLockLatch(&pMemTable->latch);
   pMemTable->minVer = TMIN(pMemTable->minVer, version);
   pMemTable->maxVer = TMAX(pMemTable->maxVer, version);
+  taosWUnLockLatch(&pMemTable->latch);
 
   return code;
 
@@ -241,6 +255,75 @@ void *tsdbTbDataIterDestroy(STbDataIter *pIter) {
   return NULL;
 }
 
+static FORCE_INLINE TSDBKEY tsdbMemChunkGetKey(SMemChunk *pChunk, int32_t iRow) {
+  TSDBKEY key = {.version = pChunk->version};
+  if (pChunk->flag == TSDBROW_ROW_FMT) {
+    key.ts = pChunk->aRow[iRow]->ts;
+  } else {
+    key.ts = pChunk->pBlockData->aTSKEY[iRow];
+  }
+  return key;
+}
+
+// position the chunk cursor at the first row >= pFrom, or the last row <= pFrom when backward
+static void tbDataMoveChunkTo(STbData *pTbData, TSDBKEY *pFrom, int8_t backward, STbDataIter *pIter) {
+  SMemChunk *pChunk;
+
+  if (backward) {
+    pChunk = (SMemChunk *)atomic_load_ptr(&pTbData->pChunkTail);
+    while (pChunk && pFrom && pChunk->minKey > pFrom->ts) {
+      pChunk = pChunk->prev;
+    }
+  } else {
+    pChunk = (SMemChunk *)atomic_load_ptr(&pTbData->pChunkHead);
+    while (pChunk && pFrom && pChunk->maxKey < pFrom->ts) {
+      pChunk = (SMemChunk *)atomic_load_ptr(&pChunk->next);
+    }
+  }
+
+  pIter->pChunk = pChunk;
+  if (pChunk == NULL) return;
+
+  if (pFrom == NULL) {
+    pIter->iChunkRow = backward ? pChunk->nRow - 1 : 0;
+    return;
+  }
+
+  // rows of a chunk are in strict ascending order of ts
+  int32_t lidx = 0, ridx = pChunk->nRow - 1;
+  while (lidx <= ridx) {
+    int32_t midx = (lidx + ridx) >> 1;
+    TSDBKEY key = tsdbMemChunkGetKey(pChunk, midx);
+    int32_t c = tsdbKeyCmprFn(&key, pFrom);
+    if (c == 0) {
+      lidx = ridx = midx;
+      break;
+    } else if (c < 0) {
+      lidx = midx + 1;
+    } else {
+      ridx = midx - 1;
+    }
+  }
+
+  if (backward) {
+    // ridx is the last row <= pFrom
+    if (ridx >= 0) {
+      pIter->iChunkRow = ridx;
+    } else {
+      pIter->pChunk = pChunk->prev;
+      if (pIter->pChunk) pIter->iChunkRow = pIter->pChunk->nRow - 1;
+    }
+  } else {
+    // lidx is the first row >= pFrom
+    if (lidx < pChunk->nRow) {
+      pIter->iChunkRow = lidx;
+    } else {
+      pIter->pChunk = (SMemChunk *)atomic_load_ptr(&pChunk->next);
+      pIter->iChunkRow = 0;
+    }
+  }
+}
+
 void tsdbTbDataIterOpen(STbData *pTbData, TSDBKEY *pFrom, int8_t backward, STbDataIter *pIter) {
   SMemSkipListNode *pos[SL_MAX_LEVEL];
   SMemSkipListNode *pHead;
@@ -251,6 +334,7 @@ void tsdbTbDataIterOpen(STbData *pTbData, TSDBKEY *pFrom, int8_t backward, STbDa
   pIter->pTbData = pTbData;
   pIter->backward = backward;
   pIter->pRow = NULL;
+  pIter->fromChunk = 0;
   if (pFrom == NULL) {
     // create from head or tail
     if (backward) {
@@ -268,31 +352,60 @@ void tsdbTbDataIterOpen(STbData *pTbData, TSDBKEY *pFrom, int8_t backward, STbDa
       pIter->pNode = SL_GET_NODE_FORWARD(pos[0], 0);
     }
   }
+
+  tbDataMoveChunkTo(pTbData, pFrom, backward, pIter);
+}
+
+static bool tsdbTbDataIterNextChunkRow(STbDataIter *pIter) {
+  if (pIter->backward) {
+    if (--pIter->iChunkRow < 0) {
+      pIter->pChunk = pIter->pChunk->prev;
+      if (pIter->pChunk) pIter->iChunkRow = pIter->pChunk->nRow - 1;
+    }
+  } else {
+    if (++pIter->iChunkRow >= pIter->pChunk->nRow) {
+      pIter->pChunk = (SMemChunk *)atomic_load_ptr(&pIter->pChunk->next);
+      pIter->iChunkRow = 0;
+    }
+  }
+
+  if (pIter->pChunk) return true;
+  if (pIter->backward) return pIter->pNode != pIter->pTbData->sl.pHead;
+  return pIter->pNode != pIter->pTbData->sl.pTail;
 }
 
 bool tsdbTbDataIterNext(STbDataIter *pIter) {
+  if (pIter->pChunk) {
+    // find out which cursor the current row is at
+    if (tsdbTbDataIterGet(pIter) == NULL) return false;
+    if (pIter->fromChunk) {
+      pIter->pRow = NULL;
+      return tsdbTbDataIterNextChunkRow(pIter);
+    }
+  }
+
   pIter->pRow = NULL;
   if (pIter->backward) {
     ASSERT(pIter->pNode != pIter->pTbData->sl.pTail);
 
     if (pIter->pNode == pIter->pTbData->sl.pHead) {
-      return false;
+      return pIter->pChunk != NULL;
     }
 
     pIter->pNode = SL_GET_NODE_BACKWARD(pIter->pNode, 0);
     if (pIter->pNode == pIter->pTbData->sl.pHead) {
-      return false;
+      return pIter->pChunk != NULL;
     }
   } else {
     ASSERT(pIter->pNode != pIter->pTbData->sl.pHead);
 
     if (pIter->pNode == pIter->pTbData->sl.pTail) {
-      return false;
+      return pIter->pChunk != NULL;
     }
 
     pIter->pNode = SL_GET_NODE_FORWARD(pIter->pNode, 0);
     if (pIter->pNode == pIter->pTbData->sl.pTail) {
-      return false;
+      return pIter->pChunk != NULL;
     }
   }
 
@@ -312,7 +425,7 @@ int64_t tsdbCountTbDataRows(STbData *pTbData) {
     rowsNum++;
   }
 
-  return rowsNum;
+  return rowsNum + pTbData->nChunkRow;
 }
 
 void tsdbMemTableCountRows(SMemTable *pMemTable, SSHashObj *pTableMap, int64_t *rowsNum) {
@@ -369,7 +482,7 @@ static int32_t tsdbGetOrCreateTbData(SMemTable *pMemTable, tb_uid_t suid, tb_uid
   int32_t code = 0;
 
   // get
-  STbData *pTbData = tsdbGetTbDataFromMemTableImpl(pMemTable, suid, uid);
+  STbData *pTbData = tsdbGetTbDataFromMemTable(pMemTable, suid, uid);
   if (pTbData) goto _exit;
 
   // create
@@ -396,6 +509,9 @@ static int32_t tsdbGetOrCreateTbData(SMemTable *pMemTable, tb_uid_t suid, tb_uid
   pTbData->sl.pTail = (SMemSkipListNode *)POINTER_SHIFT(pTbData->sl.pHead, SL_NODE_SIZE(maxLevel));
   pTbData->sl.pHead->level = maxLevel;
   pTbData->sl.pTail->level = maxLevel;
+  pTbData->pChunkHead = NULL;
+  pTbData->pChunkTail = NULL;
+  pTbData->nChunkRow = 0;
   for (int8_t iLevel = 0; iLevel < maxLevel; iLevel++) {
     SL_NODE_FORWARD(pTbData->sl.pHead, iLevel) = pTbData->sl.pTail;
     SL_NODE_BACKWARD(pTbData->sl.pTail, iLevel) = pTbData->sl.pHead;
@@ -407,6 +523,14 @@ static int32_t tsdbGetOrCreateTbData(SMemTable *pMemTable, tb_uid_t suid, tb_uid
 
   taosWLockLatch(&pMemTable->latch);
 
+  // created by another apply thread in the meantime
+  STbData *pExist = tsdbGetTbDataFromMemTableImpl(pMemTable, suid, uid);
+  if (pExist) {
+    taosWUnLockLatch(&pMemTable->latch);
+    pTbData = pExist;
+    goto _exit;
+  }
+
   if (pMemTable->nTbData >= pMemTable->nBucket) {
     code = tsdbMemTableRehash(pMemTable);
     if (code) {
@@ -602,6 +726,97 @@ _exit:
   return code;
 }
 
+// rows may go to a chunk when they are all after the table's last row, in strict order
+static bool tsdbRowDataInOrderAfter(SRow **aRow, int32_t nRow, TSKEY maxKey) {
+  for (int32_t iRow = 0; iRow < nRow; iRow++) {
+    if (aRow[iRow]->ts <= maxKey) return false;
+    maxKey = aRow[iRow]->ts;
+  }
+  return true;
+}
+
+static bool tsdbColDataInOrderAfter(SBlockData *pBlockData, TSKEY maxKey) {
+  for (int32_t iRow = 0; iRow < pBlockData->nRow; iRow++) {
+    if (pBlockData->aTSKEY[iRow] <= maxKey) return false;
+    maxKey = pBlockData->aTSKEY[iRow];
+  }
+  return true;
+}
+
+static void tsdbAppendChunk(SMemTable *pMemTable, STbData *pTbData, SMemChunk *pChunk, TSDBROW *pLastRow) {
+  // publish the chunk after it is complete, readers walk the list without locks
+  pChunk->next = NULL;
+  pChunk->prev = pTbData->pChunkTail;
+  if (pTbData->pChunkTail) {
+    atomic_store_ptr(&pTbData->pChunkTail->next, pChunk);
+  } else {
+    atomic_store_ptr(&pTbData->pChunkHead, pChunk);
+  }
+  atomic_store_ptr(&pTbData->pChunkTail, pChunk);
+  pTbData->nChunkRow += pChunk->nRow;
+
+  pTbData->minKey = TMIN(pTbData->minKey, pChunk->minKey);
+  pTbData->maxKey = pChunk->maxKey;
+
+  if (!TSDB_CACHE_NO(pMemTable->pTsdb->pVnode->config)) {
+    tsdbCacheUpdate(pMemTable->pTsdb, pTbData->suid, pTbData->uid, pLastRow);
+  }
+
+  tsdbMemTableUpdateStat(pMemTable, pTbData, pChunk->nRow);
+}
+
+static int32_t tsdbAppendRowChunk(SMemTable *pMemTable, STbData *pTbData, int64_t version, SRow **aRow, int32_t nRow) {
+  SVBufPool *pPool = pMemTable->pTsdb->pVnode->inUse;
+  int64_t    size = sizeof(SMemChunk) + sizeof(SRow *) * nRow;
+
+  for (int32_t iRow = 0; iRow < nRow; iRow++) {
+    size += ALIGN_NUM(aRow[iRow]->len, 8);
+  }
+
+  SMemChunk *pChunk = vnodeBufPoolMallocAligned(pPool, size);
+  if (pChunk == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pChunk->flag = TSDBROW_ROW_FMT;
+  pChunk->nRow = nRow;
+  pChunk->version = version;
+  pChunk->minKey = aRow[0]->ts;
+  pChunk->maxKey = aRow[nRow - 1]->ts;
+  pChunk->aRow = (SRow **)&pChunk[1];
+
+  uint8_t *pData = (uint8_t *)&pChunk->aRow[nRow];
+  for (int32_t iRow = 0; iRow < nRow; iRow++) {
+    pChunk->aRow[iRow] = (SRow *)pData;
+    memcpy(pData, aRow[iRow], aRow[iRow]->len);
+    pData += ALIGN_NUM(aRow[iRow]->len, 8);
+  }
+
+  TSDBROW lRow = tsdbRowFromTSRow(version, pChunk->aRow[nRow - 1]);
+  tsdbAppendChunk(pMemTable, pTbData, pChunk, &lRow);
+  return 0;
+}
+
+static int32_t tsdbAppendColChunk(SMemTable *pMemTable, STbData *pTbData, int64_t version, SBlockData *pBlockData) {
+  SVBufPool *pPool = pMemTable->pTsdb->pVnode->inUse;
+
+  SMemChunk *pChunk = vnodeBufPoolMallocAligned(pPool, sizeof(SMemChunk));
+  if (pChunk == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pChunk->flag = TSDBROW_COL_FMT;
+  pChunk->nRow = pBlockData->nRow;
+  pChunk->version = version;
+  pChunk->minKey = pBlockData->aTSKEY[0];
+  pChunk->maxKey = pBlockData->aTSKEY[pBlockData->nRow - 1];
+  pChunk->pBlockData = pBlockData;
+
+  TSDBROW lRow = tBlockDataLastRow(pBlockData);
+  tsdbAppendChunk(pMemTable, pTbData, pChunk, &lRow);
+  return 0;
+}
+
 static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData, int64_t version,
                                         SSubmitTbData *pSubmitTbData, int32_t *affectedRows) {
   int32_t code = 0;
@@ -653,6 +868,13 @@ static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData,
     if (code) goto _exit;
   }
 
+  if (tsMemTableChunk && tsdbColDataInOrderAfter(pBlockData, pTbData->maxKey)) {
+    code = tsdbAppendColChunk(pMemTable, pTbData, version, pBlockData);
+    if (code) goto _exit;
+    if (affectedRows) *affectedRows = pBlockData->nRow;
+    goto _exit;
+  }
+
   // loop to add each row to the skiplist
   SMemSkipListNode *pos[SL_MAX_LEVEL];
   TSDBROW           tRow = tsdbRowFromBlockData(pBlockData, 0);
@@ -695,9 +917,7 @@ static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData,
   }
 
   // SMemTable
-  pMemTable->minKey = TMIN(pMemTable->minKey, pTbData->minKey);
-  pMemTable->maxKey = TMAX(pMemTable->maxKey, pTbData->maxKey);
-  pMemTable->nRow += pBlockData->nRow;
+  tsdbMemTableUpdateStat(pMemTable, pTbData, pBlockData->nRow);
 
   if (affectedRows) *affectedRows = pBlockData->nRow;
 
@@ -717,6 +937,13 @@ static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData,
   int32_t           iRow = 0;
   TSDBROW           lRow;
 
+  if (tsMemTableChunk && tsdbRowDataInOrderAfter(aRow, nRow, pTbData->maxKey)) {
+    code = tsdbAppendRowChunk(pMemTable, pTbData, version, aRow, nRow);
+    if (code) goto _exit;
+    if (affectedRows) *affectedRows = nRow;
+    goto _exit;
+  }
+
   // backward put first data
   tRow.pTSRow = aRow[iRow++];
   key.ts = tRow.pTSRow->ts;
@@ -758,9 +985,7 @@ static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData,
   }
 
   // SMemTable
-  pMemTable->minKey = TMIN(pMemTable->minKey, pTbData->minKey);
-  pMemTable->maxKey = TMAX(pMemTable->maxKey, pTbData->maxKey);
-  pMemTable->nRow += nRow;
+  tsdbMemTableUpdateStat(pMemTable, pTbData, nRow);
 
   if (affectedRows) *affectedRows = nRow;
 
@@ -768,7 +993,7 @@ _exit:
   return code;
 }
 
-int32_t tsdbGetNRowsInTbData(STbData *pTbData) { return pTbData->sl.size; }
+int32_t tsdbGetNRowsInTbData(STbData *pTbData) { return pTbData->sl.size + pTbData->nChunkRow; }
 
 int32_t tsdbRefMemTable(SMemTable *pMemTable, SQueryNode *pQNode) {
   int32_t code = 0;
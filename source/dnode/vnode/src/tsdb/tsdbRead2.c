@@ -25,6 +25,10 @@
 #define ASCENDING_TRAVERSE(o)       (o == TSDB_ORDER_ASC)
 #define getCurrentKeyInSttBlock(_r) ((_r)->currentKey)
 
+// stop loading predicate columns ahead, if less than 1/LATE_LOAD_MIN_DROP_RATIO of the probed blocks are dropped
+#define LATE_LOAD_PROBE_BLOCKS   32
+#define LATE_LOAD_MIN_DROP_RATIO 8
+
 typedef struct {
   bool overlapWithNeighborBlock;
   bool hasDupTs;
@@ -1094,8 +1098,8 @@ static FORCE_INLINE STSchema* getTableSchemaImpl(STsdbReader* pReader, uint64_t
   return pReader->info.pSchema;
 }
 
-static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData,
-                                   uint64_t uid) {
+static int32_t doLoadFileBlockColumns(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData,
+                                     uint64_t uid, int16_t* cids, int32_t numOfCids) {
   int32_t   code = 0;
   STSchema* pSchema = pReader->info.pSchema;
   int64_t   st = taosGetTimestampUs();
@@ -1110,15 +1114,13 @@ static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockI
     }
   }
 
-  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
   SFileDataBlockInfo* pBlockInfo = getCurrentBlockInfo(pBlockIter);
   SFileBlockDumpInfo* pDumpInfo = &pReader->status.fBlockDumpInfo;
 
   SBrinRecord tmp;
   blockInfoToRecord(&tmp, pBlockInfo);
   SBrinRecord* pRecord = &tmp;
-  code = tsdbDataFileReadBlockDataByColumn(pReader->pFileReader, pRecord, pBlockData, pSchema, &pSup->colId[1],
-                                           pSup->numOfCols - 1);
+  code = tsdbDataFileReadBlockDataByColumn(pReader->pFileReader, pRecord, pBlockData, pSchema, cids, numOfCids);
   if (code != TSDB_CODE_SUCCESS) {
     tsdbError("%p error occurs in loading file block, global index:%d, table index:%d, brange:%" PRId64 "-%" PRId64
               ", rows:%d, code:%s %s",
@@ -1140,6 +1142,12 @@ static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockI
   return TSDB_CODE_SUCCESS;
 }
 
+static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData,
+                                   uint64_t uid) {
+  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
+  return doLoadFileBlockColumns(pReader, pBlockIter, pBlockData, uid, &pSup->colId[1], pSup->numOfCols - 1);
+}
+
 /**
  * This is an two rectangles overlap cases.
  */
@@ -2789,6 +2797,39 @@ static bool notOverlapWithFiles(SFileDataBlockInfo* pBlockInfo, STableBlockScanI
   }
 }
 
+// Drop a file block that has to be loaded and merged when the block SMA proves that no row in it satisfies the filter
+// of the scan. It is only safe when no other data source (neighbor block, stt files or buffer) has rows to be merged
+// with the block, since a row version in the dropped block could shadow an older row somewhere else.
+static bool fileBlockFilteredOut(STsdbReader* pReader, SFileDataBlockInfo* pBlockInfo, STableBlockScanInfo* pScanInfo,
+                                 TSDBKEY keyInBuf) {
+  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
+  bool                asc = ASCENDING_TRAVERSE(pReader->info.order);
+
+  if (pReader->pFilterInfo == NULL || (!pSup->smaValid) || pReader->type == TIMEWINDOW_RANGE_EXTERNAL) {
+    return false;
+  }
+
+  SDataBlockToLoadInfo info = {0};
+  getBlockToLoadInfo(&info, pBlockInfo, pScanInfo, keyInBuf, pReader);
+  if (info.overlapWithNeighborBlock || info.hasDupTs || info.overlapWithKeyInBuf || info.overlapWithSttBlock ||
+      bufferDataInFileBlockGap(keyInBuf, pBlockInfo, pScanInfo, pReader->info.order) ||
+      !notOverlapWithFiles(pBlockInfo, pScanInfo, asc)) {
+    return false;
+  }
+
+  SBrinRecord record;
+  blockInfoToRecord(&record, pBlockInfo);
+
+  TARRAY2_CLEAR(&pSup->colAggArray, 0);
+  int32_t code = tsdbDataFileReadBlockSma(pReader->pFileReader, &record, &pSup->colAggArray);
+  if (code != TSDB_CODE_SUCCESS || TARRAY2_SIZE(&pSup->colAggArray) == 0) {
+    return false;
+  }
+
+  pReader->cost.smaDataLoad += 1;
+  return blockSmaFilteredOut(pReader->pFilterInfo, &pSup->colAggArray, pBlockInfo->numRow);
+}
+
 static int32_t doBuildDataBlock(STsdbReader* pReader) {
   SReaderStatus*       pStatus = &pReader->status;
   SDataBlockIter*      pBlockIter = &pStatus->blockIter;
@@ -2818,6 +2859,17 @@ static int32_t doBuildDataBlock(STsdbReader* pReader) {
 
   TSDBKEY keyInBuf = getCurrentKeyInBuf(pScanInfo, pReader);
   if (fileBlockShouldLoad(pReader, pBlockInfo, pScanInfo, keyInBuf)) {
+    if (fileBlockFilteredOut(pReader, pBlockInfo, pScanInfo, keyInBuf)) {
+      setBlockAllDumped(&pStatus->fBlockDumpInfo, pBlockInfo->lastKey, pReader->info.order);
+      pScanInfo->lastProcKey = asc ? pBlockInfo->lastKey : pBlockInfo->firstKey;
+      pReader->cost.filterOutBlocks += 1;
+
+      tsdbDebug("%p uid:%" PRIu64 " file block filtered out by SMA, brange:%" PRId64 "-%" PRId64 " rows:%d, %s",
+                pReader, pScanInfo->uid, pBlockInfo->firstKey, pBlockInfo->lastKey, pBlockInfo->numRow,
+                pReader->idStr);
+      return code;
+    }
+
     code = doLoadFileBlockData(pReader, pBlockIter, &pStatus->fileBlockData, pScanInfo->uid);
     if (code != TSDB_CODE_SUCCESS) {
       return code;
@@ -4139,6 +4191,8 @@ void tsdbReaderClose2(STsdbReader* pReader) {
   }
 
   taosMemoryFree(pSupInfo->colId);
+  taosMemoryFree(pReader->lateLoad.colId);
+  tBlockDataDestroy(&pReader->lateLoad.deferData);
   tBlockDataDestroy(&pReader->status.fileBlockData);
   cleanupDataBlockIterator(&pReader->status.blockIter);
 
@@ -4180,13 +4234,15 @@ void tsdbReaderClose2(STsdbReader* pReader) {
       ", fileBlocks-load-time:%.2f ms, "
       "build in-memory-block-time:%.2f ms, sttBlocks:%" PRId64 ", sttBlocks-time:%.2f ms, sttStatisBlock:%" PRId64
       ", stt-statis-Block-time:%.2f ms, composed-blocks:%" PRId64
-      ", composed-blocks-time:%.2fms, STableBlockScanInfo size:%.2f Kb, createTime:%.2f ms,createSkylineIterTime:%.2f "
+      ", composed-blocks-time:%.2fms, filter-out-blocks:%" PRId64 ", late-filter-out-blocks:%" PRId64
+      ", STableBlockScanInfo size:%.2f Kb, createTime:%.2f ms,createSkylineIterTime:%.2f "
       "ms, initSttBlockReader:%.2fms, %s",
       pReader, pCost->headFileLoad, pCost->headFileLoadTime, pCost->smaDataLoad, pCost->smaLoadTime, pCost->numOfBlocks,
       pCost->blockLoadTime, pCost->buildmemBlock, pCost->sttCost.loadBlocks, pCost->sttCost.blockElapsedTime,
       pCost->sttCost.loadStatisBlocks, pCost->sttCost.statisElapsedTime, pCost->composedBlocks,
-      pCost->buildComposedBlockTime, numOfTables * sizeof(STableBlockScanInfo) / 1000.0, pCost->createScanInfoList,
-      pCost->createSkylineIterTime, pCost->initSttBlockReader, pReader->idStr);
+      pCost->buildComposedBlockTime, pCost->filterOutBlocks, pCost->lateFilterOutBlocks,
+      numOfTables * sizeof(STableBlockScanInfo) / 1000.0, pCost->createScanInfoList, pCost->createSkylineIterTime,
+      pCost->initSttBlockReader, pReader->idStr);
 
   taosMemoryFree(pReader->idStr);
 
@@ -4714,6 +4770,71 @@ int32_t tsdbRetrieveDatablockSMA2(STsdbReader* pReader, SSDataBlock* pDataBlock,
   return code;
 }
 
+// Load the predicate columns of current file block only, and apply the scan filter on them. The remaining columns are
+// not loaded at all if no rows survive, and they are left to be NULL in the result block, which is going to be removed
+// entirely by the filter of the scan operator. Otherwise only the remaining columns are loaded, and they are moved into
+// the file block data next to the predicate columns.
+static int32_t doLoadFileBlockByPredicate(STsdbReader* pReader, uint64_t uid, bool* pDropped) {
+  SBlockLateLoadInfo* pLate = &pReader->lateLoad;
+  SReaderStatus*      pStatus = &pReader->status;
+  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
+  SSDataBlock*        pResBlock = pReader->resBlockInfo.pResBlock;
+  SFileBlockDumpInfo  dumpInfo = pStatus->fBlockDumpInfo;
+
+  *pDropped = false;
+
+  int32_t code = doLoadFileBlockColumns(pReader, &pStatus->blockIter, &pStatus->fileBlockData, uid, pLate->colId,
+                                        pLate->numOfCols);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
+  code = copyBlockDataToSDataBlock(pReader);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
+  // no qualified rows in current block, no need to load the remaining columns either
+  if (pResBlock->info.rows == 0) {
+    *pDropped = true;
+    return code;
+  }
+
+  code = blockRowsFilteredOut(pReader->pFilterInfo, pResBlock, pDropped);
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
+  pLate->numOfProbe += 1;
+  if (*pDropped) {
+    pLate->numOfDrop += 1;
+    pReader->cost.lateFilterOutBlocks += 1;
+  } else {
+    // rewind the dump position, and discard the copied predicate columns before loading the deferred ones
+    pStatus->fBlockDumpInfo = dumpInfo;
+    for (int32_t i = 0; i < pSup->numOfCols; ++i) {
+      colInfoDataCleanup(taosArrayGet(pResBlock->pDataBlock, pSup->slotId[i]), pResBlock->info.capacity);
+    }
+
+    code = doLoadFileBlockColumns(pReader, &pStatus->blockIter, &pLate->deferData, uid, pLate->deferColId,
+                                  pLate->numOfDeferCols);
+    if (code == TSDB_CODE_SUCCESS) {
+      code = tBlockDataMoveColData(&pStatus->fileBlockData, &pLate->deferData);
+    }
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
+  }
+
+  if (pLate->numOfProbe >= LATE_LOAD_PROBE_BLOCKS && pLate->numOfDrop * LATE_LOAD_MIN_DROP_RATIO < pLate->numOfProbe) {
+    pLate->enabled = false;
+    tsdbDebug("%p disable late load of file blocks, %d of %d probed blocks dropped, %s", pReader, pLate->numOfDrop,
+              pLate->numOfProbe, pReader->idStr);
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 static SSDataBlock* doRetrieveDataBlock(STsdbReader* pReader) {
   SReaderStatus*      pStatus = &pReader->status;
   int32_t             code = TSDB_CODE_SUCCESS;
@@ -4728,7 +4849,16 @@ static SSDataBlock* doRetrieveDataBlock(STsdbReader* pReader) {
     return NULL;
   }
 
-  code = doLoadFileBlockData(pReader, &pStatus->blockIter, &pStatus->fileBlockData, pBlockScanInfo->uid);
+  if (pReader->lateLoad.enabled) {
+    bool dropped = false;
+    code = doLoadFileBlockByPredicate(pReader, pBlockScanInfo->uid, &dropped);
+    if (code == TSDB_CODE_SUCCESS && dropped) {
+      return pReader->resBlockInfo.pResBlock;
+    }
+  } else {
+    code = doLoadFileBlockData(pReader, &pStatus->blockIter, &pStatus->fileBlockData, pBlockScanInfo->uid);
+  }
+
   if (code != TSDB_CODE_SUCCESS) {
     tBlockDataReset(&pStatus->fileBlockData);
     terrno = code;
@@ -5182,6 +5312,82 @@ void tsdbReaderSetCloseFlag(STsdbReader* pReader) { /*pReader->code = TSDB_CODE_
 
 void tsdbSetFilesetDelimited(STsdbReader* pReader) { pReader->bFilesetDelimited = true; }
 
+// find out the loaded columns that the filter refers to, and enable the late load of the other columns only if the
+// filter refers to none but the columns loaded from file blocks, e.g. no tags, and some columns are left to be
+// deferred.
+static void initLateLoadInfo(STsdbReader* pReader) {
+  SBlockLateLoadInfo* pLate = &pReader->lateLoad;
+  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
+
+  taosMemoryFreeClear(pLate->colId);
+  pLate->deferColId = NULL;
+  pLate->numOfCols = 0;
+  pLate->numOfDeferCols = 0;
+  pLate->enabled = false;
+
+  if (pReader->pFilterInfo == NULL || pReader->type == TIMEWINDOW_RANGE_EXTERNAL || pSup->numOfCols <= 1) {
+    return;
+  }
+
+  SArray* pSlotIds = taosArrayInit(4, sizeof(int16_t));
+  if (pSlotIds == NULL) {
+    return;
+  }
+
+  int32_t code = filterGetColSlotIds(pReader->pFilterInfo, pSlotIds);
+  int32_t numOfSlots = taosArrayGetSize(pSlotIds);
+  if (code != TSDB_CODE_SUCCESS || numOfSlots == 0) {
+    goto _end;
+  }
+
+  pLate->colId = taosMemoryMalloc(pSup->numOfCols * 2 * sizeof(int16_t));
+  if (pLate->colId == NULL) {
+    goto _end;
+  }
+  pLate->deferColId = pLate->colId + pSup->numOfCols;
+
+  // follow the order of the loaded columns, so both lists of column ids are in ascending order as well
+  int32_t numOfMatched = 0;
+  for (int32_t i = 0; i < pSup->numOfCols; ++i) {
+    bool predicate = false;
+    for (int32_t j = 0; j < numOfSlots; ++j) {
+      if (*(int16_t*)taosArrayGet(pSlotIds, j) == pSup->slotId[i]) {
+        predicate = true;
+        numOfMatched += 1;
+        break;
+      }
+    }
+
+    if (pSup->colId[i] == PRIMARYKEY_TIMESTAMP_COL_ID) {
+      continue;
+    } else if (predicate) {
+      pLate->colId[pLate->numOfCols++] = pSup->colId[i];
+    } else {
+      pLate->deferColId[pLate->numOfDeferCols++] = pSup->colId[i];
+    }
+  }
+
+  if (numOfMatched < numOfSlots || pLate->numOfDeferCols == 0) {
+    taosMemoryFreeClear(pLate->colId);
+    pLate->deferColId = NULL;
+    pLate->numOfCols = 0;
+    pLate->numOfDeferCols = 0;
+    goto _end;
+  }
+
+  pLate->enabled = true;
+  tsdbDebug("%p enable late load of file blocks, %d predicate columns out of %d, %s", pReader, pLate->numOfCols,
+            pSup->numOfCols - 1, pReader->idStr);
+
+_end:
+  taosArrayDestroy(pSlotIds);
+}
+
+void tsdbReaderSetFilter(STsdbReader* pReader, void* pFilterInfo) {
+  pReader->pFilterInfo = pFilterInfo;
+  initLateLoadInfo(pReader);
+}
+
 void tsdbReaderSetNotifyCb(STsdbReader* pReader, TsdReaderNotifyCbFn notifyFn, void* param) {
   pReader->notifyFn = notifyFn;
   pReader->notifyParam = param;
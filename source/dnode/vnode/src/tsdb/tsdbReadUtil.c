@@ -1072,4 +1072,46 @@ bool overlapWithDelSkylineWithoutVer(STableBlockScanInfo* pBlockScanInfo, const
 
     return doCheckDatablockOverlapWithoutVersion(pBlockScanInfo, pRecord, index);
   }
-}
\ No newline at end of file
+}
+// Check the block SMA of a block with numOfRows rows against the filter, return true if it proves that no row of the
+// block satisfies the filter. Columns without SMA never drop the block.
+bool blockSmaFilteredOut(SFilterInfo* pFilterInfo, TColumnDataAggArray* pAggArray, int32_t numOfRows) {
+  int32_t num = TARRAY2_SIZE(pAggArray);
+  if (pFilterInfo == NULL || num == 0) {
+    return false;
+  }
+
+  SColumnDataAgg** pAggList = taosMemoryMalloc(num * POINTER_BYTES);
+  if (pAggList == NULL) {
+    return false;
+  }
+
+  for (int32_t i = 0; i < num; ++i) {
+    pAggList[i] = TARRAY2_GET_PTR(pAggArray, i);
+  }
+
+  bool keep = filterRangeExecute(pFilterInfo, pAggList, num, numOfRows);
+  taosMemoryFree(pAggList);
+  return !keep;
+}
+
+// Apply the filter on the rows of pBlock, pFilteredOut is set if none of them qualifies.
+int32_t blockRowsFilteredOut(SFilterInfo* pFilterInfo, SSDataBlock* pBlock, bool* pFilteredOut) {
+  SFilterColumnParam param = {.numOfCols = taosArrayGetSize(pBlock->pDataBlock), .pDataBlock = pBlock->pDataBlock};
+  SColumnInfoData*   p = NULL;
+  int32_t            status = 0;
+
+  *pFilteredOut = false;
+
+  int32_t code = filterSetDataFromSlotId(pFilterInfo, &param);
+  if (code == TSDB_CODE_SUCCESS) {
+    code = filterExecute(pFilterInfo, pBlock, &p, NULL, param.numOfCols, &status);
+  }
+
+  colDataDestroy(p);
+  taosMemoryFree(p);
+  if (code == TSDB_CODE_SUCCESS) {
+    *pFilteredOut = (status == FILTER_RESULT_NONE_QUALIFIED);
+  }
+  return code;
+}
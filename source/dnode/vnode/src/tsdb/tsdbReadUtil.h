@@ -123,6 +123,8 @@ typedef struct SReadCostSummary {
   SSttBlockLoadCostInfo sttCost;
   int64_t composedBlocks;
   double  buildComposedBlockTime;
+  int64_t filterOutBlocks;
+  int64_t lateFilterOutBlocks;
   double  createScanInfoList;
   double  createSkylineIterTime;
   double  initSttBlockReader;
@@ -161,6 +163,18 @@ typedef struct SBlockLoadSuppInfo {
   bool                smaValid;  // the sma on all queried columns are activated
 } SBlockLoadSuppInfo;
 
+// the columns that the scan filter refers to are loaded and filtered ahead of the others in a clean file block
+typedef struct SBlockLateLoadInfo {
+  int16_t*   colId;       // predicate column ids in ascending order, the primary timestamp excluded
+  int32_t    numOfCols;
+  int16_t*   deferColId;  // the other loaded column ids in ascending order, in the same allocation as colId
+  int32_t    numOfDeferCols;
+  SBlockData deferData;   // the deferred columns of a block that survives, moved into the file block data
+  int32_t    numOfProbe;  // blocks that have been loaded in two phases
+  int32_t    numOfDrop;   // blocks of which no row survives the filter on predicate columns
+  bool       enabled;
+} SBlockLateLoadInfo;
+
 // each blocks in stt file not overlaps with in-memory/data-file/tomb-files, and not overlap with any other blocks in stt-file
 typedef struct SSttBlockReader {
   STimeWindow        window;
@@ -267,6 +281,8 @@ struct STsdbReader {
   bool                 bFilesetDelimited;   // duration by duration output
   TsdReaderNotifyCbFn  notifyFn;
   void*              notifyParam;
+  SFilterInfo*       pFilterInfo;   // the filter of the scan, to drop whole file blocks by SMA before loading them
+  SBlockLateLoadInfo lateLoad;
 };
 
 typedef struct SBrinRecordIter {
@@ -316,6 +332,8 @@ int32_t tsdbGetRowsInSttFiles(STFileSet* pFileSet, SArray* pSttFileBlockIterArra
                               const char* pstr);
 bool    isCleanSttBlock(SArray* pTimewindowList, STimeWindow* pQueryWindow, STableBlockScanInfo* pScanInfo, int32_t order);
 bool    overlapWithDelSkyline(STableBlockScanInfo* pBlockScanInfo, const SBrinRecord* pRecord, int32_t order);
+bool    blockSmaFilteredOut(SFilterInfo* pFilterInfo, TColumnDataAggArray* pAggArray, int32_t numOfRows);
+int32_t blockRowsFilteredOut(SFilterInfo* pFilterInfo, SSDataBlock* pBlock, bool* pFilteredOut);
 
 typedef struct {
   SArray* pTombData;
@@ -73,6 +73,13 @@ static int32_t tsdbOpenFileImpl(STsdbFD *pFD) {
     goto _exit;
   }
 
+  if ((flag & TD_FILE_WRITE) && !pFD->s3File && tsAsyncWriteDepth > 0) {
+    if (taosAioOpen(tsAsyncWriteDepth, szPage, &pFD->pAio) < 0) {
+      code = TAOS_SYSTEM_ERROR(errno);
+      goto _exit;
+    }
+  }
+
   // not check file size when reading data files.
   if (flag != TD_FILE_READ && !pFD->s3File) {
     if (taosStatFile(path, &pFD->szFile, NULL, NULL) < 0) {
@@ -123,6 +130,10 @@ void tsdbCloseFile(STsdbFD **ppFD) {
   STsdbFD *pFD = *ppFD;
   if (pFD) {
     taosMemoryFree(pFD->pBuf);
+    // committed files are flushed by tsdbFsyncFile, only writes of an aborted file can still be pending here
+    if (taosAioClose(&pFD->pAio) < 0) {
+      tsdbError("failed to flush async writes of file %s since %s", pFD->path, strerror(errno));
+    }
     if (!pFD->s3File) {
       taosCloseFile(&pFD->pFD);
     }
@@ -145,7 +156,18 @@ static int32_t tsdbWriteFilePage(STsdbFD *pFD) {
     tsdbWarn("%s file: %s", __func__, pFD->path);
     return code;
   }
-  if (pFD->pgno > 0) {
+  if (pFD->pgno > 0 && pFD->pAio) {
+    taosCalcChecksumAppend(0, pFD->pBuf, pFD->szPage);
+
+    if (taosAioPWriteFile(pFD->pAio, pFD->pFD, pFD->pBuf, pFD->szPage, PAGE_OFFSET(pFD->pgno, pFD->szPage)) < 0) {
+      code = TAOS_SYSTEM_ERROR(errno);
+      goto _exit;
+    }
+
+    if (pFD->szFile < pFD->pgno) {
+      pFD->szFile = pFD->pgno;
+    }
+  } else if (pFD->pgno > 0) {
     int64_t n = taosLSeekFile(pFD->pFD, PAGE_OFFSET(pFD->pgno, pFD->szPage), SEEK_SET);
     if (n < 0) {
       code = TAOS_SYSTEM_ERROR(errno);
@@ -203,6 +225,12 @@ static int32_t tsdbReadFilePage(STsdbFD *pFD, int64_t pgno) {
 
     tsdbCacheRelease(pFD->pTsdb->bCache, handle);
   } else {
+    // the page may still be in flight
+    if (pFD->pAio && taosAioFlush(pFD->pAio) < 0) {
+      code = TAOS_SYSTEM_ERROR(errno);
+      goto _exit;
+    }
+
     // seek
     int64_t n = taosLSeekFile(pFD->pFD, offset, SEEK_SET);
     if (n < 0) {
@@ -424,6 +452,11 @@ int32_t tsdbFsyncFile(STsdbFD *pFD) {
   code = tsdbWriteFilePage(pFD);
   if (code) goto _exit;
 
+  if (pFD->pAio && taosAioFlush(pFD->pAio) < 0) {
+    code = TAOS_SYSTEM_ERROR(errno);
+    goto _exit;
+  }
+
   if (taosFsyncFile(pFD->pFD) < 0) {
     code = TAOS_SYSTEM_ERROR(errno);
     goto _exit;
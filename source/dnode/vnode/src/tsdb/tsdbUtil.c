@@ -388,7 +388,7 @@ int32_t tPutBlockCol(uint8_t *p, void *ph) {
 
   n += tPutI16v(p ? p + n : p, pBlockCol->cid);
   n += tPutI8(p ? p + n : p, pBlockCol->type);
-  n += tPutI8(p ? p + n : p, pBlockCol->smaOn);
+  n += tPutI8(p ? p + n : p, (pBlockCol->smaOn ? TSDB_BLOCK_COL_SMA_ON : 0) | (pBlockCol->dict ? TSDB_BLOCK_COL_DICT : 0));
   n += tPutI8(p ? p + n : p, pBlockCol->flag);
   n += tPutI32v(p ? p + n : p, pBlockCol->szOrigin);
 
@@ -422,6 +422,9 @@ int32_t tGetBlockCol(uint8_t *p, void *ph) {
   n += tGetI8(p + n, &pBlockCol->flag);
   n += tGetI32v(p + n, &pBlockCol->szOrigin);
 
+  pBlockCol->dict = (pBlockCol->smaOn & TSDB_BLOCK_COL_DICT) ? 1 : 0;
+  pBlockCol->smaOn = (pBlockCol->smaOn & TSDB_BLOCK_COL_SMA_ON) ? 1 : 0;
+
   ASSERT(pBlockCol->flag && (pBlockCol->flag != HAS_NONE));
 
   pBlockCol->szBitmap = 0;
@@ -1181,6 +1184,35 @@ void tBlockDataClear(SBlockData *pBlockData) {
   }
 }
 
+// Move the columns of pBlockDataFrom, which holds other columns of the same rows, into pBlockData. The columns stay in
+// ascending order of column id, and pBlockDataFrom is left without any column.
+int32_t tBlockDataMoveColData(SBlockData *pBlockData, SBlockData *pBlockDataFrom) {
+  if (pBlockDataFrom->nColData == 0) return 0;
+
+  ASSERT(pBlockData->nRow == pBlockDataFrom->nRow);
+
+  int32_t   nColData = pBlockData->nColData + pBlockDataFrom->nColData;
+  SColData *aColData = taosMemoryMalloc(sizeof(SColData) * nColData);
+  if (aColData == NULL) return TSDB_CODE_OUT_OF_MEMORY;
+
+  for (int32_t i = 0, iTo = 0, iFrom = 0; i < nColData; i++) {
+    if (iFrom >= pBlockDataFrom->nColData ||
+        (iTo < pBlockData->nColData && pBlockData->aColData[iTo].cid <= pBlockDataFrom->aColData[iFrom].cid)) {
+      aColData[i] = pBlockData->aColData[iTo++];
+    } else {
+      aColData[i] = pBlockDataFrom->aColData[iFrom++];
+    }
+  }
+
+  taosMemoryFree(pBlockData->aColData);
+  pBlockData->aColData = aColData;
+  pBlockData->nColData = nColData;
+
+  taosMemoryFreeClear(pBlockDataFrom->aColData);
+  pBlockDataFrom->nColData = 0;
+  return 0;
+}
+
 /* flag > 0: forward update
  * flag == 0: insert
  * flag < 0: backward update
@@ -1620,6 +1652,147 @@ _exit:
   return code;
 }
 
+// Var data with few distinct values is saved as a dictionary: the offset part holds the code of each row and the
+// value part holds the raw dictionary size followed by the compressed entries, each as [size : I32v][data]. NULL,
+// NONE and empty values share one entry of size 0, which is kept out of the hash.
+#define TSDB_DICT_MIN_ROWS     64
+#define TSDB_DICT_ROWS_PER_VAL 4
+
+static int32_t tsdbCmprColDataDict(SColData *pColData, int8_t cmprAlg, SBlockCol *pBlockCol, uint8_t **ppOut,
+                                   int32_t nOut, uint8_t **ppBuf) {
+  int32_t    code = 0;
+  int32_t    maxDict = pColData->nVal / TSDB_DICT_ROWS_PER_VAL;
+  int32_t    nDict = 0;
+  int32_t    szDict = 0;
+  int32_t    emptyCode = -1;
+  uint8_t   *pDict = NULL;
+  int32_t   *aCode = NULL;
+  SSHashObj *pHash = NULL;
+
+  if (pColData->nVal < TSDB_DICT_MIN_ROWS || pColData->nData == 0) goto _exit;
+
+  pHash = tSimpleHashInit(maxDict, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY));
+  if (pHash == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  code = tRealloc((uint8_t **)&aCode, sizeof(int32_t) * pColData->nVal);
+  if (code) goto _exit;
+
+  for (int32_t iVal = 0; iVal < pColData->nVal; iVal++) {
+    int32_t offset = pColData->aOffset[iVal];
+    int32_t nData = ((iVal < pColData->nVal - 1) ? pColData->aOffset[iVal + 1] : pColData->nData) - offset;
+    if (nData < 0) goto _exit;
+
+    int32_t *pCode = (nData == 0) ? ((emptyCode < 0) ? NULL : &emptyCode)
+                                  : tSimpleHashGet(pHash, pColData->pData + offset, nData);
+    if (pCode) {
+      aCode[iVal] = *pCode;
+      continue;
+    }
+
+    // too many distinct values, keep the plain encoding
+    if (nDict >= maxDict) goto _exit;
+
+    if (nData == 0) {
+      emptyCode = nDict;
+    } else if (tSimpleHashPut(pHash, pColData->pData + offset, nData, &nDict, sizeof(nDict))) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _exit;
+    }
+
+    code = tRealloc(&pDict, szDict + tPutI32v(NULL, nData) + nData);
+    if (code) goto _exit;
+    szDict += tPutI32v(pDict + szDict, nData);
+    memcpy(pDict + szDict, pColData->pData + offset, nData);
+    szDict += nData;
+
+    aCode[iVal] = nDict++;
+  }
+
+  if (szDict >= pColData->nData) goto _exit;
+
+  // offset
+  code = tsdbCmprData((uint8_t *)aCode, sizeof(int32_t) * pColData->nVal, TSDB_DATA_TYPE_INT, cmprAlg, ppOut, nOut,
+                      &pBlockCol->szOffset, ppBuf);
+  if (code) goto _exit;
+  nOut += pBlockCol->szOffset;
+
+  // value
+  int32_t n = tPutI32v(NULL, szDict);
+  code = tRealloc(ppOut, nOut + n);
+  if (code) goto _exit;
+  tPutI32v(*ppOut + nOut, szDict);
+
+  code = tsdbCmprData(pDict, szDict, pColData->type, cmprAlg, ppOut, nOut + n, &pBlockCol->szValue, ppBuf);
+  if (code) goto _exit;
+  pBlockCol->szValue += n;
+
+  pBlockCol->dict = 1;
+
+_exit:
+  tSimpleHashCleanup(pHash);
+  tFree(pDict);
+  tFree(aCode);
+  return code;
+}
+
+static int32_t tsdbDecmprColDataDict(uint8_t *pIn, SBlockCol *pBlockCol, int8_t cmprAlg, SColData *pColData,
+                                     uint8_t **ppBuf) {
+  int32_t  code = 0;
+  int32_t  szDict = 0;
+  int32_t  nDict = 0;
+  uint8_t *pDict = NULL;
+  int32_t *aEntry = NULL;  // (offset, size) of each dictionary entry
+
+  // codes are decoded in place of the offsets
+  code = tsdbDecmprData(pIn, pBlockCol->szOffset, TSDB_DATA_TYPE_INT, cmprAlg, (uint8_t **)&pColData->aOffset,
+                        sizeof(int32_t) * pColData->nVal, ppBuf);
+  if (code) goto _exit;
+  pIn += pBlockCol->szOffset;
+
+  int32_t n = tGetI32v(pIn, &szDict);
+  code = tsdbDecmprData(pIn + n, pBlockCol->szValue - n, pColData->type, cmprAlg, &pDict, szDict, ppBuf);
+  if (code) goto _exit;
+
+  for (int32_t offset = 0; offset < szDict; nDict++) {
+    int32_t size;
+    offset += tGetI32v(pDict + offset, &size);
+
+    code = tRealloc((uint8_t **)&aEntry, sizeof(int32_t) * 2 * (nDict + 1));
+    if (code) goto _exit;
+    aEntry[2 * nDict] = offset;
+    aEntry[2 * nDict + 1] = size;
+    offset += size;
+  }
+
+  code = tRealloc(&pColData->pData, pColData->nData);
+  if (code) goto _exit;
+
+  int32_t nData = 0;
+  for (int32_t iVal = 0; iVal < pColData->nVal; iVal++) {
+    int32_t iDict = pColData->aOffset[iVal];
+    if (iDict < 0 || iDict >= nDict || nData + aEntry[2 * iDict + 1] > pColData->nData) {
+      code = TSDB_CODE_FILE_CORRUPTED;
+      goto _exit;
+    }
+
+    pColData->aOffset[iVal] = nData;
+    memcpy(pColData->pData + nData, pDict + aEntry[2 * iDict], aEntry[2 * iDict + 1]);
+    nData += aEntry[2 * iDict + 1];
+  }
+
+  if (nData != pColData->nData) {
+    code = TSDB_CODE_FILE_CORRUPTED;
+  }
+
+_exit:
+  tFree(pDict);
+  tFree(aEntry);
+  return code;
+}
+
 int32_t tsdbCmprColData(SColData *pColData, int8_t cmprAlg, SBlockCol *pBlockCol, uint8_t **ppOut, int32_t nOut,
                         uint8_t **ppBuf) {
   int32_t code = 0;
@@ -1629,6 +1802,7 @@ int32_t tsdbCmprColData(SColData *pColData, int8_t cmprAlg, SBlockCol *pBlockCol
   pBlockCol->szBitmap = 0;
   pBlockCol->szOffset = 0;
   pBlockCol->szValue = 0;
+  pBlockCol->dict = 0;
 
   int32_t size = 0;
   // bitmap
@@ -1646,6 +1820,12 @@ int32_t tsdbCmprColData(SColData *pColData, int8_t cmprAlg, SBlockCol *pBlockCol
   }
   size += pBlockCol->szBitmap;
 
+  // offset + value as a dictionary
+  if (tsVarDictEncode && IS_VAR_DATA_TYPE(pColData->type) && (pColData->flag & HAS_VALUE)) {
+    code = tsdbCmprColDataDict(pColData, cmprAlg, pBlockCol, ppOut, nOut + size, ppBuf);
+    if (code || pBlockCol->dict) goto _exit;
+  }
+
   // offset
   if (IS_VAR_DATA_TYPE(pColData->type) && pColData->flag != (HAS_NULL | HAS_NONE)) {
     code = tsdbCmprData((uint8_t *)pColData->aOffset, sizeof(int32_t) * pColData->nVal, TSDB_DATA_TYPE_INT, cmprAlg,
@@ -1692,6 +1872,12 @@ int32_t tsdbDecmprColData(uint8_t *pIn, SBlockCol *pBlockCol, int8_t cmprAlg, in
   }
   p += pBlockCol->szBitmap;
 
+  // offset + value as a dictionary
+  if (pBlockCol->dict) {
+    code = tsdbDecmprColDataDict(p, pBlockCol, cmprAlg, pColData, ppBuf);
+    goto _exit;
+  }
+
   // offset
   if (pBlockCol->szOffset) {
     code = tsdbDecmprData(p, pBlockCol->szOffset, TSDB_DATA_TYPE_INT, cmprAlg, (uint8_t **)&pColData->aOffset,
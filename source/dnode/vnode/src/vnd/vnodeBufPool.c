@@ -16,15 +16,68 @@
 #include "vnd.h"
 
 /* ------------------------ STRUCTURES ------------------------ */
+int32_t vnodeBufPoolNumaNode(SVnode *pVnode) {
+  if (!tsBufPoolNumaBind) return -1;
+
+  int32_t numOfNodes = taosGetNumaNodes();
+  if (numOfNodes <= 1) return -1;
+  return TD_VID(pVnode) % numOfNodes;
+}
+
+// move the calling thread to the NUMA node of the vnode it is about to write, the apply workers are shared by vnodes
+void vnodeBufPoolBindThread(SVnode *pVnode) {
+  static threadlocal int32_t threadNumaNode = -1;
+
+  int32_t numaNode = vnodeBufPoolNumaNode(pVnode);
+  if (numaNode < 0 || numaNode == threadNumaNode) return;
+
+  if (taosBindThreadToNumaNode(numaNode) != 0) {
+    vWarn("vgId:%d, failed to bind thread to numa node %d since %s", TD_VID(pVnode), numaNode, tstrerror(terrno));
+  }
+  threadNumaNode = numaNode;
+}
+
+static void vnodeBufPoolFreeMem(SVBufPool *pPool) {
+  if (pPool->mapSize > 0) {
+    taosMemoryUnmapPages(pPool, pPool->mapSize);
+  } else {
+    taosMemoryFree(pPool);
+  }
+}
+
 static int vnodeBufPoolCreate(SVnode *pVnode, int32_t id, int64_t size, SVBufPool **ppPool) {
-  SVBufPool *pPool;
+  SVBufPool *pPool = NULL;
+  int32_t    numaNode = vnodeBufPoolNumaNode(pVnode);
+  int64_t    mapSize = 0;
+
+  if (tsBufPoolHugePage) {
+    pPool = taosMemoryMapPages(sizeof(SVBufPool) + size, true, numaNode, &mapSize);
+    if (pPool == NULL) {
+      vWarn("vgId:%d, failed to map buffer pool of id %d to huge pages since %s", TD_VID(pVnode), id,
+            tstrerror(terrno));
+    }
+  }
+
+  if (pPool == NULL && numaNode >= 0) {
+    pPool = taosMemoryMapPages(sizeof(SVBufPool) + size, false, numaNode, &mapSize);
+    if (pPool == NULL) {
+      vWarn("vgId:%d, failed to map buffer pool of id %d on numa node %d since %s", TD_VID(pVnode), id, numaNode,
+            tstrerror(terrno));
+    }
+  }
 
-  pPool = taosMemoryMalloc(sizeof(SVBufPool) + size);
   if (pPool == NULL) {
-    terrno = TSDB_CODE_OUT_OF_MEMORY;
-    return -1;
+    mapSize = 0;
+    pPool = taosMemoryMalloc(sizeof(SVBufPool) + size);
+    if (pPool == NULL) {
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      return -1;
+    }
   }
   memset(pPool, 0, sizeof(SVBufPool));
+  pPool->mapSize = mapSize;
+  pPool->numaNode = mapSize > 0 ? numaNode : -1;
+  pPool->hugePage = mapSize > 0 && tsBufPoolHugePage;
 
   // query handle list
   taosThreadMutexInit(&pPool->mutex, NULL);
@@ -40,16 +93,17 @@ static int vnodeBufPoolCreate(SVnode *pVnode, int32_t id, int64_t size, SVBufPoo
   pPool->node.pnext = &pPool->pTail;
   pPool->node.size = size;
 
-  if (VND_IS_RSMA(pVnode)) {
+  // rsma and the parallel apply of submit requests allocate from the pool concurrently
+  if (VND_IS_RSMA(pVnode) || tsNumOfApplyThreads > 0) {
     pPool->lock = taosMemoryMalloc(sizeof(TdThreadSpinlock));
     if (!pPool->lock) {
-      taosMemoryFree(pPool);
+      vnodeBufPoolFreeMem(pPool);
       terrno = TSDB_CODE_OUT_OF_MEMORY;
       return -1;
     }
     if (taosThreadSpinInit(pPool->lock, 0) != 0) {
       taosMemoryFree((void *)pPool->lock);
-      taosMemoryFree(pPool);
+      vnodeBufPoolFreeMem(pPool);
       terrno = TAOS_SYSTEM_ERROR(errno);
       return -1;
     }
@@ -68,7 +122,7 @@ static int vnodeBufPoolDestroy(SVBufPool *pPool) {
     taosMemoryFree((void *)pPool->lock);
   }
   taosThreadMutexDestroy(&pPool->mutex);
-  taosMemoryFree(pPool);
+  vnodeBufPoolFreeMem(pPool);
   return 0;
 }
 
@@ -88,7 +142,8 @@ int vnodeOpenBufPool(SVnode *pVnode) {
     pVnode->freeList = pVnode->aBufPool[i];
   }
 
-  vDebug("vgId:%d, vnode buffer pool is opened, size:%" PRId64, TD_VID(pVnode), size);
+  vDebug("vgId:%d, vnode buffer pool is opened, size:%" PRId64 " numa node:%d huge page:%d", TD_VID(pVnode), size,
+         pVnode->aBufPool[0]->numaNode, pVnode->aBufPool[0]->hugePage);
   return 0;
 }
 
@@ -128,6 +183,7 @@ void *vnodeBufPoolMallocAligned(SVBufPool *pPool, int size) {
   ASSERT(pPool != NULL);
 
   if (pPool->lock) taosThreadSpinLock(pPool->lock);
+  pPool->nAlloc++;
 
   ptr = pPool->ptr;
   paddingLen = (((long)ptr + 7) & ~7) - (long)ptr;
@@ -155,6 +211,8 @@ void *vnodeBufPoolMallocAligned(SVBufPool *pPool, int size) {
     pPool->pTail = pNode;
 
     pPool->size = pPool->size + sizeof(*pNode) + size;
+    pPool->nOverflow++;
+    pPool->szOverflow += size;
   }
   if (pPool->lock) taosThreadSpinUnlock(pPool->lock);
   return p;
@@ -166,6 +224,7 @@ void *vnodeBufPoolMalloc(SVBufPool *pPool, int size) {
   ASSERT(pPool != NULL);
 
   if (pPool->lock) taosThreadSpinLock(pPool->lock);
+  pPool->nAlloc++;
   if (pPool->node.size >= pPool->ptr - pPool->node.data + size) {
     // allocate from the anchor node
     p = pPool->ptr;
@@ -188,6 +247,8 @@ void *vnodeBufPoolMalloc(SVBufPool *pPool, int size) {
     pPool->pTail = pNode;
 
     pPool->size = pPool->size + sizeof(*pNode) + size;
+    pPool->nOverflow++;
+    pPool->szOverflow += size;
   }
   if (pPool->lock) taosThreadSpinUnlock(pPool->lock);
   return p;
@@ -225,6 +286,9 @@ void vnodeBufPoolAddToFreeList(SVBufPool *pPool) {
       vInfo("vgId:%d, buffer pool of id %d size changed from %" PRId64 " to %" PRId64, TD_VID(pVnode), pPool->id,
             pPool->node.size, size);
 
+      pNewPool->nAlloc = pPool->nAlloc;
+      pNewPool->nOverflow = pPool->nOverflow;
+      pNewPool->szOverflow = pPool->szOverflow;
       vnodeBufPoolDestroy(pPool);
       pPool = pNewPool;
       pVnode->aBufPool[pPool->id] = pPool;
@@ -328,3 +392,31 @@ _exit:
   taosThreadMutexUnlock(&pPool->mutex);
   return code;
 }
+
+int32_t vnodeGetBufPoolStat(SVnode *pVnode, SArray *pStats) {
+  taosThreadMutexLock(&pVnode->mutex);
+  for (int32_t i = 0; i < VNODE_BUFPOOL_SEGMENTS; i++) {
+    SVBufPool *pPool = pVnode->aBufPool[i];
+    if (pPool == NULL) continue;
+
+    SVBufPoolStat stat = {
+        .vgId = TD_VID(pVnode),
+        .id = pPool->id,
+        .numaNode = pPool->numaNode,
+        .hugePage = pPool->hugePage,
+        .capacity = pPool->node.size,
+        .mapSize = pPool->mapSize,
+        .used = pPool->size,
+        .nAlloc = pPool->nAlloc,
+        .nOverflow = pPool->nOverflow,
+        .szOverflow = pPool->szOverflow,
+    };
+    if (taosArrayPush(pStats, &stat) == NULL) {
+      taosThreadMutexUnlock(&pVnode->mutex);
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      return -1;
+    }
+  }
+  taosThreadMutexUnlock(&pVnode->mutex);
+  return 0;
+}
@@ -63,6 +63,7 @@ void initTsdbReaderAPI(TsdReader* pReader) {
 
   pReader->tsdSetFilesetDelimited = (void (*)(void*))tsdbSetFilesetDelimited;
   pReader->tsdSetSetNotifyCb = (void (*)(void*, TsdReaderNotifyCbFn, void*))tsdbReaderSetNotifyCb;
+  pReader->tsdSetFilter = (void (*)(void*, void*))tsdbReaderSetFilter;
 }
 
 void initMetadataAPI(SStoreMeta* pMeta) {
@@ -86,6 +87,8 @@ void initMetadataAPI(SStoreMeta* pMeta) {
   pMeta->extractTagVal = (const void* (*)(const void*, int16_t, STagVal*))metaGetTableTagVal;
   pMeta->getTableTags = metaGetTableTags;
   pMeta->getTableTagsByUid = metaGetTableTagsByUids;
+  pMeta->acquireTagCols = metaAcquireTagCols;
+  pMeta->releaseTagCols = metaReleaseTagCols;
 
   pMeta->getTableUidByName = metaGetTableUidByName;
   pMeta->getTableTypeByName = metaGetTableTypeByName;
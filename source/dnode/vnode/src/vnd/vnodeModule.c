@@ -18,7 +18,7 @@
 
 static volatile int32_t VINIT = 0;
 
-SVAsync* vnodeAsyncHandle[2];
+SVAsync* vnodeAsyncHandle[4];
 
 int vnodeInit(int nthreads) {
   int32_t init;
@@ -36,6 +36,18 @@ int vnodeInit(int nthreads) {
   vnodeAsyncInit(&vnodeAsyncHandle[1], "vnode-merge");
   vnodeAsyncSetWorkers(vnodeAsyncHandle[1], nthreads);
 
+  // vnode-decode
+  if (tsNumOfDecodeThreads > 0) {
+    vnodeAsyncInit(&vnodeAsyncHandle[2], "vnode-decode");
+    vnodeAsyncSetWorkers(vnodeAsyncHandle[2], tsNumOfDecodeThreads);
+  }
+
+  // vnode-apply
+  if (tsNumOfApplyThreads > 0) {
+    vnodeAsyncInit(&vnodeAsyncHandle[3], "vnode-apply");
+    vnodeAsyncSetWorkers(vnodeAsyncHandle[3], tsNumOfApplyThreads);
+  }
+
   if (walInit() < 0) {
     return -1;
   }
@@ -50,6 +62,12 @@ void vnodeCleanup() {
   // set stop
   vnodeAsyncDestroy(&vnodeAsyncHandle[0]);
   vnodeAsyncDestroy(&vnodeAsyncHandle[1]);
+  if (vnodeAsyncHandle[2] != NULL) {
+    vnodeAsyncDestroy(&vnodeAsyncHandle[2]);
+  }
+  if (vnodeAsyncHandle[3] != NULL) {
+    vnodeAsyncDestroy(&vnodeAsyncHandle[3]);
+  }
 
   walCleanUp();
   smaCleanUp();
@@ -398,6 +398,8 @@ SVnode *vnodeOpen(const char *path, int32_t diskPrimary, STfs *pTfs, SMsgCb msgC
   tsem_init(&pVnode->syncSem, 0, 0);
   taosThreadMutexInit(&pVnode->mutex, NULL);
   taosThreadCondInit(&pVnode->poolNotEmpty, NULL);
+  taosThreadMutexInit(&pVnode->applyMutex, NULL);
+  taosThreadCondInit(&pVnode->applyCond, NULL);
 
   if (vnodeAChannelInit(vnodeAsyncHandle[0], &pVnode->commitChannel) != 0) {
     vError("vgId:%d, failed to init commit channel", TD_VID(pVnode));
@@ -541,6 +543,8 @@ void vnodeClose(SVnode *pVnode) {
     tsem_destroy(&pVnode->syncSem);
     taosThreadCondDestroy(&pVnode->poolNotEmpty);
     taosThreadMutexDestroy(&pVnode->mutex);
+    taosThreadCondDestroy(&pVnode->applyCond);
+    taosThreadMutexDestroy(&pVnode->applyMutex);
     taosThreadMutexDestroy(&pVnode->lock);
     taosMemoryFree(pVnode);
   }
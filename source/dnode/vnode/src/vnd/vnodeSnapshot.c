@@ -714,6 +714,7 @@ int32_t vnodeSnapWriterClose(SVSnapWriter *pWriter, int8_t rollback, SSnapshot *
 
     code = vnodeCommitInfo(dir);
     if (code) goto _exit;
+    vnodeNotifyApplied(pVnode);
 
   } else {
     vnodeRollback(pWriter->pVnode);
@@ -691,8 +691,12 @@ int32_t vnodePreprocessQueryMsg(SVnode *pVnode, SRpcMsg *pMsg) {
 
 int32_t vnodeProcessQueryMsg(SVnode *pVnode, SRpcMsg *pMsg) {
   vTrace("message in vnode query queue is processing");
-  if ((pMsg->msgType == TDMT_SCH_QUERY || pMsg->msgType == TDMT_VND_TMQ_CONSUME ||
-       pMsg->msgType == TDMT_VND_TMQ_CONSUME_PUSH) &&
+  if (pMsg->msgType == TDMT_SCH_QUERY && vnodeReadIndex(pVnode) != 0) {
+    vnodeRedirectRpcMsg(pVnode, pMsg, terrno);
+    return 0;
+  }
+
+  if ((pMsg->msgType == TDMT_VND_TMQ_CONSUME || pMsg->msgType == TDMT_VND_TMQ_CONSUME_PUSH) &&
       !syncIsReadyForRead(pVnode->sync)) {
     vnodeRedirectRpcMsg(pVnode, pMsg, terrno);
     return 0;
@@ -724,7 +728,13 @@ int32_t vnodeProcessQueryMsg(SVnode *pVnode, SRpcMsg *pMsg) {
 
 int32_t vnodeProcessFetchMsg(SVnode *pVnode, SRpcMsg *pMsg, SQueueInfo *pInfo) {
   vTrace("vgId:%d, msg:%p in fetch queue is processing", pVnode->config.vgId, pMsg);
-  if ((pMsg->msgType == TDMT_SCH_FETCH || pMsg->msgType == TDMT_VND_TABLE_META || pMsg->msgType == TDMT_VND_TABLE_CFG ||
+  // the fetch of a query served by a follower goes on there, the read index was confirmed by the query
+  if (pMsg->msgType == TDMT_SCH_FETCH && !syncIsReadyForFollowerRead(pVnode->sync)) {
+    vnodeRedirectRpcMsg(pVnode, pMsg, terrno);
+    return 0;
+  }
+
+  if ((pMsg->msgType == TDMT_VND_TABLE_META || pMsg->msgType == TDMT_VND_TABLE_CFG ||
        pMsg->msgType == TDMT_VND_BATCH_META) &&
       !syncIsReadyForRead(pVnode->sync)) {
     vnodeRedirectRpcMsg(pVnode, pMsg, terrno);
@@ -918,6 +928,10 @@ static int32_t vnodeProcessCreateTbReq(SVnode *pVnode, int64_t ver, void *pReq,
   STbUidStore       *pStore = NULL;
   SArray            *tbUids = NULL;
   SArray            *tbNames = NULL;
+  SVCreateTbReq    **ppCreateReqs = NULL;
+  int32_t           *pCreateCodes = NULL;
+  STableMetaRsp    **ppMetaRsps = NULL;
+  int32_t            nCreateReqs = 0;
 
   pRsp->msgType = TDMT_VND_CREATE_TABLE_RSP;
   pRsp->code = TSDB_CODE_SUCCESS;
@@ -941,7 +955,18 @@ static int32_t vnodeProcessCreateTbReq(SVnode *pVnode, int64_t ver, void *pReq,
     goto _exit;
   }
 
-  // loop to create table
+  if (req.nReqs > 0) {
+    ppCreateReqs = taosMemoryCalloc(req.nReqs, sizeof(SVCreateTbReq *));
+    pCreateCodes = taosMemoryCalloc(req.nReqs, sizeof(int32_t));
+    ppMetaRsps = taosMemoryCalloc(req.nReqs, sizeof(STableMetaRsp *));
+    if (ppCreateReqs == NULL || pCreateCodes == NULL || ppMetaRsps == NULL) {
+      rcode = -1;
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      goto _exit;
+    }
+  }
+
+  // loop to validate table, the valid ones are created in one batch below
   for (int32_t iReq = 0; iReq < req.nReqs; iReq++) {
     pCreateReq = req.pReqs + iReq;
     memset(&cRsp, 0, sizeof(cRsp));
@@ -975,21 +1000,32 @@ static int32_t vnodeProcessCreateTbReq(SVnode *pVnode, int64_t ver, void *pReq,
       continue;
     }
 
-    // do create table
-    if (metaCreateTable(pVnode->pMeta, ver, pCreateReq, &cRsp.pMeta) < 0) {
-      if (pCreateReq->flags & TD_CREATE_IF_NOT_EXISTS && terrno == TSDB_CODE_TDB_TABLE_ALREADY_EXIST) {
-        cRsp.code = TSDB_CODE_SUCCESS;
+    ppCreateReqs[nCreateReqs++] = pCreateReq;
+    taosArrayPush(rsp.pArray, &cRsp);
+  }
+
+  // do create table
+  if (nCreateReqs > 0) {
+    metaCreateTables(pVnode->pMeta, ver, ppCreateReqs, nCreateReqs, pCreateCodes, ppMetaRsps);
+  }
+
+  for (int32_t i = 0; i < nCreateReqs; i++) {
+    SVCreateTbRsp *pCRsp = taosArrayGet(rsp.pArray, ppCreateReqs[i] - req.pReqs);
+
+    pCreateReq = ppCreateReqs[i];
+    pCRsp->pMeta = ppMetaRsps[i];
+    if (pCreateCodes[i] != TSDB_CODE_SUCCESS) {
+      if (pCreateReq->flags & TD_CREATE_IF_NOT_EXISTS && pCreateCodes[i] == TSDB_CODE_TDB_TABLE_ALREADY_EXIST) {
+        pCRsp->code = TSDB_CODE_SUCCESS;
       } else {
-        cRsp.code = terrno;
+        pCRsp->code = pCreateCodes[i];
       }
     } else {
-      cRsp.code = TSDB_CODE_SUCCESS;
+      pCRsp->code = TSDB_CODE_SUCCESS;
       tdFetchTbUidList(pVnode->pSma, &pStore, pCreateReq->ctb.suid, pCreateReq->uid);
       taosArrayPush(tbUids, &pCreateReq->uid);
-      vnodeUpdateMetaRsp(pVnode, cRsp.pMeta);
+      vnodeUpdateMetaRsp(pVnode, pCRsp->pMeta);
     }
-
-    taosArrayPush(rsp.pArray, &cRsp);
   }
 
   vDebug("vgId:%d, add %d new created tables into query table list", TD_VID(pVnode), (int32_t)taosArrayGetSize(tbUids));
@@ -1049,6 +1085,9 @@ _exit:
   tDecoderClear(&decoder);
   tEncoderClear(&encoder);
   taosArrayDestroy(tbNames);
+  taosMemoryFree(ppCreateReqs);
+  taosMemoryFree(pCreateCodes);
+  taosMemoryFree(ppMetaRsps);
   return rcode;
 }
 
@@ -1488,6 +1527,106 @@ static int32_t vnodeRebuildSubmitReqMsg(SSubmitReq2 *pSubmitReq, void **ppMsg) {
   return code;
 }
 
+typedef struct {
+  SVnode      *pVnode;
+  SSubmitReq2 *pSubmitReq;
+  int64_t      ver;
+  int32_t      shard;
+  int32_t      nShard;
+  int32_t      affectedRows;
+  bool         done;
+  int32_t      code;
+} SVSubmitApplyTask;
+
+// apply the data of the tables that fall into the shard of the task, the data of one table always goes to the same
+// shard, so they are still inserted in the order of the request
+static int32_t vnodeSubmitApplyTaskExec(void *arg) {
+  SVSubmitApplyTask *task = (SVSubmitApplyTask *)arg;
+  SVnode            *pVnode = task->pVnode;
+
+  vnodeBufPoolBindThread(pVnode);
+
+  for (int32_t i = 0; i < TARRAY_SIZE(task->pSubmitReq->aSubmitTbData) && task->code == 0; ++i) {
+    SSubmitTbData *pSubmitTbData = taosArrayGet(task->pSubmitReq->aSubmitTbData, i);
+    if (TABS(pSubmitTbData->uid) % task->nShard != task->shard) {
+      continue;
+    }
+
+    int32_t affectedRows;
+    task->code = tsdbInsertTableData(pVnode->pTsdb, task->ver, pSubmitTbData, &affectedRows);
+    if (task->code) break;
+
+    task->code = metaUpdateChangeTimeWithLock(pVnode->pMeta, pSubmitTbData->uid, pSubmitTbData->ctimeMs);
+    if (task->code) break;
+
+    task->affectedRows += affectedRows;
+  }
+
+  task->done = true;
+  return task->code;
+}
+
+// Insert the data of all tables in the request into the memtable. The skiplists of different tables are independent,
+// so a large request is split by table uid over the vnode-apply workers, and the calling thread takes one shard itself
+// before joining all of them. The request is applied as a whole once this returns.
+int32_t vnodeApplySubmitTbData(SVnode *pVnode, int64_t ver, SSubmitReq2 *pSubmitReq, int32_t *affectedRows) {
+  int32_t code = 0;
+  int32_t nTbData = TARRAY_SIZE(pSubmitReq->aSubmitTbData);
+  int32_t nTask = 1;
+
+  if (vnodeAsyncHandle[3] != NULL && tsApplyParallelTables > 0 && nTbData >= tsApplyParallelTables) {
+    nTask = TMIN(tsNumOfApplyThreads + 1, nTbData);
+  }
+
+  SVSubmitApplyTask  task0 = {0};
+  SVSubmitApplyTask *tasks = &task0;
+  int64_t           *taskIds = NULL;
+  if (nTask > 1) {
+    tasks = taosMemoryCalloc(nTask, sizeof(SVSubmitApplyTask) + sizeof(int64_t));
+    if (tasks == NULL) {
+      tasks = &task0;
+      nTask = 1;
+    } else {
+      taskIds = (int64_t *)(tasks + nTask);
+    }
+  }
+
+  for (int32_t i = 0; i < nTask; i++) {
+    tasks[i] = (SVSubmitApplyTask){.pVnode = pVnode, .pSubmitReq = pSubmitReq, .ver = ver, .shard = i, .nShard = nTask};
+  }
+
+  for (int32_t i = 1; i < nTask; i++) {
+    if (vnodeAsyncC(vnodeAsyncHandle[3], 0, EVA_PRIORITY_HIGH, vnodeSubmitApplyTaskExec, NULL, &tasks[i],
+                    &taskIds[i]) != 0) {
+      taskIds[i] = 0;
+      vnodeSubmitApplyTaskExec(&tasks[i]);
+    }
+  }
+
+  vnodeSubmitApplyTaskExec(&tasks[0]);
+
+  for (int32_t i = 0; i < nTask; i++) {
+    if (i > 0 && VNODE_ASYNC_VALID_TASK_ID(taskIds[i])) {
+      vnodeAWait(vnodeAsyncHandle[3], taskIds[i]);
+    }
+
+    if (code == 0) {
+      code = tasks[i].done ? tasks[i].code : TSDB_CODE_APP_IS_STOPPING;
+    }
+    *affectedRows += tasks[i].affectedRows;
+  }
+
+  if (nTask > 1) {
+    vDebug("vgId:%d, submit of %d tables applied by %d threads, version:%" PRId64, TD_VID(pVnode), nTbData, nTask,
+           ver);
+  }
+
+  if (tasks != &task0) {
+    taosMemoryFree(tasks);
+  }
+  return code;
+}
+
 static int32_t vnodeProcessSubmitReq(SVnode *pVnode, int64_t ver, void *pReq, int32_t len, SRpcMsg *pRsp, 
                                     SRpcMsg *pOriginalMsg) {
   int32_t code = 0;
@@ -1496,9 +1635,14 @@ static int32_t vnodeProcessSubmitReq(SVnode *pVnode, int64_t ver, void *pReq, in
   SSubmitReq2 *pSubmitReq = &(SSubmitReq2){0};
   SSubmitRsp2 *pSubmitRsp = &(SSubmitRsp2){0};
   SArray      *newTbUids = NULL;
+  SArray      *aCreateTbData = NULL;
   int32_t      ret;
   SEncoder     ec = {0};
 
+  SVCreateTbReq **ppCreateReqs = NULL;
+  int32_t        *pCreateCodes = NULL;
+  STableMetaRsp **ppMetaRsps = NULL;
+
   pRsp->code = TSDB_CODE_SUCCESS;
 
   void           *pAllocMsg = NULL;
@@ -1626,11 +1770,10 @@ static int32_t vnodeProcessSubmitReq(SVnode *pVnode, int64_t ver, void *pReq, in
 
   vDebug("vgId:%d, submit block size %d", TD_VID(pVnode), (int32_t)taosArrayGetSize(pSubmitReq->aSubmitTbData));
 
-  // loop to handle
+  // create tables, the auto-created tables of one submit go into meta in one batch
   for (int32_t i = 0; i < TARRAY_SIZE(pSubmitReq->aSubmitTbData); ++i) {
     SSubmitTbData *pSubmitTbData = taosArrayGet(pSubmitReq->aSubmitTbData, i);
 
-    // create table
     if (pSubmitTbData->pCreateTbReq) {
       // check (TODO: move check to create table)
       code = grantCheck(TSDB_GRANT_TIMESERIES);
@@ -1639,18 +1782,49 @@ static int32_t vnodeProcessSubmitReq(SVnode *pVnode, int64_t ver, void *pReq, in
       code = grantCheck(TSDB_GRANT_TABLE);
       if (code) goto _exit;
 
-      // alloc if need
-      if (pSubmitRsp->aCreateTbRsp == NULL &&
-          (pSubmitRsp->aCreateTbRsp = taosArrayInit(TARRAY_SIZE(pSubmitReq->aSubmitTbData), sizeof(SVCreateTbRsp))) ==
-              NULL) {
+      if ((aCreateTbData == NULL &&
+           (aCreateTbData = taosArrayInit(TARRAY_SIZE(pSubmitReq->aSubmitTbData), POINTER_BYTES)) == NULL) ||
+          taosArrayPush(aCreateTbData, &pSubmitTbData) == NULL) {
         code = TSDB_CODE_OUT_OF_MEMORY;
         goto _exit;
       }
+    }
+  }
 
+  int32_t nCreateTbs = taosArrayGetSize(aCreateTbData);
+  if (nCreateTbs > 0) {
+    // alloc if need
+    if (pSubmitRsp->aCreateTbRsp == NULL &&
+        (pSubmitRsp->aCreateTbRsp = taosArrayInit(TARRAY_SIZE(pSubmitReq->aSubmitTbData), sizeof(SVCreateTbRsp))) ==
+            NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _exit;
+    }
+
+    ppCreateReqs = taosMemoryCalloc(nCreateTbs, sizeof(SVCreateTbReq *));
+    pCreateCodes = taosMemoryCalloc(nCreateTbs, sizeof(int32_t));
+    ppMetaRsps = taosMemoryCalloc(nCreateTbs, sizeof(STableMetaRsp *));
+    if (ppCreateReqs == NULL || pCreateCodes == NULL || ppMetaRsps == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _exit;
+    }
+
+    for (int32_t i = 0; i < nCreateTbs; ++i) {
+      ppCreateReqs[i] = (*(SSubmitTbData **)taosArrayGet(aCreateTbData, i))->pCreateTbReq;
+    }
+
+    // create table
+    metaCreateTables(pVnode->pMeta, ver, ppCreateReqs, nCreateTbs, pCreateCodes, ppMetaRsps);
+
+    for (int32_t i = 0; i < nCreateTbs; ++i) {
       SVCreateTbRsp *pCreateTbRsp = taosArrayReserve(pSubmitRsp->aCreateTbRsp, 1);
+      pCreateTbRsp->pMeta = ppMetaRsps[i];
+    }
 
-      // create table
-      if (metaCreateTable(pVnode->pMeta, ver, pSubmitTbData->pCreateTbReq, &pCreateTbRsp->pMeta) == 0) {
+    for (int32_t i = 0; i < nCreateTbs; ++i) {
+      SSubmitTbData *pSubmitTbData = *(SSubmitTbData **)taosArrayGet(aCreateTbData, i);
+
+      if (pCreateCodes[i] == TSDB_CODE_SUCCESS) {
         // create table success
 
         if (newTbUids == NULL &&
@@ -1661,32 +1835,26 @@ static int32_t vnodeProcessSubmitReq(SVnode *pVnode, int64_t ver, void *pReq, in
 
         taosArrayPush(newTbUids, &pSubmitTbData->uid);
 
-        if (pCreateTbRsp->pMeta) {
-          vnodeUpdateMetaRsp(pVnode, pCreateTbRsp->pMeta);
+        if (ppMetaRsps[i]) {
+          vnodeUpdateMetaRsp(pVnode, ppMetaRsps[i]);
         }
       } else {  // create table failed
-        if (terrno != TSDB_CODE_TDB_TABLE_ALREADY_EXIST) {
-          code = terrno;
+        if (pCreateCodes[i] != TSDB_CODE_TDB_TABLE_ALREADY_EXIST) {
+          code = pCreateCodes[i];
           vError("vgId:%d failed to create table:%s, code:%s", TD_VID(pVnode), pSubmitTbData->pCreateTbReq->name,
-                 tstrerror(terrno));
+                 tstrerror(code));
           goto _exit;
         }
         terrno = 0;
         pSubmitTbData->uid = pSubmitTbData->pCreateTbReq->uid;  // update uid if table exist for using below
       }
     }
-
-    // insert data
-    int32_t affectedRows;
-    code = tsdbInsertTableData(pVnode->pTsdb, ver, pSubmitTbData, &affectedRows);
-    if (code) goto _exit;
-
-    code = metaUpdateChangeTimeWithLock(pVnode->pMeta, pSubmitTbData->uid, pSubmitTbData->ctimeMs);
-    if (code) goto _exit;
-
-    pSubmitRsp->affectedRows += affectedRows;
   }
 
+  // insert data
+  code = vnodeApplySubmitTbData(pVnode, ver, pSubmitReq, &pSubmitRsp->affectedRows);
+  if (code) goto _exit;
+
   // update the affected table uid list
   if (taosArrayGetSize(newTbUids) > 0) {
     vDebug("vgId:%d, add %d table into query table list in handling submit", TD_VID(pVnode),
@@ -1739,6 +1907,10 @@ _exit:
 
   // clear
   taosArrayDestroy(newTbUids);
+  taosArrayDestroy(aCreateTbData);
+  taosMemoryFree(ppCreateReqs);
+  taosMemoryFree(pCreateCodes);
+  taosMemoryFree(ppMetaRsps);
   tDestroySubmitReq(pSubmitReq, 0 == pMsg->version ? TSDB_MSG_FLG_CMPT : TSDB_MSG_FLG_DECODE);
   tDestroySSubmitRsp2(pSubmitRsp, TSDB_MSG_FLG_ENCODE);
 
@@ -83,6 +83,7 @@ static void inline vnodeHandleWriteMsg(SVnode *pVnode, SRpcMsg *pMsg) {
     const STraceId *trace = &pMsg->info.traceId;
     vGError("vgId:%d, msg:%p failed to apply right now since %s", pVnode->config.vgId, pMsg, terrstr());
   }
+  vnodeNotifyApplied(pVnode);
   if (rsp.info.handle != NULL) {
     tmsgSendRsp(&rsp);
   } else {
@@ -92,6 +93,58 @@ static void inline vnodeHandleWriteMsg(SVnode *pVnode, SRpcMsg *pMsg) {
   }
 }
 
+// wake the follower reads waiting for their read index to be applied
+void vnodeNotifyApplied(SVnode *pVnode) {
+  if (atomic_load_32(&pVnode->applyWaiters) > 0) {
+    taosThreadMutexLock(&pVnode->applyMutex);
+    taosThreadCondBroadcast(&pVnode->applyCond);
+    taosThreadMutexUnlock(&pVnode->applyMutex);
+  }
+}
+
+int32_t vnodeWaitApplied(SVnode *pVnode, int64_t index, int64_t timeoutMs) {
+  if (atomic_load_64(&pVnode->state.applied) >= index) {
+    return 0;
+  }
+
+  struct timeval  tv;
+  struct timespec ts;
+  taosGetTimeOfDay(&tv);
+  int64_t nsec = tv.tv_usec * 1000 + timeoutMs * 1000000;
+  ts.tv_sec = tv.tv_sec + nsec / 1000000000;
+  ts.tv_nsec = nsec % 1000000000;
+
+  int32_t code = 0;
+  taosThreadMutexLock(&pVnode->applyMutex);
+  atomic_add_fetch_32(&pVnode->applyWaiters, 1);
+  while (atomic_load_64(&pVnode->state.applied) < index) {
+    int32_t rc = taosThreadCondTimedWait(&pVnode->applyCond, &pVnode->applyMutex, &ts);
+    if (rc == ETIMEDOUT) {
+      code = (atomic_load_64(&pVnode->state.applied) >= index) ? 0 : -1;
+      break;
+    }
+  }
+  atomic_sub_fetch_32(&pVnode->applyWaiters, 1);
+  taosThreadMutexUnlock(&pVnode->applyMutex);
+  return code;
+}
+
+// a query on a follower runs once the commit index of the leader is applied, a leader runs it right away
+int32_t vnodeReadIndex(SVnode *pVnode) {
+  SyncIndex readIndex = SYNC_INDEX_INVALID;
+  if (syncReadIndex(pVnode->sync, &readIndex) != 0) {
+    return -1;
+  }
+
+  if (vnodeWaitApplied(pVnode, readIndex, SYNC_READ_INDEX_TIMEOUT_MS) != 0) {
+    vDebug("vgId:%d, read index %" PRId64 " not applied in time, applied:%" PRId64, TD_VID(pVnode), readIndex,
+           atomic_load_64(&pVnode->state.applied));
+    terrno = TSDB_CODE_SYN_NOT_LEADER;
+    return -1;
+  }
+  return 0;
+}
+
 static void vnodeHandleProposeError(SVnode *pVnode, SRpcMsg *pMsg, int32_t code) {
   if (code == TSDB_CODE_SYN_NOT_LEADER || code == TSDB_CODE_SYN_RESTORING) {
     vnodeRedirectRpcMsg(pVnode, pMsg, code);
@@ -328,6 +381,8 @@ void vnodeApplyWriteMsg(SQueueInfo *pInfo, STaosQall *qall, int32_t numOfMsgs) {
   int32_t  code = 0;
   SRpcMsg *pMsg = NULL;
 
+  vnodeBufPoolBindThread(pVnode);
+
   for (int32_t i = 0; i < numOfMsgs; ++i) {
     if (taosGetQitem(qall, (void **)&pMsg) == 0) continue;
     const STraceId *trace = &pMsg->info.traceId;
@@ -350,6 +405,7 @@ void vnodeApplyWriteMsg(SQueueInfo *pInfo, STaosQall *qall, int32_t numOfMsgs) {
                 pMsg->info.conn.applyIndex);
       }
     }
+    vnodeNotifyApplied(pVnode);
 
     vnodePostBlockMsg(pVnode, pMsg);
     if (rsp.info.handle != NULL) {
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "meta.h"
+
+namespace {
+
+const char *kMetaTestDir = "/tmp/metaCreateTablesTest";
+
+class MetaCreateTablesEnv : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    taosRemoveDir(kMetaTestDir);
+    taosMkDir(kMetaTestDir);
+
+    pVnode = (SVnode *)taosMemoryCalloc(1, sizeof(SVnode));
+    pVnode->path = (char *)kMetaTestDir;
+    pVnode->config.vgId = 2;
+    pVnode->config.szPage = 4096;
+    pVnode->config.szCache = 256;
+    ASSERT_EQ(metaOpen(pVnode, &pVnode->pMeta, 0), 0);
+    ASSERT_EQ(metaBegin(pVnode->pMeta, META_BEGIN_HEAP_OS), 0);
+    pMeta = pVnode->pMeta;
+  }
+
+  void TearDown() override {
+    for (SVCreateTbReq &req : reqs) {
+      taosMemoryFree(req.name);
+      taosMemoryFree(req.ctb.pTag);
+    }
+    metaClose(&pVnode->pMeta);
+    taosMemoryFree(pVnode);
+    taosRemoveDir(kMetaTestDir);
+  }
+
+  // a super table with a timestamp column and an indexed int tag
+  void createStb(const char *name, tb_uid_t suid) {
+    SSchema columns[2] = {{.type = TSDB_DATA_TYPE_TIMESTAMP, .colId = 1, .bytes = 8},
+                          {.type = TSDB_DATA_TYPE_INT, .colId = 2, .bytes = 4}};
+    SSchema tags[1] = {{.type = TSDB_DATA_TYPE_INT, .flags = COL_IDX_ON, .colId = 3, .bytes = 4}};
+    strcpy(columns[0].name, "ts");
+    strcpy(columns[1].name, "v");
+    strcpy(tags[0].name, "t");
+
+    SVCreateStbReq req = {0};
+    req.name = (char *)name;
+    req.suid = suid;
+    req.schemaRow = {.nCols = 2, .version = 1, .pSchema = columns};
+    req.schemaTag = {.nCols = 1, .version = 1, .pSchema = tags};
+    ASSERT_EQ(metaCreateSTable(pMeta, ver++, &req), 0);
+    stbs.push_back(name);
+  }
+
+  void addCtb(const char *name, tb_uid_t uid, int32_t iStb, tb_uid_t suid, int32_t tag) {
+    SVCreateTbReq req = {0};
+    req.name = taosStrdup(name);
+    req.uid = uid;
+    req.btime = 1000 + uid;
+    req.type = TSDB_CHILD_TABLE;
+    req.ctb.stbName = (char *)stbs[iStb];
+    req.ctb.suid = suid;
+
+    STag   *pTag = NULL;
+    SArray *pTagVals = taosArrayInit(1, sizeof(STagVal));
+    STagVal tagVal = {.cid = 3, .type = TSDB_DATA_TYPE_INT};
+    tagVal.i64 = tag;
+    taosArrayPush(pTagVals, &tagVal);
+    EXPECT_EQ(tTagNew(pTagVals, 1, false, &pTag), 0);
+    taosArrayDestroy(pTagVals);
+    req.ctb.pTag = (uint8_t *)pTag;
+    reqs.push_back(req);
+  }
+
+  int32_t createBatch(std::vector<int32_t> &codes) {
+    std::vector<SVCreateTbReq *> ppReqs;
+    for (SVCreateTbReq &req : reqs) ppReqs.push_back(&req);
+    codes.assign(reqs.size(), -1);
+    std::vector<STableMetaRsp *> rsps(reqs.size(), nullptr);
+
+    int32_t ret = metaCreateTables(pMeta, ver++, ppReqs.data(), ppReqs.size(), codes.data(), rsps.data());
+    for (size_t i = 0; i < rsps.size(); i++) {
+      EXPECT_EQ(rsps[i] != nullptr, codes[i] == TSDB_CODE_SUCCESS);
+      taosMemoryFree(rsps[i]);
+    }
+    return ret;
+  }
+
+  tb_uid_t uidOf(const char *name) {
+    SMetaReader mr = {0};
+    tb_uid_t    uid = 0;
+    metaReaderDoInit(&mr, pMeta, 0);
+    if (metaGetTableEntryByName(&mr, name) == 0) uid = mr.me.uid;
+    metaReaderClear(&mr);
+    return uid;
+  }
+
+  int64_t numOfCtbs(tb_uid_t suid) {
+    int64_t      num = 0;
+    SMCtbCursor *pCur = metaOpenCtbCursor(pVnode, suid, 1);
+    while (metaCtbCursorNext(pCur) != 0) num++;
+    metaCloseCtbCursor(pCur);
+    return num;
+  }
+
+  // keys of the tag index for the super table and the tag value
+  int64_t numOfTagged(tb_uid_t suid, int32_t tag) {
+    int64_t num = 0;
+    TBC    *pCur = NULL;
+    void   *pKey = NULL;
+    int     nKey = 0;
+
+    EXPECT_EQ(tdbTbcOpen(pMeta->pTagIdx, &pCur, NULL), 0);
+    tdbTbcMoveToFirst(pCur);
+    while (tdbTbcNext(pCur, &pKey, &nKey, NULL, NULL) == 0) {
+      STagIdxKey *pTagIdxKey = (STagIdxKey *)pKey;
+      if (pTagIdxKey->suid == suid && *(int32_t *)pTagIdxKey->data == tag) num++;
+    }
+    tdbFree(pKey);
+    tdbTbcClose(pCur);
+    return num;
+  }
+
+  SVnode                   *pVnode = NULL;
+  SMeta                    *pMeta = NULL;
+  int64_t                   ver = 1;
+  std::vector<const char *> stbs;
+  std::vector<SVCreateTbReq> reqs;
+};
+
+}  // namespace
+
+// child tables of several super tables are created in one batch
+TEST_F(MetaCreateTablesEnv, severalStbs) {
+  createStb("st0", 100);
+  createStb("st1", 200);
+  createStb("st2", 300);
+
+  for (int32_t i = 0; i < 30; i++) {
+    std::string name = "ct" + std::to_string(i);
+    addCtb(name.c_str(), 1000 + i, i % 3, (i % 3 + 1) * 100, i % 2);
+  }
+
+  std::vector<int32_t> codes;
+  ASSERT_EQ(createBatch(codes), 0);
+  for (int32_t code : codes) EXPECT_EQ(code, TSDB_CODE_SUCCESS);
+
+  EXPECT_EQ(pVnode->config.vndStats.numOfCTables, 30);
+  EXPECT_EQ(pVnode->config.vndStats.numOfTimeSeries, 30);
+  for (int32_t iStb = 0; iStb < 3; iStb++) {
+    tb_uid_t suid = (iStb + 1) * 100;
+    int64_t  numOfTables = 0;
+    EXPECT_EQ(metaGetStbStats(pVnode, suid, &numOfTables, NULL), 0);
+    EXPECT_EQ(numOfTables, 10);
+    EXPECT_EQ(numOfCtbs(suid), 10);
+    EXPECT_EQ(numOfTagged(suid, 0) + numOfTagged(suid, 1), 10);
+  }
+  for (int32_t i = 0; i < 30; i++) {
+    std::string name = "ct" + std::to_string(i);
+    EXPECT_EQ(uidOf(name.c_str()), 1000 + i);
+  }
+}
+
+// a duplicate name resolves to the first request, a failing entry is undone and the others of the batch go on
+TEST_F(MetaCreateTablesEnv, duplicateAndFailure) {
+  createStb("st0", 100);
+  createStb("st1", 200);
+
+  // a table saved at the version of the next batch, so the entry reusing its uid fails to be saved
+  addCtb("old", 2000, 0, 100, 7);
+  std::vector<int32_t> codes;
+  ver = 10;
+  ASSERT_EQ(createBatch(codes), 0);
+  ASSERT_EQ(codes[0], TSDB_CODE_SUCCESS);
+  ver = 10;
+  for (SVCreateTbReq &req : reqs) {
+    taosMemoryFree(req.name);
+    taosMemoryFree(req.ctb.pTag);
+  }
+  reqs.clear();
+
+  addCtb("a0", 3000, 0, 100, 1);
+  addCtb("b0", 3001, 1, 200, 1);
+  addCtb("a1", 3002, 0, 100, 1);
+  addCtb("a0", 3003, 0, 100, 1);    // duplicate of the first request
+  addCtb("bad", 2000, 1, 200, 1);   // fails, uid of "old" at the same version
+  addCtb("bad", 3004, 1, 200, 1);   // duplicate of the failed request
+  addCtb("b1", 3005, 1, 200, 1);
+  addCtb("a0", 3006, 1, 200, 1);    // same name in another super table
+  ASSERT_EQ(createBatch(codes), 0);
+
+  EXPECT_EQ(codes[0], TSDB_CODE_SUCCESS);
+  EXPECT_EQ(codes[1], TSDB_CODE_SUCCESS);
+  EXPECT_EQ(codes[2], TSDB_CODE_SUCCESS);
+  EXPECT_EQ(codes[3], TSDB_CODE_TDB_TABLE_ALREADY_EXIST);
+  EXPECT_EQ(reqs[3].uid, 3000);
+  EXPECT_NE(codes[4], TSDB_CODE_SUCCESS);
+  EXPECT_NE(codes[4], TSDB_CODE_TDB_TABLE_ALREADY_EXIST);
+  EXPECT_EQ(codes[5], codes[4]);
+  EXPECT_EQ(codes[6], TSDB_CODE_SUCCESS);
+  EXPECT_EQ(codes[7], TSDB_CODE_TDB_TABLE_IN_OTHER_STABLE);
+
+  // nothing is left of the failed entry, and the table it collided with is intact
+  EXPECT_EQ(uidOf("bad"), 0);
+  EXPECT_EQ(uidOf("old"), 2000);
+  EXPECT_EQ(uidOf("a0"), 3000);
+  EXPECT_EQ(uidOf("b1"), 3005);
+
+  // stats and indexes count the tables created only
+  EXPECT_EQ(pVnode->config.vndStats.numOfCTables, 5);
+  int64_t numOfTables = 0;
+  EXPECT_EQ(metaGetStbStats(pVnode, 100, &numOfTables, NULL), 0);
+  EXPECT_EQ(numOfTables, 3);
+  EXPECT_EQ(metaGetStbStats(pVnode, 200, &numOfTables, NULL), 0);
+  EXPECT_EQ(numOfTables, 2);
+  EXPECT_EQ(numOfCtbs(100), 3);
+  EXPECT_EQ(numOfCtbs(200), 2);
+  EXPECT_EQ(numOfTagged(200, 1), 2);
+}
@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "meta.h"
+
+namespace {
+
+const char    *kMetaTestDir = "/tmp/metaTagColTest";
+const tb_uid_t kSuid = 100;
+
+// the tags of a child table: an int tag t1 and a varchar tag t2, empty t2 stands for null
+struct TagRow {
+  tb_uid_t    uid;
+  int32_t     t1;
+  std::string t2;
+
+  bool operator==(const TagRow &o) const { return std::tie(uid, t1, t2) == std::tie(o.uid, o.t1, o.t2); }
+};
+
+class MetaTagColEnv : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    taosRemoveDir(kMetaTestDir);
+    taosMkDir(kMetaTestDir);
+    oldTagColumnCache = tsTagColumnCache;
+    tsTagColumnCache = true;
+
+    pVnode = (SVnode *)taosMemoryCalloc(1, sizeof(SVnode));
+    pVnode->path = (char *)kMetaTestDir;
+    pVnode->config.vgId = 2;
+    pVnode->config.szPage = 4096;
+    pVnode->config.szCache = 256;
+    ASSERT_EQ(metaOpen(pVnode, &pVnode->pMeta, 0), 0);
+    ASSERT_EQ(metaBegin(pVnode->pMeta, META_BEGIN_HEAP_OS), 0);
+    pMeta = pVnode->pMeta;
+    alterStb(1);
+  }
+
+  void TearDown() override {
+    metaClose(&pVnode->pMeta);
+    taosMemoryFree(pVnode);
+    taosRemoveDir(kMetaTestDir);
+    tsTagColumnCache = oldTagColumnCache;
+  }
+
+  // creates the super table at tag schema version 1, later versions add a tag t3
+  void alterStb(int32_t sver) {
+    SSchema columns[2] = {{.type = TSDB_DATA_TYPE_TIMESTAMP, .colId = 1, .bytes = 8},
+                          {.type = TSDB_DATA_TYPE_INT, .colId = 2, .bytes = 4}};
+    SSchema tags[3] = {{.type = TSDB_DATA_TYPE_INT, .colId = 3, .bytes = 4},
+                       {.type = TSDB_DATA_TYPE_VARCHAR, .colId = 4, .bytes = 16 + VARSTR_HEADER_SIZE},
+                       {.type = TSDB_DATA_TYPE_INT, .colId = 5, .bytes = 4}};
+    strcpy(columns[0].name, "ts");
+    strcpy(columns[1].name, "v");
+    strcpy(tags[0].name, "t1");
+    strcpy(tags[1].name, "t2");
+    strcpy(tags[2].name, "t3");
+
+    SVCreateStbReq req = {0};
+    req.name = (char *)"st";
+    req.suid = kSuid;
+    req.schemaRow = {.nCols = 2, .version = 1, .pSchema = columns};
+    req.schemaTag = {.nCols = sver > 1 ? 3 : 2, .version = sver, .pSchema = tags};
+    if (sver == 1) {
+      ASSERT_EQ(metaCreateSTable(pMeta, ver++, &req), 0);
+    } else {
+      ASSERT_EQ(metaAlterSTable(pMeta, ver++, &req), 0);
+    }
+  }
+
+  static std::string nameOf(tb_uid_t uid) { return "ct" + std::to_string(uid); }
+
+  void createCtb(tb_uid_t uid, int32_t t1, const std::string &t2) {
+    std::string   name = nameOf(uid);
+    SVCreateTbReq req = {0};
+    req.name = (char *)name.c_str();
+    req.uid = uid;
+    req.btime = 1000;
+    req.type = TSDB_CHILD_TABLE;
+    req.ctb.stbName = (char *)"st";
+    req.ctb.suid = kSuid;
+
+    STag   *pTag = NULL;
+    SArray *pTagVals = taosArrayInit(2, sizeof(STagVal));
+    STagVal tagVal = {.cid = 3, .type = TSDB_DATA_TYPE_INT};
+    tagVal.i64 = t1;
+    taosArrayPush(pTagVals, &tagVal);
+    if (!t2.empty()) {
+      tagVal = {.cid = 4, .type = TSDB_DATA_TYPE_VARCHAR};
+      tagVal.pData = (uint8_t *)t2.data();
+      tagVal.nData = t2.size();
+      taosArrayPush(pTagVals, &tagVal);
+    }
+    ASSERT_EQ(tTagNew(pTagVals, 1, false, &pTag), 0);
+    taosArrayDestroy(pTagVals);
+    req.ctb.pTag = (uint8_t *)pTag;
+
+    EXPECT_EQ(metaCreateTable(pMeta, ver++, &req, NULL), 0);
+    taosMemoryFree(pTag);
+  }
+
+  void dropCtb(tb_uid_t uid) {
+    std::string name = nameOf(uid);
+    SVDropTbReq req = {.name = (char *)name.c_str(), .suid = kSuid};
+    EXPECT_EQ(metaDropTable(pMeta, ver++, &req, NULL, NULL), 0);
+  }
+
+  void retagCtb(tb_uid_t uid, const char *tagName, const std::string &val) {
+    std::string  name = nameOf(uid);
+    int32_t      i32 = 0;
+    SVAlterTbReq req = {0};
+    req.tbName = (char *)name.c_str();
+    req.action = TSDB_ALTER_TABLE_UPDATE_TAG_VAL;
+    req.tagName = (char *)tagName;
+    if (strcmp(tagName, "t1") == 0) {
+      i32 = std::stoi(val);
+      req.pTagVal = (uint8_t *)&i32;
+      req.nTagVal = sizeof(i32);
+    } else {
+      req.isNull = val.empty();
+      req.pTagVal = (uint8_t *)val.data();
+      req.nTagVal = val.size();
+    }
+    EXPECT_EQ(metaAlterTable(pMeta, ver++, &req, NULL), 0);
+  }
+
+  // the tags as the ctb.idx path decodes them
+  std::vector<TagRow> rowsOfCtbIdx() {
+    std::vector<TagRow> rows;
+    SMCtbCursor        *pCur = metaOpenCtbCursor(pVnode, kSuid, 1);
+    while (1) {
+      tb_uid_t uid = metaCtbCursorNext(pCur);
+      if (uid == 0) break;
+
+      TagRow  row = {uid, 0, ""};
+      STagVal tagVal = {.cid = 3};
+      if (tTagGet((STag *)pCur->pVal, &tagVal)) row.t1 = (int32_t)tagVal.i64;
+      tagVal = {.cid = 4};
+      if (tTagGet((STag *)pCur->pVal, &tagVal)) row.t2.assign((char *)tagVal.pData, tagVal.nData);
+      rows.push_back(row);
+    }
+    metaCloseCtbCursor(pCur);
+    return rows;
+  }
+
+  static const SMetaTagColumn *columnOf(const SMetaTagCols *pCols, int16_t cid) {
+    for (int32_t iCol = 0; iCol < pCols->nCols; iCol++) {
+      if (pCols->aCol[iCol].cid == cid) return &pCols->aCol[iCol];
+    }
+    return nullptr;
+  }
+
+  static std::string dictValue(const SMetaTagColumn *pCol, int32_t code) {
+    const char *pVal = pCol->pDict + pCol->aDictOffset[code];
+    return std::string(varDataVal(pVal), varDataLen(pVal));
+  }
+
+  static std::vector<TagRow> rowsOfCols(const SMetaTagCols *pCols) {
+    std::vector<TagRow>   rows;
+    const SMetaTagColumn *pCol1 = columnOf(pCols, 3);
+    const SMetaTagColumn *pCol2 = columnOf(pCols, 4);
+    for (int32_t iRow = 0; iRow < pCols->nRows; iRow++) {
+      TagRow row = {pCols->aUid[iRow], 0, ""};
+      if (!META_TAG_COL_IS_NULL(pCol1, iRow)) row.t1 = ((int32_t *)pCol1->pData)[iRow];
+      if (!META_TAG_COL_IS_NULL(pCol2, iRow)) row.t2 = dictValue(pCol2, pCol2->aCode[iRow]);
+      rows.push_back(row);
+    }
+    return rows;
+  }
+
+  void expectSameAsCtbIdx() {
+    SMetaTagCols *pCols = metaAcquireTagCols(pVnode, kSuid);
+    ASSERT_NE(pCols, nullptr);
+    EXPECT_EQ(rowsOfCols(pCols), rowsOfCtbIdx());
+    metaReleaseTagCols(pVnode, pCols);
+  }
+
+  SVnode *pVnode = NULL;
+  SMeta  *pMeta = NULL;
+  int64_t ver = 1;
+  bool    oldTagColumnCache;
+};
+
+}  // namespace
+
+TEST_F(MetaTagColEnv, build) {
+  for (tb_uid_t uid = 1000; uid < 1100; uid++) {
+    createCtb(uid, uid % 7, uid % 5 == 0 ? "" : "v" + std::to_string(uid % 3));
+  }
+
+  SMetaTagCols *pCols = metaAcquireTagCols(pVnode, kSuid);
+  ASSERT_NE(pCols, nullptr);
+  EXPECT_EQ(pCols->suid, kSuid);
+  EXPECT_EQ(pCols->sver, 1);
+  EXPECT_EQ(pCols->nRows, 100);
+  EXPECT_EQ(columnOf(pCols, 4)->nDict, 3);
+  EXPECT_EQ(rowsOfCols(pCols), rowsOfCtbIdx());
+
+  // nothing changed, the same vectors are shared
+  SMetaTagCols *pAgain = metaAcquireTagCols(pVnode, kSuid);
+  EXPECT_EQ(pAgain, pCols);
+  metaReleaseTagCols(pVnode, pAgain);
+  metaReleaseTagCols(pVnode, pCols);
+
+  EXPECT_EQ(metaAcquireTagCols(pVnode, 12345), nullptr);
+}
+
+// created, dropped and retagged child tables are applied to the vectors in place once no query reads them
+TEST_F(MetaTagColEnv, applyInPlace) {
+  for (tb_uid_t uid = 1000; uid < 1200; uid += 10) {
+    createCtb(uid, 1, "a");
+  }
+  SMetaTagCols *pCols = metaAcquireTagCols(pVnode, kSuid);
+  ASSERT_NE(pCols, nullptr);
+  metaReleaseTagCols(pVnode, pCols);
+
+  createCtb(995, 2, "b");   // before the first row
+  createCtb(1055, 3, "");   // between rows
+  createCtb(1500, 4, "c");  // after the last row
+  dropCtb(1000);
+  dropCtb(1100);
+  dropCtb(1190);
+  retagCtb(1010, "t1", "9");
+  retagCtb(1020, "t2", "z");
+  retagCtb(1030, "t2", "");
+  createCtb(1101, 5, "a");  // created then dropped
+  dropCtb(1101);
+
+  SMetaTagCols *pApplied = metaAcquireTagCols(pVnode, kSuid);
+  ASSERT_NE(pApplied, nullptr);
+  EXPECT_EQ(pApplied, pCols);
+  EXPECT_EQ(pApplied->nRows, 20);
+  EXPECT_EQ(rowsOfCols(pApplied), rowsOfCtbIdx());
+  metaReleaseTagCols(pVnode, pApplied);
+}
+
+// vectors a query still reads stay as they were, the changes go to a copy
+TEST_F(MetaTagColEnv, applyToCopy) {
+  for (tb_uid_t uid = 1000; uid < 1050; uid++) {
+    createCtb(uid, uid % 4, "v" + std::to_string(uid % 4));
+  }
+  SMetaTagCols       *pOld = metaAcquireTagCols(pVnode, kSuid);
+  ASSERT_NE(pOld, nullptr);
+  std::vector<TagRow> oldRows = rowsOfCols(pOld);
+
+  dropCtb(1000);
+  createCtb(1050, 7, "new");
+  retagCtb(1020, "t2", "w");
+
+  SMetaTagCols *pNew = metaAcquireTagCols(pVnode, kSuid);
+  ASSERT_NE(pNew, nullptr);
+  EXPECT_NE(pNew, pOld);
+  EXPECT_EQ(rowsOfCols(pOld), oldRows);
+  EXPECT_EQ(rowsOfCols(pNew), rowsOfCtbIdx());
+  metaReleaseTagCols(pVnode, pOld);
+  metaReleaseTagCols(pVnode, pNew);
+
+  expectSameAsCtbIdx();
+}
+
+// a new tag schema version drops the vectors, the next reader builds them for the new schema
+TEST_F(MetaTagColEnv, schemaVersionChange) {
+  for (tb_uid_t uid = 1000; uid < 1020; uid++) {
+    createCtb(uid, uid, "a");
+  }
+  SMetaTagCols *pOld = metaAcquireTagCols(pVnode, kSuid);
+  ASSERT_NE(pOld, nullptr);
+  EXPECT_EQ(pOld->sver, 1);
+  EXPECT_EQ(pOld->nCols, 2);
+
+  alterStb(2);
+  SMetaTagCols *pNew = metaAcquireTagCols(pVnode, kSuid);
+  ASSERT_NE(pNew, nullptr);
+  EXPECT_NE(pNew, pOld);
+  EXPECT_EQ(pNew->sver, 2);
+  EXPECT_EQ(pNew->nCols, 3);
+  EXPECT_EQ(rowsOfCols(pNew), rowsOfCtbIdx());
+  for (int32_t iRow = 0; iRow < pNew->nRows; iRow++) {
+    EXPECT_TRUE(META_TAG_COL_IS_NULL(columnOf(pNew, 5), iRow));
+  }
+
+  // the old vectors live on until their last reader is done
+  EXPECT_EQ(pOld->nRows, 20);
+  metaReleaseTagCols(pVnode, pOld);
+  metaReleaseTagCols(pVnode, pNew);
+}
+
+// a filter evaluated on the vectors selects the same child tables as one on the tags decoded from ctb.idx
+TEST_F(MetaTagColEnv, tagFilter) {
+  for (tb_uid_t uid = 1000; uid < 1300; uid++) {
+    createCtb(uid, uid % 10, uid % 11 == 0 ? "" : "g" + std::to_string(uid % 6));
+  }
+  for (tb_uid_t uid = 1000; uid < 1300; uid += 7) {
+    retagCtb(uid, "t2", "g1");
+  }
+  for (tb_uid_t uid = 1003; uid < 1300; uid += 13) {
+    dropCtb(uid);
+  }
+
+  // t1 > 4 and t2 = 'g1'
+  std::vector<tb_uid_t> expected;
+  for (const TagRow &row : rowsOfCtbIdx()) {
+    if (row.t1 > 4 && row.t2 == "g1") expected.push_back(row.uid);
+  }
+
+  SMetaTagCols *pCols = metaAcquireTagCols(pVnode, kSuid);
+  ASSERT_NE(pCols, nullptr);
+  const SMetaTagColumn *pCol1 = columnOf(pCols, 3);
+  const SMetaTagColumn *pCol2 = columnOf(pCols, 4);
+  int32_t               code = -1;
+  for (int32_t iDict = 0; iDict < pCol2->nDict; iDict++) {
+    if (dictValue(pCol2, iDict) == "g1") code = iDict;
+  }
+  ASSERT_GE(code, 0);
+
+  std::vector<tb_uid_t> selected;
+  for (int32_t iRow = 0; iRow < pCols->nRows; iRow++) {
+    if (META_TAG_COL_IS_NULL(pCol1, iRow) || META_TAG_COL_IS_NULL(pCol2, iRow)) continue;
+    if (((int32_t *)pCol1->pData)[iRow] > 4 && pCol2->aCode[iRow] == code) selected.push_back(pCols->aUid[iRow]);
+  }
+  metaReleaseTagCols(pVnode, pCols);
+
+  EXPECT_FALSE(expected.empty());
+  EXPECT_EQ(selected, expected);
+}
+
+// child tables created and retagged while the vectors are built, in batches without the meta lock, are not lost
+TEST_F(MetaTagColEnv, changesDuringBuild) {
+  const tb_uid_t baseUid = 10000;
+  const int32_t  numOfTables = 10000;
+  for (tb_uid_t uid = 0; uid < numOfTables; uid++) {
+    createCtb(baseUid + uid * 2, uid % 100, "v" + std::to_string(uid % 50));
+  }
+
+  std::atomic<bool> done(false);
+  std::thread       writer([&]() {
+    for (tb_uid_t uid = 0; uid < 2000; uid++) {
+      createCtb(baseUid + uid * 2 + 1, 1, "odd");
+      if (uid % 5 == 0) retagCtb(baseUid + uid * 4, "t2", "moved");
+    }
+    done = true;
+  });
+
+  int32_t numOfAcquired = 0;
+  bool    ordered = true;
+  while (!done) {
+    SMetaTagCols *pCols = metaAcquireTagCols(pVnode, kSuid);
+    if (pCols) {
+      numOfAcquired++;
+      for (int32_t iRow = 1; iRow < pCols->nRows; iRow++) {
+        ordered = ordered && pCols->aUid[iRow - 1] < pCols->aUid[iRow];
+      }
+      metaReleaseTagCols(pVnode, pCols);
+    }
+  }
+  writer.join();
+
+  EXPECT_GT(numOfAcquired, 0);
+  EXPECT_TRUE(ordered);
+  expectSameAsCtbIdx();
+  SMetaTagCols *pCols = metaAcquireTagCols(pVnode, kSuid);
+  ASSERT_NE(pCols, nullptr);
+  EXPECT_EQ(pCols->nRows, numOfTables + 2000);
+  metaReleaseTagCols(pVnode, pCols);
+}
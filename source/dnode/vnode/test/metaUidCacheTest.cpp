@@ -0,0 +1,386 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "meta.h"
+
+namespace {
+
+const char    *kMetaTestDir = "/tmp/metaUidCacheTest";
+const tb_uid_t kSuid = 100;
+
+// the digest of the tag condition t = 1
+const uint8_t kDigest[16] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+
+// a uid list as looked up from the cache
+struct CachedList {
+  bool                  acquired;
+  int64_t               ver;
+  std::vector<uint64_t> uids;
+  std::vector<uint64_t> changed;
+};
+
+class MetaUidCacheEnv : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    taosRemoveDir(kMetaTestDir);
+    taosMkDir(kMetaTestDir);
+    oldTagFilterCache = tsTagFilterCache;
+    tsTagFilterCache = 1;
+
+    pVnode = (SVnode *)taosMemoryCalloc(1, sizeof(SVnode));
+    pVnode->path = (char *)kMetaTestDir;
+    pVnode->config.vgId = 2;
+    pVnode->config.szPage = 4096;
+    pVnode->config.szCache = 256;
+    openMeta(0);
+    createStb();
+  }
+
+  void TearDown() override {
+    metaClose(&pVnode->pMeta);
+    taosMemoryFree(pVnode);
+    taosRemoveDir(kMetaTestDir);
+    tsTagFilterCache = oldTagFilterCache;
+  }
+
+  void openMeta(int64_t committed) {
+    pVnode->state.committed = committed;
+    ASSERT_EQ(metaOpen(pVnode, &pVnode->pMeta, 0), 0);
+    ASSERT_EQ(metaBegin(pVnode->pMeta, META_BEGIN_HEAP_OS), 0);
+    pMeta = pVnode->pMeta;
+  }
+
+  void reopenMeta(int64_t committed) {
+    metaClose(&pVnode->pMeta);
+    openMeta(committed);
+  }
+
+  void createStb() {
+    SSchema columns[2] = {{.type = TSDB_DATA_TYPE_TIMESTAMP, .colId = 1, .bytes = 8},
+                          {.type = TSDB_DATA_TYPE_INT, .colId = 2, .bytes = 4}};
+    SSchema tags[1] = {{.type = TSDB_DATA_TYPE_INT, .colId = 3, .bytes = 4}};
+    strcpy(columns[0].name, "ts");
+    strcpy(columns[1].name, "v");
+    strcpy(tags[0].name, "t");
+
+    SVCreateStbReq req = {0};
+    req.name = (char *)"st";
+    req.suid = kSuid;
+    req.schemaRow = {.nCols = 2, .version = 1, .pSchema = columns};
+    req.schemaTag = {.nCols = 1, .version = 1, .pSchema = tags};
+    ASSERT_EQ(metaCreateSTable(pMeta, ver++, &req), 0);
+  }
+
+  static std::string nameOf(tb_uid_t uid) { return "ct" + std::to_string(uid); }
+
+  void createCtb(tb_uid_t uid, int32_t tag) {
+    std::string   name = nameOf(uid);
+    SVCreateTbReq req = {0};
+    req.name = (char *)name.c_str();
+    req.uid = uid;
+    req.btime = 1000;
+    req.type = TSDB_CHILD_TABLE;
+    req.ctb.stbName = (char *)"st";
+    req.ctb.suid = kSuid;
+
+    STag   *pTag = NULL;
+    SArray *pTagVals = taosArrayInit(1, sizeof(STagVal));
+    STagVal tagVal = {.cid = 3, .type = TSDB_DATA_TYPE_INT};
+    tagVal.i64 = tag;
+    taosArrayPush(pTagVals, &tagVal);
+    ASSERT_EQ(tTagNew(pTagVals, 1, false, &pTag), 0);
+    taosArrayDestroy(pTagVals);
+    req.ctb.pTag = (uint8_t *)pTag;
+
+    EXPECT_EQ(metaCreateTable(pMeta, ver++, &req, NULL), 0);
+    taosMemoryFree(pTag);
+  }
+
+  void dropCtb(tb_uid_t uid) {
+    std::string name = nameOf(uid);
+    SVDropTbReq req = {.name = (char *)name.c_str(), .suid = kSuid};
+    EXPECT_EQ(metaDropTable(pMeta, ver++, &req, NULL, NULL), 0);
+  }
+
+  void retagCtb(tb_uid_t uid, int32_t tag) {
+    std::string  name = nameOf(uid);
+    SVAlterTbReq req = {0};
+    req.tbName = (char *)name.c_str();
+    req.action = TSDB_ALTER_TABLE_UPDATE_TAG_VAL;
+    req.tagName = (char *)"t";
+    req.pTagVal = (uint8_t *)&tag;
+    req.nTagVal = sizeof(tag);
+    EXPECT_EQ(metaAlterTable(pMeta, ver++, &req, NULL), 0);
+  }
+
+  // whether the child table exists and is selected by t = 1
+  bool selected(uint64_t uid) {
+    SCtbIdxKey key = {.suid = kSuid, .uid = (tb_uid_t)uid};
+    void      *pVal = NULL;
+    int        nVal = 0;
+    bool       found = false;
+    if (tdbTbGet(pMeta->pCtbIdx, &key, sizeof(key), &pVal, &nVal) == 0) {
+      STagVal tagVal = {.cid = 3};
+      found = tTagGet((STag *)pVal, &tagVal) && (int32_t)tagVal.i64 == 1;
+    }
+    tdbFree(pVal);
+    return found;
+  }
+
+  // the uid list of t = 1 built from ctb.idx, as the executor does on a cache miss
+  std::vector<uint64_t> filter() {
+    std::vector<uint64_t> uids;
+    SMCtbCursor          *pCur = metaOpenCtbCursor(pVnode, kSuid, 1);
+    std::vector<uint64_t> all;
+    while (1) {
+      tb_uid_t uid = metaCtbCursorNext(pCur);
+      if (uid == 0) break;
+      all.push_back(uid);
+    }
+    metaCloseCtbCursor(pCur);
+    for (uint64_t uid : all) {
+      if (selected(uid)) uids.push_back(uid);
+    }
+    return uids;
+  }
+
+  // the list cached for the changed child tables, as the executor patches it on a hit
+  std::vector<uint64_t> patch(std::vector<uint64_t> uids, const std::vector<uint64_t> &changed) {
+    for (uint64_t uid : changed) {
+      uids.erase(std::remove(uids.begin(), uids.end(), uid), uids.end());
+      if (selected(uid)) uids.push_back(uid);
+    }
+    std::sort(uids.begin(), uids.end());
+    return uids;
+  }
+
+  CachedList lookup() {
+    CachedList list = {false, 0};
+    SArray    *pList = taosArrayInit(8, sizeof(uint64_t));
+    SArray    *pChanged = taosArrayInit(8, sizeof(uint64_t));
+    EXPECT_EQ(metaGetCachedTableUidList(pVnode, kSuid, kDigest, sizeof(kDigest), pList, pChanged, &list.ver,
+                                        &list.acquired),
+              0);
+    for (int32_t i = 0; i < taosArrayGetSize(pList); i++) list.uids.push_back(*(uint64_t *)taosArrayGet(pList, i));
+    for (int32_t i = 0; i < taosArrayGetSize(pChanged); i++) {
+      list.changed.push_back(*(uint64_t *)taosArrayGet(pChanged, i));
+    }
+    taosArrayDestroy(pList);
+    taosArrayDestroy(pChanged);
+    return list;
+  }
+
+  void put(const std::vector<uint64_t> &uids, int64_t listVer) {
+    int32_t  len = sizeof(int32_t) + uids.size() * sizeof(uint64_t);
+    char    *pPayload = (char *)taosMemoryMalloc(len);
+    *(int32_t *)pPayload = uids.size();
+    if (!uids.empty()) memcpy(pPayload + sizeof(int32_t), uids.data(), uids.size() * sizeof(uint64_t));
+    EXPECT_EQ(metaUidFilterCachePut(pVnode, kSuid, kDigest, sizeof(kDigest), pPayload, len, 0.0, listVer), 0);
+  }
+
+  // a list of t = 1 cached at the current version of the super table
+  void cacheList() {
+    CachedList miss = lookup();
+    ASSERT_FALSE(miss.acquired);
+    put(filter(), miss.ver);
+    ASSERT_TRUE(lookup().acquired);
+  }
+
+  std::string ckptName() { return std::string(pMeta->path) + TD_DIRSEP + "tag_filter.ckpt"; }
+
+  SVnode *pVnode = NULL;
+  SMeta  *pMeta = NULL;
+  int64_t ver = 1;
+  char    oldTagFilterCache;
+};
+
+}  // namespace
+
+// a cached list records the child tables created, dropped and retagged, and is patched for them on the next hit
+TEST_F(MetaUidCacheEnv, patchAfterChanges) {
+  for (tb_uid_t uid = 1000; uid < 1020; uid++) {
+    createCtb(uid, uid % 2);
+  }
+  cacheList();
+
+  createCtb(1020, 1);
+  dropCtb(1001);
+  retagCtb(1003, 0);
+  retagCtb(1004, 1);
+
+  CachedList hit = lookup();
+  ASSERT_TRUE(hit.acquired);
+  EXPECT_EQ(hit.changed, std::vector<uint64_t>({1020, 1001, 1003, 1004}));
+  EXPECT_EQ(hit.uids.size(), 10);
+
+  std::vector<uint64_t> patched = patch(hit.uids, hit.changed);
+  EXPECT_EQ(patched, filter());
+  put(patched, hit.ver);
+
+  CachedList again = lookup();
+  ASSERT_TRUE(again.acquired);
+  EXPECT_TRUE(again.changed.empty());
+  EXPECT_EQ(again.uids, filter());
+}
+
+// a child table changed while a list is built or patched is not lost by the list put afterwards
+TEST_F(MetaUidCacheEnv, changeDuringBuild) {
+  for (tb_uid_t uid = 1000; uid < 1010; uid++) {
+    createCtb(uid, 1);
+  }
+
+  // built from scratch: the list put is outdated, nothing recorded the change for it
+  CachedList miss = lookup();
+  ASSERT_FALSE(miss.acquired);
+  std::vector<uint64_t> built = filter();
+  createCtb(1010, 1);
+  put(built, miss.ver);
+  EXPECT_FALSE(lookup().acquired);
+
+  // patched: the change is carried over from the list cached before
+  cacheList();
+  createCtb(1011, 1);
+  CachedList            hit = lookup();
+  std::vector<uint64_t> patched = patch(hit.uids, hit.changed);
+  dropCtb(1002);
+  put(patched, hit.ver);
+
+  CachedList again = lookup();
+  ASSERT_TRUE(again.acquired);
+  EXPECT_EQ(again.changed, std::vector<uint64_t>({1002}));
+  EXPECT_EQ(patch(again.uids, again.changed), filter());
+}
+
+// a list is dropped once more child tables changed than it records
+TEST_F(MetaUidCacheEnv, tooManyChanges) {
+  for (tb_uid_t uid = 1000; uid < 1010; uid++) {
+    createCtb(uid, 1);
+  }
+  cacheList();
+
+  for (tb_uid_t uid = 2000; uid < 2000 + 1024; uid++) {
+    createCtb(uid, uid % 2);
+  }
+  CachedList hit = lookup();
+  ASSERT_TRUE(hit.acquired);
+  EXPECT_EQ(hit.changed.size(), 1024);
+
+  createCtb(5000, 1);
+  EXPECT_FALSE(lookup().acquired);
+}
+
+// the lists checkpointed at a commit are restored by a meta opened at the same version only
+TEST_F(MetaUidCacheEnv, checkpoint) {
+  for (tb_uid_t uid = 1000; uid < 1010; uid++) {
+    createCtb(uid, uid % 2);
+  }
+  cacheList();
+  createCtb(1010, 1);
+  CachedList cached = lookup();
+  ASSERT_TRUE(cached.acquired);
+
+  metaUidCachePrepareCheckpoint(pMeta, 42);
+  ASSERT_EQ(metaUidCacheSaveCheckpoint(pMeta), 0);
+  reopenMeta(42);
+
+  CachedList restored = lookup();
+  ASSERT_TRUE(restored.acquired);
+  EXPECT_EQ(restored.ver, cached.ver);
+  EXPECT_EQ(restored.uids, cached.uids);
+  EXPECT_EQ(restored.changed, cached.changed);
+
+  // the meta is at another version
+  metaUidCachePrepareCheckpoint(pMeta, 42);
+  ASSERT_EQ(metaUidCacheSaveCheckpoint(pMeta), 0);
+  reopenMeta(43);
+  EXPECT_FALSE(lookup().acquired);
+}
+
+// checkpoints are encoded outside the cache lock while lists are patched, replaced and dropped
+TEST_F(MetaUidCacheEnv, checkpointWhileChanging) {
+  for (tb_uid_t uid = 1000; uid < 1100; uid++) {
+    createCtb(uid, uid % 2);
+  }
+  cacheList();
+
+  std::atomic<bool> done(false);
+  std::thread       writer([&]() {
+    for (tb_uid_t uid = 2000; uid < 3500; uid++) {
+      createCtb(uid, uid % 2);
+    }
+    done = true;
+  });
+  std::thread reader([&]() {
+    while (!done) {
+      CachedList list = lookup();
+      put(list.acquired ? list.uids : std::vector<uint64_t>(), list.ver);
+    }
+  });
+
+  int32_t numOfCkpts = 0;
+  while (!done) {
+    metaUidCachePrepareCheckpoint(pMeta, 42);
+    numOfCkpts++;
+  }
+  writer.join();
+  reader.join();
+  EXPECT_GT(numOfCkpts, 0);
+
+  put(filter(), lookup().ver);
+  CachedList cached = lookup();
+  ASSERT_TRUE(cached.acquired);
+  metaUidCachePrepareCheckpoint(pMeta, 42);
+  ASSERT_EQ(metaUidCacheSaveCheckpoint(pMeta), 0);
+  reopenMeta(42);
+  CachedList restored = lookup();
+  ASSERT_TRUE(restored.acquired);
+  EXPECT_EQ(restored.uids, cached.uids);
+}
+
+TEST_F(MetaUidCacheEnv, corruptedCheckpoint) {
+  for (tb_uid_t uid = 1000; uid < 1010; uid++) {
+    createCtb(uid, 1);
+  }
+  cacheList();
+  metaUidCachePrepareCheckpoint(pMeta, 42);
+  ASSERT_EQ(metaUidCacheSaveCheckpoint(pMeta), 0);
+
+  std::string fname = ckptName();
+  TdFilePtr   pFile = taosOpenFile(fname.c_str(), TD_FILE_READ | TD_FILE_WRITE);
+  ASSERT_NE(pFile, nullptr);
+  int64_t size = 0;
+  ASSERT_EQ(taosFStatFile(pFile, &size, NULL), 0);
+  char byte = 0;
+  taosLSeekFile(pFile, size / 2, SEEK_SET);
+  ASSERT_EQ(taosReadFile(pFile, &byte, 1), 1);
+  byte ^= 0x5a;
+  taosLSeekFile(pFile, size / 2, SEEK_SET);
+  ASSERT_EQ(taosWriteFile(pFile, &byte, 1), 1);
+  taosCloseFile(&pFile);
+
+  reopenMeta(42);
+  EXPECT_FALSE(lookup().acquired);
+
+  // a cache without checkpoint stays usable
+  cacheList();
+}
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "tglobal.h"
+#include "tsdbDataFileRW.h"
+#include "vnd.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+namespace {
+
+const char    *kDataFile = "/tmp/tsdbDataFileRWTest.data";
+const tb_uid_t kSuid = 100;
+const tb_uid_t kUid = 101;
+const int32_t  kNumOfCols = 48;  // besides the primary key
+const int32_t  kNumOfRows = 1000;
+
+int8_t typeOf(int32_t iCol) {
+  static const int8_t types[] = {TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_BIGINT, TSDB_DATA_TYPE_DOUBLE,
+                                 TSDB_DATA_TYPE_VARCHAR};
+  return types[iCol % 4];
+}
+
+// a wide block written to a .data file, read back by column with the vnode-decode pool on or off
+class TsdbDataFileRWEnv : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    oldDecodeThreads = tsNumOfDecodeThreads;
+    oldParallelCols = tsDecodeParallelCols;
+    tsDecodeParallelCols = 16;
+    taosRemoveFile(kDataFile);
+
+    pVnode = (SVnode *)taosMemoryCalloc(1, sizeof(SVnode));
+    pVnode->config.tsdbPageSize = 4096;
+    pTsdb = (STsdb *)taosMemoryCalloc(1, sizeof(STsdb));
+    pTsdb->pVnode = pVnode;
+
+    std::vector<SSchema> schema(kNumOfCols + 1);
+    schema[0] = {.type = TSDB_DATA_TYPE_TIMESTAMP, .colId = PRIMARYKEY_TIMESTAMP_COL_ID, .bytes = 8};
+    for (int32_t iCol = 1; iCol <= kNumOfCols; iCol++) {
+      int8_t type = typeOf(iCol);
+      schema[iCol] = {.type = type, .colId = (col_id_t)(iCol + 1), .bytes = tDataTypes[type].bytes};
+      if (type == TSDB_DATA_TYPE_VARCHAR) schema[iCol].bytes = 32 + VARSTR_HEADER_SIZE;
+    }
+    pTSchema = tBuildTSchema(schema.data(), schema.size(), 1);
+
+    ASSERT_EQ(tBlockDataCreate(&written), 0);
+    writeBlock();
+  }
+
+  void TearDown() override {
+    stopDecodePool();
+    tBlockDataDestroy(&written);
+    taosMemoryFree(pTSchema);
+    taosMemoryFree(pTsdb);
+    taosMemoryFree(pVnode);
+    taosRemoveFile(kDataFile);
+    tsNumOfDecodeThreads = oldDecodeThreads;
+    tsDecodeParallelCols = oldParallelCols;
+  }
+
+  void startDecodePool(int32_t nThreads) {
+    tsNumOfDecodeThreads = nThreads;
+    ASSERT_EQ(vnodeAsyncInit(&vnodeAsyncHandle[2], "vnode-decode"), 0);
+    ASSERT_EQ(vnodeAsyncSetWorkers(vnodeAsyncHandle[2], nThreads), 0);
+  }
+
+  void stopDecodePool() {
+    if (vnodeAsyncHandle[2] != NULL) {
+      vnodeAsyncDestroy(&vnodeAsyncHandle[2]);
+    }
+  }
+
+  // rows with every kind of column: some all null, some with nulls, some with values only
+  void writeBlock() {
+    TABLEID id = {.suid = kSuid, .uid = kUid};
+    ASSERT_EQ(tBlockDataInit(&written, &id, pTSchema, NULL, 0), 0);
+
+    SArray *aColVal = taosArrayInit(kNumOfCols + 1, sizeof(SColVal));
+    for (int32_t iRow = 0; iRow < kNumOfRows; iRow++) {
+      taosArrayClear(aColVal);
+      SColVal tsVal =
+          COL_VAL_VALUE(PRIMARYKEY_TIMESTAMP_COL_ID, TSDB_DATA_TYPE_TIMESTAMP, (SValue){.val = 1000 + iRow});
+      taosArrayPush(aColVal, &tsVal);
+
+      std::string str = "v" + std::to_string(iRow % 17);
+      for (int32_t iCol = 1; iCol <= kNumOfCols; iCol++) {
+        int8_t   type = typeOf(iCol);
+        col_id_t cid = iCol + 1;
+        SColVal  cv;
+        if (iCol % 11 == 0 || (iCol % 3 == 0 && iRow % 5 == 0)) {
+          cv = COL_VAL_NULL(cid, type);
+        } else if (type == TSDB_DATA_TYPE_VARCHAR) {
+          SValue sv = {0};
+          sv.nData = str.size();
+          sv.pData = (uint8_t *)str.data();
+          cv = COL_VAL_VALUE(cid, type, sv);
+        } else {
+          int64_t v = (int64_t)iRow * iCol;
+          if (type == TSDB_DATA_TYPE_DOUBLE) {
+            double d = iRow / (iCol + 0.5);
+            memcpy(&v, &d, sizeof(d));
+          }
+          cv = COL_VAL_VALUE(cid, type, (SValue){.val = v});
+        }
+        taosArrayPush(aColVal, &cv);
+      }
+
+      SRow *pRow = NULL;
+      ASSERT_EQ(tRowBuild(aColVal, pTSchema, &pRow), 0);
+      TSDBROW row = tsdbRowFromTSRow(iRow, pRow);
+      ASSERT_EQ(tBlockDataAppendRow(&written, &row, pTSchema, kUid), 0);
+      tRowDestroy(pRow);
+    }
+    taosArrayDestroy(aColVal);
+
+    // lay the block out as tsdbDataFileWriter does
+    uint8_t *bufArr[5] = {0};
+    int32_t  sizeArr[5] = {0};
+    ASSERT_EQ(tCmprBlockData(&written, TWO_STAGE_COMP, NULL, NULL, bufArr, sizeArr), 0);
+
+    record = {0};
+    record.suid = kSuid;
+    record.uid = kUid;
+    record.numRow = written.nRow;
+    record.blockOffset = 0;
+    record.blockKeySize = sizeArr[3] + sizeArr[2];
+    record.blockSize = sizeArr[0] + sizeArr[1] + record.blockKeySize;
+
+    STsdbFD *fd = NULL;
+    ASSERT_EQ(tsdbOpenFile(kDataFile, pTsdb, TD_FILE_READ | TD_FILE_WRITE | TD_FILE_CREATE | TD_FILE_TRUNC, &fd), 0);
+    int64_t offset = 0;
+    for (int32_t i = 3; i >= 0; --i) {
+      if (sizeArr[i]) {
+        ASSERT_EQ(tsdbWriteFile(fd, offset, bufArr[i], sizeArr[i]), 0);
+        offset += sizeArr[i];
+      }
+    }
+    ASSERT_EQ(tsdbFsyncFile(fd), 0);
+    tsdbCloseFile(&fd);
+
+    for (int32_t i = 0; i < 5; i++) tFree(bufArr[i]);
+  }
+
+  void readBlock(SBlockData *pBlockData, int16_t *aCid, int32_t nCid) {
+    const char           *fname[TSDB_FTYPE_MAX] = {0};
+    SDataFileReaderConfig config = {.tsdb = pTsdb, .szPage = pVnode->config.tsdbPageSize};
+    SDataFileReader      *reader = NULL;
+
+    fname[TSDB_FTYPE_DATA] = kDataFile;
+    ASSERT_EQ(tsdbDataFileReaderOpen(fname, &config, &reader), 0);
+    ASSERT_EQ(tsdbDataFileReadBlockDataByColumn(reader, &record, pBlockData, pTSchema, aCid, nCid), 0);
+    tsdbDataFileReaderClose(&reader);
+  }
+
+  static void expectSameColData(SColData *pColData, SColData *pExpect, int32_t nRow) {
+    ASSERT_EQ(pColData->cid, pExpect->cid);
+    ASSERT_EQ(pColData->nVal, nRow) << "cid " << pColData->cid;
+    EXPECT_EQ(pColData->flag, pExpect->flag) << "cid " << pColData->cid;
+    for (int32_t iRow = 0; iRow < nRow; iRow++) {
+      SColVal cv, expect;
+      tColDataGetValue(pColData, iRow, &cv);
+      tColDataGetValue(pExpect, iRow, &expect);
+      ASSERT_EQ(cv.flag, expect.flag) << "cid " << pColData->cid << " row " << iRow;
+      if (!COL_VAL_IS_VALUE(&cv)) continue;
+      if (IS_VAR_DATA_TYPE(cv.type)) {
+        ASSERT_EQ(std::string((char *)cv.value.pData, cv.value.nData),
+                  std::string((char *)expect.value.pData, expect.value.nData))
+            << "cid " << pColData->cid << " row " << iRow;
+      } else {
+        ASSERT_EQ(cv.value.val, expect.value.val) << "cid " << pColData->cid << " row " << iRow;
+      }
+    }
+  }
+
+  // reads the given columns, or all of them when nCid is 0, and compares them with what was written
+  void checkRead(int16_t *aCid, int32_t nCid) {
+    SBlockData bData = {0};
+    ASSERT_EQ(tBlockDataCreate(&bData), 0);
+    readBlock(&bData, aCid, nCid);
+
+    ASSERT_EQ(bData.nRow, written.nRow);
+    for (int32_t iRow = 0; iRow < bData.nRow; iRow++) {
+      ASSERT_EQ(bData.aTSKEY[iRow], written.aTSKEY[iRow]);
+      ASSERT_EQ(bData.aVersion[iRow], written.aVersion[iRow]);
+    }
+    ASSERT_EQ(bData.nColData, nCid > 0 ? nCid : written.nColData);
+    for (int32_t i = 0; i < bData.nColData; i++) {
+      SColData *pColData = tBlockDataGetColDataByIdx(&bData, i);
+      SColData *pExpect = NULL;
+      tBlockDataGetColData(&written, pColData->cid, &pExpect);
+      ASSERT_NE(pExpect, nullptr);
+      expectSameColData(pColData, pExpect, bData.nRow);
+    }
+    tBlockDataDestroy(&bData);
+  }
+
+  int32_t     oldDecodeThreads;
+  int32_t     oldParallelCols;
+  SVnode     *pVnode = NULL;
+  STsdb      *pTsdb = NULL;
+  STSchema   *pTSchema = NULL;
+  SBlockData  written = {0};
+  SBrinRecord record = {0};
+};
+
+}  // namespace
+
+TEST_F(TsdbDataFileRWEnv, decodeInline) { checkRead(NULL, 0); }
+
+TEST_F(TsdbDataFileRWEnv, decodeOnPool) {
+  startDecodePool(3);
+  checkRead(NULL, 0);
+}
+
+// a block with fewer columns than decodeParallelCols is decoded inline even with the pool on
+TEST_F(TsdbDataFileRWEnv, decodeNarrowOnPool) {
+  startDecodePool(3);
+  int16_t aCid[] = {2, 3, 4, 5, 12};
+  checkRead(aCid, sizeof(aCid) / sizeof(aCid[0]));
+}
+
+TEST_F(TsdbDataFileRWEnv, decodeSomeColsOnPool) {
+  startDecodePool(2);
+  std::vector<int16_t> aCid;
+  for (int16_t cid = 2; cid <= kNumOfCols + 1; cid += 2) aCid.push_back(cid);
+  checkRead(aCid.data(), aCid.size());
+}
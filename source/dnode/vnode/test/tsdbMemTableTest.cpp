@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "tglobal.h"
+#include "tsdb.h"
+#include "vnd.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+namespace {
+
+const tb_uid_t kSuid = 100;
+const tb_uid_t kUid = 101;
+const int16_t  kValColId = 2;
+
+bool keyLess(const TSDBKEY &k1, const TSDBKEY &k2) { return tsdbKeyCmprFn(&k1, &k2) < 0; }
+
+// a memtable on a heap buffer pool, with the last row cache off
+class TsdbMemTableEnv : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    oldChunk = tsMemTableChunk;
+    tsMemTableChunk = true;
+
+    pVnode = (SVnode *)taosMemoryCalloc(1, sizeof(SVnode));
+    pVnode->config.tsdbCfg.slLevel = 5;
+    pVnode->config.cacheLast = 0;
+
+    // an empty anchor node, every allocation gets its own node
+    pPool = (SVBufPool *)taosMemoryCalloc(1, sizeof(SVBufPool));
+    pPool->pVnode = pVnode;
+    pPool->nRef = 1;
+    pPool->ptr = pPool->node.data;
+    pPool->pTail = &pPool->node;
+    pPool->node.pnext = &pPool->pTail;
+    taosThreadMutexInit(&pPool->mutex, NULL);
+    pVnode->inUse = pPool;
+
+    pTsdb = (STsdb *)taosMemoryCalloc(1, sizeof(STsdb));
+    pTsdb->pVnode = pVnode;
+    ASSERT_EQ(tsdbMemTableCreate(pTsdb, &pTsdb->mem), 0);
+
+    SSchema schema[] = {
+        {.type = TSDB_DATA_TYPE_TIMESTAMP, .colId = PRIMARYKEY_TIMESTAMP_COL_ID, .bytes = 8},
+        {.type = TSDB_DATA_TYPE_BIGINT, .colId = kValColId, .bytes = 8},
+    };
+    pTSchema = tBuildTSchema(schema, 2, 1);
+  }
+
+  void TearDown() override {
+    taosMemoryFree(pTsdb->mem->aBucket);
+    taosMemoryFree(pTsdb->mem);
+    vnodeBufPoolReset(pPool);
+    taosThreadMutexDestroy(&pPool->mutex);
+    taosMemoryFree(pPool);
+    taosMemoryFree(pTsdb);
+    taosMemoryFree(pVnode);
+    taosMemoryFree(pTSchema);
+    tsMemTableChunk = oldChunk;
+  }
+
+  // insert rows of one version in row format, or in column format when colFmt
+  void insert(int64_t version, const std::vector<TSKEY> &keys, bool colFmt) {
+    SSubmitTbData submitTbData = {0};
+    submitTbData.suid = kSuid;
+    submitTbData.uid = kUid;
+
+    if (colFmt) {
+      submitTbData.flags = SUBMIT_REQ_COLUMN_DATA_FORMAT;
+      submitTbData.aCol = taosArrayInit(2, sizeof(SColData));
+      SColData *pTsCol = (SColData *)taosArrayReserve(submitTbData.aCol, 1);
+      SColData *pValCol = (SColData *)taosArrayReserve(submitTbData.aCol, 1);
+      tColDataInit(pTsCol, PRIMARYKEY_TIMESTAMP_COL_ID, TSDB_DATA_TYPE_TIMESTAMP, 0);
+      tColDataInit(pValCol, kValColId, TSDB_DATA_TYPE_BIGINT, 0);
+      for (TSKEY ts : keys) {
+        SColVal tsVal = COL_VAL_VALUE(PRIMARYKEY_TIMESTAMP_COL_ID, TSDB_DATA_TYPE_TIMESTAMP, (SValue){.val = ts});
+        SColVal val = COL_VAL_VALUE(kValColId, TSDB_DATA_TYPE_BIGINT, (SValue){.val = version});
+        ASSERT_EQ(tColDataAppendValue(pTsCol, &tsVal), 0);
+        ASSERT_EQ(tColDataAppendValue(pValCol, &val), 0);
+      }
+    } else {
+      submitTbData.aRowP = taosArrayInit(keys.size(), sizeof(SRow *));
+      SArray *aColVal = taosArrayInit(2, sizeof(SColVal));
+      for (TSKEY ts : keys) {
+        taosArrayClear(aColVal);
+        SColVal tsVal = COL_VAL_VALUE(PRIMARYKEY_TIMESTAMP_COL_ID, TSDB_DATA_TYPE_TIMESTAMP, (SValue){.val = ts});
+        SColVal val = COL_VAL_VALUE(kValColId, TSDB_DATA_TYPE_BIGINT, (SValue){.val = version});
+        taosArrayPush(aColVal, &tsVal);
+        taosArrayPush(aColVal, &val);
+        SRow *pRow = NULL;
+        ASSERT_EQ(tRowBuild(aColVal, pTSchema, &pRow), 0);
+        taosArrayPush(submitTbData.aRowP, &pRow);
+      }
+      taosArrayDestroy(aColVal);
+    }
+
+    int32_t affectedRows = 0;
+    ASSERT_EQ(tsdbInsertTableData(pTsdb, version, &submitTbData, &affectedRows), 0);
+    ASSERT_EQ(affectedRows, (int32_t)keys.size());
+
+    if (colFmt) {
+      taosArrayDestroyEx(submitTbData.aCol, tColDataDestroy);
+    } else {
+      for (int32_t i = 0; i < taosArrayGetSize(submitTbData.aRowP); i++) {
+        tRowDestroy(*(SRow **)taosArrayGet(submitTbData.aRowP, i));
+      }
+      taosArrayDestroy(submitTbData.aRowP);
+    }
+
+    for (TSKEY ts : keys) {
+      expected.push_back({.version = version, .ts = ts});
+    }
+    std::sort(expected.begin(), expected.end(), keyLess);
+  }
+
+  STbData *tbData() { return tsdbGetTbDataFromMemTable(pTsdb->mem, kSuid, kUid); }
+
+  // all keys the iterator returns, checking each row carries the value inserted with its version
+  std::vector<TSDBKEY> scan(TSDBKEY *pFrom, int8_t backward) {
+    std::vector<TSDBKEY> keys;
+    STbDataIter          iter = {0};
+
+    tsdbTbDataIterOpen(tbData(), pFrom, backward, &iter);
+    for (TSDBROW *pRow; (pRow = tsdbTbDataIterGet(&iter)) != NULL; tsdbTbDataIterNext(&iter)) {
+      TSDBKEY key = TSDBROW_KEY(pRow);
+      SColVal cv;
+      tsdbRowGetColVal(pRow, pTSchema, 1, &cv);
+      EXPECT_EQ(cv.value.val, key.version);
+      keys.push_back(key);
+    }
+    return keys;
+  }
+
+  // the keys a scan from pFrom should return
+  std::vector<TSDBKEY> expectedFrom(TSDBKEY *pFrom, int8_t backward) {
+    std::vector<TSDBKEY> keys;
+    for (const TSDBKEY &key : expected) {
+      if (pFrom == NULL || (backward ? !keyLess(*pFrom, key) : !keyLess(key, *pFrom))) {
+        keys.push_back(key);
+      }
+    }
+    if (backward) std::reverse(keys.begin(), keys.end());
+    return keys;
+  }
+
+  void checkScan(TSDBKEY *pFrom, int8_t backward) {
+    std::vector<TSDBKEY> keys = scan(pFrom, backward);
+    std::vector<TSDBKEY> want = expectedFrom(pFrom, backward);
+    ASSERT_EQ(keys.size(), want.size()) << "from " << (pFrom ? pFrom->ts : -1) << " backward " << (int)backward;
+    for (size_t i = 0; i < keys.size(); i++) {
+      ASSERT_EQ(keys[i].ts, want[i].ts) << "row " << i << " from " << (pFrom ? pFrom->ts : -1);
+      ASSERT_EQ(keys[i].version, want[i].version) << "row " << i << " from " << (pFrom ? pFrom->ts : -1);
+    }
+  }
+
+  // scans from every ts in [minTs, maxTs], before and after all versions of it
+  void checkAllScans(TSKEY minTs, TSKEY maxTs) {
+    for (int8_t backward = 0; backward <= 1; backward++) {
+      checkScan(NULL, backward);
+      for (TSKEY ts = minTs; ts <= maxTs; ts++) {
+        TSDBKEY from = {.version = VERSION_MIN, .ts = ts};
+        checkScan(&from, backward);
+        from.version = VERSION_MAX;
+        checkScan(&from, backward);
+      }
+    }
+  }
+
+  bool                 oldChunk;
+  SVnode              *pVnode = NULL;
+  SVBufPool           *pPool = NULL;
+  STsdb               *pTsdb = NULL;
+  STSchema            *pTSchema = NULL;
+  std::vector<TSDBKEY> expected;
+};
+
+}  // namespace
+
+TEST_F(TsdbMemTableEnv, chunkOnly) {
+  insert(1, {10, 11, 12, 13}, false);
+  insert(2, {20, 21, 22}, true);
+  insert(3, {23}, false);
+  insert(4, {30, 35, 40}, true);
+
+  STbData *pTbData = tbData();
+  ASSERT_NE(pTbData, nullptr);
+  EXPECT_EQ(pTbData->sl.size, 0);
+  EXPECT_EQ(pTbData->nChunkRow, 11);
+  EXPECT_EQ(tsdbGetNRowsInTbData(pTbData), 11);
+
+  checkAllScans(5, 45);
+}
+
+// rows out of order go to the skiplist and are merged with the chunks by (ts, version)
+TEST_F(TsdbMemTableEnv, chunkAndSkiplist) {
+  insert(1, {10, 11, 12, 13}, false);
+  insert(2, {20, 21, 22}, true);
+  insert(3, {30, 31, 32}, false);
+
+  // duplicate keys at the first and last row of a chunk, in the middle of one, and in the gaps between chunks
+  insert(4, {13, 20}, false);
+  insert(5, {11, 22, 30}, true);
+  insert(6, {5, 15, 25, 32}, false);
+  insert(7, {20, 21}, true);
+
+  STbData *pTbData = tbData();
+  ASSERT_NE(pTbData, nullptr);
+  EXPECT_EQ(pTbData->nChunkRow, 10);
+  EXPECT_EQ(pTbData->sl.size, 11);
+
+  checkAllScans(0, 40);
+
+  // an append after the skiplist rows is a chunk again
+  insert(8, {33, 34}, true);
+  EXPECT_EQ(pTbData->nChunkRow, 12);
+  checkAllScans(0, 40);
+}
+
+// a duplicate of the chunk's key with a lower version than the chunk sorts before it
+TEST_F(TsdbMemTableEnv, olderVersionInSkiplist) {
+  insert(5, {10, 20}, false);
+  insert(6, {30}, true);
+  insert(3, {20, 30}, false);
+  insert(9, {10}, true);
+
+  checkAllScans(0, 40);
+}
+
+TEST_F(TsdbMemTableEnv, chunkDisabled) {
+  tsMemTableChunk = false;
+  insert(1, {10, 11, 12}, false);
+  insert(2, {11, 20}, true);
+
+  STbData *pTbData = tbData();
+  EXPECT_EQ(pTbData->nChunkRow, 0);
+  EXPECT_EQ(pTbData->sl.size, 5);
+  checkAllScans(0, 25);
+}
+
+#pragma GCC diagnostic pop
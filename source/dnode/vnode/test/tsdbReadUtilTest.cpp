@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include "querynodes.h"
+#include "tsdbReadUtil.h"
+#include "vnodeInt.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+namespace {
+
+const col_id_t kFilterColId = 2;
+
+// c2 > val, c2 is a bigint column
+SFilterInfo *createGreaterThanFilter(int64_t val) {
+  SColumnNode *pCol = (SColumnNode *)nodesMakeNode(QUERY_NODE_COLUMN);
+  pCol->node.resType.type = TSDB_DATA_TYPE_BIGINT;
+  pCol->node.resType.bytes = tDataTypes[TSDB_DATA_TYPE_BIGINT].bytes;
+  pCol->dataBlockId = 0;
+  pCol->slotId = 1;
+  pCol->colId = kFilterColId;
+
+  SValueNode *pVal = (SValueNode *)nodesMakeNode(QUERY_NODE_VALUE);
+  pVal->node.resType.type = TSDB_DATA_TYPE_BIGINT;
+  pVal->node.resType.bytes = tDataTypes[TSDB_DATA_TYPE_BIGINT].bytes;
+  nodesSetValueNodeValue(pVal, &val);
+
+  SOperatorNode *pOp = (SOperatorNode *)nodesMakeNode(QUERY_NODE_OPERATOR);
+  pOp->node.resType.type = TSDB_DATA_TYPE_BOOL;
+  pOp->node.resType.bytes = tDataTypes[TSDB_DATA_TYPE_BOOL].bytes;
+  pOp->opType = OP_TYPE_GREATER_THAN;
+  pOp->pLeft = (SNode *)pCol;
+  pOp->pRight = (SNode *)pVal;
+
+  SFilterInfo *pFilter = NULL;
+  int32_t      code = filterInitFromNode((SNode *)pOp, &pFilter, 0);
+  nodesDestroyNode((SNode *)pOp);
+  return code == TSDB_CODE_SUCCESS ? pFilter : NULL;
+}
+
+void appendAgg(TColumnDataAggArray *pArray, col_id_t colId, int64_t min, int64_t max, int16_t numOfNull) {
+  SColumnDataAgg agg = {0};
+  agg.colId = colId;
+  agg.min = min;
+  agg.max = max;
+  agg.sum = min + max;
+  agg.numOfNull = numOfNull;
+  ASSERT_EQ(TARRAY2_APPEND(pArray, agg), 0);
+}
+
+// a result block of (ts, c2), c2 in slot 1 as the filter expects
+SSDataBlock *createBlock(const std::vector<int64_t> &vals) {
+  SSDataBlock *pBlock = createDataBlock();
+
+  SColumnInfoData tsCol = createColumnInfoData(TSDB_DATA_TYPE_TIMESTAMP, sizeof(int64_t), PRIMARYKEY_TIMESTAMP_COL_ID);
+  SColumnInfoData valCol = createColumnInfoData(TSDB_DATA_TYPE_BIGINT, sizeof(int64_t), kFilterColId);
+  blockDataAppendColInfo(pBlock, &tsCol);
+  blockDataAppendColInfo(pBlock, &valCol);
+  blockDataEnsureCapacity(pBlock, vals.size());
+
+  for (int32_t i = 0; i < (int32_t)vals.size(); ++i) {
+    int64_t ts = 1700000000000 + i;
+    colDataSetVal((SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, 0), i, (const char *)&ts, false);
+    colDataSetVal((SColumnInfoData *)taosArrayGet(pBlock->pDataBlock, 1), i, (const char *)&vals[i], false);
+  }
+  pBlock->info.rows = vals.size();
+  return pBlock;
+}
+
+}  // namespace
+
+TEST(tsdbReadUtilTest, blockSmaFilteredOut) {
+  SFilterInfo *pFilter = createGreaterThanFilter(100);
+  ASSERT_NE(pFilter, nullptr);
+
+  TColumnDataAggArray aggArray = {0};
+  const int32_t       numOfRows = 4096;
+
+  // no SMA at all, the block has to be loaded
+  EXPECT_FALSE(blockSmaFilteredOut(pFilter, &aggArray, numOfRows));
+
+  // SMA of other columns only
+  appendAgg(&aggArray, kFilterColId + 1, 0, 1000, 0);
+  EXPECT_FALSE(blockSmaFilteredOut(pFilter, &aggArray, numOfRows));
+
+  // max of the filter column below the bound, no row qualifies
+  TARRAY2_CLEAR(&aggArray, NULL);
+  appendAgg(&aggArray, kFilterColId + 1, 0, 1000, 0);
+  appendAgg(&aggArray, kFilterColId, -50, 50, 0);
+  EXPECT_TRUE(blockSmaFilteredOut(pFilter, &aggArray, numOfRows));
+
+  // the bound itself does not qualify either
+  TARRAY2_CLEAR(&aggArray, NULL);
+  appendAgg(&aggArray, kFilterColId, 0, 100, 0);
+  EXPECT_TRUE(blockSmaFilteredOut(pFilter, &aggArray, numOfRows));
+
+  // the range of the block overlaps the filter
+  TARRAY2_CLEAR(&aggArray, NULL);
+  appendAgg(&aggArray, kFilterColId, 0, 101, 0);
+  EXPECT_FALSE(blockSmaFilteredOut(pFilter, &aggArray, numOfRows));
+
+  TARRAY2_CLEAR(&aggArray, NULL);
+  appendAgg(&aggArray, kFilterColId, 200, 300, 100);
+  EXPECT_FALSE(blockSmaFilteredOut(pFilter, &aggArray, numOfRows));
+
+  // all rows are NULL, a comparison never holds
+  TARRAY2_CLEAR(&aggArray, NULL);
+  appendAgg(&aggArray, kFilterColId, 0, 0, numOfRows);
+  EXPECT_TRUE(blockSmaFilteredOut(pFilter, &aggArray, numOfRows));
+
+  // no filter, nothing is dropped
+  EXPECT_FALSE(blockSmaFilteredOut(NULL, &aggArray, numOfRows));
+
+  TARRAY2_DESTROY(&aggArray, NULL);
+  filterFreeInfo(pFilter);
+}
+
+// the predicate columns of a block are checked before the deferred columns are loaded
+TEST(tsdbReadUtilTest, blockRowsFilteredOut) {
+  SFilterInfo *pFilter = createGreaterThanFilter(100);
+  ASSERT_NE(pFilter, nullptr);
+
+  // the filter rejects the whole block, the deferred columns are never loaded
+  SSDataBlock *pBlock = createBlock({1, 50, 100, -7});
+  bool         filteredOut = false;
+  ASSERT_EQ(blockRowsFilteredOut(pFilter, pBlock, &filteredOut), 0);
+  EXPECT_TRUE(filteredOut);
+  blockDataDestroy(pBlock);
+
+  // one row survives
+  pBlock = createBlock({1, 50, 101, -7});
+  ASSERT_EQ(blockRowsFilteredOut(pFilter, pBlock, &filteredOut), 0);
+  EXPECT_FALSE(filteredOut);
+  blockDataDestroy(pBlock);
+
+  filterFreeInfo(pFilter);
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "tglobal.h"
+#include "tsdb.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+namespace {
+
+const int16_t kColId = 2;
+const char   *kNull = "<null>";
+
+// build a var column, a value equal to kNull is appended as NULL
+void buildColData(SColData *pColData, int8_t type, const std::vector<std::string> &vals) {
+  tColDataInit(pColData, kColId, type, 1);
+  for (const std::string &v : vals) {
+    SColVal cv;
+    if (v == kNull) {
+      cv = COL_VAL_NULL(kColId, type);
+    } else {
+      SValue sv = {0};
+      sv.nData = (uint32_t)v.size();
+      sv.pData = (uint8_t *)v.data();
+      cv = COL_VAL_VALUE(kColId, type, sv);
+    }
+    ASSERT_EQ(tColDataAppendValue(pColData, &cv), 0);
+  }
+}
+
+// compress then decompress the column, return whether the dictionary encoding was used
+bool roundTrip(int8_t type, const std::vector<std::string> &vals, bool dictEncode = true) {
+  SColData colData = {0};
+  SColData outData = {0};
+  uint8_t *pOut = NULL;
+  uint8_t *pBuf = NULL;
+  bool     oldDictEncode = tsVarDictEncode;
+
+  tsVarDictEncode = dictEncode;
+  buildColData(&colData, type, vals);
+
+  SBlockCol blockCol = {0};
+  blockCol.cid = colData.cid;
+  blockCol.type = colData.type;
+  blockCol.smaOn = colData.smaOn;
+  blockCol.flag = colData.flag;
+  blockCol.szOrigin = colData.nData;
+  EXPECT_EQ(tsdbCmprColData(&colData, NO_COMPRESSION, &blockCol, &pOut, 0, &pBuf), 0);
+
+  tColDataInit(&outData, kColId, type, 1);
+  EXPECT_EQ(tsdbDecmprColData(pOut, &blockCol, NO_COMPRESSION, (int32_t)vals.size(), &outData, &pBuf), 0);
+
+  EXPECT_EQ(outData.nVal, (int32_t)vals.size());
+  EXPECT_EQ(outData.nData, colData.nData);
+  for (int32_t i = 0; i < (int32_t)vals.size(); i++) {
+    SColVal cv;
+    tColDataGetValue(&outData, i, &cv);
+    if (vals[i] == kNull) {
+      EXPECT_TRUE(COL_VAL_IS_NULL(&cv)) << "row " << i;
+    } else {
+      EXPECT_TRUE(COL_VAL_IS_VALUE(&cv)) << "row " << i;
+      EXPECT_EQ(std::string((const char *)cv.value.pData, cv.value.nData), vals[i]) << "row " << i;
+    }
+  }
+
+  bool dict = blockCol.dict;
+  tsVarDictEncode = oldDictEncode;
+  tFree(pOut);
+  tFree(pBuf);
+  tColDataDestroy(&colData);
+  tColDataDestroy(&outData);
+  return dict;
+}
+
+}  // namespace
+
+TEST(tsdbUtilTest, cmprColDataDictAllEqual) {
+  std::vector<std::string> vals(256, "beijing");
+  EXPECT_TRUE(roundTrip(TSDB_DATA_TYPE_VARCHAR, vals));
+  EXPECT_TRUE(roundTrip(TSDB_DATA_TYPE_NCHAR, std::vector<std::string>(256, std::string("b\0\0\0j\0\0\0", 8))));
+}
+
+// blocks in dictionary mode cannot be read by older versions, they are only written when enabled
+TEST(tsdbUtilTest, cmprColDataDictDisabled) {
+  std::vector<std::string> vals(256, "beijing");
+  EXPECT_FALSE(roundTrip(TSDB_DATA_TYPE_VARCHAR, vals, false));
+  EXPECT_FALSE(roundTrip(TSDB_DATA_TYPE_NCHAR, std::vector<std::string>(256, std::string("b\0\0\0j\0\0\0", 8)), false));
+}
+
+TEST(tsdbUtilTest, cmprColDataDictWithNull) {
+  std::vector<std::string> vals;
+  for (int32_t i = 0; i < 256; i++) {
+    vals.push_back((i % 3 == 0) ? kNull : ((i % 2) ? "shanghai" : "beijing"));
+  }
+  EXPECT_TRUE(roundTrip(TSDB_DATA_TYPE_VARCHAR, vals));
+
+  // NULL rows first, before any value enters the dictionary
+  for (int32_t i = 0; i < 64; i++) {
+    vals[i] = kNull;
+  }
+  EXPECT_TRUE(roundTrip(TSDB_DATA_TYPE_VARCHAR, vals));
+}
+
+TEST(tsdbUtilTest, cmprColDataDictWithEmpty) {
+  std::vector<std::string> vals;
+  for (int32_t i = 0; i < 256; i++) {
+    switch (i % 4) {
+      case 0:
+        vals.push_back("");
+        break;
+      case 1:
+        vals.push_back(kNull);
+        break;
+      default:
+        vals.push_back("guangzhou");
+        break;
+    }
+  }
+  EXPECT_TRUE(roundTrip(TSDB_DATA_TYPE_VARCHAR, vals));
+}
+
+TEST(tsdbUtilTest, cmprColDataHighCardinality) {
+  std::vector<std::string> vals;
+  for (int32_t i = 0; i < 256; i++) {
+    vals.push_back((i % 10 == 0) ? kNull : "device_" + std::to_string(i));
+  }
+  EXPECT_FALSE(roundTrip(TSDB_DATA_TYPE_VARCHAR, vals));
+
+  // too few rows to be worth a dictionary
+  EXPECT_FALSE(roundTrip(TSDB_DATA_TYPE_VARCHAR, std::vector<std::string>(16, "beijing")));
+}
+
+// a block with one bigint column per cid, the value of row i in column cid is cid * 1000 + i
+static void initBlockData(SBlockData *pBlockData, const std::vector<int16_t> &cids, int32_t nRow) {
+  tBlockDataCreate(pBlockData);
+  pBlockData->uid = 1;
+  pBlockData->nRow = nRow;
+  pBlockData->nColData = (int32_t)cids.size();
+  pBlockData->aColData = (SColData *)taosMemoryCalloc(cids.size(), sizeof(SColData));
+  for (int32_t i = 0; i < (int32_t)cids.size(); i++) {
+    SColData *pColData = &pBlockData->aColData[i];
+    tColDataInit(pColData, cids[i], TSDB_DATA_TYPE_BIGINT, 0);
+    for (int32_t iRow = 0; iRow < nRow; iRow++) {
+      SValue  sv = {.val = cids[i] * 1000 + iRow};
+      SColVal cv = COL_VAL_VALUE(cids[i], TSDB_DATA_TYPE_BIGINT, sv);
+      ASSERT_EQ(tColDataAppendValue(pColData, &cv), 0);
+    }
+  }
+}
+
+TEST(tsdbUtilTest, blockDataMoveColData) {
+  SBlockData predData, deferData;
+  initBlockData(&predData, {3, 7}, 10);
+  initBlockData(&deferData, {2, 4, 5, 9}, 10);
+
+  ASSERT_EQ(tBlockDataMoveColData(&predData, &deferData), 0);
+  EXPECT_EQ(deferData.nColData, 0);
+  EXPECT_EQ(deferData.aColData, nullptr);
+
+  std::vector<int16_t> expected = {2, 3, 4, 5, 7, 9};
+  ASSERT_EQ(predData.nColData, (int32_t)expected.size());
+  for (int32_t i = 0; i < predData.nColData; i++) {
+    SColData *pColData = tBlockDataGetColDataByIdx(&predData, i);
+    ASSERT_EQ(pColData->cid, expected[i]);
+    for (int32_t iRow = 0; iRow < predData.nRow; iRow++) {
+      SColVal cv;
+      tColDataGetValue(pColData, iRow, &cv);
+      ASSERT_EQ(cv.value.val, expected[i] * 1000 + iRow);
+    }
+  }
+
+  // nothing to move
+  ASSERT_EQ(tBlockDataMoveColData(&predData, &deferData), 0);
+  EXPECT_EQ(predData.nColData, (int32_t)expected.size());
+
+  tBlockDataDestroy(&predData);
+  tBlockDataDestroy(&deferData);
+}
+
+#pragma GCC diagnostic pop
@@ -0,0 +1,371 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <vector>
+
+#include "meta.h"
+#include "metaTtl.h"
+#include "tglobal.h"
+#include "tsdb.h"
+#include "vnd.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+namespace {
+
+const tb_uid_t kSuid = 100;
+const tb_uid_t kUid = 1000;
+const int16_t  kValColId = 2;
+const int32_t  kNumOfTables = 200;
+const int32_t  kApplyThreads = 3;
+const int64_t  kVersion = 7;
+
+// a vnode with just what the apply of submit data touches: buffer pools, a memtable and the meta lock
+struct TestVnode {
+  SVnode *pVnode = NULL;
+
+  void open() {
+    pVnode = (SVnode *)taosMemoryCalloc(1, sizeof(SVnode));
+    pVnode->config.vgId = 2;
+    pVnode->config.szBuf = 3 * 1024 * 1024;
+    pVnode->config.tsdbCfg.slLevel = 5;
+    pVnode->config.cacheLast = 0;
+    taosThreadMutexInit(&pVnode->mutex, NULL);
+    ASSERT_EQ(vnodeOpenBufPool(pVnode), 0);
+    pVnode->inUse = pVnode->freeList;
+    pVnode->freeList = pVnode->inUse->freeNext;
+    pVnode->inUse->freeNext = NULL;
+    pVnode->inUse->nRef = 1;
+
+    pVnode->pTsdb = (STsdb *)taosMemoryCalloc(1, sizeof(STsdb));
+    pVnode->pTsdb->pVnode = pVnode;
+    ASSERT_EQ(tsdbMemTableCreate(pVnode->pTsdb, &pVnode->pTsdb->mem), 0);
+
+    STtlManger *pTtlMgr = (STtlManger *)taosMemoryCalloc(1, sizeof(STtlManger));
+    pTtlMgr->pTtlCache = taosHashInit(8, taosGetDefaultHashFunction(TSDB_DATA_TYPE_UBIGINT), false, HASH_NO_LOCK);
+    pVnode->pMeta = (SMeta *)taosMemoryCalloc(1, sizeof(SMeta));
+    pVnode->pMeta->pTtlMgr = pTtlMgr;
+    taosThreadRwlockInit(&pVnode->pMeta->lock, NULL);
+  }
+
+  void close() {
+    if (pVnode == NULL) return;
+    taosThreadRwlockDestroy(&pVnode->pMeta->lock);
+    taosHashCleanup(pVnode->pMeta->pTtlMgr->pTtlCache);
+    taosMemoryFree(pVnode->pMeta->pTtlMgr);
+    taosMemoryFree(pVnode->pMeta);
+    taosMemoryFree(pVnode->pTsdb->mem->aBucket);
+    taosMemoryFree(pVnode->pTsdb->mem);
+    taosMemoryFree(pVnode->pTsdb);
+    vnodeCloseBufPool(pVnode);
+    taosThreadMutexDestroy(&pVnode->mutex);
+    taosMemoryFree(pVnode);
+    pVnode = NULL;
+  }
+
+  SMemTable *mem() { return pVnode->pTsdb->mem; }
+};
+
+// a submit request of many tables under one super table, some in row and some in column format, some tables twice
+class VnodeApplySubmitEnv : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    oldApplyThreads = tsNumOfApplyThreads;
+    oldParallelTables = tsApplyParallelTables;
+    oldTtlChangeOnWrite = tsTtlChangeOnWrite;
+    oldMemTableChunk = tsMemTableChunk;
+    tsNumOfApplyThreads = kApplyThreads;
+    tsApplyParallelTables = 64;
+    tsTtlChangeOnWrite = false;
+
+    SSchema schema[] = {
+        {.type = TSDB_DATA_TYPE_TIMESTAMP, .colId = PRIMARYKEY_TIMESTAMP_COL_ID, .bytes = 8},
+        {.type = TSDB_DATA_TYPE_BIGINT, .colId = kValColId, .bytes = 8},
+    };
+    pTSchema = tBuildTSchema(schema, 2, 1);
+    buildRequest();
+
+    serial.open();
+    parallel.open();
+  }
+
+  void TearDown() override {
+    stopApplyPool();
+    serial.close();
+    parallel.close();
+    tDestroySubmitReq(&req, TSDB_MSG_FLG_ENCODE);
+    taosMemoryFree(pTSchema);
+    tsNumOfApplyThreads = oldApplyThreads;
+    tsApplyParallelTables = oldParallelTables;
+    tsTtlChangeOnWrite = oldTtlChangeOnWrite;
+    tsMemTableChunk = oldMemTableChunk;
+  }
+
+  void startApplyPool() {
+    ASSERT_EQ(vnodeAsyncInit(&vnodeAsyncHandle[3], "vnode-apply"), 0);
+    ASSERT_EQ(vnodeAsyncSetWorkers(vnodeAsyncHandle[3], kApplyThreads), 0);
+  }
+
+  void stopApplyPool() {
+    if (vnodeAsyncHandle[3] != NULL) {
+      vnodeAsyncDestroy(&vnodeAsyncHandle[3]);
+    }
+  }
+
+  void addTbData(tb_uid_t uid, const std::vector<TSKEY> &keys, bool colFmt) {
+    SSubmitTbData submitTbData = {0};
+    submitTbData.suid = kSuid;
+    submitTbData.uid = uid;
+    submitTbData.sver = 1;
+    submitTbData.ctimeMs = 1000;
+
+    if (colFmt) {
+      submitTbData.flags = SUBMIT_REQ_COLUMN_DATA_FORMAT;
+      submitTbData.aCol = taosArrayInit(2, sizeof(SColData));
+      SColData *pTsCol = (SColData *)taosArrayReserve(submitTbData.aCol, 1);
+      SColData *pValCol = (SColData *)taosArrayReserve(submitTbData.aCol, 1);
+      tColDataInit(pTsCol, PRIMARYKEY_TIMESTAMP_COL_ID, TSDB_DATA_TYPE_TIMESTAMP, 0);
+      tColDataInit(pValCol, kValColId, TSDB_DATA_TYPE_BIGINT, 0);
+      for (TSKEY ts : keys) {
+        SColVal tsVal = COL_VAL_VALUE(PRIMARYKEY_TIMESTAMP_COL_ID, TSDB_DATA_TYPE_TIMESTAMP, (SValue){.val = ts});
+        SColVal val = COL_VAL_VALUE(kValColId, TSDB_DATA_TYPE_BIGINT, (SValue){.val = uid});
+        ASSERT_EQ(tColDataAppendValue(pTsCol, &tsVal), 0);
+        ASSERT_EQ(tColDataAppendValue(pValCol, &val), 0);
+      }
+    } else {
+      submitTbData.aRowP = taosArrayInit(keys.size(), sizeof(SRow *));
+      SArray *aColVal = taosArrayInit(2, sizeof(SColVal));
+      for (TSKEY ts : keys) {
+        taosArrayClear(aColVal);
+        SColVal tsVal = COL_VAL_VALUE(PRIMARYKEY_TIMESTAMP_COL_ID, TSDB_DATA_TYPE_TIMESTAMP, (SValue){.val = ts});
+        SColVal val = COL_VAL_VALUE(kValColId, TSDB_DATA_TYPE_BIGINT, (SValue){.val = uid});
+        taosArrayPush(aColVal, &tsVal);
+        taosArrayPush(aColVal, &val);
+        SRow *pRow = NULL;
+        ASSERT_EQ(tRowBuild(aColVal, pTSchema, &pRow), 0);
+        taosArrayPush(submitTbData.aRowP, &pRow);
+      }
+      taosArrayDestroy(aColVal);
+    }
+    taosArrayPush(req.aSubmitTbData, &submitTbData);
+  }
+
+  void buildRequest() {
+    req.aSubmitTbData = taosArrayInit(kNumOfTables, sizeof(SSubmitTbData));
+    for (int32_t i = 0; i < kNumOfTables; i++) {
+      std::vector<TSKEY> keys;
+      for (int32_t j = 0; j <= i % 7; j++) keys.push_back(10000 + i * 3 + j * 100);
+      addTbData(kUid + i, keys, i % 2);
+    }
+    // more data for every fifth table, after and before what it already has
+    for (int32_t i = 0; i < kNumOfTables; i += 5) {
+      addTbData(kUid + i, {20000 + i, 20001 + i}, i % 3 == 0);
+      addTbData(kUid + i, {5000 + i}, false);
+    }
+  }
+
+  SSubmitTbData *tbData(int32_t idx) { return (SSubmitTbData *)taosArrayGet(req.aSubmitTbData, idx); }
+
+  // every table the memtable holds, by the number of STbData it has for it
+  static std::map<tb_uid_t, int32_t> tbDataCount(SMemTable *pMem) {
+    std::map<tb_uid_t, int32_t> counts;
+    for (int32_t i = 0; i < pMem->nBucket; i++) {
+      for (STbData *pTbData = pMem->aBucket[i]; pTbData; pTbData = pTbData->next) {
+        EXPECT_EQ(TABS(pTbData->uid) % pMem->nBucket, i);
+        counts[pTbData->uid]++;
+      }
+    }
+
+    int32_t     nTree = 0;
+    SRBTreeIter iter = tRBTreeIterCreate(pMem->tbDataTree, 1);
+    for (SRBTreeNode *pNode = tRBTreeIterNext(&iter); pNode; pNode = tRBTreeIterNext(&iter)) {
+      nTree++;
+    }
+    EXPECT_EQ(nTree, pMem->nTbData);
+    return counts;
+  }
+
+  // the rows of one table, checking each carries the uid of the table
+  std::vector<TSDBKEY> scan(STbData *pTbData) {
+    std::vector<TSDBKEY> keys;
+    STbDataIter          iter = {0};
+
+    tsdbTbDataIterOpen(pTbData, NULL, 0, &iter);
+    for (TSDBROW *pRow; (pRow = tsdbTbDataIterGet(&iter)) != NULL; tsdbTbDataIterNext(&iter)) {
+      SColVal cv;
+      tsdbRowGetColVal(pRow, pTSchema, 1, &cv);
+      EXPECT_EQ(cv.value.val, pTbData->uid);
+      keys.push_back(TSDBROW_KEY(pRow));
+    }
+    return keys;
+  }
+
+  void expectSameTable(STbData *pTbData, STbData *pExpect) {
+    ASSERT_NE(pTbData, nullptr);
+    ASSERT_NE(pExpect, nullptr);
+    EXPECT_EQ(pTbData->minKey, pExpect->minKey) << "uid " << pTbData->uid;
+    EXPECT_EQ(pTbData->maxKey, pExpect->maxKey) << "uid " << pTbData->uid;
+
+    std::vector<TSDBKEY> keys = scan(pTbData);
+    std::vector<TSDBKEY> want = scan(pExpect);
+    ASSERT_EQ(keys.size(), want.size()) << "uid " << pTbData->uid;
+    for (size_t i = 0; i < keys.size(); i++) {
+      ASSERT_EQ(keys[i].ts, want[i].ts) << "uid " << pTbData->uid << " row " << i;
+      ASSERT_EQ(keys[i].version, want[i].version) << "uid " << pTbData->uid << " row " << i;
+    }
+  }
+
+  int32_t        oldApplyThreads;
+  int32_t        oldParallelTables;
+  bool           oldTtlChangeOnWrite;
+  bool           oldMemTableChunk;
+  STSchema      *pTSchema = NULL;
+  SSubmitReq2    req = {0};
+  TestVnode      serial;
+  TestVnode      parallel;
+};
+
+}  // namespace
+
+// split over the vnode-apply workers, the memtable ends up as if the request was applied by one thread
+TEST_F(VnodeApplySubmitEnv, parallelAsSerial) {
+  for (bool chunk : {false, true}) {
+    tsMemTableChunk = chunk;
+    if (chunk) {
+      serial.close();
+      parallel.close();
+      serial.open();
+      parallel.open();
+    }
+
+    int32_t serialRows = 0;
+    ASSERT_EQ(vnodeApplySubmitTbData(serial.pVnode, kVersion, &req, &serialRows), 0);
+
+    startApplyPool();
+    int32_t parallelRows = 0;
+    ASSERT_EQ(vnodeApplySubmitTbData(parallel.pVnode, kVersion, &req, &parallelRows), 0);
+    stopApplyPool();
+
+    int32_t nRow = 0;
+    for (int32_t i = 0; i < TARRAY_SIZE(req.aSubmitTbData); i++) {
+      SSubmitTbData *pSubmitTbData = tbData(i);
+      nRow += (pSubmitTbData->flags & SUBMIT_REQ_COLUMN_DATA_FORMAT)
+                  ? ((SColData *)TARRAY_DATA(pSubmitTbData->aCol))->nVal
+                  : TARRAY_SIZE(pSubmitTbData->aRowP);
+    }
+    EXPECT_EQ(serialRows, nRow);
+    EXPECT_EQ(parallelRows, nRow);
+
+    SMemTable *pSerial = serial.mem();
+    SMemTable *pParallel = parallel.mem();
+    EXPECT_EQ(pParallel->nTbData, kNumOfTables);
+    EXPECT_EQ(pParallel->nTbData, pSerial->nTbData);
+    EXPECT_EQ(pParallel->nRow, pSerial->nRow);
+    EXPECT_EQ(pParallel->nRow, nRow);
+    EXPECT_EQ(pParallel->minKey, pSerial->minKey);
+    EXPECT_EQ(pParallel->maxKey, pSerial->maxKey);
+    EXPECT_EQ(pParallel->minVer, kVersion);
+    EXPECT_EQ(pParallel->maxVer, kVersion);
+
+    std::map<tb_uid_t, int32_t> counts = tbDataCount(pParallel);
+    ASSERT_EQ(counts.size(), kNumOfTables);
+    for (auto &kv : counts) {
+      EXPECT_EQ(kv.second, 1) << "uid " << kv.first;
+    }
+
+    for (int32_t i = 0; i < kNumOfTables; i++) {
+      expectSameTable(tsdbGetTbDataFromMemTable(pParallel, kSuid, kUid + i),
+                      tsdbGetTbDataFromMemTable(pSerial, kSuid, kUid + i));
+    }
+  }
+}
+
+// a request too small to split is applied by the calling thread alone
+TEST_F(VnodeApplySubmitEnv, fewTablesInline) {
+  tsApplyParallelTables = TARRAY_SIZE(req.aSubmitTbData) + 1;
+  startApplyPool();
+
+  int32_t affectedRows = 0;
+  ASSERT_EQ(vnodeApplySubmitTbData(parallel.pVnode, kVersion, &req, &affectedRows), 0);
+  EXPECT_EQ(parallel.mem()->nTbData, kNumOfTables);
+  EXPECT_EQ(parallel.mem()->nRow, affectedRows);
+}
+
+// one table fails, the shards of the other workers still insert all of their tables
+TEST_F(VnodeApplySubmitEnv, oneTableFails) {
+  tsTtlChangeOnWrite = true;
+  const int32_t nShard = kApplyThreads + 1;
+  const int32_t failIdx = 42;
+  tb_uid_t      failUid = kUid + failIdx;
+  tbData(failIdx)->ctimeMs = 0;  // refused by the ttl update after the data is inserted
+
+  startApplyPool();
+  int32_t affectedRows = 0;
+  EXPECT_EQ(vnodeApplySubmitTbData(parallel.pVnode, kVersion, &req, &affectedRows),
+            TSDB_CODE_VERSION_NOT_COMPATIBLE);
+  stopApplyPool();
+  tbData(failIdx)->ctimeMs = 1000;
+
+  SMemTable                  *pMem = parallel.mem();
+  std::map<tb_uid_t, int32_t> counts = tbDataCount(pMem);
+  for (auto &kv : counts) {
+    EXPECT_EQ(kv.second, 1) << "uid " << kv.first;
+  }
+
+  // the failed shard stops after the data of the failed table, the others insert all of their tables
+  std::map<tb_uid_t, int32_t> expectRows;
+  int32_t                     expectAffected = 0;
+  bool                        failed = false;
+  for (int32_t i = 0; i < TARRAY_SIZE(req.aSubmitTbData); i++) {
+    SSubmitTbData *pSubmitTbData = tbData(i);
+    if (failed && TABS(pSubmitTbData->uid) % nShard == TABS(failUid) % nShard) continue;
+
+    int32_t nRow = (pSubmitTbData->flags & SUBMIT_REQ_COLUMN_DATA_FORMAT)
+                       ? ((SColData *)TARRAY_DATA(pSubmitTbData->aCol))->nVal
+                       : TARRAY_SIZE(pSubmitTbData->aRowP);
+    expectRows[pSubmitTbData->uid] += nRow;
+    if (i == failIdx) {
+      failed = true;
+    } else {
+      expectAffected += nRow;
+    }
+  }
+  EXPECT_EQ(affectedRows, expectAffected);
+
+  int64_t nRow = 0;
+  int32_t nOtherShards = 0;
+  for (int32_t i = 0; i < kNumOfTables; i++) {
+    tb_uid_t uid = kUid + i;
+    STbData *pTbData = tsdbGetTbDataFromMemTable(pMem, kSuid, uid);
+    if (expectRows.count(uid) == 0) {
+      EXPECT_EQ(pTbData, nullptr) << "uid " << uid;
+      continue;
+    }
+    ASSERT_NE(pTbData, nullptr) << "uid " << uid;
+    EXPECT_EQ(scan(pTbData).size(), expectRows[uid]) << "uid " << uid;
+    nRow += expectRows[uid];
+    if (TABS(uid) % nShard != TABS(failUid) % nShard) nOtherShards++;
+  }
+  EXPECT_EQ(nOtherShards, kNumOfTables - kNumOfTables / nShard);
+  EXPECT_EQ(pMem->nTbData, (int32_t)expectRows.size());
+  EXPECT_EQ(pMem->nRow, nRow);
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "vnd.h"
+
+namespace {
+
+class VnodeApplyWaitEnv : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    pVnode = (SVnode *)taosMemoryCalloc(1, sizeof(SVnode));
+    pVnode->state.applied = 10;
+    taosThreadMutexInit(&pVnode->applyMutex, NULL);
+    taosThreadCondInit(&pVnode->applyCond, NULL);
+  }
+
+  void TearDown() override {
+    taosThreadCondDestroy(&pVnode->applyCond);
+    taosThreadMutexDestroy(&pVnode->applyMutex);
+    taosMemoryFree(pVnode);
+  }
+
+  // what the apply of a write does
+  void apply(int64_t index) {
+    atomic_store_64(&pVnode->state.applied, index);
+    vnodeNotifyApplied(pVnode);
+  }
+
+  SVnode *pVnode = NULL;
+};
+
+}  // namespace
+
+TEST_F(VnodeApplyWaitEnv, applied) {
+  EXPECT_EQ(vnodeWaitApplied(pVnode, -1, 0), 0);
+  EXPECT_EQ(vnodeWaitApplied(pVnode, 10, 0), 0);
+  EXPECT_EQ(vnodeWaitApplied(pVnode, 11, 20), -1);
+  EXPECT_EQ(pVnode->applyWaiters, 0);
+}
+
+// readers sleep until the apply reaches their index, each woken by the apply itself
+TEST_F(VnodeApplyWaitEnv, wakeOnApply) {
+  std::atomic<int32_t> numOfDone(0);
+  std::thread          reader12([&]() {
+    EXPECT_EQ(vnodeWaitApplied(pVnode, 12, 5000), 0);
+    numOfDone++;
+  });
+  std::thread          reader15([&]() {
+    EXPECT_EQ(vnodeWaitApplied(pVnode, 15, 5000), 0);
+    numOfDone++;
+  });
+
+  while (atomic_load_32(&pVnode->applyWaiters) < 2) taosMsleep(1);
+  int64_t startMs = taosGetMonoTimestampMs();
+  apply(11);
+  taosMsleep(10);
+  EXPECT_EQ(numOfDone.load(), 0);
+
+  apply(12);
+  reader12.join();
+  EXPECT_EQ(numOfDone.load(), 1);
+
+  apply(15);
+  reader15.join();
+  EXPECT_EQ(numOfDone.load(), 2);
+  EXPECT_LT(taosGetMonoTimestampMs() - startMs, 1000);
+  EXPECT_EQ(pVnode->applyWaiters, 0);
+}
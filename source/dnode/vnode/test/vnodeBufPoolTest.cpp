@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "tglobal.h"
+#include "vnd.h"
+
+namespace {
+
+const int64_t kBufSize = 3 * 1024 * 1024;
+
+bool hostHasHugePages() {
+  int64_t mapSize = 0;
+  void   *p = taosMemoryMapPages(1, true, -1, &mapSize);
+  taosMemoryUnmapPages(p, mapSize);
+  return p != NULL;
+}
+
+class VnodeBufPoolEnv : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    oldHugePage = tsBufPoolHugePage;
+    oldNumaBind = tsBufPoolNumaBind;
+    oldApplyThreads = tsNumOfApplyThreads;
+    tsBufPoolNumaBind = false;
+
+    pVnode = (SVnode *)taosMemoryCalloc(1, sizeof(SVnode));
+    pVnode->config.vgId = 2;
+    pVnode->config.szBuf = kBufSize;
+    taosThreadMutexInit(&pVnode->mutex, NULL);
+  }
+
+  void TearDown() override {
+    vnodeCloseBufPool(pVnode);
+    taosThreadMutexDestroy(&pVnode->mutex);
+    taosMemoryFree(pVnode);
+    tsBufPoolHugePage = oldHugePage;
+    tsBufPoolNumaBind = oldNumaBind;
+    tsNumOfApplyThreads = oldApplyThreads;
+  }
+
+  std::vector<SVBufPoolStat> getStat() {
+    SArray *pStats = taosArrayInit(VNODE_BUFPOOL_SEGMENTS, sizeof(SVBufPoolStat));
+    EXPECT_EQ(vnodeGetBufPoolStat(pVnode, pStats), 0);
+    std::vector<SVBufPoolStat> stats((SVBufPoolStat *)TARRAY_DATA(pStats),
+                                     (SVBufPoolStat *)TARRAY_DATA(pStats) + TARRAY_SIZE(pStats));
+    taosArrayDestroy(pStats);
+    return stats;
+  }
+
+  bool     oldHugePage;
+  bool     oldNumaBind;
+  int32_t  oldApplyThreads;
+  SVnode  *pVnode = NULL;
+};
+
+}  // namespace
+
+// huge pages are asked for but none are reserved, the pools come from the heap and still work
+TEST_F(VnodeBufPoolEnv, hugePageFallback) {
+  if (hostHasHugePages()) GTEST_SKIP() << "host has huge pages reserved";
+
+  tsBufPoolHugePage = true;
+  tsNumOfApplyThreads = 0;
+  ASSERT_EQ(vnodeOpenBufPool(pVnode), 0);
+
+  int64_t capacity = kBufSize / VNODE_BUFPOOL_SEGMENTS;
+  for (SVBufPoolStat &stat : getStat()) {
+    EXPECT_EQ(stat.mapSize, 0);
+    EXPECT_FALSE(stat.hugePage);
+    EXPECT_EQ(stat.numaNode, -1);
+    EXPECT_EQ(stat.capacity, capacity);
+    EXPECT_EQ(stat.nAlloc, 0);
+    EXPECT_EQ(stat.nOverflow, 0);
+  }
+
+  // fill the first pool past its capacity
+  SVBufPool *pPool = pVnode->aBufPool[0];
+  for (int32_t i = 0; i < 100; i++) {
+    void *p = vnodeBufPoolMalloc(pPool, 1024);
+    ASSERT_NE(p, nullptr);
+    memset(p, i, 1024);
+  }
+  ASSERT_NE(vnodeBufPoolMallocAligned(pPool, capacity), nullptr);
+  ASSERT_NE(vnodeBufPoolMalloc(pPool, capacity), nullptr);
+
+  std::vector<SVBufPoolStat> stats = getStat();
+  ASSERT_EQ(stats.size(), VNODE_BUFPOOL_SEGMENTS);
+  EXPECT_EQ(stats[0].nAlloc, 102);
+  EXPECT_EQ(stats[0].nOverflow, 2);
+  EXPECT_EQ(stats[0].szOverflow, 2 * capacity);
+  for (int32_t i = 1; i < VNODE_BUFPOOL_SEGMENTS; i++) {
+    EXPECT_EQ(stats[i].nAlloc, 0);
+    EXPECT_EQ(stats[i].nOverflow, 0);
+  }
+}
+
+// with apply threads the pools are locked, allocations from several threads are all counted
+TEST_F(VnodeBufPoolEnv, concurrentAlloc) {
+  tsBufPoolHugePage = true;
+  tsNumOfApplyThreads = 4;
+  ASSERT_EQ(vnodeOpenBufPool(pVnode), 0);
+
+  SVBufPool               *pPool = pVnode->aBufPool[0];
+  const int32_t            nThreads = 4;
+  const int32_t            nAlloc = 2000;
+  std::vector<std::thread> threads;
+  for (int32_t i = 0; i < nThreads; i++) {
+    threads.emplace_back([pPool]() {
+      for (int32_t j = 0; j < nAlloc; j++) {
+        void *p = vnodeBufPoolMalloc(pPool, 512);
+        ASSERT_NE(p, nullptr);
+        memset(p, j, 512);
+      }
+    });
+  }
+  for (std::thread &t : threads) t.join();
+
+  std::vector<SVBufPoolStat> stats = getStat();
+  EXPECT_EQ(stats[0].nAlloc, nThreads * nAlloc);
+  EXPECT_GT(stats[0].nOverflow, 0);
+  EXPECT_EQ(stats[0].szOverflow, stats[0].nOverflow * 512);
+  if (!hostHasHugePages()) {
+    EXPECT_EQ(stats[0].mapSize, 0);
+  }
+}
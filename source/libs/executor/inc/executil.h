@@ -201,6 +201,16 @@ void updateTimeWindowInfo(SColumnInfoData* pColData, STimeWindow* pWin, int64_t
 SSDataBlock* createTagValBlockForFilter(SArray* pColList, int32_t numOfTables, SArray* pUidTagList, void* pVnode,
                                         SStorageAPI* pStorageAPI);
 
+const SMetaTagColumn* getTagColumn(const SMetaTagCols* pTagCols, int16_t colId);
+bool                  isTagColumnUsable(const SMetaTagCols* pTagCols, int16_t colId, int8_t type);
+SMetaTagCols* acquireTagColsForFilter(void* pVnode, uint64_t suid, SArray* pColList, SStorageAPI* pStorageAPI);
+// fill numOfRows rows of the column with the tag column, from row aRows[i] or startRow + i if aRows is NULL
+void         fillTagColumn(SColumnInfoData* pColInfo, const SMetaTagColumn* pTagCol, const int32_t* aRows,
+                           int32_t startRow, int32_t numOfRows);
+SSDataBlock* createTagValBlockFromTagCols(SArray* pColList, int32_t numOfTables, const SMetaTagCols* pTagCols,
+                                          const int32_t* aRows, int32_t startRow, SArray* pUidTagList, void* pVnode,
+                                          SStorageAPI* pStorageAPI);
+
 /**
  * @brief build a tuple into keyBuf
  * @param [out] keyBuf the output buf
@@ -378,6 +378,9 @@ typedef struct STagScanInfo {
   SArray*               aFilterIdxs;  // SArray<int32_t>
   SStorageAPI*          pStorageAPI;
   SLimitInfo           limitInfo;
+  bool                  tagColsChecked;
+  SMetaTagCols*         pTagCols;     // tags of the super table by columns, used instead of pCtbCursor if acquired
+  int32_t               tagColsPos;
 } STagScanInfo;
 
 typedef enum EStreamScanMode {
@@ -820,6 +823,8 @@ int32_t     getBufferPgSize(int32_t rowSize, uint32_t* defaultPgsz, uint32_t* de
 extern void doDestroyExchangeOperatorInfo(void* param);
 
 int32_t doFilter(SSDataBlock* pBlock, SFilterInfo* pFilterInfo, SColMatchInfo* pColMatchInfo);
+int32_t doFilterEx(SSDataBlock* pBlock, SFilterInfo* pFilterInfo, SColMatchInfo* pColMatchInfo,
+                   bool dropFilterOnlyCols);
 int32_t addTagPseudoColumnData(SReadHandle* pHandle, const SExprInfo* pExpr, int32_t numOfExpr, SSDataBlock* pBlock,
                                int32_t rows, SExecTaskInfo* pTask, STableMetaCacheInfo* pCache);
 
@@ -44,6 +44,7 @@ typedef enum {
 static FilterCondType checkTagCond(SNode* cond);
 static int32_t optimizeTbnameInCond(void* metaHandle, int64_t suid, SArray* list, SNode* pTagCond, SStorageAPI* pAPI);
 static int32_t optimizeTbnameInCondImpl(void* metaHandle, SArray* list, SNode* pTagCond, SStorageAPI* pStoreAPI);
+static int32_t locateTagColsRows(const SMetaTagCols* pTagCols, SArray* pUidTagList, int32_t** paRows);
 
 static int32_t      getTableList(void* pVnode, SScanPhysiNode* pScanNode, SNode* pTagCond, SNode* pTagIndexCond,
                                  STableListInfo* pListInfo, uint8_t* digest, const char* idstr, SStorageAPI* pStorageAPI);
@@ -464,6 +465,8 @@ int32_t getColInfoResultForGroupby(void* pVnode, SNodeList* group, STableListInf
   SArray*      groupData = NULL;
   SArray*      pUidTagList = NULL;
   SArray*      tableList = NULL;
+  SMetaTagCols* pTagCols = NULL;
+  int32_t*      aRows = NULL;
 
   int32_t rows = taosArrayGetSize(pTableListInfo->pTableList);
   if (rows == 0) {
@@ -515,13 +518,22 @@ int32_t getColInfoResultForGroupby(void* pVnode, SNodeList* group, STableListInf
     taosArrayPush(pUidTagList, &info);
   }
 
-  code = pAPI->metaFn.getTableTags(pVnode, pTableListInfo->idInfo.suid, pUidTagList);
+  pTagCols = acquireTagColsForFilter(pVnode, pTableListInfo->idInfo.suid, ctx.cInfoList, pAPI);
+  if (pTagCols != NULL) {
+    code = locateTagColsRows(pTagCols, pUidTagList, &aRows);
+  } else {
+    code = pAPI->metaFn.getTableTags(pVnode, pTableListInfo->idInfo.suid, pUidTagList);
+  }
   if (code != TSDB_CODE_SUCCESS) {
     goto end;
   }
 
   int32_t numOfTables = taosArrayGetSize(pUidTagList);
-  pResBlock = createTagValBlockForFilter(ctx.cInfoList, numOfTables, pUidTagList, pVnode, pAPI);
+  if (pTagCols != NULL) {
+    pResBlock = createTagValBlockFromTagCols(ctx.cInfoList, numOfTables, pTagCols, aRows, 0, pUidTagList, pVnode, pAPI);
+  } else {
+    pResBlock = createTagValBlockForFilter(ctx.cInfoList, numOfTables, pUidTagList, pVnode, pAPI);
+  }
   if (pResBlock == NULL) {
     code = terrno;
     goto end;
@@ -663,6 +675,10 @@ end:
   taosArrayDestroy(pBlockList);
   taosArrayDestroyEx(pUidTagList, freeItem);
   taosArrayDestroyP(groupData, releaseColInfoData);
+  taosMemoryFree(aRows);
+  if (pTagCols != NULL) {
+    pAPI->metaFn.releaseTagCols(pVnode, pTagCols);
+  }
   return code;
 }
 
@@ -939,6 +955,151 @@ SSDataBlock* createTagValBlockForFilter(SArray* pColList, int32_t numOfTables, S
   return pResBlock;
 }
 
+const SMetaTagColumn* getTagColumn(const SMetaTagCols* pTagCols, int16_t colId) {
+  for (int32_t i = 0; i < pTagCols->nCols; ++i) {
+    if (pTagCols->aCol[i].cid == colId) {
+      return &pTagCols->aCol[i];
+    }
+  }
+
+  return NULL;
+}
+
+// the tag columns serve a column only if the tag still has the type that the query is planned with
+bool isTagColumnUsable(const SMetaTagCols* pTagCols, int16_t colId, int8_t type) {
+  const SMetaTagColumn* pTagCol = getTagColumn(pTagCols, colId);
+  return pTagCol == NULL || pTagCol->type == type;
+}
+
+SMetaTagCols* acquireTagColsForFilter(void* pVnode, uint64_t suid, SArray* pColList, SStorageAPI* pStorageAPI) {
+  SMetaTagCols* pTagCols = pStorageAPI->metaFn.acquireTagCols(pVnode, suid);
+  if (pTagCols == NULL) {
+    return NULL;
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pColList); ++i) {
+    SColumnInfo* pCol = taosArrayGet(pColList, i);
+    if (pCol->colId != -1 && !isTagColumnUsable(pTagCols, pCol->colId, pCol->type)) {
+      pStorageAPI->metaFn.releaseTagCols(pVnode, pTagCols);
+      return NULL;
+    }
+  }
+
+  return pTagCols;
+}
+
+void fillTagColumn(SColumnInfoData* pColInfo, const SMetaTagColumn* pTagCol, const int32_t* aRows, int32_t startRow,
+                   int32_t numOfRows) {
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    int32_t row = (aRows != NULL) ? aRows[i] : startRow + i;
+
+    if (pTagCol == NULL || row < 0 || META_TAG_COL_IS_NULL(pTagCol, row)) {
+      colDataSetNULL(pColInfo, i);
+    } else if (IS_VAR_DATA_TYPE(pTagCol->type)) {
+      colDataSetVal(pColInfo, i, pTagCol->pDict + pTagCol->aDictOffset[pTagCol->aCode[row]], false);
+    } else {
+      colDataSetVal(pColInfo, i, pTagCol->pData + (int64_t)pTagCol->bytes * row, false);
+    }
+  }
+}
+
+SSDataBlock* createTagValBlockFromTagCols(SArray* pColList, int32_t numOfTables, const SMetaTagCols* pTagCols,
+                                          const int32_t* aRows, int32_t startRow, SArray* pUidTagList, void* pVnode,
+                                          SStorageAPI* pStorageAPI) {
+  SSDataBlock* pResBlock = createDataBlock();
+  if (pResBlock == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pColList); ++i) {
+    SColumnInfoData colInfo = {0};
+    colInfo.info = *(SColumnInfo*)taosArrayGet(pColList, i);
+    blockDataAppendColInfo(pResBlock, &colInfo);
+  }
+
+  int32_t code = blockDataEnsureCapacity(pResBlock, numOfTables);
+  if (code != TSDB_CODE_SUCCESS) {
+    terrno = code;
+    blockDataDestroy(pResBlock);
+    return NULL;
+  }
+
+  pResBlock->info.rows = numOfTables;
+
+  int32_t numOfCols = taosArrayGetSize(pResBlock->pDataBlock);
+  for (int32_t j = 0; j < numOfCols; j++) {
+    SColumnInfoData* pColInfo = (SColumnInfoData*)taosArrayGet(pResBlock->pDataBlock, j);
+
+    if (pColInfo->info.colId != -1) {
+      fillTagColumn(pColInfo, getTagColumn(pTagCols, pColInfo->info.colId), aRows, startRow, numOfTables);
+      continue;
+    }
+
+    // tbname
+    for (int32_t i = 0; i < numOfTables; i++) {
+      char str[TSDB_TABLE_FNAME_LEN + VARSTR_HEADER_SIZE] = {0};
+      if (pUidTagList != NULL) {
+        STUidTagInfo* p1 = taosArrayGet(pUidTagList, i);
+        if (p1->name != NULL) {
+          STR_TO_VARSTR(str, p1->name);
+        } else {
+          pStorageAPI->metaFn.getTableNameByUid(pVnode, p1->uid, str);
+        }
+      } else {
+        int32_t row = (aRows != NULL) ? aRows[i] : startRow + i;
+        pStorageAPI->metaFn.getTableNameByUid(pVnode, pTagCols->aUid[row], str);
+      }
+
+      colDataSetVal(pColInfo, i, str, false);
+    }
+  }
+
+  return pResBlock;
+}
+
+static int32_t tagColsUidCompare(const void* pLeft, const void* pRight) {
+  tb_uid_t left = *(tb_uid_t*)pLeft;
+  tb_uid_t right = *(tb_uid_t*)pRight;
+  if (left == right) {
+    return 0;
+  }
+  return (left < right) ? -1 : 1;
+}
+
+// without existed uids all tables of the tag columns are taken in their order, otherwise each uid is looked up in
+// the tag columns and a table they do not have gets null tags
+static int32_t locateTagColsRows(const SMetaTagCols* pTagCols, SArray* pUidTagList, int32_t** paRows) {
+  *paRows = NULL;
+
+  int32_t numOfTables = taosArrayGetSize(pUidTagList);
+  if (numOfTables == 0) {
+    if (taosArrayEnsureCap(pUidTagList, pTagCols->nRows) != TSDB_CODE_SUCCESS) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    for (int32_t i = 0; i < pTagCols->nRows; ++i) {
+      STUidTagInfo info = {.uid = pTagCols->aUid[i]};
+      taosArrayPush(pUidTagList, &info);
+    }
+    return TSDB_CODE_SUCCESS;
+  }
+
+  int32_t* aRows = taosMemoryMalloc(sizeof(int32_t) * numOfTables);
+  if (aRows == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  for (int32_t i = 0; i < numOfTables; ++i) {
+    STUidTagInfo* pInfo = taosArrayGet(pUidTagList, i);
+    tb_uid_t*     p = taosbsearch(&pInfo->uid, pTagCols->aUid, pTagCols->nRows, sizeof(tb_uid_t), tagColsUidCompare,
+                                  TD_EQ);
+    aRows[i] = (p != NULL) ? (int32_t)(p - pTagCols->aUid) : -1;
+  }
+
+  *paRows = aRows;
+  return TSDB_CODE_SUCCESS;
+}
+
 static int32_t doSetQualifiedUid(STableListInfo* pListInfo, SArray* pUidList, const SArray* pUidTagList, bool* pResultList, bool addUid) {
   taosArrayClear(pUidList);
 
@@ -991,6 +1152,8 @@ static int32_t doFilterByTagCond(STableListInfo* pListInfo, SArray* pUidList, SN
   SSDataBlock* pResBlock = NULL;
   SScalarParam output = {0};
   SArray*      pUidTagList = NULL;
+  SMetaTagCols* pTagCols = NULL;
+  int32_t*      aRows = NULL;
 
   tagFilterAssist ctx = {0};
   ctx.colHash = taosHashInit(4, taosGetDefaultHashFunction(TSDB_DATA_TYPE_SMALLINT), false, HASH_NO_LOCK);
@@ -1027,7 +1190,14 @@ static int32_t doFilterByTagCond(STableListInfo* pListInfo, SArray* pUidList, SN
     }
     terrno = 0;
   } else {
-    if ((condType == FILTER_NO_LOGIC || condType == FILTER_AND) && status != SFLT_NOT_INDEX) {
+    bool byUid = (condType == FILTER_NO_LOGIC || condType == FILTER_AND) && status != SFLT_NOT_INDEX;
+
+    pTagCols = acquireTagColsForFilter(pVnode, pListInfo->idInfo.suid, ctx.cInfoList, pAPI);
+    if (pTagCols != NULL) {
+      if (!byUid || taosArrayGetSize(pUidTagList) > 0) {
+        code = locateTagColsRows(pTagCols, pUidTagList, &aRows);
+      }
+    } else if (byUid) {
       code = pAPI->metaFn.getTableTagsByUid(pVnode, pListInfo->idInfo.suid, pUidTagList);
     } else {
       code = pAPI->metaFn.getTableTags(pVnode, pListInfo->idInfo.suid, pUidTagList);
@@ -1044,7 +1214,11 @@ static int32_t doFilterByTagCond(STableListInfo* pListInfo, SArray* pUidList, SN
     goto end;
   }
 
-  pResBlock = createTagValBlockForFilter(ctx.cInfoList, numOfTables, pUidTagList, pVnode, pAPI);
+  if (pTagCols != NULL) {
+    pResBlock = createTagValBlockFromTagCols(ctx.cInfoList, numOfTables, pTagCols, aRows, 0, pUidTagList, pVnode, pAPI);
+  } else {
+    pResBlock = createTagValBlockForFilter(ctx.cInfoList, numOfTables, pUidTagList, pVnode, pAPI);
+  }
   if (pResBlock == NULL) {
     code = terrno;
     goto end;
@@ -1081,12 +1255,147 @@ end:
   blockDataDestroy(pResBlock);
   taosArrayDestroy(pBlockList);
   taosArrayDestroyEx(pUidTagList, freeItem);
+  taosMemoryFree(aRows);
+  if (pTagCols != NULL) {
+    pAPI->metaFn.releaseTagCols(pVnode, pTagCols);
+  }
 
   colDataDestroy(output.columnData);
   taosMemoryFreeClear(output.columnData);
   return code;
 }
 
+// the cached uid list is stale for the child tables created, dropped or retagged after it was cached. drop them from
+// the list, and add back those still existing and qualified by the tag condition.
+static int32_t patchCachedTableList(void* pVnode, uint64_t suid, SNode* pTagCond, SArray* pUidList,
+                                    const SArray* pChanged, SStorageAPI* pAPI) {
+  int32_t         code = TSDB_CODE_SUCCESS;
+  int32_t         numOfChanged = taosArrayGetSize(pChanged);
+  SArray*         pUidTagList = NULL;
+  SArray*         pBlockList = NULL;
+  SSDataBlock*    pResBlock = NULL;
+  SScalarParam    output = {0};
+  tagFilterAssist ctx = {0};
+
+  SHashObj* pChangedSet =
+      taosHashInit(numOfChanged, taosGetDefaultHashFunction(TSDB_DATA_TYPE_UBIGINT), false, HASH_NO_LOCK);
+  pUidTagList = taosArrayInit(numOfChanged, sizeof(STUidTagInfo));
+  if (pChangedSet == NULL || pUidTagList == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _end;
+  }
+
+  for (int32_t i = 0; i < numOfChanged; ++i) {
+    uint64_t* uid = taosArrayGet(pChanged, i);
+    if (taosHashGet(pChangedSet, uid, sizeof(uint64_t)) != NULL) {
+      continue;
+    }
+
+    if (taosHashPut(pChangedSet, uid, sizeof(uint64_t), NULL, 0) != 0) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _end;
+    }
+
+    if (pAPI->metaFn.isTableExisted(pVnode, *uid)) {
+      STUidTagInfo info = {.uid = *uid};
+      taosArrayPush(pUidTagList, &info);
+    }
+  }
+
+  int32_t numOfTables = taosArrayGetSize(pUidList);
+  int32_t numOfKept = 0;
+  for (int32_t i = 0; i < numOfTables; ++i) {
+    uint64_t uid = *(uint64_t*)taosArrayGet(pUidList, i);
+    if (taosHashGet(pChangedSet, &uid, sizeof(uint64_t)) == NULL) {
+      *(uint64_t*)taosArrayGet(pUidList, numOfKept++) = uid;
+    }
+  }
+  taosArrayPopTailBatch(pUidList, numOfTables - numOfKept);
+
+  int32_t numOfExisted = taosArrayGetSize(pUidTagList);
+  if (numOfExisted == 0 || pTagCond == NULL) {
+    for (int32_t i = 0; i < numOfExisted; ++i) {
+      taosArrayPush(pUidList, &((STUidTagInfo*)taosArrayGet(pUidTagList, i))->uid);
+    }
+    goto _end;
+  }
+
+  ctx.colHash = taosHashInit(4, taosGetDefaultHashFunction(TSDB_DATA_TYPE_SMALLINT), false, HASH_NO_LOCK);
+  ctx.cInfoList = taosArrayInit(4, sizeof(SColumnInfo));
+  if (ctx.colHash == NULL || ctx.cInfoList == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _end;
+  }
+
+  nodesRewriteExprPostOrder(&pTagCond, getColumn, (void*)&ctx);
+
+  code = pAPI->metaFn.getTableTagsByUid(pVnode, suid, pUidTagList);
+  if (code != TSDB_CODE_SUCCESS) {
+    goto _end;
+  }
+
+  pResBlock = createTagValBlockForFilter(ctx.cInfoList, numOfExisted, pUidTagList, pVnode, pAPI);
+  if (pResBlock == NULL) {
+    code = terrno;
+    goto _end;
+  }
+
+  pBlockList = taosArrayInit(2, POINTER_BYTES);
+  taosArrayPush(pBlockList, &pResBlock);
+
+  SDataType type = {.type = TSDB_DATA_TYPE_BOOL, .bytes = sizeof(bool)};
+  code = createResultData(&type, numOfExisted, &output);
+  if (code != TSDB_CODE_SUCCESS) {
+    goto _end;
+  }
+
+  code = scalarCalculate(pTagCond, pBlockList, &output);
+  if (code != TSDB_CODE_SUCCESS) {
+    qError("failed to calculate scalar, reason:%s", tstrerror(code));
+    goto _end;
+  }
+
+  bool* pResult = (bool*)output.columnData->pData;
+  for (int32_t i = 0; i < numOfExisted; ++i) {
+    if (pResult[i]) {
+      taosArrayPush(pUidList, &((STUidTagInfo*)taosArrayGet(pUidTagList, i))->uid);
+    }
+  }
+
+_end:
+  taosHashCleanup(pChangedSet);
+  taosHashCleanup(ctx.colHash);
+  taosArrayDestroy(ctx.cInfoList);
+  blockDataDestroy(pResBlock);
+  taosArrayDestroy(pBlockList);
+  taosArrayDestroyEx(pUidTagList, freeItem);
+  colDataDestroy(output.columnData);
+  taosMemoryFreeClear(output.columnData);
+  return code;
+}
+
+// the cache is best effort, the list is not cached if it fails
+static void putCachedTableList(void* pVnode, uint64_t suid, T_MD5_CTX* pContext, const SArray* pUidList, int64_t ver,
+                               SStorageAPI* pAPI) {
+  size_t numOfTables = taosArrayGetSize(pUidList);
+  size_t size = numOfTables * sizeof(uint64_t) + sizeof(int32_t);
+  char*  pPayload = taosMemoryMalloc(size);
+  if (pPayload == NULL) {
+    return;
+  }
+
+  *(int32_t*)pPayload = numOfTables;
+  if (numOfTables > 0) {
+    memcpy(pPayload + sizeof(int32_t), taosArrayGet(pUidList, 0), numOfTables * sizeof(uint64_t));
+  }
+
+  int32_t code = pAPI->metaFn.putCachedTableList(pVnode, suid, pContext->digest, tListLen(pContext->digest), pPayload,
+                                                 size, 1, ver);
+  if (code != TSDB_CODE_SUCCESS) {
+    qDebug("failed to add table uid list into cache, suid:%" PRIu64 ", reason:%s", suid, tstrerror(code));
+  }
+}
+
 int32_t getTableList(void* pVnode, SScanPhysiNode* pScanNode, SNode* pTagCond, SNode* pTagIndexCond,
                      STableListInfo* pListInfo, uint8_t* digest, const char* idstr, SStorageAPI* pStorageAPI) {
   int32_t code = TSDB_CODE_SUCCESS;
@@ -1110,14 +1419,39 @@ int32_t getTableList(void* pVnode, SScanPhysiNode* pScanNode, SNode* pTagCond, S
     }
   } else {
     T_MD5_CTX context = {0};
+    int64_t   cacheVer = 0;
 
     if (tsTagFilterCache) {
       // try to retrieve the result from meta cache
       genTagFilterDigest(pTagCond, &context);
 
-      bool acquired = false;
-      pStorageAPI->metaFn.getCachedTableList(pVnode, pScanNode->suid, context.digest, tListLen(context.digest),
-                                             pUidList, &acquired);
+      bool    acquired = false;
+      SArray* pChanged = taosArrayInit(4, sizeof(uint64_t));
+      if (pChanged == NULL) {
+        code = TSDB_CODE_OUT_OF_MEMORY;
+        goto _end;
+      }
+
+      code = pStorageAPI->metaFn.getCachedTableList(pVnode, pScanNode->suid, context.digest, tListLen(context.digest),
+                                                    pUidList, pChanged, &cacheVer, &acquired);
+      if (code != TSDB_CODE_SUCCESS) {
+        // the super table is not registered in the cache, the list built below is not cached either
+        code = TSDB_CODE_SUCCESS;
+        acquired = false;
+      } else if (acquired && taosArrayGetSize(pChanged) > 0) {
+        // patch the cached list for the child tables changed since, instead of building it again
+        code = patchCachedTableList(pVnode, pScanNode->suid, pTagCond, pUidList, pChanged, pStorageAPI);
+        if (code == TSDB_CODE_SUCCESS) {
+          qDebug("patch cached table uid list for %d changed tables, suid:%" PRIu64 ", %s",
+                 (int32_t)taosArrayGetSize(pChanged), pScanNode->suid, idstr);
+          putCachedTableList(pVnode, pScanNode->suid, &context, pUidList, cacheVer, pStorageAPI);
+        }
+      }
+      taosArrayDestroy(pChanged);
+      if (code != TSDB_CODE_SUCCESS) {
+        goto _end;
+      }
+
       if (acquired) {
         digest[0] = 1;
         memcpy(digest + 1, context.digest, tListLen(context.digest));
@@ -1157,15 +1491,7 @@ int32_t getTableList(void* pVnode, SScanPhysiNode* pScanNode, SNode* pTagCond, S
     numOfTables = taosArrayGetSize(pUidList);
 
     if (tsTagFilterCache) {
-      size_t size = numOfTables * sizeof(uint64_t) + sizeof(int32_t);
-      char*  pPayload = taosMemoryMalloc(size);
-
-      *(int32_t*)pPayload = numOfTables;
-      if (numOfTables > 0) {
-        memcpy(pPayload + sizeof(int32_t), taosArrayGet(pUidList, 0), numOfTables * sizeof(uint64_t));
-      }
-
-      pStorageAPI->metaFn.putCachedTableList(pVnode, pScanNode->suid, context.digest, tListLen(context.digest), pPayload, size, 1);
+      putCachedTableList(pVnode, pScanNode->suid, &context, pUidList, cacheVer, pStorageAPI);
       digest[0] = 1;
       memcpy(digest + 1, context.digest, tListLen(context.digest));
     }
@@ -1358,8 +1684,9 @@ int32_t extractColMatchInfo(SNodeList* pNodeList, SDataBlockDescNode* pOutputNod
 
     SColMatchItem* info = NULL;
     for (int32_t j = 0; j < taosArrayGetSize(pList); ++j) {
-      info = taosArrayGet(pList, j);
-      if (info->dstSlotId == pNode->slotId) {
+      SColMatchItem* p = taosArrayGet(pList, j);
+      if (p->dstSlotId == pNode->slotId) {
+        info = p;
         break;
       }
     }
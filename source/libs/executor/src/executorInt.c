@@ -77,7 +77,8 @@ static void setBlockSMAInfo(SqlFunctionCtx* pCtx, SExprInfo* pExpr, SSDataBlock*
 static void initCtxOutputBuffer(SqlFunctionCtx* pCtx, int32_t size);
 static void doApplyScalarCalculation(SOperatorInfo* pOperator, SSDataBlock* pBlock, int32_t order, int32_t scanFlag);
 
-static void    extractQualifiedTupleByFilterResult(SSDataBlock* pBlock, const SColumnInfoData* p, int32_t status);
+static int32_t extractQualifiedTupleBySel(SSDataBlock* pBlock, const int32_t* pSel, int32_t numOfSel, int32_t status,
+                                          SColMatchInfo* pColMatchInfo);
 static int32_t doSetInputDataBlock(SExprSupp* pExprSup, SSDataBlock* pBlock, int32_t order, int32_t scanFlag,
                                    bool createDummyCol);
 static int32_t doCopyToSDataBlock(SExecTaskInfo* pTaskInfo, SSDataBlock* pBlock, SExprSupp* pSup, SDiskbasedBuf* pBuf,
@@ -502,13 +503,48 @@ void clearResultRowInitFlag(SqlFunctionCtx* pCtx, int32_t numOfOutput) {
   }
 }
 
+// Columns that are scanned only to evaluate the filter are not copied when the block is trimmed by the table scan,
+// since no downstream operator reads them. The primary timestamp column is always kept to update the block window.
+static bool* getFilterOnlyColumns(SSDataBlock* pBlock, SColMatchInfo* pColMatchInfo) {
+  if (pColMatchInfo == NULL) {
+    return NULL;
+  }
+
+  bool*  pUnused = NULL;
+  size_t size = taosArrayGetSize(pColMatchInfo->pList);
+  for (int32_t i = 0; i < size; ++i) {
+    SColMatchItem* pInfo = taosArrayGet(pColMatchInfo->pList, i);
+    if (pInfo->needOutput || pInfo->colId == PRIMARYKEY_TIMESTAMP_COL_ID ||
+        pInfo->dstSlotId >= taosArrayGetSize(pBlock->pDataBlock)) {
+      continue;
+    }
+
+    if (pUnused == NULL) {
+      pUnused = taosMemoryCalloc(taosArrayGetSize(pBlock->pDataBlock), sizeof(bool));
+      if (pUnused == NULL) {
+        return NULL;
+      }
+    }
+    pUnused[pInfo->dstSlotId] = true;
+  }
+
+  return pUnused;
+}
+
 int32_t doFilter(SSDataBlock* pBlock, SFilterInfo* pFilterInfo, SColMatchInfo* pColMatchInfo) {
+  return doFilterEx(pBlock, pFilterInfo, pColMatchInfo, false);
+}
+
+// dropFilterOnlyCols: the columns of pColMatchInfo not to output are not read after filtering, leave them NULL
+int32_t doFilterEx(SSDataBlock* pBlock, SFilterInfo* pFilterInfo, SColMatchInfo* pColMatchInfo,
+                   bool dropFilterOnlyCols) {
   if (pFilterInfo == NULL || pBlock->info.rows == 0) {
     return TSDB_CODE_SUCCESS;
   }
 
   SFilterColumnParam param1 = {.numOfCols = taosArrayGetSize(pBlock->pDataBlock), .pDataBlock = pBlock->pDataBlock};
-  SColumnInfoData*   p = NULL;
+  int32_t*           pSel = NULL;
+  int32_t            numOfSel = 0;
 
   int32_t code = filterSetDataFromSlotId(pFilterInfo, &param1);
   if (code != TSDB_CODE_SUCCESS) {
@@ -516,12 +552,15 @@ int32_t doFilter(SSDataBlock* pBlock, SFilterInfo* pFilterInfo, SColMatchInfo* p
   }
 
   int32_t status = 0;
-  code = filterExecute(pFilterInfo, pBlock, &p, NULL, param1.numOfCols, &status);
+  code = filterExecuteSel(pFilterInfo, pBlock, &pSel, &numOfSel, NULL, param1.numOfCols, &status);
   if (code != TSDB_CODE_SUCCESS) {
     goto _err;
   }
 
-  extractQualifiedTupleByFilterResult(pBlock, p, status);
+  code = extractQualifiedTupleBySel(pBlock, pSel, numOfSel, status, dropFilterOnlyCols ? pColMatchInfo : NULL);
+  if (code != TSDB_CODE_SUCCESS) {
+    goto _err;
+  }
 
   if (pColMatchInfo != NULL) {
     size_t size = taosArrayGetSize(pColMatchInfo->pList);
@@ -539,23 +578,26 @@ int32_t doFilter(SSDataBlock* pBlock, SFilterInfo* pFilterInfo, SColMatchInfo* p
   code = TSDB_CODE_SUCCESS;
 
 _err:
-  colDataDestroy(p);
-  taosMemoryFree(p);
+  taosMemoryFree(pSel);
   return code;
 }
 
-void extractQualifiedTupleByFilterResult(SSDataBlock* pBlock, const SColumnInfoData* p, int32_t status) {
-  int8_t* pIndicator = (int8_t*)p->pData;
+static int32_t extractQualifiedTupleBySel(SSDataBlock* pBlock, const int32_t* pSel, int32_t numOfSel, int32_t status,
+                                          SColMatchInfo* pColMatchInfo) {
+  int32_t code = TSDB_CODE_SUCCESS;
   if (status == FILTER_RESULT_ALL_QUALIFIED) {
     // here nothing needs to be done
   } else if (status == FILTER_RESULT_NONE_QUALIFIED) {
     trimDataBlock(pBlock, pBlock->info.rows, NULL);
     pBlock->info.rows = 0;
   } else if (status == FILTER_RESULT_PARTIAL_QUALIFIED) {
-    trimDataBlock(pBlock, pBlock->info.rows, (bool*)pIndicator);
+    bool* pUnused = getFilterOnlyColumns(pBlock, pColMatchInfo);
+    code = trimDataBlockBySel(pBlock, pSel, numOfSel, pUnused);
+    taosMemoryFree(pUnused);
   } else {
     qError("unknown filter result type: %d", status);
   }
+  return code;
 }
 
 void doUpdateNumOfRows(SqlFunctionCtx* pCtx, SResultRow* pRow, int32_t numOfExprs, const int32_t* rowEntryOffset) {
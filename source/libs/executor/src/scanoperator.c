@@ -398,7 +398,7 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
   pCost->totalRows -= pBlock->info.rows;
 
   if (pOperator->exprSupp.pFilterInfo != NULL) {
-    int32_t code = doFilter(pBlock, pOperator->exprSupp.pFilterInfo, &pTableScanInfo->matchInfo);
+    int32_t code = doFilterEx(pBlock, pOperator->exprSupp.pFilterInfo, &pTableScanInfo->matchInfo, true);
     if (code != TSDB_CODE_SUCCESS) return code;
 
     int64_t st = taosGetTimestampUs();
@@ -1030,6 +1030,7 @@ static SSDataBlock* groupSeqTableScan(SOperatorInfo* pOperator) {
     if (pInfo->filesetDelimited) {
       pAPI->tsdReader.tsdSetFilesetDelimited(pInfo->base.dataReader);
     }
+    pAPI->tsdReader.tsdSetFilter(pInfo->base.dataReader, pOperator->exprSupp.pFilterInfo);
     if (pInfo->pResBlock->info.capacity > pOperator->resultInfo.capacity) {
       pOperator->resultInfo.capacity = pInfo->pResBlock->info.capacity;
     }
@@ -3112,11 +3113,8 @@ static EDealRes tagScanRewriteTagColumn(SNode** pNode, void* pContext) {
 }
 
 
-static int32_t tagScanFilterByTagCond(SArray* aUidTags, SNode* pTagCond, SArray* aFilterIdxs, void* pVnode, SStorageAPI* pAPI, STagScanInfo* pInfo) {
+static int32_t tagScanFilterBlock(SSDataBlock* pResBlock, int32_t numOfTables, SNode* pTagCond, SArray* aFilterIdxs) {
   int32_t code = 0;
-  int32_t numOfTables = taosArrayGetSize(aUidTags);
-
-  SSDataBlock* pResBlock = createTagValBlockForFilter(pInfo->filterCtx.cInfoList, numOfTables, aUidTags, pVnode, pAPI);
 
   SArray* pBlockList = taosArrayInit(1, POINTER_BYTES);
   taosArrayPush(pBlockList, &pResBlock);
@@ -3143,12 +3141,24 @@ static int32_t tagScanFilterByTagCond(SArray* aUidTags, SNode* pTagCond, SArray*
   colDataDestroy(output.columnData);
   taosMemoryFreeClear(output.columnData);
 
-  blockDataDestroy(pResBlock);
   taosArrayDestroy(pBlockList);
 
   return TSDB_CODE_SUCCESS;
 }
 
+static int32_t tagScanFilterByTagCond(SArray* aUidTags, SNode* pTagCond, SArray* aFilterIdxs, void* pVnode, SStorageAPI* pAPI, STagScanInfo* pInfo) {
+  int32_t numOfTables = taosArrayGetSize(aUidTags);
+
+  SSDataBlock* pResBlock = createTagValBlockForFilter(pInfo->filterCtx.cInfoList, numOfTables, aUidTags, pVnode, pAPI);
+  if (pResBlock == NULL) {
+    return terrno;
+  }
+
+  int32_t code = tagScanFilterBlock(pResBlock, numOfTables, pTagCond, aFilterIdxs);
+  blockDataDestroy(pResBlock);
+  return code;
+}
+
 static void tagScanFillOneCellWithTag(SOperatorInfo* pOperator, const STUidTagInfo* pUidTagInfo, SExprInfo* pExprInfo, SColumnInfoData* pColInfo, int rowIndex, const SStorageAPI* pAPI, void* pVnode) {
   if (QUERY_NODE_FUNCTION == pExprInfo->pExpr->nodeType) {
     if (FUNCTION_TYPE_TBNAME == pExprInfo->pExpr->_function.functionType) {  // tbname
@@ -3213,6 +3223,128 @@ static int32_t tagScanFillResultBlock(SOperatorInfo* pOperator, SSDataBlock* pRe
   return 0;
 }
 
+static SMetaTagCols* tagScanAcquireTagCols(SOperatorInfo* pOperator) {
+  STagScanInfo* pInfo = pOperator->info;
+  SStorageAPI*  pAPI = &pOperator->pTaskInfo->storageAPI;
+  SExprInfo*    pExprInfo = &pOperator->exprSupp.pExprInfo[0];
+
+  SMetaTagCols* pTagCols =
+      acquireTagColsForFilter(pInfo->readHandle.vnode, pInfo->suid, pInfo->filterCtx.cInfoList, pAPI);
+  if (pTagCols == NULL) {
+    return NULL;
+  }
+
+  for (int32_t j = 0; j < pOperator->exprSupp.numOfExprs; ++j) {
+    if (QUERY_NODE_FUNCTION == pExprInfo[j].pExpr->nodeType) {
+      continue;
+    }
+
+    int16_t colId = pExprInfo[j].base.pParam[0].pCol->colId;
+    if (!isTagColumnUsable(pTagCols, colId, pExprInfo[j].base.resSchema.type)) {
+      pAPI->metaFn.releaseTagCols(pInfo->readHandle.vnode, pTagCols);
+      return NULL;
+    }
+  }
+
+  return pTagCols;
+}
+
+static void tagScanFillResultBlockFromTagCols(SOperatorInfo* pOperator, SSDataBlock* pRes, const int32_t* aRows,
+                                              int32_t startRow, int32_t numOfRows) {
+  STagScanInfo*       pInfo = pOperator->info;
+  const SMetaTagCols* pTagCols = pInfo->pTagCols;
+  SExprInfo*          pExprInfo = &pOperator->exprSupp.pExprInfo[0];
+
+  for (int32_t j = 0; j < pOperator->exprSupp.numOfExprs; ++j) {
+    SColumnInfoData* pDst = taosArrayGet(pRes->pDataBlock, pExprInfo[j].base.resSchema.slotId);
+
+    if (QUERY_NODE_FUNCTION != pExprInfo[j].pExpr->nodeType) {
+      fillTagColumn(pDst, getTagColumn(pTagCols, pExprInfo[j].base.pParam[0].pCol->colId), aRows, startRow, numOfRows);
+      continue;
+    }
+
+    int32_t funcType = pExprInfo[j].pExpr->_function.functionType;
+    if (FUNCTION_TYPE_TBNAME == funcType) {
+      char str[TSDB_TABLE_FNAME_LEN + VARSTR_HEADER_SIZE] = {0};
+      STR_TO_VARSTR(str, "ctbidx");
+      for (int32_t i = 0; i < numOfRows; ++i) {
+        colDataSetVal(pDst, i, str, false);
+      }
+    } else if (FUNCTION_TYPE_TBUID == funcType) {
+      for (int32_t i = 0; i < numOfRows; ++i) {
+        int32_t row = (aRows != NULL) ? aRows[i] : startRow + i;
+        colDataSetVal(pDst, i, (char*)&pTagCols->aUid[row], false);
+      }
+    } else if (FUNCTION_TYPE_VGID == funcType) {
+      for (int32_t i = 0; i < numOfRows; ++i) {
+        colDataSetVal(pDst, i, (char*)&pOperator->pTaskInfo->id.vgId, false);
+      }
+    }
+  }
+}
+
+// the same scan as the ctb.idx cursor, but each block is filtered and filled a column at a time
+static SSDataBlock* doTagScanFromTagCols(SOperatorInfo* pOperator) {
+  SExecTaskInfo* pTaskInfo = pOperator->pTaskInfo;
+  SStorageAPI*   pAPI = &pTaskInfo->storageAPI;
+
+  STagScanInfo*       pInfo = pOperator->info;
+  const SMetaTagCols* pTagCols = pInfo->pTagCols;
+  SSDataBlock*        pRes = pInfo->pRes;
+  SArray*             aFilterIdxs = pInfo->aFilterIdxs;
+  int32_t             count = 0;
+
+  while (pInfo->tagColsPos < pTagCols->nRows) {
+    int32_t startRow = pInfo->tagColsPos;
+    int32_t numOfRows = TMIN(pOperator->resultInfo.capacity, pTagCols->nRows - startRow);
+    pInfo->tagColsPos += numOfRows;
+
+    if (pInfo->pTagCond == NULL) {
+      tagScanFillResultBlockFromTagCols(pOperator, pRes, NULL, startRow, numOfRows);
+      count = numOfRows;
+      break;
+    }
+
+    taosArrayClear(aFilterIdxs);
+    SSDataBlock* pFilterBlock = createTagValBlockFromTagCols(pInfo->filterCtx.cInfoList, numOfRows, pTagCols, NULL,
+                                                             startRow, NULL, pInfo->readHandle.vnode, pAPI);
+    if (pFilterBlock == NULL) {
+      pTaskInfo->code = terrno;
+      T_LONG_JMP(pTaskInfo->env, terrno);
+    }
+    int32_t code = tagScanFilterBlock(pFilterBlock, numOfRows, pInfo->pTagCond, aFilterIdxs);
+    blockDataDestroy(pFilterBlock);
+    if (TSDB_CODE_SUCCESS != code) {
+      pTaskInfo->code = code;
+      T_LONG_JMP(pTaskInfo->env, code);
+    }
+
+    count = taosArrayGetSize(aFilterIdxs);
+    if (count > 0) {
+      int32_t* aRows = taosArrayGet(aFilterIdxs, 0);
+      for (int32_t i = 0; i < count; ++i) {
+        aRows[i] += startRow;
+      }
+      tagScanFillResultBlockFromTagCols(pOperator, pRes, aRows, 0, count);
+      break;
+    }
+  }
+
+  if (pInfo->tagColsPos >= pTagCols->nRows) {
+    pAPI->metaFn.releaseTagCols(pInfo->readHandle.vnode, pInfo->pTagCols);
+    pInfo->pTagCols = NULL;
+    setOperatorCompleted(pOperator);
+  }
+  pRes->info.rows = count;
+
+  bool bLimitReached = applyLimitOffset(&pInfo->limitInfo, pRes, pTaskInfo);
+  if (bLimitReached) {
+    setOperatorCompleted(pOperator);
+  }
+  pOperator->resultInfo.totalRows += pRes->info.rows;
+  return (pRes->info.rows == 0) ? NULL : pInfo->pRes;
+}
+
 static SSDataBlock* doTagScanFromCtbIdx(SOperatorInfo* pOperator) {
   if (pOperator->status == OP_EXEC_DONE) {
     return NULL;
@@ -3224,6 +3356,14 @@ static SSDataBlock* doTagScanFromCtbIdx(SOperatorInfo* pOperator) {
   SSDataBlock*  pRes = pInfo->pRes;
   blockDataCleanup(pRes);
 
+  if (!pInfo->tagColsChecked) {
+    pInfo->tagColsChecked = true;
+    pInfo->pTagCols = tagScanAcquireTagCols(pOperator);
+  }
+  if (pInfo->pTagCols != NULL) {
+    return doTagScanFromTagCols(pOperator);
+  }
+
   if (pInfo->pCtbCursor == NULL) {
     pInfo->pCtbCursor = pAPI->metaFn.openCtbCursor(pInfo->readHandle.vnode, pInfo->suid, 1);
   } else {
@@ -3348,6 +3488,9 @@ static void destroyTagScanOperatorInfo(void* param) {
   if (pInfo->pCtbCursor != NULL) {
     pInfo->pStorageAPI->metaFn.closeCtbCursor(pInfo->pCtbCursor);
   }
+  if (pInfo->pTagCols != NULL) {
+    pInfo->pStorageAPI->metaFn.releaseTagCols(pInfo->readHandle.vnode, pInfo->pTagCols);
+  }
   taosHashCleanup(pInfo->filterCtx.colHash);
   taosArrayDestroy(pInfo->filterCtx.cInfoList);
   taosArrayDestroy(pInfo->aFilterIdxs);
@@ -4078,6 +4221,7 @@ int32_t startGroupTableMergeScan(SOperatorInfo* pOperator) {
     pAPI->tsdReader.tsdSetFilesetDelimited(pInfo->base.dataReader);
   }
   pAPI->tsdReader.tsdSetSetNotifyCb(pInfo->base.dataReader, tableMergeScanTsdbNotifyCb, pInfo);
+  pAPI->tsdReader.tsdSetFilter(pInfo->base.dataReader, pOperator->exprSupp.pFilterInfo);
 
   int32_t code = startDurationForGroupTableMergeScan(pOperator);
 
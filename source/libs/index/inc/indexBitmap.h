@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TD_INDEX_BITMAP_H_
+#define _TD_INDEX_BITMAP_H_
+
+#include "os.h"
+#include "tarray.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * compressed uid set in the roaring layout: uids are partitioned by their high 48 bits, and the low 16 bits of
+ * each partition are kept in a container, a sorted uint16 array while sparse and a 2^16 bit set once it holds
+ * more than IDX_BITMAP_ARRAY_MAX values. uids generated in a burst share the high bits, so the postings of
+ * child tables created together fall into few dense containers.
+ *
+ * serialized layout:
+ * |<-numOfContainers->|<---key--->|<--type-->|<--card-->|<--values or bits-->| ... |
+ * |<-----int32_t----->|<-uint64_t->|<-uint8_t->|<-int32_t->|<-card * uint16_t or 1024 * uint64_t->|
+ */
+
+#define IDX_BITMAP_ARRAY_MAX 4096
+
+typedef struct SIdxBmContainer SIdxBmContainer;
+
+typedef struct SIdxBitmap {
+  int32_t          num;
+  int32_t          cap;
+  SIdxBmContainer *pContainers;
+} SIdxBitmap;
+
+SIdxBitmap *idxBitmapCreate();
+void        idxBitmapDestroy(SIdxBitmap *bm);
+void        idxBitmapClear(SIdxBitmap *bm);
+int64_t     idxBitmapCardinality(const SIdxBitmap *bm);
+bool        idxBitmapContains(const SIdxBitmap *bm, uint64_t uid);
+
+int32_t idxBitmapAdd(SIdxBitmap *bm, uint64_t uid);
+// add all uids of an array of uint64_t, cheapest when the array is sorted
+int32_t idxBitmapAddArray(SIdxBitmap *bm, const SArray *uids);
+// append all uids in ascending order to an array of uint64_t
+int32_t idxBitmapToArray(const SIdxBitmap *bm, SArray *uids);
+
+// set operations, the result is a new bitmap
+SIdxBitmap *idxBitmapAnd(const SIdxBitmap *a, const SIdxBitmap *b);
+SIdxBitmap *idxBitmapOr(const SIdxBitmap *a, const SIdxBitmap *b);
+SIdxBitmap *idxBitmapAndNot(const SIdxBitmap *a, const SIdxBitmap *b);
+
+int32_t     idxBitmapSerialSize(const SIdxBitmap *bm);
+// serialized size of the bitmap of a sorted array of distinct uint64_t, without building it
+int32_t     idxBitmapSerialSizeOfArray(const SArray *uids);
+int32_t     idxBitmapSerial(const SIdxBitmap *bm, char *buf);
+SIdxBitmap *idxBitmapDeserial(const char *buf, int32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_TD_INDEX_BITMAP_H_*/
@@ -0,0 +1,629 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "indexBitmap.h"
+#include "taoserror.h"
+
+#define IDX_BM_ARRAY  0
+#define IDX_BM_BITSET 1
+
+#define IDX_BM_WORDS         1024  // 2^16 bits
+#define IDX_BM_BITSET_SIZE   (IDX_BM_WORDS * sizeof(uint64_t))
+#define IDX_BM_HEAD_SIZE     (sizeof(uint64_t) + sizeof(uint8_t) + sizeof(int32_t))
+#define IDX_BM_KEY(uid)      ((uid) >> 16)
+#define IDX_BM_LOW(uid)      ((uint16_t)((uid)&0xFFFF))
+#define IDX_BM_UID(key, low) (((key) << 16) | (uint64_t)(low))
+
+#define IDX_BM_TEST(w, v)  (((w)[(v) >> 6] >> ((v)&63)) & 1)
+#define IDX_BM_SET(w, v)   ((w)[(v) >> 6] |= (1ULL << ((v)&63)))
+#define IDX_BM_UNSET(w, v) ((w)[(v) >> 6] &= ~(1ULL << ((v)&63)))
+
+struct SIdxBmContainer {
+  uint64_t key;
+  int8_t   type;
+  int32_t  card;
+  int32_t  cap;  // values an array container can hold without growing
+  void    *data;
+};
+
+static FORCE_INLINE int32_t idxBmPopcnt(uint64_t w) {
+#if defined(WINDOWS)
+  w = w - ((w >> 1) & 0x5555555555555555ULL);
+  w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+  w = (w + (w >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return (int32_t)((w * 0x0101010101010101ULL) >> 56);
+#else
+  return __builtin_popcountll(w);
+#endif
+}
+
+static void idxBmContainerFree(SIdxBmContainer *c) {
+  taosMemoryFreeClear(c->data);
+  c->card = 0;
+  c->cap = 0;
+}
+
+static int32_t idxBmArrayReserve(SIdxBmContainer *c, int32_t cap) {
+  if (c->cap >= cap) return 0;
+
+  int32_t ncap = c->cap == 0 ? 4 : c->cap;
+  while (ncap < cap) ncap *= 2;
+  ncap = TMIN(ncap, IDX_BITMAP_ARRAY_MAX);
+
+  void *data = taosMemoryRealloc(c->data, ncap * sizeof(uint16_t));
+  if (data == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return -1;
+  }
+  c->data = data;
+  c->cap = ncap;
+  return 0;
+}
+
+static int32_t idxBmToBitset(SIdxBmContainer *c) {
+  uint64_t *words = taosMemoryCalloc(1, IDX_BM_BITSET_SIZE);
+  if (words == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return -1;
+  }
+
+  uint16_t *vals = c->data;
+  for (int32_t i = 0; i < c->card; i++) {
+    IDX_BM_SET(words, vals[i]);
+  }
+  taosMemoryFree(c->data);
+  c->data = words;
+  c->type = IDX_BM_BITSET;
+  c->cap = 0;
+  return 0;
+}
+
+// turn a bit set container back to an array once it is sparse enough
+static int32_t idxBmNormalize(SIdxBmContainer *c) {
+  if (c->type != IDX_BM_BITSET || c->card > IDX_BITMAP_ARRAY_MAX) return 0;
+
+  uint16_t *vals = taosMemoryMalloc(TMAX(c->card, 1) * sizeof(uint16_t));
+  if (vals == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return -1;
+  }
+
+  uint64_t *words = c->data;
+  int32_t   n = 0;
+  for (int32_t i = 0; i < IDX_BM_WORDS; i++) {
+    for (uint64_t w = words[i]; w != 0; w &= w - 1) {
+      vals[n++] = (uint16_t)(i * 64 + BUILDIN_CTZL(w));
+    }
+  }
+  taosMemoryFree(c->data);
+  c->data = vals;
+  c->type = IDX_BM_ARRAY;
+  c->cap = TMAX(c->card, 1);
+  return 0;
+}
+
+static int32_t idxBmContainerCopy(const SIdxBmContainer *src, SIdxBmContainer *dst) {
+  int64_t size = src->type == IDX_BM_BITSET ? IDX_BM_BITSET_SIZE : TMAX(src->card, 1) * sizeof(uint16_t);
+
+  *dst = (SIdxBmContainer){.key = src->key, .type = src->type, .card = src->card};
+  dst->data = taosMemoryMalloc(size);
+  if (dst->data == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return -1;
+  }
+  memcpy(dst->data, src->data, src->type == IDX_BM_BITSET ? size : src->card * sizeof(uint16_t));
+  dst->cap = src->type == IDX_BM_BITSET ? 0 : TMAX(src->card, 1);
+  return 0;
+}
+
+// first position in vals[s, e) whose value is not less than v
+static FORCE_INLINE int32_t idxBmLowerBound(const uint16_t *vals, int32_t s, int32_t e, uint16_t v) {
+  while (s < e) {
+    int32_t m = s + (e - s) / 2;
+    if (vals[m] < v) {
+      s = m + 1;
+    } else {
+      e = m;
+    }
+  }
+  return s;
+}
+
+static int32_t idxBmContainerAdd(SIdxBmContainer *c, uint16_t low) {
+  if (c->type == IDX_BM_BITSET) {
+    if (!IDX_BM_TEST((uint64_t *)c->data, low)) {
+      IDX_BM_SET((uint64_t *)c->data, low);
+      c->card++;
+    }
+    return 0;
+  }
+
+  uint16_t *vals = c->data;
+  int32_t   pos = c->card;
+  if (c->card > 0 && vals[c->card - 1] >= low) {
+    pos = idxBmLowerBound(vals, 0, c->card, low);
+    if (vals[pos] == low) return 0;
+  }
+
+  if (c->card >= IDX_BITMAP_ARRAY_MAX) {
+    if (idxBmToBitset(c) != 0) return -1;
+    IDX_BM_SET((uint64_t *)c->data, low);
+    c->card++;
+    return 0;
+  }
+
+  if (idxBmArrayReserve(c, c->card + 1) != 0) return -1;
+  vals = c->data;
+  if (pos < c->card) {
+    memmove(vals + pos + 1, vals + pos, (c->card - pos) * sizeof(uint16_t));
+  }
+  vals[pos] = low;
+  c->card++;
+  return 0;
+}
+
+static int32_t idxBmFind(const SIdxBitmap *bm, uint64_t key, bool *found) {
+  int32_t s = 0, e = bm->num;
+  while (s < e) {
+    int32_t m = s + (e - s) / 2;
+    if (bm->pContainers[m].key < key) {
+      s = m + 1;
+    } else {
+      e = m;
+    }
+  }
+  *found = (s < bm->num && bm->pContainers[s].key == key);
+  return s;
+}
+
+static SIdxBmContainer *idxBmInsert(SIdxBitmap *bm, int32_t pos, uint64_t key) {
+  if (bm->num >= bm->cap) {
+    int32_t          ncap = bm->cap == 0 ? 4 : bm->cap * 2;
+    SIdxBmContainer *p = taosMemoryRealloc(bm->pContainers, ncap * sizeof(SIdxBmContainer));
+    if (p == NULL) {
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      return NULL;
+    }
+    bm->pContainers = p;
+    bm->cap = ncap;
+  }
+
+  if (pos < bm->num) {
+    memmove(bm->pContainers + pos + 1, bm->pContainers + pos, (bm->num - pos) * sizeof(SIdxBmContainer));
+  }
+  bm->pContainers[pos] = (SIdxBmContainer){.key = key, .type = IDX_BM_ARRAY};
+  bm->num++;
+  return &bm->pContainers[pos];
+}
+
+// append a container built in key order, the bitmap takes over its data
+static int32_t idxBmPush(SIdxBitmap *bm, SIdxBmContainer *c) {
+  if (c->card == 0) {
+    idxBmContainerFree(c);
+    return 0;
+  }
+
+  SIdxBmContainer *p = idxBmInsert(bm, bm->num, c->key);
+  if (p == NULL) {
+    idxBmContainerFree(c);
+    return -1;
+  }
+  *p = *c;
+  return 0;
+}
+
+SIdxBitmap *idxBitmapCreate() {
+  SIdxBitmap *bm = taosMemoryCalloc(1, sizeof(SIdxBitmap));
+  if (bm == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+  }
+  return bm;
+}
+
+void idxBitmapClear(SIdxBitmap *bm) {
+  if (bm == NULL) return;
+  for (int32_t i = 0; i < bm->num; i++) {
+    idxBmContainerFree(&bm->pContainers[i]);
+  }
+  bm->num = 0;
+}
+
+void idxBitmapDestroy(SIdxBitmap *bm) {
+  if (bm == NULL) return;
+  idxBitmapClear(bm);
+  taosMemoryFree(bm->pContainers);
+  taosMemoryFree(bm);
+}
+
+int64_t idxBitmapCardinality(const SIdxBitmap *bm) {
+  int64_t card = 0;
+  for (int32_t i = 0; i < bm->num; i++) {
+    card += bm->pContainers[i].card;
+  }
+  return card;
+}
+
+bool idxBitmapContains(const SIdxBitmap *bm, uint64_t uid) {
+  bool    found = false;
+  int32_t pos = idxBmFind(bm, IDX_BM_KEY(uid), &found);
+  if (!found) return false;
+
+  SIdxBmContainer *c = &bm->pContainers[pos];
+  uint16_t         low = IDX_BM_LOW(uid);
+  if (c->type == IDX_BM_BITSET) {
+    return IDX_BM_TEST((uint64_t *)c->data, low);
+  }
+  int32_t idx = idxBmLowerBound(c->data, 0, c->card, low);
+  return idx < c->card && ((uint16_t *)c->data)[idx] == low;
+}
+
+int32_t idxBitmapAdd(SIdxBitmap *bm, uint64_t uid) {
+  uint64_t         key = IDX_BM_KEY(uid);
+  SIdxBmContainer *c = NULL;
+
+  if (bm->num > 0 && bm->pContainers[bm->num - 1].key == key) {
+    c = &bm->pContainers[bm->num - 1];
+  } else if (bm->num == 0 || bm->pContainers[bm->num - 1].key < key) {
+    c = idxBmInsert(bm, bm->num, key);
+  } else {
+    bool    found = false;
+    int32_t pos = idxBmFind(bm, key, &found);
+    c = found ? &bm->pContainers[pos] : idxBmInsert(bm, pos, key);
+  }
+  if (c == NULL) return -1;
+
+  if (idxBmContainerAdd(c, IDX_BM_LOW(uid)) != 0) {
+    // never leave an empty container behind
+    if (c->card == 0) {
+      int32_t pos = (int32_t)(c - bm->pContainers);
+      idxBmContainerFree(c);
+      memmove(c, c + 1, (bm->num - pos - 1) * sizeof(SIdxBmContainer));
+      bm->num--;
+    }
+    return -1;
+  }
+  return 0;
+}
+
+int32_t idxBitmapAddArray(SIdxBitmap *bm, const SArray *uids) {
+  int32_t sz = (int32_t)taosArrayGetSize(uids);
+  for (int32_t i = 0; i < sz; i++) {
+    if (idxBitmapAdd(bm, *(uint64_t *)taosArrayGet(uids, i)) != 0) return -1;
+  }
+  return 0;
+}
+
+int32_t idxBitmapToArray(const SIdxBitmap *bm, SArray *uids) {
+  if (taosArrayEnsureCap(uids, taosArrayGetSize(uids) + idxBitmapCardinality(bm)) != 0) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return -1;
+  }
+
+  for (int32_t i = 0; i < bm->num; i++) {
+    SIdxBmContainer *c = &bm->pContainers[i];
+    if (c->type == IDX_BM_ARRAY) {
+      uint16_t *vals = c->data;
+      for (int32_t j = 0; j < c->card; j++) {
+        uint64_t uid = IDX_BM_UID(c->key, vals[j]);
+        taosArrayPush(uids, &uid);
+      }
+    } else {
+      uint64_t *words = c->data;
+      for (int32_t j = 0; j < IDX_BM_WORDS; j++) {
+        for (uint64_t w = words[j]; w != 0; w &= w - 1) {
+          uint64_t uid = IDX_BM_UID(c->key, j * 64 + BUILDIN_CTZL(w));
+          taosArrayPush(uids, &uid);
+        }
+      }
+    }
+  }
+  return 0;
+}
+
+static int32_t idxBmAndContainer(const SIdxBmContainer *a, const SIdxBmContainer *b, SIdxBmContainer *r) {
+  *r = (SIdxBmContainer){.key = a->key, .type = IDX_BM_ARRAY};
+
+  if (a->type == IDX_BM_BITSET && b->type == IDX_BM_BITSET) {
+    if (idxBmContainerCopy(a, r) != 0) return -1;
+    uint64_t *words = r->data;
+    uint64_t *bw = b->data;
+    r->card = 0;
+    for (int32_t i = 0; i < IDX_BM_WORDS; i++) {
+      words[i] &= bw[i];
+      r->card += idxBmPopcnt(words[i]);
+    }
+    return idxBmNormalize(r);
+  }
+
+  if (a->type == IDX_BM_BITSET) {
+    const SIdxBmContainer *t = a;
+    a = b;
+    b = t;
+  }
+
+  // a is an array container from here
+  if (idxBmArrayReserve(r, TMAX(TMIN(a->card, b->card), 1)) != 0) return -1;
+  uint16_t *av = a->data;
+  uint16_t *rv = r->data;
+  if (b->type == IDX_BM_BITSET) {
+    for (int32_t i = 0; i < a->card; i++) {
+      if (IDX_BM_TEST((uint64_t *)b->data, av[i])) rv[r->card++] = av[i];
+    }
+  } else {
+    uint16_t *bv = b->data;
+    int32_t   i = 0, j = 0;
+    while (i < a->card && j < b->card) {
+      if (av[i] < bv[j]) {
+        i++;
+      } else if (av[i] > bv[j]) {
+        j++;
+      } else {
+        rv[r->card++] = av[i];
+        i++;
+        j++;
+      }
+    }
+  }
+  return 0;
+}
+
+static int32_t idxBmOrContainer(const SIdxBmContainer *a, const SIdxBmContainer *b, SIdxBmContainer *r) {
+  *r = (SIdxBmContainer){.key = a->key, .type = IDX_BM_ARRAY};
+
+  if (a->type == IDX_BM_ARRAY && b->type == IDX_BM_ARRAY && a->card + b->card <= IDX_BITMAP_ARRAY_MAX) {
+    if (idxBmArrayReserve(r, TMAX(a->card + b->card, 1)) != 0) return -1;
+    uint16_t *av = a->data, *bv = b->data, *rv = r->data;
+    int32_t   i = 0, j = 0;
+    while (i < a->card || j < b->card) {
+      if (j >= b->card || (i < a->card && av[i] < bv[j])) {
+        rv[r->card++] = av[i++];
+      } else if (i >= a->card || av[i] > bv[j]) {
+        rv[r->card++] = bv[j++];
+      } else {
+        rv[r->card++] = av[i];
+        i++;
+        j++;
+      }
+    }
+    return 0;
+  }
+
+  if (a->type == IDX_BM_ARRAY) {
+    const SIdxBmContainer *t = a;
+    a = b;
+    b = t;
+  }
+
+  // a is a bit set container unless both are large arrays
+  if (a->type == IDX_BM_BITSET) {
+    if (idxBmContainerCopy(a, r) != 0) return -1;
+  } else {
+    if (idxBmContainerCopy(a, r) != 0 || idxBmToBitset(r) != 0) return -1;
+  }
+
+  uint64_t *words = r->data;
+  if (b->type == IDX_BM_BITSET) {
+    uint64_t *bw = b->data;
+    r->card = 0;
+    for (int32_t i = 0; i < IDX_BM_WORDS; i++) {
+      words[i] |= bw[i];
+      r->card += idxBmPopcnt(words[i]);
+    }
+  } else {
+    uint16_t *bv = b->data;
+    for (int32_t i = 0; i < b->card; i++) {
+      if (!IDX_BM_TEST(words, bv[i])) {
+        IDX_BM_SET(words, bv[i]);
+        r->card++;
+      }
+    }
+  }
+  return idxBmNormalize(r);
+}
+
+static int32_t idxBmAndNotContainer(const SIdxBmContainer *a, const SIdxBmContainer *b, SIdxBmContainer *r) {
+  *r = (SIdxBmContainer){.key = a->key, .type = IDX_BM_ARRAY};
+
+  if (a->type == IDX_BM_BITSET) {
+    if (idxBmContainerCopy(a, r) != 0) return -1;
+    uint64_t *words = r->data;
+    if (b->type == IDX_BM_BITSET) {
+      uint64_t *bw = b->data;
+      r->card = 0;
+      for (int32_t i = 0; i < IDX_BM_WORDS; i++) {
+        words[i] &= ~bw[i];
+        r->card += idxBmPopcnt(words[i]);
+      }
+    } else {
+      uint16_t *bv = b->data;
+      for (int32_t i = 0; i < b->card; i++) {
+        if (IDX_BM_TEST(words, bv[i])) {
+          IDX_BM_UNSET(words, bv[i]);
+          r->card--;
+        }
+      }
+    }
+    return idxBmNormalize(r);
+  }
+
+  if (idxBmArrayReserve(r, TMAX(a->card, 1)) != 0) return -1;
+  uint16_t *av = a->data;
+  uint16_t *rv = r->data;
+  if (b->type == IDX_BM_BITSET) {
+    for (int32_t i = 0; i < a->card; i++) {
+      if (!IDX_BM_TEST((uint64_t *)b->data, av[i])) rv[r->card++] = av[i];
+    }
+  } else {
+    uint16_t *bv = b->data;
+    int32_t   j = 0;
+    for (int32_t i = 0; i < a->card; i++) {
+      j = idxBmLowerBound(bv, j, b->card, av[i]);
+      if (j >= b->card || bv[j] != av[i]) rv[r->card++] = av[i];
+    }
+  }
+  return 0;
+}
+
+typedef int32_t (*idx_bm_container_fn)(const SIdxBmContainer *a, const SIdxBmContainer *b, SIdxBmContainer *r);
+
+// walk the containers of both bitmaps in key order, keep the unmatched ones of a and/or b as asked
+static SIdxBitmap *idxBmMerge(const SIdxBitmap *a, const SIdxBitmap *b, idx_bm_container_fn fn, bool keepA,
+                              bool keepB) {
+  SIdxBitmap *r = idxBitmapCreate();
+  if (r == NULL) return NULL;
+
+  int32_t i = 0, j = 0;
+  while (i < a->num || j < b->num) {
+    SIdxBmContainer c = {0};
+    int32_t         code = 0;
+
+    if (j >= b->num || (i < a->num && a->pContainers[i].key < b->pContainers[j].key)) {
+      if (keepA) code = idxBmContainerCopy(&a->pContainers[i], &c);
+      i++;
+    } else if (i >= a->num || a->pContainers[i].key > b->pContainers[j].key) {
+      if (keepB) code = idxBmContainerCopy(&b->pContainers[j], &c);
+      j++;
+    } else {
+      code = fn(&a->pContainers[i], &b->pContainers[j], &c);
+      i++;
+      j++;
+    }
+
+    if (code != 0 || idxBmPush(r, &c) != 0) {
+      idxBmContainerFree(&c);
+      idxBitmapDestroy(r);
+      return NULL;
+    }
+  }
+  return r;
+}
+
+SIdxBitmap *idxBitmapAnd(const SIdxBitmap *a, const SIdxBitmap *b) {
+  return idxBmMerge(a, b, idxBmAndContainer, false, false);
+}
+SIdxBitmap *idxBitmapOr(const SIdxBitmap *a, const SIdxBitmap *b) {
+  return idxBmMerge(a, b, idxBmOrContainer, true, true);
+}
+SIdxBitmap *idxBitmapAndNot(const SIdxBitmap *a, const SIdxBitmap *b) {
+  return idxBmMerge(a, b, idxBmAndNotContainer, true, false);
+}
+
+int32_t idxBitmapSerialSize(const SIdxBitmap *bm) {
+  int32_t size = sizeof(int32_t);
+  for (int32_t i = 0; i < bm->num; i++) {
+    SIdxBmContainer *c = &bm->pContainers[i];
+    size += IDX_BM_HEAD_SIZE + (c->type == IDX_BM_BITSET ? IDX_BM_BITSET_SIZE : c->card * sizeof(uint16_t));
+  }
+  return size;
+}
+
+int32_t idxBitmapSerialSizeOfArray(const SArray *uids) {
+  int32_t sz = (int32_t)taosArrayGetSize(uids);
+  int32_t size = sizeof(int32_t);
+  for (int32_t i = 0; i < sz;) {
+    uint64_t key = IDX_BM_KEY(*(uint64_t *)taosArrayGet(uids, i));
+    int32_t  card = 0;
+    for (; i < sz && IDX_BM_KEY(*(uint64_t *)taosArrayGet(uids, i)) == key; i++) card++;
+    size += IDX_BM_HEAD_SIZE + (card > IDX_BITMAP_ARRAY_MAX ? IDX_BM_BITSET_SIZE : card * sizeof(uint16_t));
+  }
+  return size;
+}
+
+int32_t idxBitmapSerial(const SIdxBitmap *bm, char *buf) {
+  char *p = buf;
+  memcpy(p, &bm->num, sizeof(bm->num));
+  p += sizeof(bm->num);
+
+  for (int32_t i = 0; i < bm->num; i++) {
+    SIdxBmContainer *c = &bm->pContainers[i];
+    uint8_t          type = c->type;
+    int32_t          len = c->type == IDX_BM_BITSET ? IDX_BM_BITSET_SIZE : c->card * sizeof(uint16_t);
+
+    memcpy(p, &c->key, sizeof(c->key));
+    p += sizeof(c->key);
+    memcpy(p, &type, sizeof(type));
+    p += sizeof(type);
+    memcpy(p, &c->card, sizeof(c->card));
+    p += sizeof(c->card);
+    memcpy(p, c->data, len);
+    p += len;
+  }
+  return (int32_t)(p - buf);
+}
+
+SIdxBitmap *idxBitmapDeserial(const char *buf, int32_t len) {
+  const char *p = buf;
+  const char *end = buf + len;
+  int32_t     num = 0;
+  SIdxBitmap *bm = NULL;
+
+  if (len < sizeof(num)) goto _err;
+  memcpy(&num, p, sizeof(num));
+  p += sizeof(num);
+  if (num < 0) goto _err;
+
+  bm = idxBitmapCreate();
+  if (bm == NULL) return NULL;
+
+  for (int32_t i = 0; i < num; i++) {
+    SIdxBmContainer c = {0};
+    uint8_t         type = 0;
+
+    if (end - p < IDX_BM_HEAD_SIZE) goto _err1;
+    memcpy(&c.key, p, sizeof(c.key));
+    p += sizeof(c.key);
+    memcpy(&type, p, sizeof(type));
+    p += sizeof(type);
+    memcpy(&c.card, p, sizeof(c.card));
+    p += sizeof(c.card);
+
+    if (type == IDX_BM_BITSET) {
+      if (c.card <= 0 || c.card > 65536 || end - p < IDX_BM_BITSET_SIZE) goto _err1;
+      c.type = IDX_BM_BITSET;
+      if ((c.data = taosMemoryMalloc(IDX_BM_BITSET_SIZE)) == NULL) goto _oom;
+      memcpy(c.data, p, IDX_BM_BITSET_SIZE);
+      p += IDX_BM_BITSET_SIZE;
+    } else if (type == IDX_BM_ARRAY) {
+      if (c.card <= 0 || c.card > IDX_BITMAP_ARRAY_MAX || end - p < c.card * sizeof(uint16_t)) goto _err1;
+      c.type = IDX_BM_ARRAY;
+      c.cap = c.card;
+      if ((c.data = taosMemoryMalloc(c.card * sizeof(uint16_t))) == NULL) goto _oom;
+      memcpy(c.data, p, c.card * sizeof(uint16_t));
+      p += c.card * sizeof(uint16_t);
+    } else {
+      goto _err1;
+    }
+
+    if (i > 0 && bm->pContainers[bm->num - 1].key >= c.key) {
+      idxBmContainerFree(&c);
+      goto _err1;
+    }
+    if (idxBmPush(bm, &c) != 0) {
+      idxBitmapDestroy(bm);
+      return NULL;
+    }
+  }
+  return bm;
+
+_oom:
+  idxBitmapDestroy(bm);
+  terrno = TSDB_CODE_OUT_OF_MEMORY;
+  return NULL;
+_err1:
+  idxBitmapDestroy(bm);
+_err:
+  terrno = TSDB_CODE_INVALID_DATA_FMT;
+  return NULL;
+}
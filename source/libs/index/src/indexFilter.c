@@ -15,6 +15,7 @@
 
 #include "filter.h"
 #include "index.h"
+#include "indexBitmap.h"
 #include "indexComm.h"
 #include "indexInt.h"
 #include "indexUtil.h"
@@ -860,6 +861,39 @@ _return:
   return code;
 }
 
+// combine the uids of the operands with compressed bitmaps, an operand the index can not serve restricts nothing in
+// AND and is skipped
+static int32_t sifMergeResult(ELogicConditionType type, SIFParam *params, int32_t nParam, SArray *result) {
+  SIdxBitmap *pRes = NULL;
+  for (int32_t m = 0; m < nParam; m++) {
+    if (type == LOGIC_COND_TYPE_AND && params[m].status == SFLT_NOT_INDEX) continue;
+
+    SIdxBitmap *pBm = idxBitmapCreate();
+    if (pBm == NULL || (params[m].result && idxBitmapAddArray(pBm, params[m].result) != 0)) {
+      idxBitmapDestroy(pBm);
+      idxBitmapDestroy(pRes);
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    if (pRes == NULL) {
+      pRes = pBm;
+      continue;
+    }
+
+    SIdxBitmap *pNew = (type == LOGIC_COND_TYPE_AND) ? idxBitmapAnd(pRes, pBm) : idxBitmapOr(pRes, pBm);
+    idxBitmapDestroy(pRes);
+    idxBitmapDestroy(pBm);
+    if (pNew == NULL) return TSDB_CODE_OUT_OF_MEMORY;
+    pRes = pNew;
+  }
+
+  int32_t code = TSDB_CODE_SUCCESS;
+  if (pRes != NULL && idxBitmapToArray(pRes, result) != 0) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+  }
+  idxBitmapDestroy(pRes);
+  return code;
+}
+
 static int32_t sifExecLogic(SLogicConditionNode *node, SIFCtx *ctx, SIFParam *output) {
   if (NULL == node->pParameterList || node->pParameterList->length <= 0) {
     indexError("invalid logic parameter list, list:%p, paramNum:%d", node->pParameterList,
@@ -873,15 +907,10 @@ static int32_t sifExecLogic(SLogicConditionNode *node, SIFCtx *ctx, SIFParam *ou
 
   if (ctx->noExec == false) {
     for (int32_t m = 0; m < node->pParameterList->length; m++) {
-      if (node->condType == LOGIC_COND_TYPE_AND) {
-        taosArrayAddAll(output->result, params[m].result);
-      } else if (node->condType == LOGIC_COND_TYPE_OR) {
-        taosArrayAddAll(output->result, params[m].result);
-      } else if (node->condType == LOGIC_COND_TYPE_NOT) {
-        // taosArrayAddAll(output->result, params[m].result);
-      }
-      taosArraySort(output->result, uidCompare);
-      taosArrayRemoveDuplicate(output->result, uidCompare, NULL);
+      output->status = sifMergeCond(node->condType, output->status, params[m].status);
+    }
+    if (node->condType == LOGIC_COND_TYPE_AND || node->condType == LOGIC_COND_TYPE_OR) {
+      SIF_ERR_JRET(sifMergeResult(node->condType, params, node->pParameterList->length, output->result));
     }
   } else {
     for (int32_t m = 0; m < node->pParameterList->length; m++) {
@@ -14,6 +14,7 @@
 
 #include "indexTfile.h"
 #include "index.h"
+#include "indexBitmap.h"
 #include "indexComm.h"
 #include "indexFst.h"
 #include "indexFstFile.h"
@@ -34,9 +35,10 @@ typedef struct TFileFstIter {
 
 #define TF_TABLE_TATOAL_SIZE(sz) (sizeof(sz) + sz * sizeof(uint64_t))
 
-static int  tfileStrCompare(const void* a, const void* b);
-static int  tfileValueCompare(const void* a, const void* b, const void* param);
-static void tfileSerialTableIdsToBuf(char* buf, SArray* tableIds);
+static int     tfileStrCompare(const void* a, const void* b);
+static int     tfileValueCompare(const void* a, const void* b, const void* param);
+static int32_t tfileTableIdsSerialSize(SArray* tableIds, bool* bitmap);
+static int     tfileSerialTableIdsToBuf(char* buf, SArray* tableIds, bool bitmap);
 
 static int tfileWriteHeader(TFileWriter* writer);
 static int tfileWriteFstOffset(TFileWriter* tw, int32_t offset);
@@ -564,7 +566,8 @@ int tfileWriterPut(TFileWriter* tw, void* data, bool order) {
     taosArrayRemoveDuplicate(v->tableId, idxUidCompare, NULL);
     int32_t tbsz = taosArrayGetSize(v->tableId);
     if (tbsz == 0) continue;
-    fstOffset += TF_TABLE_TATOAL_SIZE(tbsz);
+    bool bitmap = false;
+    fstOffset += tfileTableIdsSerialSize(v->tableId, &bitmap);
   }
   tfileWriteFstOffset(tw, fstOffset);
 
@@ -577,7 +580,8 @@ int tfileWriterPut(TFileWriter* tw, void* data, bool order) {
     int32_t tbsz = taosArrayGetSize(v->tableId);
     if (tbsz == 0) continue;
     // check buf has enough space or not
-    int32_t ttsz = TF_TABLE_TATOAL_SIZE(tbsz);
+    bool    bitmap = false;
+    int32_t ttsz = tfileTableIdsSerialSize(v->tableId, &bitmap);
 
     if (cap < ttsz) {
       cap = ttsz;
@@ -590,7 +594,10 @@ int tfileWriterPut(TFileWriter* tw, void* data, bool order) {
     }
 
     char* p = buf;
-    tfileSerialTableIdsToBuf(p, v->tableId);
+    if (tfileSerialTableIdsToBuf(p, v->tableId, bitmap) != 0) {
+      taosMemoryFree(buf);
+      return -1;
+    }
     tw->ctx->write(tw->ctx, buf, ttsz);
     v->offset = tw->offset;
     tw->offset += ttsz;
@@ -823,13 +830,38 @@ void tfileValueDestroy(TFileValue* tf) {
   taosMemoryFree(tf->colVal);
   taosMemoryFree(tf);
 }
-static void tfileSerialTableIdsToBuf(char* buf, SArray* ids) {
+// table ids of a value are kept as a compressed bitmap when it is smaller than the plain array:
+// |<--- -bitmapSize --->|<--- bitmap --->|  or  |<--- numOfIds --->|<--- id --->| ... |
+// the sign of the leading int32_t tells them apart, so index files written before stay readable
+static int32_t tfileTableIdsSerialSize(SArray* ids, bool* bitmap) {
+  int32_t sz = taosArrayGetSize(ids);
+  int32_t arraySize = TF_TABLE_TATOAL_SIZE(sz);
+  int32_t bitmapSize = sizeof(int32_t) + idxBitmapSerialSizeOfArray(ids);
+
+  *bitmap = bitmapSize < arraySize;
+  return *bitmap ? bitmapSize : arraySize;
+}
+static int tfileSerialTableIdsToBuf(char* buf, SArray* ids, bool bitmap) {
+  if (bitmap) {
+    SIdxBitmap* bm = idxBitmapCreate();
+    if (bm == NULL || idxBitmapAddArray(bm, ids) != 0) {
+      idxBitmapDestroy(bm);
+      return -1;
+    }
+    int32_t len = idxBitmapSerialSize(bm);
+    SERIALIZE_VAR_TO_BUF(buf, -len, int32_t);
+    idxBitmapSerial(bm, buf);
+    idxBitmapDestroy(bm);
+    return 0;
+  }
+
   int sz = taosArrayGetSize(ids);
   SERIALIZE_VAR_TO_BUF(buf, sz, int32_t);
   for (size_t i = 0; i < sz; i++) {
     uint64_t* v = taosArrayGet(ids, i);
     SERIALIZE_VAR_TO_BUF(buf, *v, uint64_t);
   }
+  return 0;
 }
 
 static int tfileWriteFstOffset(TFileWriter* tw, int32_t offset) {
@@ -926,6 +958,33 @@ static int tfileReaderLoadFst(TFileReader* reader) {
 
   return reader->fst != NULL ? 0 : -1;
 }
+static int tfileReaderLoadTableIdsBitmap(TFileReader* reader, int32_t offset, int32_t len, char* data, int32_t nread,
+                                         SArray* result) {
+  char* buf = data;
+  if (len > nread) {
+    // the bitmap spans beyond the block already read
+    if ((buf = taosMemoryMalloc(len)) == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    memcpy(buf, data, nread);
+    if (reader->ctx->readFrom(reader->ctx, buf + nread, len - nread, offset + nread) != len - nread) {
+      indexError("failed to read table ids bitmap, offset: %d, len: %d, filename: %s", offset, len,
+                 reader->ctx->file.buf);
+      taosMemoryFree(buf);
+      return TSDB_CODE_INVALID_DATA_FMT;
+    }
+  }
+
+  SIdxBitmap* bm = idxBitmapDeserial(buf, len);
+  int32_t     code = bm ? idxBitmapToArray(bm, result) : terrno;
+  if (bm == NULL) {
+    indexError("failed to decode table ids bitmap, offset: %d, len: %d, filename: %s", offset, len,
+               reader->ctx->file.buf);
+  }
+  idxBitmapDestroy(bm);
+  if (buf != data) taosMemoryFree(buf);
+  return code;
+}
 static int tfileReaderLoadTableIds(TFileReader* reader, int32_t offset, SArray* result) {
   // TODO(yihao): opt later
   IFileCtx* ctx = reader->ctx;
@@ -938,6 +997,10 @@ static int tfileReaderLoadTableIds(TFileReader* reader, int32_t offset, SArray*
   int32_t nid = *(int32_t*)p;
   p += sizeof(nid);
 
+  if (nid < 0) {
+    return tfileReaderLoadTableIdsBitmap(reader, offset + sizeof(nid), -nid, p, nread - sizeof(nid), result);
+  }
+
   while (nid > 0) {
     int32_t left = block + sizeof(block) - p;
     if (left >= sizeof(uint64_t)) {
@@ -14,8 +14,12 @@
  */
 #include "indexUtil.h"
 #include "index.h"
+#include "indexBitmap.h"
 #include "tcompare.h"
 
+// inputs with more uids than this in total are merged through compressed bitmaps
+#define INDEX_BITMAP_MERGE_THRESHOLD 1024
+
 typedef struct MergeIndex {
   int idx;
   int len;
@@ -36,11 +40,60 @@ static FORCE_INLINE int iBinarySearch(SArray *arr, int s, int e, uint64_t k) {
   return s;
 }
 
+static int64_t iTotalSize(SArray *in) {
+  int64_t total = 0;
+  for (int32_t i = 0; i < taosArrayGetSize(in); i++) {
+    total += taosArrayGetSize(taosArrayGetP(in, i));
+  }
+  return total;
+}
+
+static SIdxBitmap *iBitmapFromArray(SArray *uids) {
+  SIdxBitmap *bm = idxBitmapCreate();
+  if (bm != NULL && idxBitmapAddArray(bm, uids) != 0) {
+    idxBitmapDestroy(bm);
+    bm = NULL;
+  }
+  return bm;
+}
+
+// fold all arrays of in with the bitmap operation, the result is appended to out
+static int32_t iBitmapMerge(SArray *in, SArray *out, SIdxBitmap *(*fn)(const SIdxBitmap *, const SIdxBitmap *)) {
+  SIdxBitmap *res = NULL;
+  for (int32_t i = 0; i < taosArrayGetSize(in); i++) {
+    SIdxBitmap *bm = iBitmapFromArray(taosArrayGetP(in, i));
+    if (bm == NULL) {
+      idxBitmapDestroy(res);
+      return -1;
+    }
+    if (res == NULL) {
+      res = bm;
+      continue;
+    }
+
+    SIdxBitmap *t = fn(res, bm);
+    idxBitmapDestroy(res);
+    idxBitmapDestroy(bm);
+    if (t == NULL) return -1;
+    res = t;
+  }
+
+  int32_t code = res ? idxBitmapToArray(res, out) : 0;
+  idxBitmapDestroy(res);
+  return code;
+}
+
 void iIntersection(SArray *in, SArray *out) {
   int32_t sz = (int32_t)taosArrayGetSize(in);
   if (sz <= 0) {
     return;
   }
+  if (iTotalSize(in) > INDEX_BITMAP_MERGE_THRESHOLD) {
+    int32_t n = (int32_t)taosArrayGetSize(out);
+    if (iBitmapMerge(in, out, idxBitmapAnd) == 0) return;
+    taosArrayPopTailBatch(out, taosArrayGetSize(out) - n);
+  }
+
   MergeIndex *mi = taosMemoryCalloc(sz, sizeof(MergeIndex));
   for (int i = 0; i < sz; i++) {
     SArray *t = taosArrayGetP(in, i);
@@ -78,6 +131,11 @@ void iUnion(SArray *in, SArray *out) {
     taosArrayAddAll(out, taosArrayGetP(in, 0));
     return;
   }
+  if (iTotalSize(in) > INDEX_BITMAP_MERGE_THRESHOLD) {
+    int32_t n = (int32_t)taosArrayGetSize(out);
+    if (iBitmapMerge(in, out, idxBitmapOr) == 0) return;
+    taosArrayPopTailBatch(out, taosArrayGetSize(out) - n);
+  }
 
   MergeIndex *mi = taosMemoryCalloc(sz, sizeof(MergeIndex));
   for (int i = 0; i < sz; i++) {
@@ -123,6 +181,22 @@ void iExcept(SArray *total, SArray *except) {
     return;
   }
 
+  if (tsz + esz > INDEX_BITMAP_MERGE_THRESHOLD) {
+    SIdxBitmap *tbm = iBitmapFromArray(total);
+    SIdxBitmap *ebm = iBitmapFromArray(except);
+    SIdxBitmap *res = (tbm && ebm) ? idxBitmapAndNot(tbm, ebm) : NULL;
+    idxBitmapDestroy(tbm);
+    idxBitmapDestroy(ebm);
+    if (res != NULL) {
+      // the difference is never larger than total, so it is written back without growing the array
+      taosArrayClear(total);
+      idxBitmapToArray(res, total);
+      idxBitmapDestroy(res);
+      return;
+    }
+    idxBitmapDestroy(res);
+  }
+
   int vIdx = 0;
   for (int i = 0; i < tsz; i++) {
     uint64_t val = *(uint64_t *)taosArrayGet(total, i);
@@ -5,6 +5,7 @@
 #include <thread>
 #include <vector>
 #include "index.h"
+#include "indexBitmap.h"
 #include "indexCache.h"
 #include "indexComm.h"
 #include "indexFst.h"
@@ -365,3 +366,74 @@ TEST_F(UtilEnv, testDictComm) {
     EXPECT_EQ(COMMON_INPUTS[v], i);
   }
 }
+
+TEST_F(UtilEnv, bitmapMerge) {
+  clearSourceArray(src);
+  clearFinalArray(rslt);
+
+  // uids of consecutive serial numbers share the high bits and end up in dense containers
+  uint64_t base = (uint64_t)0x1234 << 48;
+  SArray  *f = (SArray *)taosArrayGetP(src, 0);
+  for (uint64_t i = 0; i < 10000; i++) {
+    uint64_t val = base + i;
+    taosArrayPush(f, &val);
+  }
+  f = (SArray *)taosArrayGetP(src, 1);
+  for (uint64_t i = 5000; i < 80000; i += 2) {
+    uint64_t val = base + i;
+    taosArrayPush(f, &val);
+  }
+  f = (SArray *)taosArrayGetP(src, 2);
+  for (uint64_t i = 0; i < 9000; i += 3) {
+    uint64_t val = base + i;
+    taosArrayPush(f, &val);
+  }
+
+  iIntersection(src, rslt);
+  // even and multiple of 3 in [5000, 9000)
+  EXPECT_EQ(taosArrayGetSize(rslt), 666);
+  for (int i = 1; i < taosArrayGetSize(rslt); i++) {
+    EXPECT_LT(*(uint64_t *)taosArrayGet(rslt, i - 1), *(uint64_t *)taosArrayGet(rslt, i));
+  }
+
+  clearFinalArray(rslt);
+  iUnion(src, rslt);
+  EXPECT_EQ(taosArrayGetSize(rslt), 10000 + 35000);
+  for (int i = 1; i < taosArrayGetSize(rslt); i++) {
+    EXPECT_LT(*(uint64_t *)taosArrayGet(rslt, i - 1), *(uint64_t *)taosArrayGet(rslt, i));
+  }
+
+  iExcept(rslt, (SArray *)taosArrayGetP(src, 1));
+  EXPECT_EQ(taosArrayGetSize(rslt), 5000 + 2500);
+}
+
+TEST_F(UtilEnv, bitmapSerial) {
+  SIdxBitmap *bm = idxBitmapCreate();
+  for (uint64_t i = 0; i < 100000; i += 7) {
+    idxBitmapAdd(bm, i * 3);
+  }
+  idxBitmapAdd(bm, UINT64_MAX);
+  idxBitmapAdd(bm, 21);
+  EXPECT_EQ(idxBitmapCardinality(bm), 14286 + 1);
+
+  int32_t len = idxBitmapSerialSize(bm);
+  char   *buf = (char *)taosMemoryMalloc(len);
+  EXPECT_EQ(idxBitmapSerial(bm, buf), len);
+
+  SIdxBitmap *dbm = idxBitmapDeserial(buf, len);
+  ASSERT_TRUE(dbm != NULL);
+  EXPECT_EQ(idxBitmapCardinality(dbm), idxBitmapCardinality(bm));
+  EXPECT_TRUE(idxBitmapContains(dbm, UINT64_MAX));
+  EXPECT_TRUE(idxBitmapContains(dbm, 21));
+  EXPECT_FALSE(idxBitmapContains(dbm, 22));
+  EXPECT_TRUE(idxBitmapDeserial(buf, len - 1) == NULL);
+
+  SArray *uids = taosArrayInit(8, sizeof(uint64_t));
+  idxBitmapToArray(dbm, uids);
+  EXPECT_EQ(idxBitmapSerialSizeOfArray(uids), len);
+
+  taosArrayDestroy(uids);
+  idxBitmapDestroy(dbm);
+  idxBitmapDestroy(bm);
+  taosMemoryFree(buf);
+}
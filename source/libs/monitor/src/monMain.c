@@ -488,6 +488,58 @@ static void monGenDiskJson(SMonInfo *pMonitor) {
   tjsonAddDoubleToObject(pTempdirJson, "total", pTempDesc->size.total);
 }
 
+static void monGenWorkerJson(SMonInfo *pMonitor) {
+  SMonWorkerInfo *pInfo = &pMonitor->vmInfo.worker;
+  if (pInfo->workers == NULL) return;
+
+  SJson *pJson = tjsonAddArrayToObject(pMonitor->pJson, "worker_infos");
+  if (pJson == NULL) return;
+
+  double interval = (pMonitor->curTime - pMonitor->lastTime) * 1000.0;
+  if (interval <= 0) interval = 1;
+
+  for (int32_t i = 0; i < taosArrayGetSize(pInfo->workers); ++i) {
+    SJson *pWorkerJson = tjsonCreateObject();
+    if (pWorkerJson == NULL) continue;
+
+    SMonWorkerDesc *pDesc = taosArrayGet(pInfo->workers, i);
+    tjsonAddStringToObject(pWorkerJson, "pool", pDesc->pool);
+    tjsonAddDoubleToObject(pWorkerJson, "id", pDesc->id);
+    tjsonAddDoubleToObject(pWorkerJson, "queues", pDesc->queues);
+    tjsonAddDoubleToObject(pWorkerJson, "processed", pDesc->processed);
+    tjsonAddDoubleToObject(pWorkerJson, "stolen", pDesc->stolen);
+    tjsonAddDoubleToObject(pWorkerJson, "utilization", TMIN(pDesc->busy / interval, 1.0));
+
+    if (tjsonAddItemToArray(pJson, pWorkerJson) != 0) tjsonDelete(pWorkerJson);
+  }
+}
+
+static void monGenBufPoolJson(SMonInfo *pMonitor) {
+  SMonBufPoolInfo *pInfo = &pMonitor->vmInfo.bufPool;
+  if (pInfo->pools == NULL) return;
+
+  SJson *pJson = tjsonAddArrayToObject(pMonitor->pJson, "buffer_pool_infos");
+  if (pJson == NULL) return;
+
+  for (int32_t i = 0; i < taosArrayGetSize(pInfo->pools); ++i) {
+    SJson *pPoolJson = tjsonCreateObject();
+    if (pPoolJson == NULL) continue;
+
+    SMonBufPoolDesc *pDesc = taosArrayGet(pInfo->pools, i);
+    tjsonAddDoubleToObject(pPoolJson, "vgroup_id", pDesc->vgId);
+    tjsonAddDoubleToObject(pPoolJson, "id", pDesc->id);
+    tjsonAddDoubleToObject(pPoolJson, "numa_node", pDesc->numaNode);
+    tjsonAddDoubleToObject(pPoolJson, "huge_page", pDesc->hugePage);
+    tjsonAddDoubleToObject(pPoolJson, "capacity", pDesc->capacity);
+    tjsonAddDoubleToObject(pPoolJson, "used", pDesc->used);
+    tjsonAddDoubleToObject(pPoolJson, "allocs", pDesc->allocs);
+    tjsonAddDoubleToObject(pPoolJson, "overflows", pDesc->overflows);
+    tjsonAddDoubleToObject(pPoolJson, "overflow_size", pDesc->overflowSize);
+
+    if (tjsonAddItemToArray(pJson, pPoolJson) != 0) tjsonDelete(pPoolJson);
+  }
+}
+
 static const char *monLogLevelStr(ELogLevel level) {
   if (level == DEBUG_ERROR) {
     return "error";
@@ -579,6 +631,8 @@ void monGenAndSendReport() {
     monGenGrantJson(pMonitor);
     monGenDnodeJson(pMonitor);
     monGenDiskJson(pMonitor);
+    monGenWorkerJson(pMonitor);
+    monGenBufPoolJson(pMonitor);
     monGenLogJson(pMonitor);
 
     monSendReport(pMonitor);
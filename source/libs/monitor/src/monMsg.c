@@ -34,8 +34,12 @@ void tFreeSMonMmInfo(SMonMmInfo *pInfo) {
 void tFreeSMonVmInfo(SMonVmInfo *pInfo) {
   taosArrayDestroy(pInfo->log.logs);
   taosArrayDestroy(pInfo->tfs.datadirs);
+  taosArrayDestroy(pInfo->worker.workers);
+  taosArrayDestroy(pInfo->bufPool.pools);
   pInfo->log.logs = NULL;
   pInfo->tfs.datadirs = NULL;
+  pInfo->worker.workers = NULL;
+  pInfo->bufPool.pools = NULL;
 }
 
 void tFreeSMonQmInfo(SMonQmInfo *pInfo) {
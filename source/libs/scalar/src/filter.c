@@ -4638,6 +4638,47 @@ int32_t filterSetDataFromColId(SFilterInfo *info, void *param) {
   return fltSetColFieldDataImpl(info, param, fltGetDataFromColId, true);
 }
 
+static void fltAddColSlotId(SArray *pSlotIds, int16_t slotId) {
+  for (int32_t i = 0; i < taosArrayGetSize(pSlotIds); ++i) {
+    if (*(int16_t *)taosArrayGet(pSlotIds, i) == slotId) {
+      return;
+    }
+  }
+
+  taosArrayPush(pSlotIds, &slotId);
+}
+
+static EDealRes fltCollectColSlotId(SNode *pNode, void *pContext) {
+  if (QUERY_NODE_COLUMN == nodeType(pNode)) {
+    fltAddColSlotId((SArray *)pContext, ((SColumnNode *)pNode)->slotId);
+  }
+
+  return DEAL_RES_CONTINUE;
+}
+
+// collect the distinct slot ids of all the columns that the filter refers to
+int32_t filterGetColSlotIds(SFilterInfo *info, SArray *pSlotIds) {
+  if (NULL == info || NULL == pSlotIds) {
+    return TSDB_CODE_QRY_INVALID_INPUT;
+  }
+
+  if (info->scalarMode) {
+    nodesWalkExpr(info->sclCtx.node, fltCollectColSlotId, pSlotIds);
+    return TSDB_CODE_SUCCESS;
+  }
+
+  if (FILTER_ALL_RES(info) || FILTER_EMPTY_RES(info)) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  for (uint32_t i = 0; i < info->fields[FLD_TYPE_COLUMN].num; ++i) {
+    SFilterField *fi = &info->fields[FLD_TYPE_COLUMN].fields[i];
+    fltAddColSlotId(pSlotIds, FILTER_GET_COL_FIELD_SLOT_ID(fi));
+  }
+
+  return TSDB_CODE_SUCCESS;
+}
+
 int32_t filterInitFromNode(SNode *pNode, SFilterInfo **pInfo, uint32_t options) {
   SFilterInfo *info = NULL;
   if (pNode == NULL) {
@@ -4758,6 +4799,45 @@ int32_t filterExecute(SFilterInfo *info, SSDataBlock *pSrc, SColumnInfoData **p,
   return TSDB_CODE_SUCCESS;
 }
 
+int32_t filterExecuteSel(SFilterInfo *info, SSDataBlock *pSrc, int32_t **pSel, int32_t *pNumOfSel,
+                         SColumnDataAgg *statis, int16_t numOfCols, int32_t *pResultStatus) {
+  SColumnInfoData *p = NULL;
+
+  *pSel = NULL;
+  *pNumOfSel = 0;
+
+  int32_t code = filterExecute(info, pSrc, &p, statis, numOfCols, pResultStatus);
+  if (code != TSDB_CODE_SUCCESS) {
+    goto _return;
+  }
+
+  if (*pResultStatus == FILTER_RESULT_ALL_QUALIFIED) {
+    *pNumOfSel = pSrc->info.rows;
+  } else if (*pResultStatus == FILTER_RESULT_PARTIAL_QUALIFIED) {
+    int32_t *sel = taosMemoryMalloc(sizeof(int32_t) * pSrc->info.rows);
+    if (sel == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _return;
+    }
+
+    // branch free: every row index is written, but the cursor only advances for the qualified ones
+    int8_t *pRes = (int8_t *)p->pData;
+    int32_t num = 0;
+    for (int32_t i = 0; i < pSrc->info.rows; ++i) {
+      sel[num] = i;
+      num += (pRes[i] != 0);
+    }
+
+    *pSel = sel;
+    *pNumOfSel = num;
+  }
+
+_return:
+  colDataDestroy(p);
+  taosMemoryFree(p);
+  return code;
+}
+
 typedef struct SClassifyConditionCxt {
   bool hasPrimaryKey;
   bool hasTagIndexCol;
@@ -1145,6 +1145,243 @@ static void doReleaseVec(SColumnInfoData *pCol, int32_t type) {
   }
 }
 
+// Typed arithmetic kernels, used when both operands are fixed-width numerics and each side is either a whole column
+// or a constant. Every value is widened to double exactly as getVectorDoubleValue_xxx does, so the results are the
+// same as the row-by-row loops below, but the loops are plain typed loops the compiler can vectorize.
+#define SCL_MATH_TO_DOUBLE(_t)                        \
+  do {                                                \
+    const _t *p = (const _t *)pData;                  \
+    for (int32_t i = 0; i < numOfRows; ++i) {         \
+      out[i] = (double)p[i];                          \
+    }                                                 \
+  } while (0)
+
+#define SCL_MATH_APPLY_LOOP(_t, _op)                  \
+  do {                                                \
+    const _t *p = (const _t *)pData;                  \
+    for (int32_t i = 0; i < numOfRows; ++i) {         \
+      out[i] = src[i] _op (double)p[i];               \
+    }                                                 \
+  } while (0)
+
+#define SCL_MATH_APPLY(_t)                            \
+  do {                                                \
+    switch (optr) {                                   \
+      case OP_TYPE_ADD:                               \
+        SCL_MATH_APPLY_LOOP(_t, +);                   \
+        break;                                        \
+      case OP_TYPE_SUB:                               \
+        SCL_MATH_APPLY_LOOP(_t, -);                   \
+        break;                                        \
+      case OP_TYPE_MULTI:                             \
+        SCL_MATH_APPLY_LOOP(_t, *);                   \
+        break;                                        \
+      default:                                        \
+        SCL_MATH_APPLY_LOOP(_t, /);                   \
+        break;                                        \
+    }                                                 \
+  } while (0)
+
+#define SCL_MATH_ZERO_NULL(_t)                                     \
+  do {                                                             \
+    const _t *p = (const _t *)pData;                               \
+    for (int32_t i = 0; i < numOfRows; i += 8) {                   \
+      uint8_t bits = 0;                                            \
+      for (int32_t j = 0; j < 8 && i + j < numOfRows; ++j) {       \
+        bits |= (uint8_t)((p[i + j] == 0) << (7u - j));            \
+      }                                                            \
+      if (bits != 0) {                                             \
+        pOutputCol->nullbitmap[i >> NBIT] |= bits;                 \
+        pOutputCol->hasNull = true;                                \
+      }                                                            \
+    }                                                              \
+  } while (0)
+
+#define SCL_MATH_DISPATCH(_macro)       \
+  do {                                  \
+    switch (type) {                     \
+      case TSDB_DATA_TYPE_BOOL:         \
+        _macro(bool);                   \
+        break;                          \
+      case TSDB_DATA_TYPE_TINYINT:      \
+        _macro(int8_t);                 \
+        break;                          \
+      case TSDB_DATA_TYPE_UTINYINT:     \
+        _macro(uint8_t);                \
+        break;                          \
+      case TSDB_DATA_TYPE_SMALLINT:     \
+        _macro(int16_t);                \
+        break;                          \
+      case TSDB_DATA_TYPE_USMALLINT:    \
+        _macro(uint16_t);               \
+        break;                          \
+      case TSDB_DATA_TYPE_INT:          \
+        _macro(int32_t);                \
+        break;                          \
+      case TSDB_DATA_TYPE_UINT:         \
+        _macro(uint32_t);               \
+        break;                          \
+      case TSDB_DATA_TYPE_BIGINT:       \
+      case TSDB_DATA_TYPE_TIMESTAMP:    \
+        _macro(int64_t);                \
+        break;                          \
+      case TSDB_DATA_TYPE_UBIGINT:      \
+        _macro(uint64_t);               \
+        break;                          \
+      case TSDB_DATA_TYPE_FLOAT:        \
+        _macro(float);                  \
+        break;                          \
+      default:                          \
+        _macro(double);                 \
+        break;                          \
+    }                                   \
+  } while (0)
+
+static void vectorMathFixedToDouble(int32_t type, const void *pData, int32_t numOfRows, double *out) {
+  SCL_MATH_DISPATCH(SCL_MATH_TO_DOUBLE);
+}
+
+// out[i] = src[i] optr (double)pData[i]
+static void vectorMathFixedApply(int32_t optr, const double *src, int32_t type, const void *pData, int32_t numOfRows,
+                                 double *out) {
+  SCL_MATH_DISPATCH(SCL_MATH_APPLY);
+}
+
+// out[i] = src[i] optr v, or v optr src[i] if the constant is the left operand
+static void vectorMathFixedApplyConst(int32_t optr, const double *src, double v, bool constLeft, int32_t numOfRows,
+                                      double *out) {
+  switch (optr) {
+    case OP_TYPE_ADD:
+      for (int32_t i = 0; i < numOfRows; ++i) {
+        out[i] = src[i] + v;
+      }
+      break;
+    case OP_TYPE_SUB:
+      if (constLeft) {  // same sign of zero as vectorMathSubHelper, which computes (src - v) * -1
+        for (int32_t i = 0; i < numOfRows; ++i) {
+          out[i] = -(src[i] - v);
+        }
+      } else {
+        for (int32_t i = 0; i < numOfRows; ++i) {
+          out[i] = src[i] - v;
+        }
+      }
+      break;
+    case OP_TYPE_MULTI:
+      for (int32_t i = 0; i < numOfRows; ++i) {
+        out[i] = src[i] * v;
+      }
+      break;
+    default:
+      if (constLeft) {
+        for (int32_t i = 0; i < numOfRows; ++i) {
+          out[i] = v / src[i];
+        }
+      } else {
+        for (int32_t i = 0; i < numOfRows; ++i) {
+          out[i] = src[i] / v;
+        }
+      }
+      break;
+  }
+}
+
+// Set the rows of a zero divisor to null, as the row-by-row divide does.
+static void vectorMathFixedSetZeroNull(int32_t type, const void *pData, int32_t numOfRows,
+                                       SColumnInfoData *pOutputCol) {
+  SCL_MATH_DISPATCH(SCL_MATH_ZERO_NULL);
+}
+
+// OR the null bitmap of an operand column into the output, a 64-bit word at a time.
+static void vectorMathFixedMergeNull(SColumnInfoData *pOutputCol, const SColumnInfoData *pCol, int32_t numOfRows) {
+  if (!pCol->hasNull) {
+    return;
+  }
+
+  int32_t len = BitmapLen(numOfRows);
+  int32_t i = 0;
+  for (; i + (int32_t)sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+    uint64_t src = 0, dst = 0;
+    memcpy(&src, pCol->nullbitmap + i, sizeof(uint64_t));
+    memcpy(&dst, pOutputCol->nullbitmap + i, sizeof(uint64_t));
+    dst |= src;
+    memcpy(pOutputCol->nullbitmap + i, &dst, sizeof(uint64_t));
+  }
+
+  for (; i < len; ++i) {
+    pOutputCol->nullbitmap[i] |= pCol->nullbitmap[i];
+  }
+
+  // do not leak the bits of the rows beyond numOfRows
+  if ((numOfRows & 0x07) != 0) {
+    pOutputCol->nullbitmap[len - 1] &= (uint8_t)(0xFFu << (8u - (numOfRows & 0x07)));
+  }
+
+  pOutputCol->hasNull = true;
+}
+
+static bool vectorMathFixedType(int32_t type) {
+  return (IS_NUMERIC_TYPE(type) || type == TSDB_DATA_TYPE_TIMESTAMP || type == TSDB_DATA_TYPE_BOOL);
+}
+
+// Compute pLeftCol optr pRightCol into the double output column with the typed kernels. Return false if the operands
+// are not supported, in which case nothing has been written.
+static bool vectorMathFixed(SColumnInfoData *pLeftCol, SColumnInfoData *pRightCol, int32_t leftRows, int32_t rightRows,
+                            int32_t step, int32_t optr, SColumnInfoData *pOutputCol) {
+  int32_t numOfRows = TMAX(leftRows, rightRows);
+  int32_t lType = pLeftCol->info.type;
+  int32_t rType = pRightCol->info.type;
+
+  if (step != 1 || pOutputCol->info.type != TSDB_DATA_TYPE_DOUBLE || !vectorMathFixedType(lType) ||
+      !vectorMathFixedType(rType) || (leftRows != numOfRows && leftRows != 1) ||
+      (rightRows != numOfRows && rightRows != 1)) {
+    return false;
+  }
+
+  double *out = (double *)pOutputCol->pData;
+
+  if (rightRows == numOfRows && (leftRows == numOfRows || numOfRows == 1)) {  // column optr column
+    const double *src = (const double *)pLeftCol->pData;
+    if (lType != TSDB_DATA_TYPE_DOUBLE) {
+      vectorMathFixedToDouble(lType, pLeftCol->pData, numOfRows, out);
+      src = out;
+    }
+
+    vectorMathFixedApply(optr, src, rType, pRightCol->pData, numOfRows, out);
+    vectorMathFixedMergeNull(pOutputCol, pLeftCol, numOfRows);
+    vectorMathFixedMergeNull(pOutputCol, pRightCol, numOfRows);
+    if (optr == OP_TYPE_DIV) {
+      vectorMathFixedSetZeroNull(rType, pRightCol->pData, numOfRows, pOutputCol);
+    }
+    return true;
+  }
+
+  bool             constLeft = (leftRows == 1);
+  SColumnInfoData *pCol = constLeft ? pRightCol : pLeftCol;
+  SColumnInfoData *pConst = constLeft ? pLeftCol : pRightCol;
+
+  double v = 0;
+  vectorMathFixedToDouble(pConst->info.type, pConst->pData, 1, &v);
+  if (colDataIsNull_s(pConst, 0) || (optr == OP_TYPE_DIV && !constLeft && v == 0)) {
+    colDataSetNNULL(pOutputCol, 0, numOfRows);
+    return true;
+  }
+
+  const double *src = (const double *)pCol->pData;
+  if (pCol->info.type != TSDB_DATA_TYPE_DOUBLE) {
+    vectorMathFixedToDouble(pCol->info.type, pCol->pData, numOfRows, out);
+    src = out;
+  }
+
+  vectorMathFixedApplyConst(optr, src, v, constLeft, numOfRows, out);
+  vectorMathFixedMergeNull(pOutputCol, pCol, numOfRows);
+  if (optr == OP_TYPE_DIV && constLeft) {
+    vectorMathFixedSetZeroNull(pCol->info.type, pCol->pData, numOfRows, pOutputCol);
+  }
+
+  return true;
+}
+
 void vectorMathAdd(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut, int32_t _ord) {
   SColumnInfoData *pOutputCol = pOut->columnData;
 
@@ -1190,7 +1427,9 @@ void vectorMathAdd(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut
     _getDoubleValue_fn_t getVectorDoubleValueFnLeft = getVectorDoubleValueFn(pLeftCol->info.type);
     _getDoubleValue_fn_t getVectorDoubleValueFnRight = getVectorDoubleValueFn(pRightCol->info.type);
 
-    if (pLeft->numOfRows == pRight->numOfRows) {
+    if (vectorMathFixed(pLeftCol, pRightCol, pLeft->numOfRows, pRight->numOfRows, step, OP_TYPE_ADD, pOutputCol)) {
+      // done by the typed kernels
+    } else if (pLeft->numOfRows == pRight->numOfRows) {
       for (; i < pRight->numOfRows && i >= 0; i += step, output += 1) {
         if (IS_NULL) {
           colDataSetNULL(pOutputCol, i);
@@ -1291,7 +1530,9 @@ void vectorMathSub(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut
     _getDoubleValue_fn_t getVectorDoubleValueFnLeft = getVectorDoubleValueFn(pLeftCol->info.type);
     _getDoubleValue_fn_t getVectorDoubleValueFnRight = getVectorDoubleValueFn(pRightCol->info.type);
 
-    if (pLeft->numOfRows == pRight->numOfRows) {
+    if (vectorMathFixed(pLeftCol, pRightCol, pLeft->numOfRows, pRight->numOfRows, step, OP_TYPE_SUB, pOutputCol)) {
+      // done by the typed kernels
+    } else if (pLeft->numOfRows == pRight->numOfRows) {
       for (; i < pRight->numOfRows && i >= 0; i += step, output += 1) {
         if (IS_NULL) {
           colDataSetNULL(pOutputCol, i);
@@ -1346,7 +1587,9 @@ void vectorMathMultiply(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam
   _getDoubleValue_fn_t getVectorDoubleValueFnRight = getVectorDoubleValueFn(pRightCol->info.type);
 
   double *output = (double *)pOutputCol->pData;
-  if (pLeft->numOfRows == pRight->numOfRows) {
+  if (vectorMathFixed(pLeftCol, pRightCol, pLeft->numOfRows, pRight->numOfRows, step, OP_TYPE_MULTI, pOutputCol)) {
+    // done by the typed kernels
+  } else if (pLeft->numOfRows == pRight->numOfRows) {
     for (; i < pRight->numOfRows && i >= 0; i += step, output += 1) {
       if (IS_NULL) {
         colDataSetNULL(pOutputCol, i);
@@ -1379,7 +1622,9 @@ void vectorMathDivide(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *p
   _getDoubleValue_fn_t getVectorDoubleValueFnRight = getVectorDoubleValueFn(pRightCol->info.type);
 
   double *output = (double *)pOutputCol->pData;
-  if (pLeft->numOfRows == pRight->numOfRows) {
+  if (vectorMathFixed(pLeftCol, pRightCol, pLeft->numOfRows, pRight->numOfRows, step, OP_TYPE_DIV, pOutputCol)) {
+    // done by the typed kernels
+  } else if (pLeft->numOfRows == pRight->numOfRows) {
     for (; i < pRight->numOfRows && i >= 0; i += step, output += 1) {
       if (IS_NULL || (getVectorDoubleValueFnRight(RIGHT_COL, i) == 0)) {  // divide by 0 check
         colDataSetNULL(pOutputCol, i);
@@ -1646,12 +1891,578 @@ void vectorBitOr(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut,
   doReleaseVec(pRightCol, rightConvert);
 }
 
+// Typed compare kernels. When both operands of a comparison are fixed-width numerics and each side is either a
+// whole column or a constant, the result is computed by a tight loop per type/operator (or by the AVX2/AVX512
+// variants below) instead of calling the __compar_fn_t for every row. The per-row semantics of the compare
+// functions in tcompare.c are kept exactly: integers compare by value, float/double of the same type use the
+// FLT_EQUAL tolerance and order NaN first, and float/double against an integer constant use a plain C comparison.
+#define SCL_CMP_FLT_TOL (FLT_COMPAR_TOL_FACTOR * FLT_EPSILON)
+
+#define SCL_FLT_COMPARE(_a, _b)                     \
+  (isnan(_a) ? (isnan(_b) ? 0 : -1)                 \
+             : (isnan(_b) ? 1 : (FLT_EQUAL(_a, _b) ? 0 : ((_a) > (_b) ? 1 : -1))))
+
+#define SCL_CMP_LOOP(_t, _expr)                        \
+  do {                                                 \
+    const _t *pl = (const _t *)pLeftData;              \
+    const _t *pr = (const _t *)pRightData;             \
+    if (rightConst) {                                  \
+      const _t b = pr[0];                              \
+      for (int32_t i = start; i < end; ++i) {          \
+        const _t a = pl[i];                            \
+        pRes[i] = (_expr);                             \
+      }                                                \
+    } else {                                           \
+      for (int32_t i = start; i < end; ++i) {          \
+        const _t a = pl[i];                            \
+        const _t b = pr[i];                            \
+        pRes[i] = (_expr);                             \
+      }                                                \
+    }                                                  \
+  } while (0)
+
+// "!(a < b)" rather than "a >= b" etc., so that a NaN compared with an integer constant yields the same result as
+// compareFloatInt64() and friends, which report 0 when neither a > b nor a < b holds.
+#define SCL_CMP_EXACT(_t)                                   \
+  do {                                                      \
+    switch (optr) {                                         \
+      case OP_TYPE_GREATER_THAN:                            \
+        SCL_CMP_LOOP(_t, a > b);                            \
+        break;                                              \
+      case OP_TYPE_GREATER_EQUAL:                           \
+        SCL_CMP_LOOP(_t, !(a < b));                         \
+        break;                                              \
+      case OP_TYPE_LOWER_THAN:                              \
+        SCL_CMP_LOOP(_t, a < b);                            \
+        break;                                              \
+      case OP_TYPE_LOWER_EQUAL:                             \
+        SCL_CMP_LOOP(_t, !(a > b));                         \
+        break;                                              \
+      case OP_TYPE_EQUAL:                                   \
+        SCL_CMP_LOOP(_t, !(a < b || a > b));                \
+        break;                                              \
+      default:                                              \
+        SCL_CMP_LOOP(_t, (a < b || a > b));                 \
+        break;                                              \
+    }                                                       \
+  } while (0)
+
+#define SCL_CMP_TOLERANT(_t)                                \
+  do {                                                      \
+    switch (optr) {                                         \
+      case OP_TYPE_GREATER_THAN:                            \
+        SCL_CMP_LOOP(_t, SCL_FLT_COMPARE(a, b) > 0);        \
+        break;                                              \
+      case OP_TYPE_GREATER_EQUAL:                           \
+        SCL_CMP_LOOP(_t, SCL_FLT_COMPARE(a, b) >= 0);       \
+        break;                                              \
+      case OP_TYPE_LOWER_THAN:                              \
+        SCL_CMP_LOOP(_t, SCL_FLT_COMPARE(a, b) < 0);        \
+        break;                                              \
+      case OP_TYPE_LOWER_EQUAL:                             \
+        SCL_CMP_LOOP(_t, SCL_FLT_COMPARE(a, b) <= 0);       \
+        break;                                              \
+      case OP_TYPE_EQUAL:                                   \
+        SCL_CMP_LOOP(_t, SCL_FLT_COMPARE(a, b) == 0);       \
+        break;                                              \
+      default:                                              \
+        SCL_CMP_LOOP(_t, SCL_FLT_COMPARE(a, b) != 0);       \
+        break;                                              \
+    }                                                       \
+  } while (0)
+
+// Combine the per-lane "greater than" and "equal" bits produced by the simd kernels into the result bits of optr.
+static FORCE_INLINE uint32_t vectorCompareMaskByOptr(int32_t optr, uint32_t gt, uint32_t eq, uint32_t lanes) {
+  switch (optr) {
+    case OP_TYPE_GREATER_THAN:
+      return gt & lanes;
+    case OP_TYPE_GREATER_EQUAL:
+      return (gt | eq) & lanes;
+    case OP_TYPE_LOWER_THAN:
+      return ~(gt | eq) & lanes;
+    case OP_TYPE_LOWER_EQUAL:
+      return ~gt & lanes;
+    case OP_TYPE_EQUAL:
+      return eq & lanes;
+    default:
+      return ~eq & lanes;
+  }
+}
+
+// Expand the low 8 bits of mask to 8 bool bytes, lane k to byte k, and store the first num of them.
+static FORCE_INLINE void vectorCompareStoreMask(bool *pRes, uint32_t mask, int32_t num) {
+  uint64_t v = ((uint64_t)(mask & 0xFFu) * 0x0101010101010101ULL) & 0x8040201008040201ULL;
+  v = ((v + 0x7F7F7F7F7F7F7F7FULL) >> 7) & 0x0101010101010101ULL;
+  memcpy(pRes, &v, num);
+}
+
+// Derive gt/eq bits for the FLT_EQUAL based comparison from the raw lane predicates, see compareDoubleVal().
+#define SCL_CMP_TOLERANT_MASK(_gt, _eq, _near, _nanL, _nanR)    \
+  do {                                                          \
+    uint32_t notNan = ~((_nanL) | (_nanR));                     \
+    (_eq) = ((_nanL) & (_nanR)) | (notNan & (_near));           \
+    (_gt) = (~(_nanL) & (_nanR)) | (notNan & ~(_near) & (_gt)); \
+  } while (0)
+
+static int32_t vectorCompareI32Avx2(const int32_t *pl, const int32_t *pr, bool rightConst, int32_t optr,
+                                    int32_t start, int32_t end, bool *pRes) {
+  int32_t i = start;
+#if __AVX2__
+  const __m256i c = _mm256_set1_epi32(pr[0]);
+  for (; i + 8 <= end; i += 8) {
+    __m256i  a = _mm256_loadu_si256((const __m256i *)(pl + i));
+    __m256i  b = rightConst ? c : _mm256_loadu_si256((const __m256i *)(pr + i));
+    uint32_t gt = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(a, b)));
+    uint32_t eq = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)));
+    vectorCompareStoreMask(pRes + i, vectorCompareMaskByOptr(optr, gt, eq, 0xFF), 8);
+  }
+#endif
+  return i;
+}
+
+static int32_t vectorCompareI64Avx2(const int64_t *pl, const int64_t *pr, bool rightConst, int32_t optr,
+                                    int32_t start, int32_t end, bool *pRes) {
+  int32_t i = start;
+#if __AVX2__
+  const __m256i c = _mm256_set1_epi64x(pr[0]);
+  for (; i + 8 <= end; i += 8) {
+    __m256i  a0 = _mm256_loadu_si256((const __m256i *)(pl + i));
+    __m256i  a1 = _mm256_loadu_si256((const __m256i *)(pl + i + 4));
+    __m256i  b0 = rightConst ? c : _mm256_loadu_si256((const __m256i *)(pr + i));
+    __m256i  b1 = rightConst ? c : _mm256_loadu_si256((const __m256i *)(pr + i + 4));
+    uint32_t gt = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(a0, b0))) |
+                  (_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(a1, b1))) << 4);
+    uint32_t eq = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a0, b0))) |
+                  (_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a1, b1))) << 4);
+    vectorCompareStoreMask(pRes + i, vectorCompareMaskByOptr(optr, gt, eq, 0xFF), 8);
+  }
+#endif
+  return i;
+}
+
+static int32_t vectorCompareFloatAvx2(const float *pl, const float *pr, bool rightConst, bool tolerant, int32_t optr,
+                                      int32_t start, int32_t end, bool *pRes) {
+  int32_t i = start;
+#if __AVX2__
+  const __m256 c = _mm256_set1_ps(pr[0]);
+  const __m256 tol = _mm256_set1_ps(SCL_CMP_FLT_TOL);
+  const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(INT32_MAX));
+  for (; i + 8 <= end; i += 8) {
+    __m256   a = _mm256_loadu_ps(pl + i);
+    __m256   b = rightConst ? c : _mm256_loadu_ps(pr + i);
+    uint32_t gt = _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GT_OQ));
+    uint32_t eq = 0;
+    if (tolerant) {
+      uint32_t nearby = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_and_ps(_mm256_sub_ps(a, b), absMask), tol, _CMP_LE_OQ));
+      uint32_t nanL = _mm256_movemask_ps(_mm256_cmp_ps(a, a, _CMP_UNORD_Q));
+      uint32_t nanR = _mm256_movemask_ps(_mm256_cmp_ps(b, b, _CMP_UNORD_Q));
+      SCL_CMP_TOLERANT_MASK(gt, eq, nearby, nanL, nanR);
+    } else {
+      eq = ~(gt | (uint32_t)_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LT_OQ)));
+    }
+    vectorCompareStoreMask(pRes + i, vectorCompareMaskByOptr(optr, gt, eq, 0xFF), 8);
+  }
+#endif
+  return i;
+}
+
+static int32_t vectorCompareDoubleAvx2(const double *pl, const double *pr, bool rightConst, bool tolerant,
+                                       int32_t optr, int32_t start, int32_t end, bool *pRes) {
+  int32_t i = start;
+#if __AVX2__
+  const __m256d c = _mm256_set1_pd(pr[0]);
+  const __m256d tol = _mm256_set1_pd(SCL_CMP_FLT_TOL);
+  const __m256d absMask = _mm256_castsi256_pd(_mm256_set1_epi64x(INT64_MAX));
+  for (; i + 4 <= end; i += 4) {
+    __m256d  a = _mm256_loadu_pd(pl + i);
+    __m256d  b = rightConst ? c : _mm256_loadu_pd(pr + i);
+    uint32_t gt = _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_GT_OQ));
+    uint32_t eq = 0;
+    if (tolerant) {
+      uint32_t nearby = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_and_pd(_mm256_sub_pd(a, b), absMask), tol, _CMP_LE_OQ));
+      uint32_t nanL = _mm256_movemask_pd(_mm256_cmp_pd(a, a, _CMP_UNORD_Q));
+      uint32_t nanR = _mm256_movemask_pd(_mm256_cmp_pd(b, b, _CMP_UNORD_Q));
+      SCL_CMP_TOLERANT_MASK(gt, eq, nearby, nanL, nanR);
+    } else {
+      eq = ~(gt | (uint32_t)_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LT_OQ)));
+    }
+    vectorCompareStoreMask(pRes + i, vectorCompareMaskByOptr(optr, gt, eq, 0x0F), 4);
+  }
+#endif
+  return i;
+}
+
+static int32_t vectorCompareI32Avx512(const int32_t *pl, const int32_t *pr, bool rightConst, int32_t optr,
+                                      int32_t start, int32_t end, bool *pRes) {
+  int32_t i = start;
+#if __AVX512F__
+  const __m512i c = _mm512_set1_epi32(pr[0]);
+  for (; i + 16 <= end; i += 16) {
+    __m512i  a = _mm512_loadu_si512((const void *)(pl + i));
+    __m512i  b = rightConst ? c : _mm512_loadu_si512((const void *)(pr + i));
+    uint32_t res = vectorCompareMaskByOptr(optr, _mm512_cmpgt_epi32_mask(a, b), _mm512_cmpeq_epi32_mask(a, b), 0xFFFF);
+    vectorCompareStoreMask(pRes + i, res, 8);
+    vectorCompareStoreMask(pRes + i + 8, res >> 8, 8);
+  }
+#endif
+  return i;
+}
+
+static int32_t vectorCompareI64Avx512(const int64_t *pl, const int64_t *pr, bool rightConst, int32_t optr,
+                                      int32_t start, int32_t end, bool *pRes) {
+  int32_t i = start;
+#if __AVX512F__
+  const __m512i c = _mm512_set1_epi64(pr[0]);
+  for (; i + 8 <= end; i += 8) {
+    __m512i a = _mm512_loadu_si512((const void *)(pl + i));
+    __m512i b = rightConst ? c : _mm512_loadu_si512((const void *)(pr + i));
+    vectorCompareStoreMask(
+        pRes + i, vectorCompareMaskByOptr(optr, _mm512_cmpgt_epi64_mask(a, b), _mm512_cmpeq_epi64_mask(a, b), 0xFF), 8);
+  }
+#endif
+  return i;
+}
+
+static int32_t vectorCompareFloatAvx512(const float *pl, const float *pr, bool rightConst, bool tolerant,
+                                        int32_t optr, int32_t start, int32_t end, bool *pRes) {
+  int32_t i = start;
+#if __AVX512F__
+  const __m512 c = _mm512_set1_ps(pr[0]);
+  const __m512 tol = _mm512_set1_ps(SCL_CMP_FLT_TOL);
+  for (; i + 16 <= end; i += 16) {
+    __m512   a = _mm512_loadu_ps(pl + i);
+    __m512   b = rightConst ? c : _mm512_loadu_ps(pr + i);
+    uint32_t gt = _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ);
+    uint32_t eq = 0;
+    if (tolerant) {
+      uint32_t nearby = _mm512_cmp_ps_mask(_mm512_abs_ps(_mm512_sub_ps(a, b)), tol, _CMP_LE_OQ);
+      uint32_t nanL = _mm512_cmp_ps_mask(a, a, _CMP_UNORD_Q);
+      uint32_t nanR = _mm512_cmp_ps_mask(b, b, _CMP_UNORD_Q);
+      SCL_CMP_TOLERANT_MASK(gt, eq, nearby, nanL, nanR);
+    } else {
+      eq = ~(gt | (uint32_t)_mm512_cmp_ps_mask(a, b, _CMP_LT_OQ));
+    }
+    uint32_t res = vectorCompareMaskByOptr(optr, gt, eq, 0xFFFF);
+    vectorCompareStoreMask(pRes + i, res, 8);
+    vectorCompareStoreMask(pRes + i + 8, res >> 8, 8);
+  }
+#endif
+  return i;
+}
+
+static int32_t vectorCompareDoubleAvx512(const double *pl, const double *pr, bool rightConst, bool tolerant,
+                                         int32_t optr, int32_t start, int32_t end, bool *pRes) {
+  int32_t i = start;
+#if __AVX512F__
+  const __m512d c = _mm512_set1_pd(pr[0]);
+  const __m512d tol = _mm512_set1_pd(SCL_CMP_FLT_TOL);
+  for (; i + 8 <= end; i += 8) {
+    __m512d  a = _mm512_loadu_pd(pl + i);
+    __m512d  b = rightConst ? c : _mm512_loadu_pd(pr + i);
+    uint32_t gt = _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ);
+    uint32_t eq = 0;
+    if (tolerant) {
+      uint32_t nearby = _mm512_cmp_pd_mask(_mm512_abs_pd(_mm512_sub_pd(a, b)), tol, _CMP_LE_OQ);
+      uint32_t nanL = _mm512_cmp_pd_mask(a, a, _CMP_UNORD_Q);
+      uint32_t nanR = _mm512_cmp_pd_mask(b, b, _CMP_UNORD_Q);
+      SCL_CMP_TOLERANT_MASK(gt, eq, nearby, nanL, nanR);
+    } else {
+      eq = ~(gt | (uint32_t)_mm512_cmp_pd_mask(a, b, _CMP_LT_OQ));
+    }
+    vectorCompareStoreMask(pRes + i, vectorCompareMaskByOptr(optr, gt, eq, 0xFF), 8);
+  }
+#endif
+  return i;
+}
+
+// Run the simd kernel of the given type as far as it goes, and return the first row that is left to the scalar loop.
+static int32_t vectorCompareFixedSimd(int32_t type, const void *pLeftData, const void *pRightData, bool rightConst,
+                                      bool tolerant, int32_t optr, int32_t start, int32_t end, bool *pRes) {
+  int32_t i = start;
+  if (!tsSIMDEnable) {
+    return i;
+  }
+
+  if (tsAVX512Enable) {
+    switch (type) {
+      case TSDB_DATA_TYPE_INT:
+        i = vectorCompareI32Avx512(pLeftData, pRightData, rightConst, optr, i, end, pRes);
+        break;
+      case TSDB_DATA_TYPE_BIGINT:
+      case TSDB_DATA_TYPE_TIMESTAMP:
+        i = vectorCompareI64Avx512(pLeftData, pRightData, rightConst, optr, i, end, pRes);
+        break;
+      case TSDB_DATA_TYPE_FLOAT:
+        i = vectorCompareFloatAvx512(pLeftData, pRightData, rightConst, tolerant, optr, i, end, pRes);
+        break;
+      case TSDB_DATA_TYPE_DOUBLE:
+        i = vectorCompareDoubleAvx512(pLeftData, pRightData, rightConst, tolerant, optr, i, end, pRes);
+        break;
+      default:
+        break;
+    }
+  }
+
+  // the avx512 kernels may be compiled out, or leave a tail that still fits in a 256-bit register
+  if (tsAVX2Enable) {
+    switch (type) {
+      case TSDB_DATA_TYPE_INT:
+        i = vectorCompareI32Avx2(pLeftData, pRightData, rightConst, optr, i, end, pRes);
+        break;
+      case TSDB_DATA_TYPE_BIGINT:
+      case TSDB_DATA_TYPE_TIMESTAMP:
+        i = vectorCompareI64Avx2(pLeftData, pRightData, rightConst, optr, i, end, pRes);
+        break;
+      case TSDB_DATA_TYPE_FLOAT:
+        i = vectorCompareFloatAvx2(pLeftData, pRightData, rightConst, tolerant, optr, i, end, pRes);
+        break;
+      case TSDB_DATA_TYPE_DOUBLE:
+        i = vectorCompareDoubleAvx2(pLeftData, pRightData, rightConst, tolerant, optr, i, end, pRes);
+        break;
+      default:
+        break;
+    }
+  }
+
+  return i;
+}
+
+static void vectorCompareFixedKernel(int32_t type, const void *pLeftData, const void *pRightData, bool rightConst,
+                                     bool tolerant, int32_t optr, int32_t start, int32_t end, bool *pRes) {
+  start = vectorCompareFixedSimd(type, pLeftData, pRightData, rightConst, tolerant, optr, start, end, pRes);
+
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      SCL_CMP_EXACT(int8_t);
+      break;
+    case TSDB_DATA_TYPE_UTINYINT:
+      SCL_CMP_EXACT(uint8_t);
+      break;
+    case TSDB_DATA_TYPE_SMALLINT:
+      SCL_CMP_EXACT(int16_t);
+      break;
+    case TSDB_DATA_TYPE_USMALLINT:
+      SCL_CMP_EXACT(uint16_t);
+      break;
+    case TSDB_DATA_TYPE_INT:
+      SCL_CMP_EXACT(int32_t);
+      break;
+    case TSDB_DATA_TYPE_UINT:
+      SCL_CMP_EXACT(uint32_t);
+      break;
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+      SCL_CMP_EXACT(int64_t);
+      break;
+    case TSDB_DATA_TYPE_UBIGINT:
+      SCL_CMP_EXACT(uint64_t);
+      break;
+    case TSDB_DATA_TYPE_FLOAT:
+      if (tolerant) {
+        SCL_CMP_TOLERANT(float);
+      } else {
+        SCL_CMP_EXACT(float);
+      }
+      break;
+    case TSDB_DATA_TYPE_DOUBLE:
+      if (tolerant) {
+        SCL_CMP_TOLERANT(double);
+      } else {
+        SCL_CMP_EXACT(double);
+      }
+      break;
+    default:
+      break;
+  }
+}
+
+// Convert the constant side to the type of the column side, if the column type compare against it gives exactly the
+// result of the mixed-type compare function chosen by filterGetCompFuncEx().
+static bool vectorCompareConvertConst(int32_t colType, int32_t constType, const char *pConst, char *buf,
+                                      bool *tolerant) {
+  *tolerant = IS_FLOAT_TYPE(colType);
+  if (colType == constType) {
+    memcpy(buf, pConst, tDataTypes[colType].bytes);
+    return true;
+  }
+
+  if (colType == TSDB_DATA_TYPE_DOUBLE && constType == TSDB_DATA_TYPE_FLOAT) {  // compareDoubleFloat
+    *(double *)buf = GET_FLOAT_VAL(pConst);
+    return true;
+  }
+
+  if (!IS_INTEGER_TYPE(constType) || constType == TSDB_DATA_TYPE_UBIGINT) {
+    return false;
+  }
+
+  int64_t v = 0;
+  GET_TYPED_DATA(v, int64_t, constType, pConst);
+
+  // compareFloatInt64() and friends do a plain C comparison
+  *tolerant = false;
+  switch (colType) {
+    case TSDB_DATA_TYPE_FLOAT:
+      *(float *)buf = (float)v;
+      return true;
+    case TSDB_DATA_TYPE_DOUBLE:
+      *(double *)buf = (double)v;
+      return true;
+    case TSDB_DATA_TYPE_TINYINT:
+      *(int8_t *)buf = (int8_t)v;
+      return v >= INT8_MIN && v <= INT8_MAX;
+    case TSDB_DATA_TYPE_UTINYINT:
+      *(uint8_t *)buf = (uint8_t)v;
+      return v >= 0 && v <= UINT8_MAX;
+    case TSDB_DATA_TYPE_SMALLINT:
+      *(int16_t *)buf = (int16_t)v;
+      return v >= INT16_MIN && v <= INT16_MAX;
+    case TSDB_DATA_TYPE_USMALLINT:
+      *(uint16_t *)buf = (uint16_t)v;
+      return v >= 0 && v <= UINT16_MAX;
+    case TSDB_DATA_TYPE_INT:
+      *(int32_t *)buf = (int32_t)v;
+      return v >= INT32_MIN && v <= INT32_MAX;
+    case TSDB_DATA_TYPE_UINT:
+      *(uint32_t *)buf = (uint32_t)v;
+      return v >= 0 && v <= UINT32_MAX;
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+      *(int64_t *)buf = v;
+      return true;
+    case TSDB_DATA_TYPE_UBIGINT:
+      *(uint64_t *)buf = (uint64_t)v;
+      return v >= 0;
+    default:
+      return false;
+  }
+}
+
+// Clear the result of the rows that are null in pCol, skipping 64 rows at a time while the bitmap word is empty.
+static void vectorCompareClearNull(const SColumnInfoData *pCol, int32_t start, int32_t end, bool *pRes) {
+  if (!pCol->hasNull) {
+    return;
+  }
+
+  int32_t i = start;
+  while (i < end) {
+    if ((i & 0x07) == 0 && i + 64 <= end) {
+      uint64_t word = 0;
+      memcpy(&word, pCol->nullbitmap + (i >> NBIT), sizeof(word));
+      if (word == 0) {
+        i += 64;
+        continue;
+      }
+    }
+
+    if (colDataIsNull_f(pCol->nullbitmap, i)) {
+      pRes[i] = false;
+    }
+    ++i;
+  }
+}
+
+static bool vectorCompareFixedType(int32_t type) {
+  return (IS_NUMERIC_TYPE(type) || type == TSDB_DATA_TYPE_TIMESTAMP || type == TSDB_DATA_TYPE_BOOL);
+}
+
+static int32_t vectorCompareMirrorOptr(int32_t optr) {
+  switch (optr) {
+    case OP_TYPE_GREATER_THAN:
+      return OP_TYPE_LOWER_THAN;
+    case OP_TYPE_GREATER_EQUAL:
+      return OP_TYPE_LOWER_EQUAL;
+    case OP_TYPE_LOWER_THAN:
+      return OP_TYPE_GREATER_THAN;
+    case OP_TYPE_LOWER_EQUAL:
+      return OP_TYPE_GREATER_EQUAL;
+    default:
+      return optr;
+  }
+}
+
+// Try the typed kernels for rows covered by the loop of doVectorCompareImpl. Return false if the operands are not
+// supported, in which case nothing has been written yet.
+static bool vectorCompareFixed(SScalarParam *pLeft, SScalarParam *pRight, bool *pRes, int32_t startIndex,
+                               int32_t numOfRows, int32_t step, int32_t optr, int32_t *pNum) {
+  if (optr < OP_TYPE_GREATER_THAN || optr > OP_TYPE_NOT_EQUAL || pLeft->pHashFilter || pRight->pHashFilter) {
+    return false;
+  }
+
+  // the descending loop walks from startIndex down to 0
+  int32_t start = (step > 0) ? startIndex : 0;
+  int32_t end = (step > 0) ? numOfRows : TMIN(startIndex + 1, numOfRows);
+  if (start < 0 || end <= start) {
+    return false;
+  }
+
+  bool leftConst = (pLeft->numOfRows == 1);
+  bool rightConst = (pRight->numOfRows == 1);
+  if (leftConst && rightConst) {
+    return false;
+  }
+
+  SScalarParam *pCol = pLeft;
+  SScalarParam *pOther = pRight;
+  if (leftConst) {
+    pCol = pRight;
+    pOther = pLeft;
+    optr = vectorCompareMirrorOptr(optr);
+  }
+
+  int32_t colType = GET_PARAM_TYPE(pCol);
+  int32_t otherType = GET_PARAM_TYPE(pOther);
+  if (!vectorCompareFixedType(colType) || !vectorCompareFixedType(otherType) || pCol->numOfRows < end ||
+      (!leftConst && !rightConst && pOther->numOfRows < end)) {
+    return false;
+  }
+
+  bool        tolerant = IS_FLOAT_TYPE(colType);
+  const char *pOtherData = pOther->columnData->pData;
+  char        buf[sizeof(int64_t)] = {0};
+
+  if (leftConst || rightConst) {
+    if (pOther->columnData->hasNull && colDataIsNull_f(pOther->columnData->nullbitmap, 0)) {
+      memset(pRes + start, 0, end - start);
+      *pNum = 0;
+      return true;
+    }
+
+    if (!vectorCompareConvertConst(colType, otherType, pOtherData, buf, &tolerant)) {
+      return false;
+    }
+    pOtherData = buf;
+  } else if (colType != otherType) {
+    return false;
+  }
+
+  vectorCompareFixedKernel(colType, pCol->columnData->pData, pOtherData, leftConst || rightConst, tolerant, optr,
+                           start, end, pRes);
+
+  vectorCompareClearNull(pCol->columnData, start, end, pRes);
+  if (!leftConst && !rightConst) {
+    vectorCompareClearNull(pOther->columnData, start, end, pRes);
+  }
+
+  int32_t num = 0;
+  for (int32_t i = start; i < end; ++i) {
+    num += pRes[i];
+  }
+
+  *pNum = num;
+  return true;
+}
+
 int32_t doVectorCompareImpl(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut, int32_t startIndex,
                             int32_t numOfRows, int32_t step, __compar_fn_t fp, int32_t optr) {
   int32_t num = 0;
   bool   *pRes = (bool *)pOut->columnData->pData;
 
   if (IS_MATHABLE_TYPE(GET_PARAM_TYPE(pLeft)) && IS_MATHABLE_TYPE(GET_PARAM_TYPE(pRight))) {
+    if (vectorCompareFixed(pLeft, pRight, pRes, startIndex, numOfRows, step, optr, &num)) {
+      return num;
+    }
+
     if (!(pLeft->columnData->hasNull || pRight->columnData->hasNull)) {
       for (int32_t i = startIndex; i < numOfRows && i >= 0; i += step) {
         int32_t leftIndex = (i >= pLeft->numOfRows) ? 0 : i;
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Measure rows/sec of the binary arithmetic and comparison operators of sclvector.c.
+// usage: scalarBench [rows] [loops]
+
+#include "os.h"
+#include "function.h"
+#include "querynodes.h"
+#include "sclvector.h"
+#include "tdatablock.h"
+#include "tglobal.h"
+
+typedef struct {
+  int32_t     optr;
+  const char *name;
+} SBenchOptr;
+
+typedef struct {
+  int32_t lType;
+  int32_t rType;
+  bool    rConst;
+} SBenchCase;
+
+static SScalarParam *benchMakeParam(int32_t type, int32_t numOfRows, bool withNull) {
+  SScalarParam *pParam = taosMemoryCalloc(1, sizeof(SScalarParam));
+  pParam->columnData = taosMemoryCalloc(1, sizeof(SColumnInfoData));
+  pParam->numOfRows = numOfRows;
+  *pParam->columnData = createColumnInfoData(type, tDataTypes[type].bytes, 0);
+  colInfoDataEnsureCapacity(pParam->columnData, numOfRows, true);
+
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    int64_t v = taosRand() % 10000 + 1;
+    double  d = v * 0.37;
+    switch (type) {
+      case TSDB_DATA_TYPE_INT: {
+        int32_t n = (int32_t)v;
+        colDataSetVal(pParam->columnData, i, (const char *)&n, false);
+      } break;
+      case TSDB_DATA_TYPE_FLOAT: {
+        float f = (float)d;
+        colDataSetVal(pParam->columnData, i, (const char *)&f, false);
+      } break;
+      case TSDB_DATA_TYPE_DOUBLE:
+        colDataSetVal(pParam->columnData, i, (const char *)&d, false);
+        break;
+      default:
+        colDataSetVal(pParam->columnData, i, (const char *)&v, false);
+        break;
+    }
+
+    if (withNull && i % 97 == 0) {
+      colDataSetNULL(pParam->columnData, i);
+    }
+  }
+
+  return pParam;
+}
+
+static void benchDestroyParam(SScalarParam *pParam) {
+  colDataDestroy(pParam->columnData);
+  taosMemoryFree(pParam->columnData);
+  taosMemoryFree(pParam);
+}
+
+static void benchRun(const SBenchOptr *pOptr, const SBenchCase *pCase, int32_t numOfRows, int32_t loops) {
+  SScalarParam *pLeft = benchMakeParam(pCase->lType, numOfRows, true);
+  SScalarParam *pRight = benchMakeParam(pCase->rType, pCase->rConst ? 1 : numOfRows, false);
+  int32_t       outType = (pOptr->optr >= OP_TYPE_GREATER_THAN) ? TSDB_DATA_TYPE_BOOL : TSDB_DATA_TYPE_DOUBLE;
+  SScalarParam *pOut = benchMakeParam(outType, numOfRows, false);
+
+  _bin_scalar_fn_t fn = getBinScalarOperatorFn(pOptr->optr);
+
+  int64_t st = taosGetTimestampUs();
+  for (int32_t i = 0; i < loops; ++i) {
+    fn(pLeft, pRight, pOut, TSDB_ORDER_ASC);
+  }
+  int64_t el = taosGetTimestampUs() - st;
+
+  double rowsPerSec = (el > 0) ? ((double)numOfRows * loops * 1000000.0 / el) : 0;
+  printf("%-4s %-9s %-9s %-6s %12.2f Mrows/s\n", pOptr->name, tDataTypes[pCase->lType].name,
+         tDataTypes[pCase->rType].name, pCase->rConst ? "const" : "column", rowsPerSec / 1000000.0);
+
+  benchDestroyParam(pLeft);
+  benchDestroyParam(pRight);
+  benchDestroyParam(pOut);
+}
+
+int main(int argc, char *argv[]) {
+  int32_t numOfRows = (argc > 1) ? atoi(argv[1]) : 4096;
+  int32_t loops = (argc > 2) ? atoi(argv[2]) : 2000;
+
+  taosGetSystemInfo();
+  tsSIMDEnable = 1;
+
+  SBenchOptr optrs[] = {
+      {OP_TYPE_ADD, "+"},  {OP_TYPE_SUB, "-"}, {OP_TYPE_MULTI, "*"},         {OP_TYPE_DIV, "/"},
+      {OP_TYPE_GREATER_THAN, ">"}, {OP_TYPE_EQUAL, "="}, {OP_TYPE_LOWER_EQUAL, "<="},
+  };
+
+  SBenchCase cases[] = {
+      {TSDB_DATA_TYPE_BIGINT, TSDB_DATA_TYPE_BIGINT, false}, {TSDB_DATA_TYPE_BIGINT, TSDB_DATA_TYPE_BIGINT, true},
+      {TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_INT, false},       {TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_BIGINT, true},
+      {TSDB_DATA_TYPE_FLOAT, TSDB_DATA_TYPE_FLOAT, false},   {TSDB_DATA_TYPE_FLOAT, TSDB_DATA_TYPE_BIGINT, true},
+      {TSDB_DATA_TYPE_DOUBLE, TSDB_DATA_TYPE_DOUBLE, false}, {TSDB_DATA_TYPE_DOUBLE, TSDB_DATA_TYPE_DOUBLE, true},
+  };
+
+  printf("rows:%d loops:%d simd:%d avx2:%d avx512:%d\n", numOfRows, loops, tsSIMDEnable, tsAVX2Enable,
+         tsAVX512Enable);
+  for (int32_t i = 0; i < sizeof(optrs) / sizeof(optrs[0]); ++i) {
+    for (int32_t j = 0; j < sizeof(cases) / sizeof(cases[0]); ++j) {
+      benchRun(&optrs[i], &cases[j], numOfRows, loops);
+    }
+  }
+
+  return 0;
+}
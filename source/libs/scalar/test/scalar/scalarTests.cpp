@@ -36,6 +36,7 @@
 #include "nodes.h"
 #include "parUtil.h"
 #include "scalar.h"
+#include "sclvector.h"
 #include "stub.h"
 #include "taos.h"
 #include "tdatablock.h"
@@ -2045,6 +2046,138 @@ void scltDestroyDataBlock(SScalarParam *pInput) {
   taosMemoryFree(pInput);
 }
 
+TEST(columnTest, fixed_type_compare_kernels) {
+  const int32_t rowNum = 67;
+  int32_t       types[] = {TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_BIGINT, TSDB_DATA_TYPE_FLOAT, TSDB_DATA_TYPE_DOUBLE};
+  int32_t       optrs[] = {OP_TYPE_GREATER_THAN, OP_TYPE_GREATER_EQUAL, OP_TYPE_LOWER_THAN,
+                           OP_TYPE_LOWER_EQUAL,  OP_TYPE_EQUAL,         OP_TYPE_NOT_EQUAL};
+
+  for (int32_t t = 0; t < sizeof(types) / sizeof(types[0]); ++t) {
+    int32_t       type = types[t];
+    SScalarParam *pLeft = NULL, *pRight = NULL, *pConst = NULL, *pOut = NULL;
+    int64_t       zero = 0;
+    scltMakeDataBlock(&pLeft, type, &zero, rowNum, true);
+    scltMakeDataBlock(&pRight, type, &zero, rowNum, true);
+    scltMakeDataBlock(&pConst, TSDB_DATA_TYPE_BIGINT, &zero, 1, true);
+
+    for (int32_t i = 0; i < rowNum; ++i) {
+      double v1 = (i % 7) - 3, v2 = (i % 5) - 2;
+      if (IS_FLOAT_TYPE(type) && i % 11 == 0) {
+        v1 = NAN;
+      }
+      char lbuf[8] = {0}, rbuf[8] = {0};
+      if (type == TSDB_DATA_TYPE_INT) {
+        *(int32_t *)lbuf = (int32_t)v1;
+        *(int32_t *)rbuf = (int32_t)v2;
+      } else if (type == TSDB_DATA_TYPE_BIGINT) {
+        *(int64_t *)lbuf = (int64_t)v1;
+        *(int64_t *)rbuf = (int64_t)v2;
+      } else if (type == TSDB_DATA_TYPE_FLOAT) {
+        *(float *)lbuf = (float)v1;
+        *(float *)rbuf = (float)v2;
+      } else {
+        *(double *)lbuf = v1;
+        *(double *)rbuf = v2;
+      }
+      colDataSetVal(pLeft->columnData, i, lbuf, false);
+      colDataSetVal(pRight->columnData, i, rbuf, false);
+    }
+    colDataSetNULL(pLeft->columnData, 3);
+    colDataSetNULL(pRight->columnData, 64);
+
+    for (int32_t o = 0; o < sizeof(optrs) / sizeof(optrs[0]); ++o) {
+      for (int32_t k = 0; k < 2; ++k) {
+        SScalarParam *pSecond = (k == 0) ? pRight : pConst;
+        scltMakeDataBlock(&pOut, TSDB_DATA_TYPE_TINYINT, &zero, rowNum, false);
+        pOut->columnData->info = createColumnInfo(0, TSDB_DATA_TYPE_BOOL, sizeof(bool));
+
+        _bin_scalar_fn_t fn = getBinScalarOperatorFn(optrs[o]);
+        fn(pLeft, pSecond, pOut, TSDB_ORDER_ASC);
+
+        __compar_fn_t cmp = filterGetCompFuncEx(type, pSecond->columnData->info.type, optrs[o]);
+        if (type == pSecond->columnData->info.type) {
+          cmp = filterGetCompFunc(type, optrs[o]);
+        }
+
+        int32_t qualified = 0;
+        for (int32_t i = 0; i < rowNum; ++i) {
+          int32_t j = (pSecond->numOfRows == 1) ? 0 : i;
+          bool    expect = false;
+          if (!colDataIsNull_s(pLeft->columnData, i) && !colDataIsNull_s(pSecond->columnData, j)) {
+            expect = filterDoCompare(cmp, optrs[o], colDataGetData(pLeft->columnData, i),
+                                     colDataGetData(pSecond->columnData, j));
+          }
+          qualified += expect;
+          ASSERT_EQ(*((bool *)colDataGetData(pOut->columnData, i)), expect);
+        }
+        ASSERT_EQ(pOut->numOfQualified, qualified);
+        scltDestroyDataBlock(pOut);
+      }
+    }
+
+    scltDestroyDataBlock(pLeft);
+    scltDestroyDataBlock(pRight);
+    scltDestroyDataBlock(pConst);
+  }
+}
+
+TEST(columnTest, fixed_type_arith_kernels) {
+  const int32_t rowNum = 131;
+  int32_t       optrs[] = {OP_TYPE_ADD, OP_TYPE_SUB, OP_TYPE_MULTI, OP_TYPE_DIV};
+  int64_t       zero = 0;
+  double        factor = 0.001;
+
+  SScalarParam *pBigint1 = NULL, *pBigint2 = NULL, *pConst = NULL;
+  scltMakeDataBlock(&pBigint1, TSDB_DATA_TYPE_BIGINT, &zero, rowNum, true);
+  scltMakeDataBlock(&pBigint2, TSDB_DATA_TYPE_INT, &zero, rowNum, true);
+  scltMakeDataBlock(&pConst, TSDB_DATA_TYPE_DOUBLE, &factor, 1, true);
+  for (int32_t i = 0; i < rowNum; ++i) {
+    int64_t v1 = i * 1000 - 7;
+    int32_t v2 = i % 9 - 4;
+    colDataSetVal(pBigint1->columnData, i, (const char *)&v1, false);
+    colDataSetVal(pBigint2->columnData, i, (const char *)&v2, false);
+  }
+  colDataSetNULL(pBigint1->columnData, 1);
+  colDataSetNULL(pBigint2->columnData, 70);
+
+  for (int32_t o = 0; o < sizeof(optrs) / sizeof(optrs[0]); ++o) {
+    for (int32_t k = 0; k < 3; ++k) {
+      SScalarParam *pL = (k == 2) ? pConst : pBigint1;
+      SScalarParam *pR = (k == 0) ? pBigint2 : ((k == 1) ? pConst : pBigint2);
+      SScalarParam *pOut = NULL;
+      scltMakeDataBlock(&pOut, TSDB_DATA_TYPE_DOUBLE, &zero, rowNum, false);
+
+      _bin_scalar_fn_t fn = getBinScalarOperatorFn(optrs[o]);
+      fn(pL, pR, pOut, TSDB_ORDER_ASC);
+      ASSERT_EQ(pOut->numOfRows, rowNum);
+
+      for (int32_t i = 0; i < rowNum; ++i) {
+        int32_t li = (pL->numOfRows == 1) ? 0 : i;
+        int32_t ri = (pR->numOfRows == 1) ? 0 : i;
+        double  l = (pL == pConst) ? factor : (double)*(int64_t *)colDataGetData(pL->columnData, li);
+        double  r = (pR == pConst) ? factor : (double)*(int32_t *)colDataGetData(pR->columnData, ri);
+        bool    isNull = colDataIsNull_s(pL->columnData, li) || colDataIsNull_s(pR->columnData, ri) ||
+                      (optrs[o] == OP_TYPE_DIV && r == 0);
+        ASSERT_EQ(colDataIsNull_s(pOut->columnData, i), isNull);
+        if (isNull) {
+          continue;
+        }
+
+        double expect = (optrs[o] == OP_TYPE_ADD)   ? l + r
+                        : (optrs[o] == OP_TYPE_SUB) ? l - r
+                        : (optrs[o] == OP_TYPE_MULTI) ? l * r
+                                                      : l / r;
+        ASSERT_DOUBLE_EQ(*(double *)colDataGetData(pOut->columnData, i), expect);
+      }
+      scltDestroyDataBlock(pOut);
+    }
+  }
+
+  scltDestroyDataBlock(pBigint1);
+  scltDestroyDataBlock(pBigint2);
+  scltDestroyDataBlock(pConst);
+}
+
 TEST(ScalarFunctionTest, absFunction_constant) {
   SScalarParam *pInput, *pOutput;
   int32_t       code = TSDB_CODE_SUCCESS;
@@ -104,6 +104,7 @@ typedef struct SElectTimerParam {
 typedef struct SPeerState {
   SyncIndex lastSendIndex;
   int64_t   lastSendTime;
+  int64_t   leaseTime;  // monotonic send time of the last heartbeat acked in current term
 } SPeerState;
 
 typedef struct SSyncNode {
@@ -217,6 +218,15 @@ typedef struct SSyncNode {
   int64_t roleTimeMs;
   int64_t lastReplicateTime;
 
+  // leader lease and follower read index
+  int64_t       leaderTime;      // monotonic time last heard from the leader of current term
+  TdThreadMutex readMutex;       // guards the read index fields below
+  TdThreadCond  readCond;        // signaled when the leader answers a read index request
+  int64_t       readSeq;         // last read index request sent to the leader
+  int64_t       readExpireTime;  // monotonic time readSeq is taken as lost, when its sender gives up
+  int64_t       readAckSeq;      // last read index request answered by the leader
+  SyncIndex     readIndex;       // commit index the leader answered with
+
   int32_t electNum;
   int32_t becomeLeaderNum;
   int32_t configChangeNum;
@@ -274,6 +284,9 @@ bool      syncNodeHeartbeatReplyTimeout(SSyncNode* pSyncNode);
 bool      syncNodeSnapshotSending(SSyncNode* pSyncNode);
 bool      syncNodeSnapshotRecving(SSyncNode* pSyncNode);
 bool      syncNodeIsReadyForRead(SSyncNode* pSyncNode);
+bool      syncNodeIsLeaderSticky(SSyncNode* pSyncNode);
+int32_t   syncNodeReadIndex(SSyncNode* pSyncNode, int64_t timeoutMs, SyncIndex* pReadIndex);
+void      syncNodeAckReadIndex(SSyncNode* pSyncNode, int64_t readSeq, SyncIndex commitIndex);
 
 // raft state change --------------
 void syncNodeUpdateTerm(SSyncNode* pSyncNode, SyncTerm term);
@@ -98,7 +98,7 @@ typedef struct SyncAppendEntries {
   SyncTerm  prevLogTerm;
   SyncIndex commitIndex;
   SyncTerm  privateTerm;
-  int16_t   reserved;
+  int16_t   numOfEntries;  // number of raft entries packed in data, 0 is taken as 1
   uint32_t  dataLen;
   char      data[];
 } SyncAppendEntries;
@@ -133,6 +133,8 @@ typedef struct SyncHeartbeat {
   SyncTerm  minMatchIndex;
   int64_t   timeStamp;
   int16_t   reserved;
+  int64_t   leaseTime;  // monotonic send time of the leader, echoed back to extend its lease
+  int64_t   readSeq;    // read index request of the follower answered by commitIndex, 0 if none
 } SyncHeartbeat;
 
 typedef struct SyncHeartbeatReply {
@@ -148,6 +150,8 @@ typedef struct SyncHeartbeatReply {
   int64_t  startTime;
   int64_t  timeStamp;
   int16_t  reserved;
+  int64_t  leaseTime;  // leaseTime of the heartbeat acked
+  int64_t  readSeq;    // read index request to the leader, 0 if none
 } SyncHeartbeatReply;
 
 typedef struct SyncPreSnapshot {
@@ -260,6 +264,8 @@ int32_t syncBuildRequestVote(SRpcMsg* pMsg, int32_t vgId);
 int32_t syncBuildRequestVoteReply(SRpcMsg* pMsg, int32_t vgId);
 int32_t syncBuildAppendEntries(SRpcMsg* pMsg, int32_t dataLen, int32_t vgId);
 int32_t syncBuildAppendEntriesReply(SRpcMsg* pMsg, int32_t vgId);
+int32_t syncBuildAppendEntriesFromRaftEntries(SSyncNode* pNode, SSyncRaftEntry** ppEntries, int32_t numOfEntries,
+                                              SyncTerm prevLogTerm, SRpcMsg* pRpcMsg);
 int32_t syncBuildAppendEntriesFromRaftEntry(SSyncNode* pNode, SSyncRaftEntry* pEntry, SyncTerm prevLogTerm,
                                             SRpcMsg* pRpcMsg);
 int32_t syncBuildHeartbeat(SRpcMsg* pMsg, int32_t vgId);
@@ -22,6 +22,9 @@ extern "C" {
 
 #include "syncInt.h"
 
+// max number of raft entries packed into one append entries msg
+#define SYNC_LOG_REPL_BATCH_NUM 256
+
 typedef struct SSyncReplInfo {
   bool    barrier;
   bool    acked;
@@ -85,6 +88,10 @@ int32_t syncLogReplProbe(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncIndex inde
 int32_t syncLogReplRetryOnNeed(SSyncLogReplMgr* pMgr, SSyncNode* pNode);
 int32_t syncLogReplSendTo(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncIndex index, SyncTerm* pTerm, SRaftId* pDestId,
                           bool* pBarrier);
+int32_t syncLogReplCollectBatch(SSyncLogBuffer* pBuf, SyncIndex index, SyncIndex maxIndex, SyncTerm prevLogTerm,
+                                int32_t maxBytes, SSyncRaftEntry** ppEntries, int64_t* pBytes);
+int32_t syncLogReplSendBatchTo(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncIndex index, SyncIndex maxIndex,
+                               SyncIndex* pLastIndex, SyncTerm* pTerm, SRaftId* pDestId, bool* pBarrier);
 
 int32_t syncLogReplProcessReply(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncAppendEntriesReply* pMsg);
 int32_t syncLogReplRecover(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncAppendEntriesReply* pMsg);
@@ -25,6 +25,7 @@ extern "C" {
 typedef struct SRespStub {
   SRpcMsg rpcMsg;
   int64_t createTime;
+  void   *pCont;  // referenced cont of the proposed msg, applied on the leader instead of a copy of the entry
 } SRespStub;
 
 typedef struct SSyncRespMgr {
@@ -41,6 +42,7 @@ uint64_t      syncRespMgrAdd(SSyncRespMgr *pObj, const SRespStub *pStub);
 int32_t       syncRespMgrDel(SSyncRespMgr *pObj, uint64_t seq);
 int32_t       syncRespMgrGet(SSyncRespMgr *pObj, uint64_t seq, SRespStub *pStub);
 int32_t       syncRespMgrGetAndDel(SSyncRespMgr *pObj, uint64_t seq, SRpcHandleInfo *pInfo);
+int32_t       syncRespMgrGetAndDelCont(SSyncRespMgr *pObj, uint64_t seq, SRpcHandleInfo *pInfo, void **ppCont);
 void          syncRespClean(SSyncRespMgr *pObj);
 void          syncRespCleanRsp(SSyncRespMgr *pObj);
 
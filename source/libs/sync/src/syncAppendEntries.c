@@ -115,7 +115,7 @@ int32_t syncNodeOnAppendEntries(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
   pReply->term = raftStoreGetTerm(ths);
   pReply->success = false;
   pReply->matchIndex = SYNC_INDEX_INVALID;
-  pReply->lastSendIndex = pMsg->prevLogIndex + 1;
+  pReply->lastSendIndex = pMsg->prevLogIndex + TMAX(pMsg->numOfEntries, 1);
   pReply->startTime = ths->startTime;
 
   if (pMsg->term < raftStoreGetTerm(ths)) {
@@ -137,34 +137,47 @@ int32_t syncNodeOnAppendEntries(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
     goto _IGNORE;
   }
 
-  pEntry = syncEntryBuildFromAppendEntries(pMsg);
-  if (pEntry == NULL) {
-    sError("vgId:%d, failed to get raft entry from append entries since %s", ths->vgId, terrstr());
-    goto _IGNORE;
-  }
-
-  if (pMsg->prevLogIndex + 1 != pEntry->index || pEntry->term < 0) {
-    sError("vgId:%d, invalid previous log index in msg. index:%" PRId64 ",  term:%" PRId64 ", prevLogIndex:%" PRId64
-           ", prevLogTerm:%" PRId64,
-           ths->vgId, pEntry->index, pEntry->term, pMsg->prevLogIndex, pMsg->prevLogTerm);
-    goto _IGNORE;
-  }
-
-  sTrace("vgId:%d, recv append entries msg. index:%" PRId64 ", term:%" PRId64 ", preLogIndex:%" PRId64
-         ", prevLogTerm:%" PRId64 " commitIndex:%" PRId64 " entryterm:%" PRId64,
-         pMsg->vgId, pMsg->prevLogIndex + 1, pMsg->term, pMsg->prevLogIndex, pMsg->prevLogTerm, pMsg->commitIndex,
-         pEntry->term);
-
-  if (ths->fsmState == SYNC_FSM_STATE_INCOMPLETE) {
-    pReply->fsmState = ths->fsmState;
-    sWarn("vgId:%d, unable to accept, due to incomplete fsm state. index:%" PRId64, ths->vgId, pEntry->index);
-    syncEntryDestroy(pEntry);
-    goto _SEND_RESPONSE;
-  }
-
-  // accept
-  if (syncLogBufferAccept(ths->pLogBuf, ths, pEntry, pMsg->prevLogTerm) < 0) {
-    goto _SEND_RESPONSE;
+  // a batch of consecutive entries is accepted in order, and persisted together in syncLogBufferProceed below
+  int32_t  numOfEntries = TMAX(pMsg->numOfEntries, 1);
+  uint32_t offset = 0;
+  SyncTerm prevLogTerm = pMsg->prevLogTerm;
+  for (int32_t i = 0; i < numOfEntries; ++i) {
+    pEntry = syncEntryBuildFromAppendEntries(pMsg, &offset);
+    if (pEntry == NULL) {
+      sError("vgId:%d, failed to get raft entry from append entries since %s", ths->vgId, terrstr());
+      goto _IGNORE;
+    }
+
+    if (pMsg->prevLogIndex + 1 + i != pEntry->index || pEntry->term < 0) {
+      sError("vgId:%d, invalid previous log index in msg. index:%" PRId64 ",  term:%" PRId64 ", prevLogIndex:%" PRId64
+             ", prevLogTerm:%" PRId64 ", pos:%d",
+             ths->vgId, pEntry->index, pEntry->term, pMsg->prevLogIndex, pMsg->prevLogTerm, i);
+      goto _IGNORE;
+    }
+
+    sTrace("vgId:%d, recv append entries msg. index:%" PRId64 ", term:%" PRId64 ", preLogIndex:%" PRId64
+           ", prevLogTerm:%" PRId64 " commitIndex:%" PRId64 " entryterm:%" PRId64,
+           pMsg->vgId, pEntry->index, pMsg->term, pEntry->index - 1, prevLogTerm, pMsg->commitIndex, pEntry->term);
+
+    if (ths->fsmState == SYNC_FSM_STATE_INCOMPLETE) {
+      pReply->fsmState = ths->fsmState;
+      sWarn("vgId:%d, unable to accept, due to incomplete fsm state. index:%" PRId64, ths->vgId, pEntry->index);
+      syncEntryDestroy(pEntry);
+      goto _SEND_RESPONSE;
+    }
+
+    // accept
+    SyncTerm term = pEntry->term;
+    if (syncLogBufferAccept(ths->pLogBuf, ths, pEntry, prevLogTerm) < 0) {
+      if (i == 0) goto _SEND_RESPONSE;
+      // ack the entries accepted so far, the leader sends the rest again
+      sWarn("vgId:%d, accepted %d of %d packed entries. prevLogIndex:%" PRId64, ths->vgId, i, numOfEntries,
+            pMsg->prevLogIndex);
+      pReply->lastSendIndex = pMsg->prevLogIndex + i;
+      break;
+    }
+    pEntry = NULL;
+    prevLogTerm = term;
   }
   accepted = true;
 
@@ -427,6 +427,42 @@ int32_t syncStepDown(int64_t rid, SyncTerm newTerm) {
 }
 #endif
 
+// a voter refuses to vote for syncNodeStickyMs after it heard from the leader, and the leader holds its lease for a
+// shorter time since the heartbeats sent, leaving a margin for clock drift
+static FORCE_INLINE int64_t syncNodeStickyMs(SSyncNode* pSyncNode) {
+  return pSyncNode->electBaseLine - pSyncNode->hbBaseLine;
+}
+
+static FORCE_INLINE int64_t syncNodeLeaseMs(SSyncNode* pSyncNode) { return syncNodeStickyMs(pSyncNode) * 9 / 10; }
+
+static bool syncNodeHasLease(SSyncNode* pSyncNode) {
+  int64_t nowMs = taosGetMonoTimestampMs();
+  int64_t leaseMs = syncNodeLeaseMs(pSyncNode);
+  int32_t num = 1;  // myself
+
+  for (int32_t i = 0; i < pSyncNode->peersNum; ++i) {
+    if (pSyncNode->peersNodeInfo[i].nodeRole == TAOS_SYNC_ROLE_LEARNER) {
+      continue;
+    }
+    SPeerState* pState = syncNodeGetPeerState(pSyncNode, &pSyncNode->peersId[i]);
+    if (pState != NULL && atomic_load_64(&pState->leaseTime) + leaseMs > nowMs) {
+      num++;
+    }
+  }
+
+  return num >= pSyncNode->quorum;
+}
+
+bool syncNodeIsLeaderSticky(SSyncNode* pSyncNode) {
+  if (!tsSyncLeaderLease || syncNodeStickyMs(pSyncNode) <= 0) {
+    return false;
+  }
+  if (pSyncNode->state != TAOS_SYNC_STATE_FOLLOWER && pSyncNode->state != TAOS_SYNC_STATE_LEARNER) {
+    return false;
+  }
+  return taosGetMonoTimestampMs() - atomic_load_64(&pSyncNode->leaderTime) < syncNodeStickyMs(pSyncNode);
+}
+
 bool syncNodeIsReadyForRead(SSyncNode* pSyncNode) {
   if (pSyncNode == NULL) {
     terrno = TSDB_CODE_SYN_INTERNAL_ERROR;
@@ -444,6 +480,11 @@ bool syncNodeIsReadyForRead(SSyncNode* pSyncNode) {
     return false;
   }
 
+  if (tsSyncLeaderLease && syncNodeStickyMs(pSyncNode) > 0 && !syncNodeHasLease(pSyncNode)) {
+    terrno = TSDB_CODE_SYN_NOT_LEADER;
+    return false;
+  }
+
   return true;
 }
 
@@ -460,6 +501,129 @@ bool syncIsReadyForRead(int64_t rid) {
   return ready;
 }
 
+static int32_t syncNodeSendReadIndex(SSyncNode* pSyncNode, const SRaftId* pLeaderId, int64_t seq) {
+  SRpcMsg rpcMsg = {0};
+  if (syncBuildHeartbeatReply(&rpcMsg, pSyncNode->vgId) != 0) {
+    return -1;
+  }
+
+  SyncHeartbeatReply* pMsg = rpcMsg.pCont;
+  pMsg->srcId = pSyncNode->myRaftId;
+  pMsg->destId = *pLeaderId;
+  pMsg->term = raftStoreGetTerm(pSyncNode);
+  pMsg->privateTerm = 8864;  // magic number
+  pMsg->startTime = pSyncNode->startTime;
+  pMsg->timeStamp = taosGetTimestampMs();
+  pMsg->readSeq = seq;
+
+  sNTrace(pSyncNode, "send read index to dnode:%d, seq:%" PRId64, DID(pLeaderId), seq);
+  return syncNodeSendMsgById(pLeaderId, pSyncNode, &rpcMsg);
+}
+
+static void syncNodeWaitReadCond(SSyncNode* pSyncNode, int64_t waitMs) {
+  struct timeval  tv;
+  struct timespec ts;
+  taosGetTimeOfDay(&tv);
+  int64_t nsec = tv.tv_usec * 1000 + waitMs * 1000000;
+  ts.tv_sec = tv.tv_sec + nsec / 1000000000;
+  ts.tv_nsec = nsec % 1000000000;
+  (void)taosThreadCondTimedWait(&pSyncNode->readCond, &pSyncNode->readMutex, &ts);
+}
+
+// read index: ask the leader for its commit index, which it answers only under its lease. a request sent before a read
+// started can not confirm it, so the reads arriving while one is in flight wait for it and share the next one.
+int32_t syncNodeReadIndex(SSyncNode* pSyncNode, int64_t timeoutMs, SyncIndex* pReadIndex) {
+  *pReadIndex = SYNC_INDEX_INVALID;
+  if (pSyncNode->state == TAOS_SYNC_STATE_LEADER) {
+    return syncNodeIsReadyForRead(pSyncNode) ? 0 : -1;
+  }
+
+  SRaftId leaderId = pSyncNode->leaderCache;
+  if (!tsSyncLeaderLease || !tsSyncFollowerRead || pSyncNode->state != TAOS_SYNC_STATE_FOLLOWER ||
+      pSyncNode->fsmState == SYNC_FSM_STATE_INCOMPLETE || leaderId.addr == 0) {
+    terrno = TSDB_CODE_SYN_NOT_LEADER;
+    return -1;
+  }
+
+  int32_t code = 0;
+  int64_t endMs = taosGetMonoTimestampMs() + timeoutMs;
+
+  taosThreadMutexLock(&pSyncNode->readMutex);
+  int64_t seq = pSyncNode->readSeq + 1;
+  while (pSyncNode->readAckSeq < seq) {
+    int64_t nowMs = taosGetMonoTimestampMs();
+    if (nowMs >= endMs || pSyncNode->state != TAOS_SYNC_STATE_FOLLOWER) {
+      code = -1;
+      break;
+    }
+
+    // send a request for all the reads waiting, unless one is in flight. it is taken as lost once its sender gave up
+    if (pSyncNode->readSeq == pSyncNode->readAckSeq || nowMs >= pSyncNode->readExpireTime) {
+      int64_t sendSeq = ++pSyncNode->readSeq;
+      pSyncNode->readExpireTime = endMs;
+      taosThreadMutexUnlock(&pSyncNode->readMutex);
+      code = syncNodeSendReadIndex(pSyncNode, &leaderId, sendSeq);
+      taosThreadMutexLock(&pSyncNode->readMutex);
+      if (code != 0) break;
+      continue;
+    }
+
+    syncNodeWaitReadCond(pSyncNode, TMIN(pSyncNode->readExpireTime, endMs) - nowMs);
+  }
+  *pReadIndex = pSyncNode->readIndex;
+  int64_t ackSeq = pSyncNode->readAckSeq;
+  taosThreadMutexUnlock(&pSyncNode->readMutex);
+
+  if (code != 0) {
+    sNTrace(pSyncNode, "read index failed, seq:%" PRId64 ", ack seq:%" PRId64, seq, ackSeq);
+    *pReadIndex = SYNC_INDEX_INVALID;
+    terrno = TSDB_CODE_SYN_NOT_LEADER;
+    return -1;
+  }
+  return 0;
+}
+
+// the leader answered the read index requests up to readSeq with its commit index
+void syncNodeAckReadIndex(SSyncNode* pSyncNode, int64_t readSeq, SyncIndex commitIndex) {
+  taosThreadMutexLock(&pSyncNode->readMutex);
+  if (readSeq > pSyncNode->readAckSeq) {
+    pSyncNode->readIndex = TMAX(pSyncNode->readIndex, commitIndex);
+    pSyncNode->readAckSeq = readSeq;
+    taosThreadCondBroadcast(&pSyncNode->readCond);
+  }
+  taosThreadMutexUnlock(&pSyncNode->readMutex);
+}
+
+int32_t syncReadIndex(int64_t rid, SyncIndex* pReadIndex) {
+  SSyncNode* pSyncNode = syncNodeAcquire(rid);
+  if (pSyncNode == NULL) {
+    sError("sync read index error");
+    return -1;
+  }
+
+  int32_t code = syncNodeReadIndex(pSyncNode, SYNC_READ_INDEX_TIMEOUT_MS, pReadIndex);
+  syncNodeRelease(pSyncNode);
+  return code;
+}
+
+bool syncIsReadyForFollowerRead(int64_t rid) {
+  SSyncNode* pSyncNode = syncNodeAcquire(rid);
+  if (pSyncNode == NULL) {
+    sError("sync ready for follower read error");
+    return false;
+  }
+
+  bool ready = false;
+  if (pSyncNode->state == TAOS_SYNC_STATE_FOLLOWER && tsSyncLeaderLease && tsSyncFollowerRead) {
+    ready = true;
+  } else {
+    ready = syncNodeIsReadyForRead(pSyncNode);
+  }
+
+  syncNodeRelease(pSyncNode);
+  return ready;
+}
+
 #ifdef BUILD_NO_CALL
 bool syncSnapshotSending(int64_t rid) {
   SSyncNode* pSyncNode = syncNodeAcquire(rid);
@@ -718,7 +882,7 @@ int32_t syncNodePropose(SSyncNode* pSyncNode, SRpcMsg* pMsg, bool isWeak, int64_
       return -1;
     }
   } else {
-    SRespStub stub = {.createTime = taosGetTimestampMs(), .rpcMsg = *pMsg};
+    SRespStub stub = {.createTime = taosGetTimestampMs(), .rpcMsg = *pMsg, .pCont = rpcRefCont(pMsg->pCont)};
     uint64_t  seqNum = syncRespMgrAdd(pSyncNode->pSyncRespMgr, &stub);
     SRpcMsg   rpcMsg = {0};
     int32_t   code = syncBuildClientRequest(&rpcMsg, pMsg, seqNum, isWeak, pSyncNode->vgId);
@@ -816,6 +980,8 @@ SSyncNode* syncNodeOpen(SSyncInfo* pSyncInfo, int32_t vnodeVersion) {
     terrno = TSDB_CODE_OUT_OF_MEMORY;
     goto _error;
   }
+  taosThreadMutexInit(&pSyncNode->readMutex, NULL);
+  taosThreadCondInit(&pSyncNode->readCond, NULL);
 
   if (!taosDirExist((char*)(pSyncInfo->path))) {
     if (taosMkDir(pSyncInfo->path) != 0) {
@@ -1125,6 +1291,8 @@ SSyncNode* syncNodeOpen(SSyncInfo* pSyncInfo, int32_t vnodeVersion) {
   int64_t timeNow = taosGetTimestampMs();
   pSyncNode->startTime = timeNow;
   pSyncNode->lastReplicateTime = timeNow;
+  // a restarted voter might have acked a lease before, so it stays sticky as if it just heard from the leader
+  pSyncNode->leaderTime = taosGetMonoTimestampMs();
 
   // snapshotting
   atomic_store_64(&pSyncNode->snapshottingIndex, SYNC_INDEX_INVALID);
@@ -1334,6 +1502,8 @@ void syncNodeClose(SSyncNode* pSyncNode) {
 
   raftStoreClose(pSyncNode);
 
+  taosThreadCondDestroy(&pSyncNode->readCond);
+  taosThreadMutexDestroy(&pSyncNode->readMutex);
   taosMemoryFree(pSyncNode);
 }
 
@@ -1934,6 +2104,7 @@ int32_t syncNodePeerStateInit(SSyncNode* pSyncNode) {
   for (int32_t i = 0; i < TSDB_MAX_REPLICA + TSDB_MAX_LEARNER_REPLICA; ++i) {
     pSyncNode->peerStates[i].lastSendIndex = SYNC_INDEX_INVALID;
     pSyncNode->peerStates[i].lastSendTime = 0;
+    pSyncNode->peerStates[i].leaseTime = 0;
   }
 
   return 0;
@@ -2312,6 +2483,7 @@ static void syncNodeEqPeerHeartbeatTimer(void* param, void* tmrId) {
         pSyncMsg->minMatchIndex = pSyncNode->minMatchIndex;
         pSyncMsg->privateTerm = 0;
         pSyncMsg->timeStamp = tsNow;
+        pSyncMsg->leaseTime = taosGetMonoTimestampMs();
 
         // update reset time
         int64_t timerElapsed = tsNow - pSyncTimer->timeStamp;
@@ -3075,6 +3247,14 @@ int32_t syncNodeOnHeartbeat(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
     syncIndexMgrSetRecvTime(ths->pNextIndex, &(pMsg->srcId), tsMs);
     resetElect = true;
 
+    atomic_store_64(&ths->leaderTime, taosGetMonoTimestampMs());
+    if (pMsg->bytes >= sizeof(SyncHeartbeat)) {
+      pMsgReply->leaseTime = pMsg->leaseTime;
+      if (pMsg->readSeq > 0) {
+        syncNodeAckReadIndex(ths, pMsg->readSeq, pMsg->commitIndex);
+      }
+    }
+
     ths->minMatchIndex = pMsg->minMatchIndex;
 
     if (ths->state == TAOS_SYNC_STATE_FOLLOWER || ths->state == TAOS_SYNC_STATE_LEARNER) {
@@ -3127,6 +3307,34 @@ int32_t syncNodeOnHeartbeat(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
   return 0;
 }
 
+// answer a read index request with a heartbeat carrying the commit index, only while holding the lease
+static void syncNodeReplyReadIndex(SSyncNode* ths, const SRaftId* pDestId, int64_t readSeq) {
+  if (!syncNodeIsReadyForRead(ths)) {
+    sNTrace(ths, "ignore read index request from dnode:%d since %s, seq:%" PRId64, DID(pDestId), terrstr(), readSeq);
+    return;
+  }
+
+  SRpcMsg rpcMsg = {0};
+  if (syncBuildHeartbeat(&rpcMsg, ths->vgId) != 0) {
+    return;
+  }
+
+  SyncHeartbeat* pSyncMsg = rpcMsg.pCont;
+  pSyncMsg->srcId = ths->myRaftId;
+  pSyncMsg->destId = *pDestId;
+  pSyncMsg->term = raftStoreGetTerm(ths);
+  pSyncMsg->commitIndex = ths->commitIndex;
+  pSyncMsg->minMatchIndex = ths->minMatchIndex;
+  pSyncMsg->privateTerm = 0;
+  pSyncMsg->timeStamp = taosGetTimestampMs();
+  pSyncMsg->leaseTime = taosGetMonoTimestampMs();
+  pSyncMsg->readSeq = readSeq;
+
+  sNTrace(ths, "reply read index to dnode:%d, seq:%" PRId64 ", commit index:%" PRId64, DID(pDestId), readSeq,
+          pSyncMsg->commitIndex);
+  syncNodeSendHeartbeat(ths, &pSyncMsg->destId, &rpcMsg);
+}
+
 int32_t syncNodeOnHeartbeatReply(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
   const STraceId* trace = &pRpcMsg->info.traceId;
   char            tbuf[40] = {0};
@@ -3144,6 +3352,17 @@ int32_t syncNodeOnHeartbeatReply(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
 
   syncIndexMgrSetRecvTime(ths->pMatchIndex, &pMsg->srcId, tsMs);
 
+  if (pMsg->bytes >= sizeof(SyncHeartbeatReply) && ths->state == TAOS_SYNC_STATE_LEADER &&
+      pMsg->term == raftStoreGetTerm(ths)) {
+    SPeerState* pState = syncNodeGetPeerState(ths, &pMsg->srcId);
+    if (pState != NULL && pMsg->leaseTime > pState->leaseTime) {
+      atomic_store_64(&pState->leaseTime, pMsg->leaseTime);
+    }
+    if (pMsg->readSeq > 0) {
+      syncNodeReplyReadIndex(ths, &pMsg->srcId, pMsg->readSeq);
+    }
+  }
+
   return syncLogReplProcessHeartbeatReply(pMgr, ths, pMsg);
 }
 
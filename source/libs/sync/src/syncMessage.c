@@ -154,9 +154,13 @@ int32_t syncBuildAppendEntriesReply(SRpcMsg* pMsg, int32_t vgId) {
   return 0;
 }
 
-int32_t syncBuildAppendEntriesFromRaftEntry(SSyncNode* pNode, SSyncRaftEntry* pEntry, SyncTerm prevLogTerm,
-                                            SRpcMsg* pRpcMsg) {
-  uint32_t dataLen = pEntry->bytes;
+int32_t syncBuildAppendEntriesFromRaftEntries(SSyncNode* pNode, SSyncRaftEntry** ppEntries, int32_t numOfEntries,
+                                              SyncTerm prevLogTerm, SRpcMsg* pRpcMsg) {
+  uint32_t dataLen = 0;
+  for (int32_t i = 0; i < numOfEntries; ++i) {
+    ASSERT(i == 0 || ppEntries[i]->index == ppEntries[i - 1]->index + 1);
+    dataLen += ppEntries[i]->bytes;
+  }
   uint32_t bytes = sizeof(SyncAppendEntries) + dataLen;
   pRpcMsg->contLen = bytes;
   pRpcMsg->pCont = rpcMallocCont(pRpcMsg->contLen);
@@ -168,11 +172,17 @@ int32_t syncBuildAppendEntriesFromRaftEntry(SSyncNode* pNode, SSyncRaftEntry* pE
   SyncAppendEntries* pMsg = pRpcMsg->pCont;
   pMsg->bytes = pRpcMsg->contLen;
   pMsg->msgType = pRpcMsg->msgType = TDMT_SYNC_APPEND_ENTRIES;
+  pMsg->numOfEntries = numOfEntries;
   pMsg->dataLen = dataLen;
 
-  (void)memcpy(pMsg->data, pEntry, dataLen);
+  // entries are packed back to back, each one led by its own length
+  char* pData = pMsg->data;
+  for (int32_t i = 0; i < numOfEntries; ++i) {
+    (void)memcpy(pData, ppEntries[i], ppEntries[i]->bytes);
+    pData += ppEntries[i]->bytes;
+  }
 
-  pMsg->prevLogIndex = pEntry->index - 1;
+  pMsg->prevLogIndex = ppEntries[0]->index - 1;
   pMsg->prevLogTerm = prevLogTerm;
   pMsg->vgId = pNode->vgId;
   pMsg->srcId = pNode->myRaftId;
@@ -182,6 +192,11 @@ int32_t syncBuildAppendEntriesFromRaftEntry(SSyncNode* pNode, SSyncRaftEntry* pE
   return 0;
 }
 
+int32_t syncBuildAppendEntriesFromRaftEntry(SSyncNode* pNode, SSyncRaftEntry* pEntry, SyncTerm prevLogTerm,
+                                            SRpcMsg* pRpcMsg) {
+  return syncBuildAppendEntriesFromRaftEntries(pNode, &pEntry, 1, prevLogTerm, pRpcMsg);
+}
+
 int32_t syncBuildHeartbeat(SRpcMsg* pMsg, int32_t vgId) {
   int32_t bytes = sizeof(SyncHeartbeat);
   pMsg->pCont = rpcMallocCont(bytes);
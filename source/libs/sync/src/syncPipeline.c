@@ -27,6 +27,7 @@
 #include "syncUtil.h"
 #include "syncRaftCfg.h"
 #include "syncVoteMgr.h"
+#include "tglobal.h"
 
 static bool syncIsMsgBlock(tmsg_t type) {
   return (type == TDMT_VND_CREATE_TABLE) || (type == TDMT_VND_ALTER_TABLE) || (type == TDMT_VND_DROP_TABLE) ||
@@ -436,6 +437,7 @@ int64_t syncLogBufferProceed(SSyncLogBuffer* pBuf, SSyncNode* pNode, SyncTerm* p
 
   SSyncLogStore* pLogStore = pNode->pLogStore;
   int64_t        matchIndex = pBuf->matchIndex;
+  int64_t        prevMatchIndex = matchIndex;
 
   while (pBuf->matchIndex + 1 < pBuf->endIndex) {
     int64_t index = pBuf->matchIndex + 1;
@@ -519,13 +521,18 @@ int64_t syncLogBufferProceed(SSyncLogBuffer* pBuf, SSyncNode* pNode, SyncTerm* p
 
     ASSERT(pEntry->index == pBuf->matchIndex);
 
-    // update my match index
     matchIndex = pBuf->matchIndex;
-    syncIndexMgrSetIndex(pNode->pMatchIndex, &pNode->myRaftId, pBuf->matchIndex);
   }  // end of while
 
 _out:
   pBuf->matchIndex = matchIndex;
+  if (matchIndex > prevMatchIndex) {
+    // group commit: the entries persisted above share one fsync, done before they count toward the quorum
+    pLogStore->syncLogFlush(pLogStore);
+
+    // update my match index
+    syncIndexMgrSetIndex(pNode->pMatchIndex, &pNode->myRaftId, matchIndex);
+  }
   if (pMatchTerm) {
     *pMatchTerm = pBuf->entries[(matchIndex + pBuf->size) % pBuf->size].pItem->term;
   }
@@ -558,11 +565,28 @@ int32_t syncFsmExecute(SSyncNode* pNode, SSyncFSM* pFsm, ESyncState role, SyncTe
           pEntry->term);
   }
 
-  int32_t code = 0;
-  bool    retry = false;
+  int32_t        code = 0;
+  bool           retry = false;
+  SRpcHandleInfo info = {0};
+  void          *pCont = NULL;
+  (void)syncRespMgrGetAndDelCont(pNode->pSyncRespMgr, pEntry->seqNum, &info, &pCont);
+
+  // an entry proposed by this leader in the current term still has the proposed msg referenced, apply it in place
+  if (role != TAOS_SYNC_STATE_LEADER || pEntry->term != term) {
+    rpcFreeCont(pCont);
+    pCont = NULL;
+  }
+
   do {
-    SRpcMsg rpcMsg = {.code = applyCode};
-    syncEntry2OriginalRpc(pEntry, &rpcMsg);
+    SRpcMsg rpcMsg = {.code = applyCode, .info = info};
+    if (pCont != NULL) {
+      rpcMsg.msgType = pEntry->originalRpcType;
+      rpcMsg.contLen = (int32_t)pEntry->dataLen;
+      rpcMsg.pCont = pCont;
+      pCont = NULL;
+    } else {
+      syncEntry2OriginalRpc(pEntry, &rpcMsg);
+    }
 
     SFsmCbMeta cbMeta = {0};
     cbMeta.index = pEntry->index;
@@ -575,7 +599,6 @@ int32_t syncFsmExecute(SSyncNode* pNode, SSyncFSM* pFsm, ESyncState role, SyncTe
     cbMeta.currentTerm = term;
     cbMeta.flag = -1;
 
-    (void)syncRespMgrGetAndDel(pNode->pSyncRespMgr, cbMeta.seqNum, &rpcMsg.info);
     code = pFsm->FpCommitCb(pFsm, &rpcMsg, &cbMeta);
     retry = (code != 0) && (terrno == TSDB_CODE_OUT_OF_RPC_MEMORY_QUEUE);
     if (retry) {
@@ -992,23 +1015,28 @@ int32_t syncLogReplAttempt(SSyncLogReplMgr* pMgr, SSyncNode* pNode) {
     if (pMgr->startIndex + 1 < index && pMgr->states[(index - 1) % pMgr->size].barrier) {
       break;
     }
-    int64_t  pos = index % pMgr->size;
-    SRaftId* pDestId = &pNode->replicasId[pMgr->peerId];
-    bool     barrier = false;
-    SyncTerm term = -1;
-    if (syncLogReplSendTo(pMgr, pNode, index, &term, pDestId, &barrier) < 0) {
+    SRaftId*  pDestId = &pNode->replicasId[pMgr->peerId];
+    SyncIndex maxIndex = TMIN(pNode->pLogBuf->matchIndex, pMgr->startIndex + limit - 1);
+    SyncIndex lastIndex = index;
+    bool      barrier = false;
+    SyncTerm  term = -1;
+    if (syncLogReplSendBatchTo(pMgr, pNode, index, maxIndex, &lastIndex, &term, pDestId, &barrier) < 0) {
       sError("vgId:%d, failed to replicate log entry since %s. index:%" PRId64 ", dest: 0x%016" PRIx64 "", pNode->vgId,
              terrstr(), index, pDestId->addr);
       return -1;
     }
-    pMgr->states[pos].barrier = barrier;
-    pMgr->states[pos].timeMs = nowMs;
-    pMgr->states[pos].term = term;
-    pMgr->states[pos].acked = false;
+    for (SyncIndex sent = index; sent <= lastIndex; sent++) {
+      int64_t pos = sent % pMgr->size;
+      pMgr->states[pos].barrier = barrier;
+      pMgr->states[pos].timeMs = nowMs;
+      pMgr->states[pos].term = term;
+      pMgr->states[pos].acked = false;
+    }
 
     if (firstIndex == -1) firstIndex = index;
     count++;
 
+    index = lastIndex;
     pMgr->endIndex = index + 1;
     if (barrier) {
       sInfo("vgId:%d, replicated sync barrier to dnode:%d. index:%" PRId64 ", term:%" PRId64 ", repl-mgr:[%" PRId64
@@ -1299,3 +1327,67 @@ _err:
   }
   return -1;
 }
+
+int32_t syncLogReplCollectBatch(SSyncLogBuffer* pBuf, SyncIndex index, SyncIndex maxIndex, SyncTerm prevLogTerm,
+                                int32_t maxBytes, SSyncRaftEntry** ppEntries, int64_t* pBytes) {
+  int32_t numOfEntries = 0;
+  int64_t bytes = 0;
+
+  // only entries still in the log buffer are packed, and a barrier is always sent alone. a follower takes an entry
+  // only if its prev term is the term of its last matched entry, which moves on after the whole msg is accepted,
+  // so all packed entries are of the term of the entry before them and a batch ends at a term change.
+  for (SyncIndex next = index; maxBytes > 0 && next > pBuf->startIndex && next < pBuf->endIndex && next <= maxIndex &&
+                               numOfEntries < SYNC_LOG_REPL_BATCH_NUM;
+       next++) {
+    SSyncRaftEntry* pEntry = pBuf->entries[next % pBuf->size].pItem;
+    if (pEntry == NULL || syncLogReplBarrier(pEntry) || pEntry->term != prevLogTerm) break;
+    if (numOfEntries > 0 && bytes + pEntry->bytes > maxBytes) break;
+    ppEntries[numOfEntries++] = pEntry;
+    bytes += pEntry->bytes;
+  }
+
+  *pBytes = bytes;
+  return numOfEntries;
+}
+
+int32_t syncLogReplSendBatchTo(SSyncLogReplMgr* pMgr, SSyncNode* pNode, SyncIndex index, SyncIndex maxIndex,
+                               SyncIndex* pLastIndex, SyncTerm* pTerm, SRaftId* pDestId, bool* pBarrier) {
+  SSyncRaftEntry* entries[SYNC_LOG_REPL_BATCH_NUM];
+  int32_t         numOfEntries = 0;
+  int64_t         bytes = 0;
+  SRpcMsg         msgOut = {0};
+
+  *pLastIndex = index;
+  if (tsSyncLogReplBatchSize <= 0 || index >= maxIndex) {
+    return syncLogReplSendTo(pMgr, pNode, index, pTerm, pDestId, pBarrier);
+  }
+
+  SyncTerm prevLogTerm = syncLogReplGetPrevLogTerm(pMgr, pNode, index);
+  if (prevLogTerm < 0) {
+    sError("vgId:%d, failed to get prev log term since %s. index:%" PRId64 "", pNode->vgId, terrstr(), index);
+    return -1;
+  }
+
+  numOfEntries = syncLogReplCollectBatch(pNode->pLogBuf, index, maxIndex, prevLogTerm, tsSyncLogReplBatchSize,
+                                         entries, &bytes);
+  if (numOfEntries <= 1) {
+    return syncLogReplSendTo(pMgr, pNode, index, pTerm, pDestId, pBarrier);
+  }
+
+  if (syncBuildAppendEntriesFromRaftEntries(pNode, entries, numOfEntries, prevLogTerm, &msgOut) < 0) {
+    sError("vgId:%d, failed to get append entries for index:%" PRId64 ", num:%d", pNode->vgId, index, numOfEntries);
+    return -1;
+  }
+
+  (void)syncNodeSendAppendEntries(pNode, pDestId, &msgOut);
+
+  *pLastIndex = index + numOfEntries - 1;
+  *pBarrier = false;
+  if (pTerm) *pTerm = entries[numOfEntries - 1]->term;
+
+  sTrace("vgId:%d, replicate %d msgs index:%" PRId64 "-%" PRId64 " term:%" PRId64 " prevterm:%" PRId64
+         " bytes:%" PRId64 " to dest: 0x%016" PRIx64,
+         pNode->vgId, numOfEntries, index, *pLastIndex, entries[numOfEntries - 1]->term, prevLogTerm, bytes,
+         pDestId->addr);
+  return 0;
+}
@@ -63,14 +63,28 @@ SSyncRaftEntry* syncEntryBuildFromRpcMsg(const SRpcMsg* pMsg, SyncTerm term, Syn
   return pEntry;
 }
 
-SSyncRaftEntry* syncEntryBuildFromAppendEntries(const SyncAppendEntries* pMsg) {
-  SSyncRaftEntry* pEntry = taosMemoryMalloc(pMsg->dataLen);
+SSyncRaftEntry* syncEntryBuildFromAppendEntries(const SyncAppendEntries* pMsg, uint32_t* pOffset) {
+  uint32_t offset = *pOffset;
+  uint32_t bytes = 0;
+  if (offset + sizeof(SSyncRaftEntry) > pMsg->dataLen) {
+    terrno = TSDB_CODE_SYN_INTERNAL_ERROR;
+    return NULL;
+  }
+
+  // packed entries are not aligned
+  memcpy(&bytes, pMsg->data + offset, sizeof(bytes));
+  if (bytes < sizeof(SSyncRaftEntry) || bytes > pMsg->dataLen - offset) {
+    terrno = TSDB_CODE_SYN_INTERNAL_ERROR;
+    return NULL;
+  }
+
+  SSyncRaftEntry* pEntry = taosMemoryMalloc(bytes);
   if (pEntry == NULL) {
     terrno = TSDB_CODE_OUT_OF_MEMORY;
     return NULL;
   }
-  memcpy(pEntry, pMsg->data, pMsg->dataLen);
-  ASSERT(pEntry->bytes == pMsg->dataLen);
+  memcpy(pEntry, pMsg->data + offset, bytes);
+  *pOffset = offset + bytes;
   return pEntry;
 }
 
@@ -99,14 +99,16 @@ int32_t syncNodeOnRequestVote(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
   }
 
   bool logOK = syncNodeOnRequestVoteLogOK(ths, pMsg);
+  // leader stickiness: within the lease of the leader heard lately, neither update term nor grant the vote
+  bool sticky = syncNodeIsLeaderSticky(ths);
   // maybe update term
-  if (pMsg->term > raftStoreGetTerm(ths)) {
+  if (pMsg->term > raftStoreGetTerm(ths) && !sticky) {
     syncNodeStepDown(ths, pMsg->term);
   }
   SyncTerm currentTerm = raftStoreGetTerm(ths);
-  ASSERT(pMsg->term <= currentTerm);
+  ASSERT(sticky || pMsg->term <= currentTerm);
 
-  bool grant = (pMsg->term == currentTerm) && logOK &&
+  bool grant = !sticky && (pMsg->term == currentTerm) && logOK &&
                ((!raftStoreHasVoted(ths)) || (syncUtilSameId(&ths->raftStore.voteFor, &pMsg->srcId)));
   if (grant) {
     // maybe has already voted for pMsg->srcId
@@ -134,7 +136,7 @@ int32_t syncNodeOnRequestVote(SSyncNode* ths, const SRpcMsg* pRpcMsg) {
 
   // trace log
   syncLogRecvRequestVote(ths, pMsg, pReply->voteGranted, "");
-  syncLogSendRequestVoteReply(ths, pReply, "");
+  syncLogSendRequestVoteReply(ths, pReply, sticky ? "leader lease" : "");
   syncNodeSendMsgById(&pReply->destId, ths, &rpcMsg);
 
   if (resetElect) syncNodeResetElectTimer(ths);
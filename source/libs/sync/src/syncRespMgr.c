@@ -19,6 +19,12 @@
 #include "syncRaftStore.h"
 #include "syncUtil.h"
 
+static void syncRespStubFree(void *p) {
+  SRespStub *pStub = p;
+  rpcFreeCont(pStub->pCont);
+  pStub->pCont = NULL;
+}
+
 SSyncRespMgr *syncRespMgrCreate(void *data, int64_t ttl) {
   SSyncRespMgr *pObj = taosMemoryCalloc(1, sizeof(SSyncRespMgr));
   if (pObj == NULL) {
@@ -29,6 +35,7 @@ SSyncRespMgr *syncRespMgrCreate(void *data, int64_t ttl) {
   pObj->pRespHash =
       taosHashInit(sizeof(uint64_t), taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_NO_LOCK);
   if (pObj->pRespHash == NULL) return NULL;
+  taosHashSetFreeFp(pObj->pRespHash, syncRespStubFree);
 
   pObj->ttl = ttl;
   pObj->data = data;
@@ -95,11 +102,19 @@ int32_t syncRespMgrGet(SSyncRespMgr *pObj, uint64_t seq, SRespStub *pStub) {
 }
 
 int32_t syncRespMgrGetAndDel(SSyncRespMgr *pObj, uint64_t seq, SRpcHandleInfo *pInfo) {
+  return syncRespMgrGetAndDelCont(pObj, seq, pInfo, NULL);
+}
+
+int32_t syncRespMgrGetAndDelCont(SSyncRespMgr *pObj, uint64_t seq, SRpcHandleInfo *pInfo, void **ppCont) {
   taosThreadMutexLock(&pObj->mutex);
 
   SRespStub *pStub = taosHashGet(pObj->pRespHash, &seq, sizeof(uint64_t));
   if (pStub != NULL) {
     *pInfo = pStub->rpcMsg.info;
+    if (ppCont != NULL) {
+      *ppCont = pStub->pCont;
+      pStub->pCont = NULL;
+    }
     sNTrace(pObj->data, "get-and-del message handle:%p, type:%s seq:%" PRIu64, pStub->rpcMsg.info.handle,
             TMSG_INFO(pStub->rpcMsg.msgType), seq);
     taosHashRemove(pObj->pRespHash, &seq, sizeof(uint64_t));
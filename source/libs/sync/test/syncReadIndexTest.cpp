@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "syncInt.h"
+#include "syncMessage.h"
+#include "tglobal.h"
+
+namespace {
+
+// the read index requests sent to the leader
+std::mutex              sentMutex;
+std::condition_variable sentCond;
+std::vector<int64_t>    sentSeqs;
+
+int32_t recordReadIndex(const SEpSet *pEpSet, SRpcMsg *pMsg) {
+  SyncHeartbeatReply *pReply = (SyncHeartbeatReply *)pMsg->pCont;
+  {
+    std::lock_guard<std::mutex> lock(sentMutex);
+    sentSeqs.push_back(pReply->readSeq);
+  }
+  sentCond.notify_all();
+  rpcFreeCont(pMsg->pCont);
+  return 0;
+}
+
+// the seq of the n-th request, once it is sent
+int64_t waitSent(size_t n) {
+  std::unique_lock<std::mutex> lock(sentMutex);
+  bool sent = sentCond.wait_for(lock, std::chrono::seconds(5), [n]() { return sentSeqs.size() >= n; });
+  return sent ? sentSeqs[n - 1] : -1;
+}
+
+size_t numOfSent() {
+  std::lock_guard<std::mutex> lock(sentMutex);
+  return sentSeqs.size();
+}
+
+class SyncReadIndexEnv : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    oldLease = tsSyncLeaderLease;
+    oldFollowerRead = tsSyncFollowerRead;
+    tsSyncLeaderLease = true;
+    tsSyncFollowerRead = true;
+    sentSeqs.clear();
+
+    pNode = (SSyncNode *)taosMemoryCalloc(1, sizeof(SSyncNode));
+    pNode->vgId = 2;
+    pNode->state = TAOS_SYNC_STATE_FOLLOWER;
+    pNode->myRaftId = {.addr = 2, .vgId = 2};
+    pNode->leaderCache = {.addr = 1, .vgId = 2};
+    pNode->peersNum = 1;
+    pNode->peersId[0] = pNode->leaderCache;
+    pNode->syncSendMSg = recordReadIndex;
+    pNode->readIndex = SYNC_INDEX_INVALID;
+    taosThreadMutexInit(&pNode->raftStore.mutex, NULL);
+    taosThreadMutexInit(&pNode->readMutex, NULL);
+    taosThreadCondInit(&pNode->readCond, NULL);
+  }
+
+  void TearDown() override {
+    taosThreadCondDestroy(&pNode->readCond);
+    taosThreadMutexDestroy(&pNode->readMutex);
+    taosThreadMutexDestroy(&pNode->raftStore.mutex);
+    taosMemoryFree(pNode);
+    tsSyncLeaderLease = oldLease;
+    tsSyncFollowerRead = oldFollowerRead;
+  }
+
+  bool       oldLease;
+  bool       oldFollowerRead;
+  SSyncNode *pNode = NULL;
+};
+
+}  // namespace
+
+// a reader is woken by the answer of the leader, not by polling
+TEST_F(SyncReadIndexEnv, ackWakesReader) {
+  SyncIndex readIndex = SYNC_INDEX_INVALID;
+  int32_t   code = -1;
+  int64_t   startMs = taosGetMonoTimestampMs();
+  int64_t   doneMs = 0;
+
+  std::thread reader([&]() {
+    code = syncNodeReadIndex(pNode, 5000, &readIndex);
+    doneMs = taosGetMonoTimestampMs();
+  });
+  ASSERT_EQ(waitSent(1), 1);
+  syncNodeAckReadIndex(pNode, 1, 42);
+  reader.join();
+
+  EXPECT_EQ(code, 0);
+  EXPECT_EQ(readIndex, 42);
+  EXPECT_LT(doneMs - startMs, 1000);
+  EXPECT_EQ(numOfSent(), 1);
+}
+
+// the reads arriving while a request is in flight share the next one
+TEST_F(SyncReadIndexEnv, batchConcurrentReaders) {
+  const int32_t numOfReaders = 16;
+
+  SyncIndex   firstIndex = SYNC_INDEX_INVALID;
+  std::thread first([&]() { EXPECT_EQ(syncNodeReadIndex(pNode, 5000, &firstIndex), 0); });
+  ASSERT_EQ(waitSent(1), 1);
+
+  std::atomic<int32_t>     numOfDone(0);
+  std::vector<SyncIndex>   indexes(numOfReaders, SYNC_INDEX_INVALID);
+  std::vector<std::thread> readers;
+  for (int32_t i = 0; i < numOfReaders; i++) {
+    readers.emplace_back([&, i]() {
+      EXPECT_EQ(syncNodeReadIndex(pNode, 5000, &indexes[i]), 0);
+      numOfDone++;
+    });
+  }
+
+  // let the readers block behind the request in flight
+  taosMsleep(50);
+  EXPECT_EQ(numOfSent(), 1);
+
+  // the first answer was asked for before the readers came, it confirms only the first read
+  syncNodeAckReadIndex(pNode, 1, 10);
+  first.join();
+  EXPECT_EQ(firstIndex, 10);
+  ASSERT_EQ(waitSent(2), 2);
+  taosMsleep(10);
+  EXPECT_EQ(numOfDone.load(), 0);
+
+  syncNodeAckReadIndex(pNode, 2, 20);
+  for (auto &t : readers) t.join();
+  EXPECT_EQ(numOfDone.load(), numOfReaders);
+  for (SyncIndex index : indexes) EXPECT_EQ(index, 20);
+  EXPECT_EQ(numOfSent(), 2);
+}
+
+// an answer never goes back to an older commit index
+TEST_F(SyncReadIndexEnv, ackIsMonotonic) {
+  syncNodeAckReadIndex(pNode, 3, 30);
+  syncNodeAckReadIndex(pNode, 2, 40);
+  EXPECT_EQ(pNode->readAckSeq, 3);
+  EXPECT_EQ(pNode->readIndex, 30);
+  syncNodeAckReadIndex(pNode, 4, 25);
+  EXPECT_EQ(pNode->readAckSeq, 4);
+  EXPECT_EQ(pNode->readIndex, 30);
+}
+
+// a read times out without an answer, and the next read sends a new request for the lost one
+TEST_F(SyncReadIndexEnv, timeout) {
+  SyncIndex readIndex = 0;
+  int64_t   startMs = taosGetMonoTimestampMs();
+  EXPECT_EQ(syncNodeReadIndex(pNode, 50, &readIndex), -1);
+  EXPECT_GE(taosGetMonoTimestampMs() - startMs, 50);
+  EXPECT_EQ(readIndex, SYNC_INDEX_INVALID);
+  EXPECT_EQ(terrno, TSDB_CODE_SYN_NOT_LEADER);
+  EXPECT_EQ(numOfSent(), 1);
+
+  std::thread reader([&]() { EXPECT_EQ(syncNodeReadIndex(pNode, 5000, &readIndex), 0); });
+  ASSERT_EQ(waitSent(2), 2);
+  syncNodeAckReadIndex(pNode, 2, 7);
+  reader.join();
+  EXPECT_EQ(readIndex, 7);
+}
+
+TEST_F(SyncReadIndexEnv, notFollower) {
+  SyncIndex readIndex = 0;
+  pNode->state = TAOS_SYNC_STATE_CANDIDATE;
+  EXPECT_EQ(syncNodeReadIndex(pNode, 50, &readIndex), -1);
+
+  pNode->state = TAOS_SYNC_STATE_FOLLOWER;
+  tsSyncFollowerRead = false;
+  EXPECT_EQ(syncNodeReadIndex(pNode, 50, &readIndex), -1);
+  EXPECT_EQ(readIndex, SYNC_INDEX_INVALID);
+  EXPECT_EQ(numOfSent(), 0);
+}
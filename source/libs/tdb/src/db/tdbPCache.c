@@ -17,18 +17,37 @@
 // #include <sys/types.h>
 // #include <unistd.h>
 
-struct SPCache {
-  int         szPage;
-  int         nPages;
-  SPage     **aPage;
+/*
+ * The page cache is split into shards by page id hash, each shard owns its own lock, hash table, free list and
+ * CLOCK ring, so lookups of different pages from concurrent readers do not serialize on one mutex. A shard only
+ * borrows a page from the free list of another shard when its own pages are all pinned.
+ *
+ * CLOCK: every local page holding a pgid sits in the ring of its shard, pinned or not. A hit sets the reference bit
+ * of the page instead of moving it in a list; the hand skips pinned pages, clears set bits and evicts the first
+ * unpinned page whose bit is clear.
+ */
+#define TDB_PCACHE_MAX_SHARDS      16
+#define TDB_PCACHE_MIN_SHARD_PAGES 64
+
+typedef struct {
   tdb_mutex_t mutex;
   int         nFree;
   SPage      *pFree;
   int         nPage;
   int         nHash;
   SPage     **pgHash;
-  int         nRecyclable;
-  SPage       lru;
+  int         nClock;
+  SPage       clock;  // anchor of the CLOCK ring
+  SPage      *pHand;
+} SPCacheShard;
+
+struct SPCache {
+  int           szPage;
+  int           nPages;
+  SPage       **aPage;
+  tdb_mutex_t   mutex;  // serialize tdbPCacheAlter
+  int           nShards;
+  SPCacheShard *aShard;
 };
 
 static inline uint32_t tdbPCachePageHash(const SPgid *pPgid) {
@@ -36,11 +55,16 @@ static inline uint32_t tdbPCachePageHash(const SPgid *pPgid) {
   return (uint32_t)(t[0] + t[1] + t[2] + t[3] + t[4] + t[5] + (pPgid)->pgno);
 }
 
+#define TDB_PCACHE_SHARD_OF(pCache, h) ((h) % (pCache)->nShards)
+#define TDB_PCACHE_BUCKET_OF(pCache, pShard, h) (((h) / (pCache)->nShards) % (pShard)->nHash)
+
 static int    tdbPCacheOpenImpl(SPCache *pCache);
-static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn);
-static void   tdbPCachePinPage(SPCache *pCache, SPage *pPage);
+static SPage *tdbPCacheFetchImpl(SPCache *pCache, int iShard, const SPgid *pPgid, TXN *pTxn);
 static void   tdbPCacheRemovePageFromHash(SPCache *pCache, SPage *pPage);
 static void   tdbPCacheAddPageToHash(SPCache *pCache, SPage *pPage);
+static void   tdbPCacheAddPageToClock(SPCacheShard *pShard, SPage *pPage);
+static void   tdbPCacheRemovePageFromClock(SPCacheShard *pShard, SPage *pPage);
+static SPage *tdbPCacheEvictPage(SPCache *pCache, SPCacheShard *pShard);
 static void   tdbPCacheUnpinPage(SPCache *pCache, SPage *pPage);
 static int    tdbPCacheCloseImpl(SPCache *pCache);
 
@@ -48,13 +72,15 @@ static void tdbPCacheInitLock(SPCache *pCache) { tdbMutexInit(&(pCache->mutex),
 static void tdbPCacheDestroyLock(SPCache *pCache) { tdbMutexDestroy(&(pCache->mutex)); }
 static void tdbPCacheLock(SPCache *pCache) { tdbMutexLock(&(pCache->mutex)); }
 static void tdbPCacheUnlock(SPCache *pCache) { tdbMutexUnlock(&(pCache->mutex)); }
+static void tdbPCacheLockShard(SPCacheShard *pShard) { tdbMutexLock(&(pShard->mutex)); }
+static void tdbPCacheUnlockShard(SPCacheShard *pShard) { tdbMutexUnlock(&(pShard->mutex)); }
 
 int tdbPCacheOpen(int pageSize, int cacheSize, SPCache **ppCache) {
   SPCache *pCache;
   void    *pPtr;
   SPage   *pPgHdr;
 
-  pCache = (SPCache *)tdbOsCalloc(1, sizeof(*pCache) + sizeof(SPage *) * cacheSize);
+  pCache = (SPCache *)tdbOsCalloc(1, sizeof(*pCache));
   if (pCache == NULL) {
     return -1;
   }
@@ -67,7 +93,20 @@ int tdbPCacheOpen(int pageSize, int cacheSize, SPCache **ppCache) {
     return -1;
   }
 
+  // small caches keep a single shard, so that a cursor stack never runs out of pages in one shard
+  pCache->nShards = cacheSize / TDB_PCACHE_MIN_SHARD_PAGES;
+  if (pCache->nShards > TDB_PCACHE_MAX_SHARDS) pCache->nShards = TDB_PCACHE_MAX_SHARDS;
+  if (pCache->nShards < 1) pCache->nShards = 1;
+  pCache->aShard = (SPCacheShard *)tdbOsCalloc(pCache->nShards, sizeof(SPCacheShard));
+  if (pCache->aShard == NULL) {
+    tdbOsFree(pCache->aPage);
+    tdbOsFree(pCache);
+    return -1;
+  }
+
   if (tdbPCacheOpenImpl(pCache) < 0) {
+    tdbOsFree(pCache->aShard);
+    tdbOsFree(pCache->aPage);
     tdbOsFree(pCache);
     return -1;
   }
@@ -79,12 +118,34 @@ int tdbPCacheOpen(int pageSize, int cacheSize, SPCache **ppCache) {
 int tdbPCacheClose(SPCache *pCache) {
   if (pCache) {
     tdbPCacheCloseImpl(pCache);
+    tdbOsFree(pCache->aShard);
     tdbOsFree(pCache->aPage);
     tdbOsFree(pCache);
   }
   return 0;
 }
 
+static void tdbPCacheInitLocalPage(SPage *pPage, int32_t id) {
+  // pPage->pgid = 0;
+  pPage->isAnchor = 0;
+  pPage->isLocal = 1;
+  pPage->isRef = 0;
+  pPage->nRef = 0;
+  pPage->pHashNext = NULL;
+  pPage->pClockNext = NULL;
+  pPage->pClockPrev = NULL;
+  pPage->pDirtyNext = NULL;
+
+  // add to local list
+  pPage->id = id;
+}
+
+static void tdbPCacheAddPageToFree(SPCacheShard *pShard, SPage *pPage) {
+  pPage->pFreeNext = pShard->pFree;
+  pShard->pFree = pPage;
+  pShard->nFree++;
+}
+
 // TODO:
 // if (pPage->id >= pCache->nPages) {
 //   free(pPage);
@@ -109,24 +170,13 @@ static int tdbPCacheAlterImpl(SPCache *pCache, int32_t nPage) {
         return -1;
       }
 
-      // pPage->pgid = 0;
-      aPage[iPage]->isAnchor = 0;
-      aPage[iPage]->isLocal = 1;
-      aPage[iPage]->nRef = 0;
-      aPage[iPage]->pHashNext = NULL;
-      aPage[iPage]->pLruNext = NULL;
-      aPage[iPage]->pLruPrev = NULL;
-      aPage[iPage]->pDirtyNext = NULL;
-
-      // add to local list
-      aPage[iPage]->id = iPage;
+      tdbPCacheInitLocalPage(aPage[iPage], iPage);
     }
 
-    // add page to free list
+    // add page to free list, spread over the shards
     for (int32_t iPage = pCache->nPages; iPage < nPage; iPage++) {
-      aPage[iPage]->pFreeNext = pCache->pFree;
-      pCache->pFree = aPage[iPage];
-      pCache->nFree++;
+      aPage[iPage]->iShard = iPage % pCache->nShards;
+      tdbPCacheAddPageToFree(&pCache->aShard[aPage[iPage]->iShard], aPage[iPage]);
     }
 
     for (int32_t iPage = 0; iPage < pCache->nPages; iPage++) {
@@ -136,17 +186,21 @@ static int tdbPCacheAlterImpl(SPCache *pCache, int32_t nPage) {
     tdbOsFree(pCache->aPage);
     pCache->aPage = aPage;
   } else {
-    for (SPage **ppPage = &pCache->pFree; *ppPage;) {
-      int32_t iPage = (*ppPage)->id;
-
-      if (iPage >= nPage) {
-        SPage *pPage = *ppPage;
-        *ppPage = pPage->pFreeNext;
-        pCache->aPage[pPage->id] = NULL;
-        tdbPageDestroy(pPage, tdbDefaultFree, NULL);
-        pCache->nFree--;
-      } else {
-        ppPage = &(*ppPage)->pFreeNext;
+    for (int32_t iShard = 0; iShard < pCache->nShards; iShard++) {
+      SPCacheShard *pShard = &pCache->aShard[iShard];
+
+      for (SPage **ppPage = &pShard->pFree; *ppPage;) {
+        int32_t iPage = (*ppPage)->id;
+
+        if (iPage >= nPage) {
+          SPage *pPage = *ppPage;
+          *ppPage = pPage->pFreeNext;
+          pCache->aPage[pPage->id] = NULL;
+          tdbPageDestroy(pPage, tdbDefaultFree, NULL);
+          pShard->nFree--;
+        } else {
+          ppPage = &(*ppPage)->pFreeNext;
+        }
       }
     }
   }
@@ -159,26 +213,34 @@ int tdbPCacheAlter(SPCache *pCache, int32_t nPage) {
   int ret = 0;
 
   tdbPCacheLock(pCache);
+  for (int32_t iShard = 0; iShard < pCache->nShards; iShard++) {
+    tdbPCacheLockShard(&pCache->aShard[iShard]);
+  }
 
   ret = tdbPCacheAlterImpl(pCache, nPage);
 
+  for (int32_t iShard = pCache->nShards - 1; iShard >= 0; iShard--) {
+    tdbPCacheUnlockShard(&pCache->aShard[iShard]);
+  }
   tdbPCacheUnlock(pCache);
 
   return ret;
 }
 
 SPage *tdbPCacheFetch(SPCache *pCache, const SPgid *pPgid, TXN *pTxn) {
-  SPage *pPage;
-  i32    nRef = 0;
+  SPage        *pPage;
+  i32           nRef = 0;
+  int           iShard = TDB_PCACHE_SHARD_OF(pCache, tdbPCachePageHash(pPgid));
+  SPCacheShard *pShard = &pCache->aShard[iShard];
 
-  tdbPCacheLock(pCache);
+  tdbPCacheLockShard(pShard);
 
-  pPage = tdbPCacheFetchImpl(pCache, pPgid, pTxn);
+  pPage = tdbPCacheFetchImpl(pCache, iShard, pPgid, pTxn);
   if (pPage) {
     nRef = tdbRefPage(pPage);
   }
 
-  tdbPCacheUnlock(pCache);
+  tdbPCacheUnlockShard(pShard);
 
   // printf("thread %" PRId64 " fetch page %d pgno %d pPage %p nRef %d\n", taosGetSelfPthreadId(), pPage->id,
   //        TDB_PAGE_PGNO(pPage), pPage, nRef);
@@ -193,18 +255,21 @@ SPage *tdbPCacheFetch(SPCache *pCache, const SPgid *pPgid, TXN *pTxn) {
 }
 
 void tdbPCacheMarkFree(SPCache *pCache, SPage *pPage) {
-  tdbPCacheLock(pCache);
+  SPCacheShard *pShard = &pCache->aShard[pPage->iShard];
+
+  tdbPCacheLockShard(pShard);
   tdbPCacheRemovePageFromHash(pCache, pPage);
   pPage->isFree = 1;
-  tdbPCacheUnlock(pCache);
+  tdbPCacheUnlockShard(pShard);
 }
 
 static void tdbPCacheFreePage(SPCache *pCache, SPage *pPage) {
+  SPCacheShard *pShard = &pCache->aShard[pPage->iShard];
+
+  tdbPCacheRemovePageFromClock(pShard, pPage);
   if (pPage->id < pCache->nPages) {
-    pPage->pFreeNext = pCache->pFree;
-    pCache->pFree = pPage;
     pPage->isFree = 0;
-    ++pCache->nFree;
+    tdbPCacheAddPageToFree(pShard, pPage);
     tdbTrace("pcache/free page %p/%d, pgno:%d, ", pPage, pPage->id, TDB_PAGE_PGNO(pPage));
   } else {
     tdbTrace("pcache/free2 page: %p/%d, pgno:%d, ", pPage, pPage->id, TDB_PAGE_PGNO(pPage));
@@ -215,41 +280,49 @@ static void tdbPCacheFreePage(SPCache *pCache, SPage *pPage) {
 }
 
 void tdbPCacheInvalidatePage(SPCache *pCache, SPager *pPager, SPgno pgno) {
-  SPgid        pgid;
-  const SPgid *pPgid = &pgid;
-  SPage       *pPage = NULL;
+  SPgid         pgid;
+  const SPgid  *pPgid = &pgid;
+  SPage        *pPage = NULL;
+  uint32_t      h;
+  SPCacheShard *pShard;
 
   memcpy(&pgid, pPager->fid, TDB_FILE_ID_LEN);
   pgid.pgno = pgno;
 
-  pPage = pCache->pgHash[tdbPCachePageHash(pPgid) % pCache->nHash];
+  h = tdbPCachePageHash(pPgid);
+  pShard = &pCache->aShard[TDB_PCACHE_SHARD_OF(pCache, h)];
+
+  tdbPCacheLockShard(pShard);
+
+  pPage = pShard->pgHash[TDB_PCACHE_BUCKET_OF(pCache, pShard, h)];
   while (pPage) {
     if (pPage->pgid.pgno == pPgid->pgno && memcmp(pPage->pgid.fileid, pPgid->fileid, TDB_FILE_ID_LEN) == 0) break;
     pPage = pPage->pHashNext;
   }
 
   if (pPage) {
-    bool moveToFreeList = false;
-    if (pPage->pLruNext) {
-      tdbPCachePinPage(pCache, pPage);
-      moveToFreeList = true;
-    }
     tdbPCacheRemovePageFromHash(pCache, pPage);
-    if (moveToFreeList) {
+    // a pinned page is recycled by the CLOCK hand once it is released
+    if (pPage->isLocal && tdbGetPageRef(pPage) == 0) {
       tdbPCacheFreePage(pCache, pPage);
     }
   }
+
+  tdbPCacheUnlockShard(pShard);
 }
 
 void tdbPCacheRelease(SPCache *pCache, SPage *pPage, TXN *pTxn) {
-  i32 nRef;
+  i32           nRef;
+  SPCacheShard *pShard;
 
   if (!pTxn) {
     tdbError("tdb/pcache: null ptr pTxn, release failed.");
     return;
   }
 
-  tdbPCacheLock(pCache);
+  pShard = &pCache->aShard[pPage->iShard];
+
+  tdbPCacheLockShard(pShard);
   nRef = tdbUnrefPage(pPage);
   tdbTrace("pcache/release page %p/%d/%d/%d", pPage, TDB_PAGE_PGNO(pPage), pPage->id, nRef);
   if (nRef == 0) {
@@ -273,15 +346,39 @@ void tdbPCacheRelease(SPCache *pCache, SPage *pPage, TXN *pTxn) {
     }
     // }
   }
-  tdbPCacheUnlock(pCache);
+  tdbPCacheUnlockShard(pShard);
 }
 
 int tdbPCacheGetPageSize(SPCache *pCache) { return pCache->szPage; }
 
-static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn) {
-  int    ret = 0;
+// borrow a free or evictable page from the other shards, never blocks on their locks
+static SPage *tdbPCacheStealPage(SPCache *pCache, int iShard) {
   SPage *pPage = NULL;
-  SPage *pPageH = NULL;
+
+  for (int i = 1; i < pCache->nShards && pPage == NULL; i++) {
+    SPCacheShard *pShard = &pCache->aShard[(iShard + i) % pCache->nShards];
+
+    if (tdbMutexTryLock(&pShard->mutex) != 0) continue;
+
+    if (pShard->pFree) {
+      pPage = pShard->pFree;
+      pShard->pFree = pPage->pFreeNext;
+      pShard->nFree--;
+    } else {
+      pPage = tdbPCacheEvictPage(pCache, pShard);
+    }
+
+    tdbPCacheUnlockShard(pShard);
+  }
+
+  return pPage;
+}
+
+static SPage *tdbPCacheFetchImpl(SPCache *pCache, int iShard, const SPgid *pPgid, TXN *pTxn) {
+  int           ret = 0;
+  SPage        *pPage = NULL;
+  SPage        *pPageH = NULL;
+  SPCacheShard *pShard = &pCache->aShard[iShard];
 
   if (!pTxn) {
     tdbError("tdb/pcache: null ptr pTxn, fetch impl failed.");
@@ -289,7 +386,7 @@ static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn)
   }
 
   // 1. Search the hash table
-  pPage = pCache->pgHash[tdbPCachePageHash(pPgid) % pCache->nHash];
+  pPage = pShard->pgHash[TDB_PCACHE_BUCKET_OF(pCache, pShard, tdbPCachePageHash(pPgid))];
   while (pPage) {
     if (pPage->pgid.pgno == pPgid->pgno && memcmp(pPage->pgid.fileid, pPgid->fileid, TDB_FILE_ID_LEN) == 0) break;
     pPage = pPage->pHashNext;
@@ -297,7 +394,7 @@ static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn)
 
   if (pPage) {
     if (pPage->isLocal || TDB_TXN_IS_WRITE(pTxn)) {
-      tdbPCachePinPage(pCache, pPage);
+      pPage->isRef = 1;
       return pPage;
     }
   }
@@ -308,21 +405,28 @@ static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn)
   pPage = NULL;
 
   // 2. Try to allocate a new page from the free list
-  if (pCache->pFree) {
-    pPage = pCache->pFree;
-    pCache->pFree = pPage->pFreeNext;
-    pCache->nFree--;
-    pPage->pLruNext = NULL;
+  if (pShard->pFree) {
+    pPage = pShard->pFree;
+    pShard->pFree = pPage->pFreeNext;
+    pShard->nFree--;
   }
 
   // 3. Try to Recycle a page
-  if (!pPage && !pCache->lru.pLruPrev->isAnchor) {
-    pPage = pCache->lru.pLruPrev;
-    tdbPCacheRemovePageFromHash(pCache, pPage);
-    tdbPCachePinPage(pCache, pPage);
+  if (!pPage) {
+    pPage = tdbPCacheEvictPage(pCache, pShard);
   }
 
-  // 4. Try a create new page
+  // 4. Try to borrow a page from another shard
+  if (!pPage) {
+    pPage = tdbPCacheStealPage(pCache, iShard);
+  }
+
+  if (pPage) {
+    pPage->iShard = iShard;
+    pPage->isRef = 0;
+  }
+
+  // 5. Try a create new page
   if (!pPage && pTxn->xMalloc != NULL) {
     ret = tdbPageCreate(pCache->szPage, &pPage, pTxn->xMalloc, pTxn->xArg);
     if (ret < 0 || pPage == NULL) {
@@ -334,11 +438,15 @@ static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn)
     // init the page fields
     pPage->isAnchor = 0;
     pPage->isLocal = 0;
+    pPage->isRef = 0;
+    pPage->iShard = iShard;
     pPage->nRef = 0;
     pPage->id = -1;
+    pPage->pClockNext = NULL;
+    pPage->pClockPrev = NULL;
   }
 
-  // 5. Page here are just created from a free list
+  // 6. Page here are just created from a free list
   // or by recycling or allocated streesly,
   // need to initialize it
   if (pPage) {
@@ -354,7 +462,6 @@ static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn)
         }
       }
 
-      pPage->pLruNext = NULL;
       pPage->pPager = pPageH->pPager;
 
       memcpy(pPage->pData, pPageH->pData, pPage->pageSize);
@@ -367,37 +474,74 @@ static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn)
       pPage->minLocal = pPageH->minLocal;
     } else {
       memcpy(&(pPage->pgid), pPgid, sizeof(*pPgid));
-      pPage->pLruNext = NULL;
       pPage->pPager = NULL;
 
       if (pPage->isLocal || TDB_TXN_IS_WRITE(pTxn)) {
         tdbPCacheAddPageToHash(pCache, pPage);
       }
     }
+
+    if (pPage->isLocal) {
+      tdbPCacheAddPageToClock(pShard, pPage);
+    }
   }
 
   return pPage;
 }
 
-static void tdbPCachePinPage(SPCache *pCache, SPage *pPage) {
-  if (pPage->pLruNext != NULL) {
-    int32_t nRef = tdbGetPageRef(pPage);
-    if (nRef != 0) {
-      tdbError("tdb/pcache: pin page's ref not zero: %" PRId32, nRef);
-      return;
-    }
+static void tdbPCacheAddPageToClock(SPCacheShard *pShard, SPage *pPage) {
+  if (pPage->pClockNext != NULL) return;
+
+  // insert right behind the hand, the hand reaches it last
+  pPage->pClockNext = pShard->pHand;
+  pPage->pClockPrev = pShard->pHand->pClockPrev;
+  pPage->pClockPrev->pClockNext = pPage;
+  pShard->pHand->pClockPrev = pPage;
 
-    pPage->pLruPrev->pLruNext = pPage->pLruNext;
-    pPage->pLruNext->pLruPrev = pPage->pLruPrev;
-    pPage->pLruNext = NULL;
+  pShard->nClock++;
+}
 
-    pCache->nRecyclable--;
+static void tdbPCacheRemovePageFromClock(SPCacheShard *pShard, SPage *pPage) {
+  if (pPage->pClockNext == NULL) return;
 
-    tdbTrace("pcache/pin page %p/%d, pgno:%d, ", pPage, pPage->id, TDB_PAGE_PGNO(pPage));
+  if (pShard->pHand == pPage) {
+    pShard->pHand = pPage->pClockNext;
   }
+
+  pPage->pClockPrev->pClockNext = pPage->pClockNext;
+  pPage->pClockNext->pClockPrev = pPage->pClockPrev;
+  pPage->pClockNext = NULL;
+  pPage->pClockPrev = NULL;
+
+  pShard->nClock--;
+}
+
+static SPage *tdbPCacheEvictPage(SPCache *pCache, SPCacheShard *pShard) {
+  // two rounds are enough: the first one clears all reference bits
+  for (int nStep = 2 * (pShard->nClock + 1); nStep > 0; nStep--) {
+    SPage *pPage = pShard->pHand;
+
+    pShard->pHand = pPage->pClockNext;
+    if (pPage->isAnchor || tdbGetPageRef(pPage) > 0) continue;
+
+    if (pPage->isRef) {
+      pPage->isRef = 0;
+      continue;
+    }
+
+    tdbPCacheRemovePageFromClock(pShard, pPage);
+    tdbPCacheRemovePageFromHash(pCache, pPage);
+
+    tdbTrace("pcache/evict page %p/%d, pgno:%d, ", pPage, pPage->id, TDB_PAGE_PGNO(pPage));
+    return pPage;
+  }
+
+  return NULL;
 }
 
 static void tdbPCacheUnpinPage(SPCache *pCache, SPage *pPage) {
+  SPCacheShard *pShard = &pCache->aShard[pPage->iShard];
+
   i32 nRef = tdbGetPageRef(pPage);
   if (nRef != 0) {
     tdbError("tdb/pcache: unpin page's ref not zero: %" PRId32, nRef);
@@ -411,41 +555,35 @@ static void tdbPCacheUnpinPage(SPCache *pCache, SPage *pPage) {
     tdbError("tdb/pcache: unpin page's dirty: %" PRIu8, pPage->isDirty);
     return;
   }
-  if (NULL != pPage->pLruNext) {
-    tdbError("tdb/pcache: unpin page's pLruNext not null.");
-    return;
-  }
 
   tdbTrace("pCache:%p unpin page %p/%d, nPages:%d, pgno:%d, ", pCache, pPage, pPage->id, pCache->nPages,
            TDB_PAGE_PGNO(pPage));
   if (pPage->id < pCache->nPages) {
-    pPage->pLruPrev = &(pCache->lru);
-    pPage->pLruNext = pCache->lru.pLruNext;
-    pCache->lru.pLruNext->pLruPrev = pPage;
-    pCache->lru.pLruNext = pPage;
-
-    pCache->nRecyclable++;
+    // an unpinned page is only reclaimed by the CLOCK hand
+    tdbPCacheAddPageToClock(pShard, pPage);
 
     // printf("unpin page %d pgno %d pPage %p\n", pPage->id, TDB_PAGE_PGNO(pPage), pPage);
     tdbTrace("pcache/unpin page %p/%d/%d", pPage, TDB_PAGE_PGNO(pPage), pPage->id);
   } else {
     tdbTrace("pcache destroy page: %p/%d/%d", pPage, TDB_PAGE_PGNO(pPage), pPage->id);
 
+    tdbPCacheRemovePageFromClock(pShard, pPage);
     tdbPCacheRemovePageFromHash(pCache, pPage);
     tdbPageDestroy(pPage, tdbDefaultFree, NULL);
   }
 }
 
 static void tdbPCacheRemovePageFromHash(SPCache *pCache, SPage *pPage) {
-  uint32_t h = tdbPCachePageHash(&(pPage->pgid)) % pCache->nHash;
+  SPCacheShard *pShard = &pCache->aShard[pPage->iShard];
+  uint32_t      h = TDB_PCACHE_BUCKET_OF(pCache, pShard, tdbPCachePageHash(&(pPage->pgid)));
 
-  SPage **ppPage = &(pCache->pgHash[h]);
+  SPage **ppPage = &(pShard->pgHash[h]);
   for (; (*ppPage) && *ppPage != pPage; ppPage = &((*ppPage)->pHashNext))
     ;
 
   if (*ppPage) {
     *ppPage = pPage->pHashNext;
-    pCache->nPage--;
+    pShard->nPage--;
     // printf("rmv page %d to hash, pgno %d, pPage %p\n", pPage->id, TDB_PAGE_PGNO(pPage), pPage);
   }
 
@@ -453,12 +591,13 @@ static void tdbPCacheRemovePageFromHash(SPCache *pCache, SPage *pPage) {
 }
 
 static void tdbPCacheAddPageToHash(SPCache *pCache, SPage *pPage) {
-  uint32_t h = tdbPCachePageHash(&(pPage->pgid)) % pCache->nHash;
+  SPCacheShard *pShard = &pCache->aShard[pPage->iShard];
+  uint32_t      h = TDB_PCACHE_BUCKET_OF(pCache, pShard, tdbPCachePageHash(&(pPage->pgid)));
 
-  pPage->pHashNext = pCache->pgHash[h];
-  pCache->pgHash[h] = pPage;
+  pPage->pHashNext = pShard->pgHash[h];
+  pShard->pgHash[h] = pPage;
 
-  pCache->nPage++;
+  pShard->nPage++;
 
   tdbTrace("pcache/add page %p/%d to hash %" PRIu32 " pgno:%d, ", pPage, pPage->id, h, TDB_PAGE_PGNO(pPage));
 }
@@ -471,69 +610,90 @@ static int tdbPCacheOpenImpl(SPCache *pCache) {
 
   tdbPCacheInitLock(pCache);
 
-  // Open the free list
-  pCache->nFree = 0;
-  pCache->pFree = NULL;
+  for (int iShard = 0; iShard < pCache->nShards; iShard++) {
+    SPCacheShard *pShard = &pCache->aShard[iShard];
+    int           nShardPages = pCache->nPages / pCache->nShards + 1;
+
+    tdbMutexInit(&(pShard->mutex), NULL);
+
+    // Open the free list
+    pShard->nFree = 0;
+    pShard->pFree = NULL;
+
+    // Open the hash table
+    pShard->nPage = 0;
+    pShard->nHash = nShardPages < 8 ? 8 : nShardPages;
+    pShard->pgHash = (SPage **)tdbOsCalloc(pShard->nHash, sizeof(SPage *));
+    if (pShard->pgHash == NULL) {
+      // unwind the shards opened so far
+      tdbMutexDestroy(&(pShard->mutex));
+      while (--iShard >= 0) {
+        tdbOsFree(pCache->aShard[iShard].pgHash);
+        tdbMutexDestroy(&(pCache->aShard[iShard].mutex));
+      }
+      tdbPCacheDestroyLock(pCache);
+      return -1;
+    }
+
+    // Open CLOCK ring
+    pShard->nClock = 0;
+    pShard->clock.isAnchor = 1;
+    pShard->clock.pClockNext = &(pShard->clock);
+    pShard->clock.pClockPrev = &(pShard->clock);
+    pShard->pHand = &(pShard->clock);
+  }
+
   for (int i = 0; i < pCache->nPages; i++) {
     if (tdbPageCreate(pCache->szPage, &pPage, tdbDefaultMalloc, NULL) < 0) {
-      // TODO: handle error
+      // every shard is open and the pages created so far are on their free lists
+      tdbPCacheCloseImpl(pCache);
       return -1;
     }
 
-    // pPage->pgid = 0;
-    pPage->isAnchor = 0;
-    pPage->isLocal = 1;
-    pPage->nRef = 0;
-    pPage->pHashNext = NULL;
-    pPage->pLruNext = NULL;
-    pPage->pLruPrev = NULL;
-    pPage->pDirtyNext = NULL;
+    tdbPCacheInitLocalPage(pPage, i);
 
     // add page to free list
-    pPage->pFreeNext = pCache->pFree;
-    pCache->pFree = pPage;
-    pCache->nFree++;
+    pPage->iShard = i % pCache->nShards;
+    tdbPCacheAddPageToFree(&pCache->aShard[pPage->iShard], pPage);
 
-    // add to local list
-    pPage->id = i;
     pCache->aPage[i] = pPage;
   }
 
-  // Open the hash table
-  pCache->nPage = 0;
-  pCache->nHash = pCache->nPages < 8 ? 8 : pCache->nPages;
-  pCache->pgHash = (SPage **)tdbOsCalloc(pCache->nHash, sizeof(SPage *));
-  if (pCache->pgHash == NULL) {
-    // TODO
-    return -1;
-  }
-
-  // Open LRU list
-  pCache->nRecyclable = 0;
-  pCache->lru.isAnchor = 1;
-  pCache->lru.pLruNext = &(pCache->lru);
-  pCache->lru.pLruPrev = &(pCache->lru);
-
   return 0;
 }
 
 static int tdbPCacheCloseImpl(SPCache *pCache) {
-  // free free page
-  for (SPage *pPage = pCache->pFree; pPage;) {
-    SPage *pPageT = pPage->pFreeNext;
-    tdbPageDestroy(pPage, tdbDefaultFree, NULL);
-    pPage = pPageT;
-  }
+  for (int iShard = 0; iShard < pCache->nShards; iShard++) {
+    SPCacheShard *pShard = &pCache->aShard[iShard];
+
+    // free free page
+    for (SPage *pPage = pShard->pFree; pPage;) {
+      SPage *pPageT = pPage->pFreeNext;
+      tdbPageDestroy(pPage, tdbDefaultFree, NULL);
+      pPage = pPageT;
+    }
+
+    // pages both in the hash table and the ring are freed with the ring
+    for (int32_t iBucket = 0; iBucket < pShard->nHash; iBucket++) {
+      for (SPage *pPage = pShard->pgHash[iBucket]; pPage;) {
+        SPage *pPageT = pPage->pHashNext;
+        if (pPage->pClockNext == NULL) {
+          tdbPageDestroy(pPage, tdbDefaultFree, NULL);
+        }
+        pPage = pPageT;
+      }
+    }
 
-  for (int32_t iBucket = 0; iBucket < pCache->nHash; iBucket++) {
-    for (SPage *pPage = pCache->pgHash[iBucket]; pPage;) {
-      SPage *pPageT = pPage->pHashNext;
+    for (SPage *pPage = pShard->clock.pClockNext; !pPage->isAnchor;) {
+      SPage *pPageT = pPage->pClockNext;
       tdbPageDestroy(pPage, tdbDefaultFree, NULL);
       pPage = pPageT;
     }
+
+    tdbOsFree(pShard->pgHash);
+    tdbMutexDestroy(&(pShard->mutex));
   }
 
-  tdbOsFree(pCache->pgHash);
   tdbPCacheDestroyLock(pCache);
   return 0;
 }
@@ -205,19 +205,21 @@ int tdbPagerRestoreJournals(SPager *pPager);
 int tdbPagerRollback(SPager *pPager);
 
 // tdbPCache.c ====================================
-#define TDB_PCACHE_PAGE    \
-  u8           isAnchor;   \
-  u8           isLocal;    \
-  u8           isDirty;    \
-  u8           isFree;     \
-  volatile i32 nRef;       \
-  i32          id;         \
-  SPage       *pFreeNext;  \
-  SPage       *pHashNext;  \
-  SPage       *pLruNext;   \
-  SPage       *pLruPrev;   \
-  SPage       *pDirtyNext; \
-  SPager      *pPager;     \
+#define TDB_PCACHE_PAGE     \
+  u8           isAnchor;    \
+  u8           isLocal;     \
+  u8           isDirty;     \
+  u8           isFree;      \
+  u8           isRef;       \
+  u8           iShard;      \
+  volatile i32 nRef;        \
+  i32          id;          \
+  SPage       *pFreeNext;   \
+  SPage       *pHashNext;   \
+  SPage       *pClockNext;  \
+  SPage       *pClockPrev;  \
+  SPage       *pDirtyNext;  \
+  SPager      *pPager;      \
   SPgid        pgid;
 
 // For page ref
@@ -84,6 +84,7 @@ typedef TdThreadMutex tdb_mutex_t;
 #define tdbMutexDestroy taosThreadMutexDestroy
 #define tdbMutexLock    taosThreadMutexLock
 #define tdbMutexUnlock  taosThreadMutexUnlock
+#define tdbMutexTryLock taosThreadMutexTryLock
 
 #else
 
@@ -142,6 +143,7 @@ typedef pthread_mutex_t tdb_mutex_t;
 #define tdbMutexDestroy pthread_mutex_destroy
 #define tdbMutexLock    pthread_mutex_lock
 #define tdbMutexUnlock  pthread_mutex_unlock
+#define tdbMutexTryLock pthread_mutex_trylock
 
 #endif
 
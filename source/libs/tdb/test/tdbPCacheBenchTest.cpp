@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#define ALLOW_FORBID_FUNC
+#include "os.h"
+#include "tdb.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "tlog.h"
+
+// concurrent point lookups through the page cache, the readers used to serialize on one cache mutex
+
+static void *benchMalloc(void *arg, size_t size) { return taosMemoryMalloc(size); }
+static void  benchFree(void *arg, void *ptr) { taosMemoryFree(ptr); }
+
+static const int nBenchData = 200000;
+static const int nBenchOps = 200000;
+
+static int benchKey(char *buf, int i) { return sprintf(buf, "key%08d", i); }
+static int benchVal(char *buf, int i) { return sprintf(buf, "value%08d", i); }
+
+static TDB *openBenchDb(int nPages, TTB **ppDb) {
+  TDB *pEnv = NULL;
+  TXN *txn = NULL;
+  char key[64];
+  char val[64];
+
+  taosRemoveDir("tdb_pcache_bench");
+  if (tdbOpen("tdb_pcache_bench", 4096, nPages, &pEnv, 0) < 0) return NULL;
+  if (tdbTbOpen("bench.db", -1, -1, NULL, pEnv, ppDb, 0) < 0) return NULL;
+
+  tdbBegin(pEnv, &txn, benchMalloc, benchFree, NULL, TDB_TXN_WRITE | TDB_TXN_READ_UNCOMMITTED);
+  for (int i = 0; i < nBenchData; i++) {
+    int kLen = benchKey(key, i);
+    int vLen = benchVal(val, i);
+    if (tdbTbInsert(*ppDb, key, kLen, val, vLen, txn) < 0) return NULL;
+  }
+  tdbCommit(pEnv, txn);
+  tdbPostCommit(pEnv, txn);
+
+  return pEnv;
+}
+
+static void runBench(TTB *pDb, int nThreads) {
+  std::atomic<int64_t>     nFail(0);
+  std::vector<std::thread> threads;
+
+  int64_t start = taosGetTimestampUs();
+  for (int t = 0; t < nThreads; t++) {
+    threads.push_back(std::thread([pDb, t, &nFail]() {
+      uint32_t seed = t + 1;
+      char     key[64];
+      char     val[64];
+      void    *pVal = NULL;
+      int      vLen = 0;
+
+      for (int i = 0; i < nBenchOps; i++) {
+        int iData = taosRandR(&seed) % nBenchData;
+        int kLen = benchKey(key, iData);
+        int eLen = benchVal(val, iData);
+
+        if (tdbTbGet(pDb, key, kLen, &pVal, &vLen) < 0 || vLen != eLen || memcmp(pVal, val, vLen) != 0) {
+          nFail++;
+        }
+      }
+      tdbFree(pVal);
+    }));
+  }
+  for (auto &th : threads) {
+    th.join();
+  }
+  int64_t elapsed = taosGetTimestampUs() - start;
+
+  GTEST_ASSERT_EQ(nFail.load(), 0);
+  printf("pcache bench, threads:%d, lookups:%d, elapsed:%" PRId64 "us, %.0f lookups/s\n", nThreads,
+         nThreads * nBenchOps, elapsed, (double)nThreads * nBenchOps * 1000000 / (elapsed > 0 ? elapsed : 1));
+}
+
+TEST(TdbPCacheBenchTest, concurrent_get) {
+  TTB *pDb = NULL;
+  // large enough for the cache to be sharded, small enough for the hand to keep evicting
+  TDB *pEnv = openBenchDb(1024, &pDb);
+  GTEST_ASSERT_NE(pEnv, nullptr);
+
+  for (int nThreads : {1, 4, 16}) {
+    runBench(pDb, nThreads);
+  }
+
+  tdbTbClose(pDb);
+  GTEST_ASSERT_EQ(tdbClose(pEnv), 0);
+  taosRemoveDir("tdb_pcache_bench");
+}
+
+TEST(TdbPCacheBenchTest, concurrent_get_small_cache) {
+  TTB *pDb = NULL;
+  // a single shard, pages are borrowed from nobody
+  TDB *pEnv = openBenchDb(32, &pDb);
+  GTEST_ASSERT_NE(pEnv, nullptr);
+
+  runBench(pDb, 8);
+
+  tdbTbClose(pDb);
+  GTEST_ASSERT_EQ(tdbClose(pEnv), 0);
+  taosRemoveDir("tdb_pcache_bench");
+}
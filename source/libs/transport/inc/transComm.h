@@ -107,6 +107,10 @@ typedef void* queue[2];
 #define TRANS_MAGIC_NUM           0x5f375a86
 #define TRANS_NOVALID_PACKET(src) ((src) != TRANS_MAGIC_NUM ? 1 : 0)
 
+// a shared cont is never sent, so its message head is free to keep the reference count
+#define TRANS_SHARED_MAGIC         0x2ab5c3e1
+#define transSharedRef(pHead)      ((int32_t*)((char*)(pHead) + sizeof(int64_t)))
+
 typedef SRpcMsg      STransMsg;
 typedef SRpcCtx      STransCtx;
 typedef SRpcCtxVal   STransCtxVal;
@@ -443,6 +447,7 @@ void transCleanup();
 void transPrintEpSet(SEpSet* pEpSet);
 
 void    transFreeMsg(void* msg);
+void*   transRefMsg(void* msg);
 int32_t transCompressMsg(char* msg, int32_t len);
 int32_t transDecompressMsg(char** msg, int32_t len);
 
@@ -142,6 +142,8 @@ void* rpcMallocCont(int64_t contLen) {
 
 void rpcFreeCont(void* cont) { transFreeMsg(cont); }
 
+void* rpcRefCont(void* cont) { return transRefMsg(cont); }
+
 void* rpcReallocCont(void* ptr, int64_t contLen) {
   if (ptr == NULL) return rpcMallocCont(contLen);
 
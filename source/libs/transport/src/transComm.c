@@ -87,9 +87,28 @@ void transFreeMsg(void* msg) {
   if (msg == NULL) {
     return;
   }
+  STransMsgHead* pHead = transHeadFromCont(msg);
+  if (pHead->magicNum == TRANS_SHARED_MAGIC && atomic_sub_fetch_32(transSharedRef(pHead), 1) > 0) {
+    return;
+  }
   tTrace("rpc free cont:%p", (char*)msg - TRANS_MSG_OVERHEAD);
   taosMemoryFree((char*)msg - sizeof(STransMsgHead));
 }
+
+void* transRefMsg(void* msg) {
+  if (msg == NULL) {
+    return NULL;
+  }
+  STransMsgHead* pHead = transHeadFromCont(msg);
+  if (pHead->magicNum == TRANS_SHARED_MAGIC) {
+    atomic_add_fetch_32(transSharedRef(pHead), 1);
+  } else {
+    // only the owner can share a cont, no other reference exists yet
+    pHead->magicNum = TRANS_SHARED_MAGIC;
+    *transSharedRef(pHead) = 2;
+  }
+  return msg;
+}
 int transSockInfo2Str(struct sockaddr* sockname, char* dst) {
   struct sockaddr_in addr = *(struct sockaddr_in*)sockname;
 
@@ -135,8 +154,19 @@ int transDumpFromBuffer(SConnBuffer* connBuf, char** buf) {
   }
   int total = p->total;
   if (total >= HEADSIZE && !p->invalid) {
-    *buf = taosMemoryCalloc(1, total);
-    memcpy(*buf, p->buf, total);
+    if (p->len == total && p->cap == total && total > BUFFER_CAP) {
+      // the buffer was grown to hold exactly this message, hand it over instead of copying it out
+      char* pNewBuf = taosMemoryCalloc(1, BUFFER_CAP);
+      if (pNewBuf == NULL) {
+        return -1;
+      }
+      *buf = p->buf;
+      p->buf = pNewBuf;
+      p->cap = BUFFER_CAP;
+    } else {
+      *buf = taosMemoryCalloc(1, total);
+      memcpy(*buf, p->buf, total);
+    }
     if (transResetBuffer(connBuf) < 0) {
       return -1;
     }
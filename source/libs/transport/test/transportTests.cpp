@@ -232,4 +232,68 @@ int32_t cloneVal(void *src, void **dst) {
 //  skey = (char *)transCtxDumpVal(ctx, 2);
 //  EXPECT_EQ(0, strcmp(skey, val.c_str()));
 //}
+
+// a cont nobody shares is released by its single rpcFreeCont
+TEST(TransRefTest, ownedCont) {
+  char *pCont = (char *)rpcMallocCont(64);
+  ASSERT_NE(pCont, nullptr);
+  EXPECT_NE(transHeadFromCont(pCont)->magicNum, TRANS_SHARED_MAGIC);
+  memset(pCont, 1, 64);
+  rpcFreeCont(pCont);
+
+  EXPECT_EQ(rpcRefCont(NULL), nullptr);
+  rpcFreeCont(NULL);
+}
+
+// every reference is dropped by one rpcFreeCont, the cont stays readable until the last one
+TEST(TransRefTest, sharedCont) {
+  char *pCont = (char *)rpcMallocCont(64);
+  ASSERT_NE(pCont, nullptr);
+  memset(pCont, 7, 64);
+
+  EXPECT_EQ(rpcRefCont(pCont), pCont);
+  STransMsgHead *pHead = transHeadFromCont(pCont);
+  EXPECT_EQ(pHead->magicNum, TRANS_SHARED_MAGIC);
+  EXPECT_EQ(*transSharedRef(pHead), 2);
+
+  EXPECT_EQ(rpcRefCont(pCont), pCont);
+  EXPECT_EQ(*transSharedRef(pHead), 3);
+
+  rpcFreeCont(pCont);
+  EXPECT_EQ(*transSharedRef(pHead), 2);
+  rpcFreeCont(pCont);
+  EXPECT_EQ(*transSharedRef(pHead), 1);
+  for (int32_t i = 0; i < 64; i++) {
+    ASSERT_EQ(pCont[i], 7);
+  }
+
+  // the count drops to 0 and the memory is released
+  rpcFreeCont(pCont);
+}
+
+// references taken and dropped from several threads, only the owner's is left at the end
+TEST(TransRefTest, concurrentRef) {
+  char *pCont = (char *)rpcMallocCont(64);
+  ASSERT_NE(pCont, nullptr);
+  STransMsgHead *pHead = transHeadFromCont(pCont);
+
+  rpcRefCont(pCont);
+  rpcFreeCont(pCont);
+  ASSERT_EQ(*transSharedRef(pHead), 1);
+
+  std::vector<std::thread> threads;
+  for (int32_t i = 0; i < 4; i++) {
+    threads.emplace_back([pCont]() {
+      for (int32_t j = 0; j < 10000; j++) {
+        rpcRefCont(pCont);
+        rpcFreeCont(pCont);
+      }
+    });
+  }
+  for (auto &t : threads) t.join();
+
+  EXPECT_EQ(*transSharedRef(pHead), 1);
+  rpcFreeCont(pCont);
+}
+
 #endif
@@ -17,6 +17,7 @@
 #include "os.h"
 #include "taoserror.h"
 #include "tcompare.h"
+#include "tglobal.h"
 #include "tref.h"
 #include "walInt.h"
 
@@ -143,6 +144,12 @@ SWal *walOpen(const char *path, SWalCfg *pCfg) {
   pWal->writeHead.head.protoVer = WAL_PROTO_VER;
   pWal->writeHead.magic = WAL_MAGIC;
 
+  // init async writer
+  if (tsAsyncWriteDepth > 0 && taosAioOpen(tsAsyncWriteDepth, WAL_AIO_BUF_SIZE, &pWal->pAio) < 0) {
+    wError("vgId:%d, failed to init async writer since %s", pWal->cfg.vgId, strerror(errno));
+    goto _err;
+  }
+
   // load meta
   (void)walLoadMeta(pWal);
 
@@ -168,6 +175,7 @@ SWal *walOpen(const char *path, SWalCfg *pCfg) {
   return pWal;
 
 _err:
+  (void)taosAioClose(&pWal->pAio);
   taosArrayDestroy(pWal->fileInfoSet);
   taosHashCleanup(pWal->pRefHash);
   taosThreadMutexDestroy(&pWal->mutex);
@@ -212,6 +220,9 @@ int32_t walPersist(SWal *pWal) {
 void walClose(SWal *pWal) {
   taosThreadMutexLock(&pWal->mutex);
   (void)walSaveMeta(pWal);
+  if (taosAioClose(&pWal->pAio) < 0) {
+    wError("vgId:%d, failed to flush async writes since %s", pWal->cfg.vgId, strerror(errno));
+  }
   taosCloseFile(&pWal->pLogFile);
   pWal->pLogFile = NULL;
   taosCloseFile(&pWal->pIdxFile);
@@ -255,6 +266,15 @@ static bool walNeedFsync(SWal *pWal) {
   return false;
 }
 
+static bool walNeedFsyncPending(SWal *pWal) {
+  if (pWal->cfg.fsyncPeriod != 0 || pWal->cfg.level != TAOS_WAL_FSYNC || tsWalGroupCommitSize <= 0) {
+    return false;
+  }
+
+  int64_t pendingTs = atomic_load_64(&pWal->pendingSyncTs);
+  return pendingTs > 0 && taosGetTimestampUs() - pendingTs >= tsWalGroupCommitLatency;
+}
+
 static void walUpdateSeq() {
   taosMsleep(WAL_REFRESH_MS);
   atomic_add_fetch_32(&tsWal.seq, 1);
@@ -271,6 +291,8 @@ static void walFsyncAll() {
         wError("vgId:%d, file:%" PRId64 ".log, failed to fsync since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
                strerror(errno));
       }
+    } else if (walNeedFsyncPending(pWal)) {
+      walFsyncPending(pWal);
     }
     pWal = taosIterateRef(tsWal.refSetId, pWal->refId);
   }
@@ -413,6 +413,8 @@ int32_t walRollImpl(SWal *pWal) {
       terrno = TAOS_SYSTEM_ERROR(errno);
       goto END;
     }
+    pWal->pendingSyncSize = 0;
+    pWal->pendingSyncTs = 0;
     code = taosCloseFile(&pWal->pLogFile);
     if (code != 0) {
       terrno = TAOS_SYSTEM_ERROR(errno);
@@ -488,6 +490,23 @@ static int32_t walWriteIndex(SWal *pWal, int64_t ver, int64_t offset) {
   return 0;
 }
 
+// idx entry, head and body are queued in order and submitted together, instead of three blocking writes
+static int32_t walWriteAsync(SWal *pWal, int64_t ver, int64_t offset, const void *body, int32_t bodyLen) {
+  SWalIdxEntry entry = {.ver = ver, .offset = offset};
+
+  if (taosAioPWriteFile(pWal->pAio, pWal->pIdxFile, &entry, sizeof(SWalIdxEntry), -1) < 0 ||
+      taosAioPWriteFile(pWal->pAio, pWal->pLogFile, &pWal->writeHead, sizeof(SWalCkHead), -1) < 0 ||
+      taosAioPWriteFile(pWal->pAio, pWal->pLogFile, body, bodyLen, -1) < 0 || taosAioFlush(pWal->pAio) < 0) {
+    terrno = TAOS_SYSTEM_ERROR(errno);
+    wError("vgId:%d, file:%" PRId64 ".log, failed to write since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
+           strerror(errno));
+    (void)taosAioFlush(pWal->pAio);
+    return -1;
+  }
+
+  return 0;
+}
+
 static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, int64_t index, tmsg_t msgType, SWalSyncInfo syncMeta,
                                          const void *body, int32_t bodyLen) {
   int64_t code = 0;
@@ -508,25 +527,32 @@ static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, int64_t index, tmsg_t msgTy
   wDebug("vgId:%d, wal write log %" PRId64 ", msgType: %s, cksum head %u cksum body %u", pWal->cfg.vgId, index,
          TMSG_INFO(msgType), pWal->writeHead.cksumHead, pWal->writeHead.cksumBody);
 
-  code = walWriteIndex(pWal, index, offset);
-  if (code < 0) {
-    goto END;
-  }
+  if (pWal->pAio) {
+    code = walWriteAsync(pWal, index, offset, body, bodyLen);
+    if (code < 0) {
+      goto END;
+    }
+  } else {
+    code = walWriteIndex(pWal, index, offset);
+    if (code < 0) {
+      goto END;
+    }
 
-  if (taosWriteFile(pWal->pLogFile, &pWal->writeHead, sizeof(SWalCkHead)) != sizeof(SWalCkHead)) {
-    terrno = TAOS_SYSTEM_ERROR(errno);
-    wError("vgId:%d, file:%" PRId64 ".log, failed to write since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
-           strerror(errno));
-    code = -1;
-    goto END;
-  }
+    if (taosWriteFile(pWal->pLogFile, &pWal->writeHead, sizeof(SWalCkHead)) != sizeof(SWalCkHead)) {
+      terrno = TAOS_SYSTEM_ERROR(errno);
+      wError("vgId:%d, file:%" PRId64 ".log, failed to write since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
+             strerror(errno));
+      code = -1;
+      goto END;
+    }
 
-  if (taosWriteFile(pWal->pLogFile, (char *)body, bodyLen) != bodyLen) {
-    terrno = TAOS_SYSTEM_ERROR(errno);
-    wError("vgId:%d, file:%" PRId64 ".log, failed to write since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
-           strerror(errno));
-    code = -1;
-    goto END;
+    if (taosWriteFile(pWal->pLogFile, (char *)body, bodyLen) != bodyLen) {
+      terrno = TAOS_SYSTEM_ERROR(errno);
+      wError("vgId:%d, file:%" PRId64 ".log, failed to write since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
+             strerror(errno));
+      code = -1;
+      goto END;
+    }
   }
 
   // set status
@@ -535,6 +561,10 @@ static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, int64_t index, tmsg_t msgTy
   }
   pWal->vers.lastVer = index;
   pWal->totSize += sizeof(SWalCkHead) + bodyLen;
+  if (pWal->pendingSyncSize == 0) {
+    pWal->pendingSyncTs = pWal->writeHead.head.ingestTs;
+  }
+  pWal->pendingSyncSize += sizeof(SWalCkHead) + bodyLen;
   pFileInfo->lastVer = index;
   pFileInfo->fileSize += sizeof(SWalCkHead) + bodyLen;
 
@@ -637,14 +667,38 @@ int32_t walWrite(SWal *pWal, int64_t index, tmsg_t msgType, const void *body, in
   return walWriteWithSyncInfo(pWal, index, msgType, syncMeta, body, bodyLen);
 }
 
+static void walDoFsync(SWal *pWal) {
+  wTrace("vgId:%d, fileId:%" PRId64 ".log, do fsync, pending size:%" PRId64, pWal->cfg.vgId,
+         walGetCurFileFirstVer(pWal), pWal->pendingSyncSize);
+  if (taosFsyncFile(pWal->pLogFile) < 0) {
+    wError("vgId:%d, file:%" PRId64 ".log, fsync failed since %s", pWal->cfg.vgId, walGetCurFileFirstVer(pWal),
+           strerror(errno));
+  }
+  pWal->pendingSyncSize = 0;
+  pWal->pendingSyncTs = 0;
+}
+
+// With group commit, an unforced fsync is deferred until the pending appends exceed the batch size or
+// the oldest of them exceeds the batch latency. The caller must invoke walFsyncPending before acking.
+static bool walGroupCommitDefer(SWal *pWal) {
+  if (tsWalGroupCommitSize <= 0) return false;
+  if (pWal->pendingSyncSize >= tsWalGroupCommitSize) return false;
+  if (taosGetTimestampUs() - pWal->pendingSyncTs >= tsWalGroupCommitLatency) return false;
+  return true;
+}
+
 void walFsync(SWal *pWal, bool forceFsync) {
   taosThreadMutexLock(&pWal->mutex);
-  if (forceFsync || (pWal->cfg.level == TAOS_WAL_FSYNC && pWal->cfg.fsyncPeriod == 0)) {
-    wTrace("vgId:%d, fileId:%" PRId64 ".log, do fsync", pWal->cfg.vgId, walGetCurFileFirstVer(pWal));
-    if (taosFsyncFile(pWal->pLogFile) < 0) {
-      wError("vgId:%d, file:%" PRId64 ".log, fsync failed since %s", pWal->cfg.vgId, walGetCurFileFirstVer(pWal),
-             strerror(errno));
-    }
+  if (forceFsync || (pWal->cfg.level == TAOS_WAL_FSYNC && pWal->cfg.fsyncPeriod == 0 && !walGroupCommitDefer(pWal))) {
+    walDoFsync(pWal);
+  }
+  taosThreadMutexUnlock(&pWal->mutex);
+}
+
+void walFsyncPending(SWal *pWal) {
+  taosThreadMutexLock(&pWal->mutex);
+  if (pWal->pendingSyncSize > 0 && pWal->pLogFile != NULL) {
+    walDoFsync(pWal);
   }
   taosThreadMutexUnlock(&pWal->mutex);
 }
@@ -3,6 +3,7 @@
 #include <iostream>
 #include <queue>
 
+#include "tglobal.h"
 #include "walInt.h"
 
 const char* ranStr = "tvapq02tcp";
@@ -234,6 +235,65 @@ TEST_F(WalCleanEnv, write) {
   ASSERT_EQ(code, 0);
 }
 
+TEST_F(WalCleanEnv, groupCommit) {
+  int     code;
+  int64_t oldSize = tsWalGroupCommitSize;
+  int32_t oldLatency = tsWalGroupCommitLatency;
+  tsWalGroupCommitSize = 1024 * 1024;
+  tsWalGroupCommitLatency = 1000000;
+  for (int i = 0; i < 10; i++) {
+    code = walWrite(pWal, i, i + 1, (void*)ranStr, ranStrLen);
+    ASSERT_EQ(code, 0);
+    walFsync(pWal, false);
+    ASSERT_EQ(pWal->pendingSyncSize, (i + 1) * (int64_t)(sizeof(SWalCkHead) + ranStrLen));
+  }
+  walFsyncPending(pWal);
+  ASSERT_EQ(pWal->pendingSyncSize, 0);
+
+  tsWalGroupCommitSize = sizeof(SWalCkHead) + ranStrLen;
+  code = walWrite(pWal, 10, 11, (void*)ranStr, ranStrLen);
+  ASSERT_EQ(code, 0);
+  walFsync(pWal, false);
+  ASSERT_EQ(pWal->pendingSyncSize, 0);
+
+  tsWalGroupCommitSize = oldSize;
+  tsWalGroupCommitLatency = oldLatency;
+}
+
+TEST_F(WalCleanEnv, asyncWrite) {
+  walClose(pWal);
+  int32_t oldDepth = tsAsyncWriteDepth;
+  tsAsyncWriteDepth = 8;
+  SWalCfg cfg = {0};
+  cfg.rollPeriod = -1;
+  cfg.segSize = -1;
+  cfg.level = TAOS_WAL_FSYNC;
+  pWal = walOpen(pathName, &cfg);
+  tsAsyncWriteDepth = oldDepth;
+  ASSERT(pWal != NULL);
+
+  int   code;
+  char* bigStr = (char*)taosMemoryMalloc(WAL_AIO_BUF_SIZE * 10);
+  memset(bigStr, 'x', WAL_AIO_BUF_SIZE * 10);
+  for (int i = 0; i < 20; i++) {
+    int32_t len = (i % 2) ? WAL_AIO_BUF_SIZE * 10 : ranStrLen;
+    code = walWrite(pWal, i, 0, (i % 2) ? bigStr : ranStr, len);
+    ASSERT_EQ(code, 0);
+  }
+
+  SWalReader* pRead = walOpenReader(pWal, NULL, 0);
+  ASSERT(pRead != NULL);
+  for (int i = 19; i >= 0; i--) {
+    code = walReadVer(pRead, i);
+    ASSERT_EQ(code, 0);
+    ASSERT_EQ(pRead->pHead->head.version, i);
+    ASSERT_EQ(pRead->pHead->head.bodyLen, (i % 2) ? WAL_AIO_BUF_SIZE * 10 : ranStrLen);
+    ASSERT_EQ(memcmp(pRead->pHead->head.body, (i % 2) ? bigStr : ranStr, pRead->pHead->head.bodyLen), 0);
+  }
+  walCloseReader(pRead);
+  taosMemoryFree(bigStr);
+}
+
 TEST_F(WalCleanEnv, rollback) {
   int code;
   for (int i = 0; i < 10; i++) {
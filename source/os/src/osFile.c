@@ -1404,3 +1404,361 @@ int32_t taosLinkFile(char *src, char *dst) {
 #endif
   return 0;
 }
+
+// =============== ASYNC WRITE ===============
+#if defined(LINUX) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register)
+#define TD_AIO_URING
+#endif
+#endif
+#endif
+
+typedef struct TdFileAio {
+  int32_t  depth;
+  int32_t  szBuf;
+  uint8_t *pBufs;      // depth slots of szBuf bytes, registered to the ring if possible
+  int32_t *freeSlots;  // stack of free slot indexes
+  int32_t  nFree;
+  int32_t  code;  // errno of the first failed write since the last flush
+#ifdef TD_AIO_URING
+  int32_t *slotLen;
+  int32_t  nQueued;    // queued to the sq but not submitted
+  int32_t  nInflight;  // submitted but not reaped
+  int32_t  lastQueued;  // sqe index of the last queued write, -1 if none
+  bool     chained;     // the queued writes since the first queued append form a link chain
+  bool     appendInflight;
+  bool     fixedBuf;
+  int      ringFd;
+  void    *sqRing;
+  size_t   szSqRing;
+  void    *cqRing;
+  size_t   szCqRing;
+  struct io_uring_sqe *sqes;
+  size_t               szSqes;
+  unsigned            *sqHead;
+  unsigned            *sqTail;
+  unsigned            *sqMask;
+  unsigned            *sqArray;
+  unsigned            *cqHead;
+  unsigned            *cqTail;
+  unsigned            *cqMask;
+  struct io_uring_cqe *cqes;
+#endif
+} TdFileAio;
+
+#ifdef TD_AIO_URING
+static int taosAioSetup(unsigned entries, struct io_uring_params *p) {
+  return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int taosAioEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+  return (int)syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, NULL, 0);
+}
+
+static int taosAioRegister(int fd, unsigned opcode, void *arg, unsigned nArgs) {
+  return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nArgs);
+}
+
+static void taosAioUnmapRing(TdFileAio *pAio) {
+  if (pAio->sqes != NULL) munmap(pAio->sqes, pAio->szSqes);
+  if (pAio->cqRing != NULL && pAio->cqRing != pAio->sqRing) munmap(pAio->cqRing, pAio->szCqRing);
+  if (pAio->sqRing != NULL) munmap(pAio->sqRing, pAio->szSqRing);
+  if (pAio->ringFd >= 0) close(pAio->ringFd);
+  pAio->sqes = NULL;
+  pAio->cqRing = NULL;
+  pAio->sqRing = NULL;
+  pAio->ringFd = -1;
+}
+
+static int32_t taosAioInitRing(TdFileAio *pAio) {
+  struct io_uring_params params = {0};
+
+  pAio->ringFd = taosAioSetup(pAio->depth, &params);
+  if (pAio->ringFd < 0) return -1;
+
+  // offset -1 (current position) is needed for appends
+  if (!(params.features & IORING_FEAT_RW_CUR_POS)) goto _err;
+
+  pAio->szSqRing = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  pAio->szCqRing = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+  if (params.features & IORING_FEAT_SINGLE_MMAP) {
+    pAio->szSqRing = TMAX(pAio->szSqRing, pAio->szCqRing);
+    pAio->szCqRing = pAio->szSqRing;
+  }
+
+  pAio->sqRing =
+      mmap(NULL, pAio->szSqRing, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, pAio->ringFd, IORING_OFF_SQ_RING);
+  if (pAio->sqRing == MAP_FAILED) {
+    pAio->sqRing = NULL;
+    goto _err;
+  }
+
+  if (params.features & IORING_FEAT_SINGLE_MMAP) {
+    pAio->cqRing = pAio->sqRing;
+  } else {
+    pAio->cqRing = mmap(NULL, pAio->szCqRing, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, pAio->ringFd,
+                        IORING_OFF_CQ_RING);
+    if (pAio->cqRing == MAP_FAILED) {
+      pAio->cqRing = NULL;
+      goto _err;
+    }
+  }
+
+  pAio->szSqes = params.sq_entries * sizeof(struct io_uring_sqe);
+  pAio->sqes =
+      mmap(NULL, pAio->szSqes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, pAio->ringFd, IORING_OFF_SQES);
+  if (pAio->sqes == MAP_FAILED) {
+    pAio->sqes = NULL;
+    goto _err;
+  }
+
+  pAio->sqHead = (unsigned *)((char *)pAio->sqRing + params.sq_off.head);
+  pAio->sqTail = (unsigned *)((char *)pAio->sqRing + params.sq_off.tail);
+  pAio->sqMask = (unsigned *)((char *)pAio->sqRing + params.sq_off.ring_mask);
+  pAio->sqArray = (unsigned *)((char *)pAio->sqRing + params.sq_off.array);
+  pAio->cqHead = (unsigned *)((char *)pAio->cqRing + params.cq_off.head);
+  pAio->cqTail = (unsigned *)((char *)pAio->cqRing + params.cq_off.tail);
+  pAio->cqMask = (unsigned *)((char *)pAio->cqRing + params.cq_off.ring_mask);
+  pAio->cqes = (struct io_uring_cqe *)((char *)pAio->cqRing + params.cq_off.cqes);
+
+  // registered buffers save the page pinning of each write, but may exceed RLIMIT_MEMLOCK on old kernels
+  struct iovec *iovs = taosMemoryMalloc(sizeof(struct iovec) * pAio->depth);
+  if (iovs != NULL) {
+    for (int32_t i = 0; i < pAio->depth; i++) {
+      iovs[i].iov_base = pAio->pBufs + (int64_t)i * pAio->szBuf;
+      iovs[i].iov_len = pAio->szBuf;
+    }
+    pAio->fixedBuf = (taosAioRegister(pAio->ringFd, IORING_REGISTER_BUFFERS, iovs, pAio->depth) == 0);
+    taosMemoryFree(iovs);
+  }
+
+  pAio->lastQueued = -1;
+  return 0;
+
+_err:
+  taosAioUnmapRing(pAio);
+  return -1;
+}
+
+static void taosAioReap(TdFileAio *pAio) {
+  unsigned head = *pAio->cqHead;
+  unsigned tail = __atomic_load_n(pAio->cqTail, __ATOMIC_ACQUIRE);
+
+  for (; head != tail; head++) {
+    struct io_uring_cqe *cqe = &pAio->cqes[head & *pAio->cqMask];
+    int32_t              slot = (int32_t)cqe->user_data;
+
+    if (pAio->code == 0) {
+      if (cqe->res < 0) {
+        pAio->code = -cqe->res;
+      } else if (cqe->res != pAio->slotLen[slot]) {
+        pAio->code = EIO;
+      }
+    }
+    pAio->freeSlots[pAio->nFree++] = slot;
+    pAio->nInflight--;
+  }
+
+  __atomic_store_n(pAio->cqHead, head, __ATOMIC_RELEASE);
+  if (pAio->nInflight == 0) {
+    pAio->appendInflight = false;
+  }
+}
+
+static int32_t taosAioSubmit(TdFileAio *pAio, int32_t minComplete) {
+  while (pAio->nQueued > 0 || minComplete > 0) {
+    unsigned flags = minComplete > 0 ? IORING_ENTER_GETEVENTS : 0;
+    int      ret = taosAioEnter(pAio->ringFd, pAio->nQueued, minComplete, flags);
+    if (ret < 0) {
+      if (errno == EINTR) continue;
+      return -1;
+    }
+
+    pAio->nQueued -= ret;
+    pAio->nInflight += ret;
+    if (ret > 0 && pAio->chained) {
+      // the kernel ends the chain at the submit boundary, later appends are ordered by drain
+      pAio->appendInflight = true;
+      if (pAio->nQueued == 0) {
+        pAio->chained = false;
+        pAio->lastQueued = -1;
+      } else {
+        unsigned head = __atomic_load_n(pAio->sqHead, __ATOMIC_ACQUIRE);
+        pAio->sqes[pAio->sqArray[head & *pAio->sqMask]].flags |= IOSQE_IO_DRAIN;
+      }
+    }
+
+    taosAioReap(pAio);
+    minComplete = TMIN(minComplete, pAio->nInflight);
+    if (pAio->nQueued == 0 || minComplete == 0) break;
+  }
+  return 0;
+}
+
+static int32_t taosAioQueue(TdFileAio *pAio, TdFilePtr pFile, const void *buf, int32_t count, int64_t offset) {
+  if (pAio->nFree == 0) {
+    if (taosAioSubmit(pAio, 1) < 0) return -1;
+  }
+
+  int32_t  slot = pAio->freeSlots[--pAio->nFree];
+  uint8_t *pSlotBuf = pAio->pBufs + (int64_t)slot * pAio->szBuf;
+  memcpy(pSlotBuf, buf, count);
+  pAio->slotLen[slot] = count;
+
+  unsigned             tail = *pAio->sqTail;
+  unsigned             idx = tail & *pAio->sqMask;
+  struct io_uring_sqe *sqe = &pAio->sqes[idx];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = pAio->fixedBuf ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+  sqe->fd = pFile->fd;
+  sqe->addr = (uint64_t)(uintptr_t)pSlotBuf;
+  sqe->len = count;
+  sqe->off = offset < 0 ? (uint64_t)-1 : (uint64_t)offset;
+  sqe->buf_index = pAio->fixedBuf ? slot : 0;
+  sqe->user_data = slot;
+
+  // appends depend on the file position: IOSQE_IO_LINK orders an sqe before the next one in the ring, so once an
+  // append is queued every following write joins the chain, and the chain starts after the appends in flight
+  if (pAio->chained) {
+    pAio->sqes[pAio->lastQueued].flags |= IOSQE_IO_LINK;
+  } else if (offset < 0) {
+    if (pAio->appendInflight) {
+      sqe->flags |= IOSQE_IO_DRAIN;
+    }
+    pAio->chained = true;
+  }
+  pAio->lastQueued = idx;
+
+  pAio->sqArray[idx] = idx;
+  __atomic_store_n(pAio->sqTail, tail + 1, __ATOMIC_RELEASE);
+  pAio->nQueued++;
+
+  // submit in batches without waiting, so the writes proceed while the caller fills more
+  if (pAio->nQueued >= pAio->depth / 2) {
+    return taosAioSubmit(pAio, 0);
+  }
+  return 0;
+}
+#endif
+
+int32_t taosAioOpen(int32_t depth, int32_t szBuf, TdFileAioPtr *ppAio) {
+  TdFileAio *pAio = taosMemoryCalloc(1, sizeof(TdFileAio));
+  if (pAio == NULL) {
+    errno = ENOMEM;
+    return -1;
+  }
+
+  pAio->depth = depth;
+  pAio->szBuf = szBuf;
+#ifdef TD_AIO_URING
+  pAio->ringFd = -1;
+  pAio->lastQueued = -1;
+  if (depth > 0 && szBuf > 0) {
+    pAio->pBufs = taosMemoryMallocAlign(4096, (int64_t)depth * szBuf);
+    pAio->freeSlots = taosMemoryMalloc(sizeof(int32_t) * depth);
+    pAio->slotLen = taosMemoryMalloc(sizeof(int32_t) * depth);
+    if (pAio->pBufs == NULL || pAio->freeSlots == NULL || pAio->slotLen == NULL || taosAioInitRing(pAio) < 0) {
+      // fall back to synchronous writes
+      taosMemoryFreeClear(pAio->pBufs);
+      taosMemoryFreeClear(pAio->freeSlots);
+      taosMemoryFreeClear(pAio->slotLen);
+    } else {
+      for (int32_t i = 0; i < depth; i++) {
+        pAio->freeSlots[i] = depth - i - 1;
+      }
+      pAio->nFree = depth;
+    }
+  }
+#endif
+
+  *ppAio = pAio;
+  return 0;
+}
+
+bool taosAioIsAsync(TdFileAioPtr pAio) {
+#ifdef TD_AIO_URING
+  return pAio != NULL && pAio->ringFd >= 0;
+#else
+  return false;
+#endif
+}
+
+int32_t taosAioPWriteFile(TdFileAioPtr pAio, TdFilePtr pFile, const void *buf, int64_t count, int64_t offset) {
+  if (pFile == NULL) {
+    errno = EBADF;
+    return -1;
+  }
+
+#ifdef TD_AIO_URING
+  if (pAio->ringFd >= 0) {
+    if (pFile->fd < 0) {
+      errno = EBADF;
+      return -1;
+    }
+
+    int64_t n = 0;
+    while (n < count) {
+      int32_t nWrite = (int32_t)TMIN(count - n, pAio->szBuf);
+      if (taosAioQueue(pAio, pFile, (const uint8_t *)buf + n, nWrite, offset < 0 ? -1 : offset + n) < 0) {
+        return -1;
+      }
+      n += nWrite;
+    }
+    return 0;
+  }
+#endif
+
+  int64_t ret = offset < 0 ? taosWriteFile(pFile, buf, count) : taosPWriteFile(pFile, buf, count, offset);
+  if (ret != count) {
+    if (ret >= 0) errno = EIO;
+    return -1;
+  }
+  return 0;
+}
+
+int32_t taosAioFlush(TdFileAioPtr pAio) {
+#ifdef TD_AIO_URING
+  if (pAio->ringFd >= 0) {
+    while (pAio->nQueued > 0 || pAio->nInflight > 0) {
+      if (taosAioSubmit(pAio, pAio->nQueued + pAio->nInflight) < 0) {
+        return -1;
+      }
+    }
+  }
+#endif
+
+  if (pAio->code != 0) {
+    errno = pAio->code;
+    pAio->code = 0;
+    return -1;
+  }
+  return 0;
+}
+
+int32_t taosAioClose(TdFileAioPtr *ppAio) {
+  TdFileAio *pAio = *ppAio;
+  if (pAio == NULL) return 0;
+
+  // the writer is released even if the flush fails, the error is for the caller to handle
+  int32_t ret = taosAioFlush(pAio);
+  int32_t code = errno;
+#ifdef TD_AIO_URING
+  if (pAio->ringFd >= 0) {
+    taosAioUnmapRing(pAio);
+  }
+  taosMemoryFree(pAio->pBufs);
+  taosMemoryFree(pAio->freeSlots);
+  taosMemoryFree(pAio->slotLen);
+#endif
+  taosMemoryFree(pAio);
+  *ppAio = NULL;
+
+  if (ret < 0) {
+    errno = code;
+  }
+  return ret;
+}
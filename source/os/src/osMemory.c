@@ -20,6 +20,9 @@
 #include <malloc.h>
 #endif
 #include "os.h"
+#if defined(LINUX)
+#include <sys/syscall.h>
+#endif
 
 #if defined(USE_TD_MEMORY) || defined(USE_ADDR2LINE)
 
@@ -394,3 +397,55 @@ void *taosMemoryMallocAlign(uint32_t alignment, int64_t size) {
 #endif
 #endif
 }
+
+#define TD_HUGE_PAGE_SIZE (2 * 1024 * 1024L)
+
+// Map anonymous memory of at least size bytes outside of the heap. With hugePage the mapping is rounded up to 2MB
+// and backed by reserved huge pages, it fails if the host has none so that the caller can fall back. A non-negative
+// numaNode makes the kernel prefer that node when the pages are faulted in. The mapped size is returned in pMapSize.
+void *taosMemoryMapPages(int64_t size, bool hugePage, int32_t numaNode, int64_t *pMapSize) {
+#if defined(LINUX)
+  int64_t mapSize = hugePage ? (size + TD_HUGE_PAGE_SIZE - 1) / TD_HUGE_PAGE_SIZE * TD_HUGE_PAGE_SIZE : size;
+  void   *p = MAP_FAILED;
+
+  if (hugePage) {
+#ifdef MAP_HUGETLB
+    p = mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (p == MAP_FAILED) {
+      terrno = TAOS_SYSTEM_ERROR(errno);
+      return NULL;
+    }
+#else
+    terrno = TSDB_CODE_OPS_NOT_SUPPORT;
+    return NULL;
+#endif
+  } else {
+    p = mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+      terrno = TAOS_SYSTEM_ERROR(errno);
+      return NULL;
+    }
+  }
+
+#ifdef SYS_mbind
+  if (numaNode >= 0 && numaNode < 64) {
+    uint64_t nodeMask = 1ULL << numaNode;
+    // MPOL_PREFERRED, fall back to other nodes rather than fail when the preferred one is exhausted
+    syscall(SYS_mbind, p, mapSize, 1, &nodeMask, 64, 0);
+  }
+#endif
+
+  if (pMapSize) *pMapSize = mapSize;
+  return p;
+#else
+  terrno = TSDB_CODE_OPS_NOT_SUPPORT;
+  return NULL;
+#endif
+}
+
+void taosMemoryUnmapPages(void *ptr, int64_t mapSize) {
+  if (ptr == NULL) return;
+#if defined(LINUX)
+  munmap(ptr, mapSize);
+#endif
+}
@@ -1233,3 +1233,65 @@ int taosGetlocalhostname(char *hostname, size_t maxLen) {
   return gethostname(hostname, maxLen);
 #endif
 }
+
+// Number of NUMA nodes present on the host, 1 if the topology is not exported
+int32_t taosGetNumaNodes() {
+#if defined(LINUX)
+  static int32_t numOfNodes = 0;
+  if (numOfNodes > 0) return numOfNodes;
+
+  int32_t n = 0;
+  char    path[64];
+  for (; n < 64; n++) {
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%d", n);
+    if (!taosDirExist(path)) break;
+  }
+  numOfNodes = TMAX(n, 1);
+  return numOfNodes;
+#else
+  return 1;
+#endif
+}
+
+// Restrict the calling thread to the cpus of the given NUMA node, e.g. "0-7,16-23" in its cpulist
+int32_t taosBindThreadToNumaNode(int32_t node) {
+#if defined(LINUX)
+  char path[64];
+  char line[1024] = {0};
+  snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+
+  TdFilePtr pFile = taosOpenFile(path, TD_FILE_READ | TD_FILE_STREAM);
+  if (pFile == NULL) return -1;
+  int64_t len = taosGetsFile(pFile, sizeof(line), line);
+  taosCloseFile(&pFile);
+  if (len <= 0) return -1;
+
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  char *p = line;
+  while (*p != 0 && *p != '\n') {
+    char   *end = NULL;
+    int32_t first = taosStr2Int32(p, &end, 10);
+    int32_t last = first;
+    if (end == p) break;
+    if (*end == '-') {
+      p = end + 1;
+      last = taosStr2Int32(p, &end, 10);
+    }
+    for (int32_t cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++) {
+      CPU_SET(cpu, &mask);
+    }
+    p = (*end == ',') ? end + 1 : end;
+  }
+  if (CPU_COUNT(&mask) == 0) return -1;
+
+  if (sched_setaffinity(0, sizeof(mask), &mask) != 0) {
+    terrno = TAOS_SYSTEM_ERROR(errno);
+    return -1;
+  }
+  return 0;
+#else
+  terrno = TSDB_CODE_OPS_NOT_SUPPORT;
+  return -1;
+#endif
+}
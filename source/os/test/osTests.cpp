@@ -342,4 +342,58 @@ TEST(osTest, osFilePerformance) {
 
 #endif // OSFILE_PERFORMANCE_TEST
 
+// appends to one file interleaved with positioned writes to another, on a shallow ring so the appends span several
+// submits and wait for free slots
+TEST(osTest, osFileAio) {
+  const char *appendName = "./osfileaio_append.txt";
+  const char *pwriteName = "./osfileaio_pwrite.txt";
+  const int32_t szBuf = 64;
+  const int32_t nWrite = 200;
+
+  TdFilePtr pAppend = taosOpenFile(appendName, TD_FILE_CREATE | TD_FILE_WRITE | TD_FILE_READ | TD_FILE_TRUNC);
+  TdFilePtr pPWrite = taosOpenFile(pwriteName, TD_FILE_CREATE | TD_FILE_WRITE | TD_FILE_READ | TD_FILE_TRUNC);
+  ASSERT_NE(pAppend, nullptr);
+  ASSERT_NE(pPWrite, nullptr);
+
+  TdFileAioPtr pAio = NULL;
+  ASSERT_EQ(taosAioOpen(4, szBuf, &pAio), 0);
+  printf("async write %s\n", taosAioIsAsync(pAio) ? "enabled" : "disabled");
+
+  char buf[szBuf * 3];
+  for (int32_t i = 0; i < nWrite; i++) {
+    // 1 to 3 slots per append
+    int32_t len = szBuf / 2 + (i % 5) * szBuf / 2;
+    memset(buf, 'a' + i % 26, len);
+    ASSERT_EQ(taosAioPWriteFile(pAio, pAppend, buf, len, -1), 0);
+
+    memset(buf, 'A' + i % 26, szBuf);
+    ASSERT_EQ(taosAioPWriteFile(pAio, pPWrite, buf, szBuf, (int64_t)(nWrite - i - 1) * szBuf), 0);
+  }
+  ASSERT_EQ(taosAioClose(&pAio), 0);
+  ASSERT_EQ(pAio, nullptr);
+
+  char rbuf[szBuf * 3];
+  ASSERT_EQ(taosLSeekFile(pAppend, 0, SEEK_SET), 0);
+  for (int32_t i = 0; i < nWrite; i++) {
+    int32_t len = szBuf / 2 + (i % 5) * szBuf / 2;
+    ASSERT_EQ(taosReadFile(pAppend, rbuf, len), len);
+    for (int32_t j = 0; j < len; j++) {
+      ASSERT_EQ(rbuf[j], 'a' + i % 26) << "append " << i << " byte " << j;
+    }
+  }
+  ASSERT_EQ(taosReadFile(pAppend, rbuf, 1), 0);
+
+  for (int32_t i = 0; i < nWrite; i++) {
+    ASSERT_EQ(taosPReadFile(pPWrite, rbuf, szBuf, (int64_t)(nWrite - i - 1) * szBuf), szBuf);
+    for (int32_t j = 0; j < szBuf; j++) {
+      ASSERT_EQ(rbuf[j], 'A' + i % 26) << "pwrite " << i << " byte " << j;
+    }
+  }
+
+  taosCloseFile(&pAppend);
+  taosCloseFile(&pPWrite);
+  taosRemoveFile(appendName);
+  taosRemoveFile(pwriteName);
+}
+
 #pragma GCC diagnostic pop
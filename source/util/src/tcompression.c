@@ -26,6 +26,11 @@
  *   NOTE : For bigint, only 59 bits can be used, which means data from -(2**59) to (2**59)-1
  *   are allowed.
  *
+ *   For smallint, int and bigint, a frame-of-reference encoding is tried as well. The values are
+ *   split into mini-blocks of 128, and each mini-block keeps its minimum as the reference and
+ *   packs (value - reference) with a fixed bit width. It is used whenever it is not larger than
+ *   the simple 8B output, because it decodes without per-word selectors and unpacks with SIMD.
+ *
  * BOOLEAN Compression Algorithm:
  *   We provide two methods for compress boolean types. Because boolean types in C
  *   code are char bytes with 0 and 1 values only, only one bit can used to discriminate
@@ -44,6 +49,9 @@
  *   adjacent values. Then compare the number of leading zeros and trailing zeros. If the number
  *   of leading zeros are larger than the trailing zeros, then record the last serveral bytes
  *   of the XORed value with informations. If not, record the first corresponding bytes.
+ *   Chimp128 (https://doi.org/10.14778/3551793.3551852), which XORs against the best of the
+ *   last 128 values at bit granularity, is used instead when it does better on a sample taken
+ *   from the head of the block.
  *
  */
 
@@ -88,7 +96,8 @@ void tsCompressExit() { tdszExit(); }
 /*
  * Compress Integer (Simple8B).
  */
-int32_t tsCompressINTImp(const char *const input, const int32_t nelements, char *const output, const char type) {
+static int32_t tsCompressINTSimple8bImp(const char *const input, const int32_t nelements, char *const output,
+                                        const char type) {
   // Selector value:              0    1   2   3   4   5   6   7   8  9  10  11
   // 12  13  14  15
   char    bit_per_integer[] = {0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 10, 12, 15, 20, 30, 60};
@@ -202,6 +211,265 @@ int32_t tsCompressINTImp(const char *const input, const int32_t nelements, char
   return opos;
 }
 
+/*
+ * Compress Integer (Frame-of-reference).
+ *   [indicator = 2] followed by one mini-block per TS_FOR_BLOCK_VALUES values:
+ *   [bit width : 1 byte][reference : word_length bytes][packed (value - reference), little-endian bit order]
+ */
+#define TS_FOR_INDICATOR                2
+#define TS_FOR_BLOCK_VALUES             128
+#define TS_FOR_PACKED_BYTES(nVal, bits) (((nVal) * (bits) + 7) >> 3)
+
+bool tsIntForCodec = false;
+
+static FORCE_INLINE int64_t tsForGetValue(const char *const input, int32_t idx, const char type) {
+  switch (type) {
+    case TSDB_DATA_TYPE_TINYINT:
+      return *((int8_t *)input + idx);
+    case TSDB_DATA_TYPE_SMALLINT:
+      return *((int16_t *)input + idx);
+    case TSDB_DATA_TYPE_INT:
+      return *((int32_t *)input + idx);
+    default:
+      return *((int64_t *)input + idx);
+  }
+}
+
+static int32_t tsForBlockBits(const char *const input, int32_t start, int32_t nVal, const char type, int64_t *pRef) {
+  int64_t minVal = tsForGetValue(input, start, type);
+  int64_t maxVal = minVal;
+  for (int32_t i = start + 1; i < start + nVal; i++) {
+    int64_t val = tsForGetValue(input, i, type);
+    if (val < minVal) minVal = val;
+    if (val > maxVal) maxVal = val;
+  }
+
+  *pRef = minVal;
+  uint64_t range = (uint64_t)maxVal - (uint64_t)minVal;
+  return range ? (LONG_BYTES * BITS_PER_BYTE) - BUILDIN_CLZL(range) : 0;
+}
+
+// Pick the codec in one pass over the input: the frame-of-reference size is exact, the simple 8B size is estimated as
+// if every value of a mini-block took the width of the widest zigzag delta in it.
+static bool tsCompressINTPreferFor(const char *const input, const int32_t nelements, const char type) {
+  char    bit_to_selector[] = {0,  2,  3,  4,  5,  6,  7,  8,  9,  10, 10, 11, 11, 12, 12, 12, 13, 13, 13, 13, 13,
+                               14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+                               15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15};
+  int32_t selector_to_elems[] = {240, 120, 60, 30, 20, 15, 12, 10, 8, 7, 6, 5, 4, 3, 2, 1};
+
+  int32_t word_length = getWordLength(type);
+  int64_t byte_limit = (int64_t)nelements * word_length + 1;
+  int64_t forSize = 1;
+  int64_t s8bSize = 1;
+  int64_t prev_value = 0;
+
+  for (int32_t i = 0; i < nelements; i += TS_FOR_BLOCK_VALUES) {
+    int32_t  nVal = TMIN(TS_FOR_BLOCK_VALUES, nelements - i);
+    int64_t  minVal = INT64_MAX;
+    int64_t  maxVal = INT64_MIN;
+    uint64_t maxZigzag = 0;
+
+    for (int32_t j = i; j < i + nVal; j++) {
+      int64_t val = tsForGetValue(input, j, type);
+      if (val < minVal) minVal = val;
+      if (val > maxVal) maxVal = val;
+
+      if (s8bSize < byte_limit) {
+        if (!safeInt64Add(val, -prev_value)) {
+          s8bSize = byte_limit;
+        } else {
+          uint64_t zigzag_value = ZIGZAG_ENCODE(int64_t, val - prev_value);
+          if (zigzag_value > maxZigzag) maxZigzag = zigzag_value;
+        }
+      }
+      prev_value = val;
+    }
+
+    uint64_t range = (uint64_t)maxVal - (uint64_t)minVal;
+    int32_t  bits = range ? (LONG_BYTES * BITS_PER_BYTE) - BUILDIN_CLZL(range) : 0;
+    forSize += 1 + word_length + TS_FOR_PACKED_BYTES(nVal, bits);
+
+    if (s8bSize < byte_limit) {
+      if (maxZigzag >= SIMPLE8B_MAX_INT64) {
+        s8bSize = byte_limit;
+      } else {
+        int32_t nBit = maxZigzag ? (LONG_BYTES * BITS_PER_BYTE) - BUILDIN_CLZL(maxZigzag) : 0;
+        int32_t elems = selector_to_elems[(int32_t)bit_to_selector[nBit]];
+        s8bSize += ((int64_t)nVal * LONG_BYTES + elems - 1) / elems;
+      }
+    }
+  }
+
+  return forSize <= TMIN(s8bSize, byte_limit);
+}
+
+static void tsForPack(const char *const input, int32_t start, int32_t nVal, const char type, int64_t ref, int32_t bits,
+                      uint8_t *out) {
+  int32_t nBytes = TS_FOR_PACKED_BYTES(nVal, bits);
+  memset(out, 0, nBytes);
+  if (bits == 0) return;
+
+  for (int32_t i = 0; i < nVal; i++) {
+    uint64_t delta = (uint64_t)tsForGetValue(input, start + i, type) - (uint64_t)ref;
+    int32_t  bitPos = i * bits;
+    int32_t  bytePos = bitPos >> 3;
+    int32_t  shift = bitPos & 7;
+
+    if (bits <= 56 && bytePos + LONG_BYTES <= nBytes) {
+      uint64_t w;
+      memcpy(&w, out + bytePos, LONG_BYTES);
+      w |= (delta << shift);
+      memcpy(out + bytePos, &w, LONG_BYTES);
+    } else {
+      for (int32_t left = bits; left > 0; bytePos++) {
+        out[bytePos] |= (uint8_t)(delta << shift);
+        delta >>= (8 - shift);
+        left -= (8 - shift);
+        shift = 0;
+      }
+    }
+  }
+}
+
+static int32_t tsCompressINTForImp(const char *const input, const int32_t nelements, char *const output,
+                                   const char type) {
+  int32_t word_length = getWordLength(type);
+  int32_t opos = 1;
+
+  for (int32_t i = 0; i < nelements; i += TS_FOR_BLOCK_VALUES) {
+    int32_t nVal = TMIN(TS_FOR_BLOCK_VALUES, nelements - i);
+    int64_t ref = 0;
+    int32_t bits = tsForBlockBits(input, i, nVal, type, &ref);
+
+    output[opos++] = (char)bits;
+    switch (type) {
+      case TSDB_DATA_TYPE_TINYINT: {
+        int8_t v = (int8_t)ref;
+        memcpy(output + opos, &v, sizeof(v));
+      } break;
+      case TSDB_DATA_TYPE_SMALLINT: {
+        int16_t v = (int16_t)ref;
+        memcpy(output + opos, &v, sizeof(v));
+      } break;
+      case TSDB_DATA_TYPE_INT: {
+        int32_t v = (int32_t)ref;
+        memcpy(output + opos, &v, sizeof(v));
+      } break;
+      default:
+        memcpy(output + opos, &ref, sizeof(ref));
+        break;
+    }
+    opos += word_length;
+
+    tsForPack(input, i, nVal, type, ref, bits, (uint8_t *)output + opos);
+    opos += TS_FOR_PACKED_BYTES(nVal, bits);
+  }
+
+  output[0] = TS_FOR_INDICATOR;
+  return opos;
+}
+
+int32_t tsCompressINTImp(const char *const input, const int32_t nelements, char *const output, const char type) {
+  // the frame-of-reference output is only chosen when it is not larger than the raw copy, so it fits the output
+  if (tsIntForCodec && type != TSDB_DATA_TYPE_TINYINT && tsCompressINTPreferFor(input, nelements, type)) {
+    return tsCompressINTForImp(input, nelements, output, type);
+  }
+  return tsCompressINTSimple8bImp(input, nelements, output, type);
+}
+
+static FORCE_INLINE uint64_t tsForUnpackOne(const uint8_t *in, int32_t nBytes, int32_t idx, int32_t bits) {
+  int32_t  bitPos = idx * bits;
+  int32_t  bytePos = bitPos >> 3;
+  int32_t  shift = bitPos & 7;
+  uint64_t mask = (bits == 64) ? UINT64_MAX : ((((uint64_t)1) << bits) - 1);
+
+  if (bits <= 56 && bytePos + LONG_BYTES <= nBytes) {
+    uint64_t w;
+    memcpy(&w, in + bytePos, LONG_BYTES);
+    return (w >> shift) & mask;
+  }
+
+  uint64_t v = in[bytePos++] >> shift;
+  for (int32_t got = 8 - shift; got < bits; got += 8) {
+    v |= ((uint64_t)in[bytePos++]) << got;
+  }
+  return v & mask;
+}
+
+static int32_t tsDecompressINTForImp(const char *const input, const int32_t nelements, char *const output,
+                                     const char type) {
+  int32_t        word_length = getWordLength(type);
+  const uint8_t *ip = (const uint8_t *)input + 1;
+  int64_t        aVal[TS_FOR_BLOCK_VALUES];
+
+  for (int32_t i = 0; i < nelements; i += TS_FOR_BLOCK_VALUES) {
+    int32_t nVal = TMIN(TS_FOR_BLOCK_VALUES, nelements - i);
+    int32_t bits = *(ip++);
+    if (bits > LONG_BYTES * BITS_PER_BYTE) {
+      uError("Invalid frame-of-reference bit width:%d", bits);
+      return -1;
+    }
+
+    int64_t ref = 0;
+    switch (type) {
+      case TSDB_DATA_TYPE_TINYINT: {
+        int8_t v;
+        memcpy(&v, ip, sizeof(v));
+        ref = v;
+      } break;
+      case TSDB_DATA_TYPE_SMALLINT: {
+        int16_t v;
+        memcpy(&v, ip, sizeof(v));
+        ref = v;
+      } break;
+      case TSDB_DATA_TYPE_INT: {
+        int32_t v;
+        memcpy(&v, ip, sizeof(v));
+        ref = v;
+      } break;
+      default:
+        memcpy(&ref, ip, sizeof(ref));
+        break;
+    }
+    ip += word_length;
+
+    // bigint is unpacked in place, narrower types go through a staging block
+    int32_t  nBytes = TS_FOR_PACKED_BYTES(nVal, bits);
+    int64_t *pVal = (type == TSDB_DATA_TYPE_BIGINT) ? ((int64_t *)output + i) : aVal;
+    int32_t  j = 0;
+    if (bits == 0) {
+      for (; j < nVal; j++) pVal[j] = ref;
+    } else {
+      if (tsSIMDEnable && tsAVX2Enable) {
+        j = tsDecompressINTForUnpackAvx2(ip, nBytes, nVal, bits, ref, pVal);
+      }
+      for (; j < nVal; j++) {
+        pVal[j] = (int64_t)(tsForUnpackOne(ip, nBytes, j, bits) + (uint64_t)ref);
+      }
+    }
+    ip += nBytes;
+
+    switch (type) {
+      case TSDB_DATA_TYPE_TINYINT: {
+        int8_t *p = (int8_t *)output + i;
+        for (j = 0; j < nVal; j++) p[j] = (int8_t)aVal[j];
+      } break;
+      case TSDB_DATA_TYPE_SMALLINT: {
+        int16_t *p = (int16_t *)output + i;
+        for (j = 0; j < nVal; j++) p[j] = (int16_t)aVal[j];
+      } break;
+      case TSDB_DATA_TYPE_INT: {
+        int32_t *p = (int32_t *)output + i;
+        for (j = 0; j < nVal; j++) p[j] = (int32_t)aVal[j];
+      } break;
+      default:
+        break;
+    }
+  }
+
+  return nelements * word_length;
+}
+
 int32_t tsDecompressINTImp(const char *const input, const int32_t nelements, char *const output, const char type) {
   int32_t word_length = getWordLength(type);
   if (word_length == -1) {
@@ -214,6 +482,10 @@ int32_t tsDecompressINTImp(const char *const input, const int32_t nelements, cha
     return nelements * word_length;
   }
 
+  if (input[0] == TS_FOR_INDICATOR) {
+    return tsDecompressINTForImp(input, nelements, output, type);
+  }
+
 #if __AVX2__
   tsDecompressIntImpl_Hw(input, nelements, output, type);
   return nelements * word_length;
@@ -605,6 +877,310 @@ int32_t tsDecompressTimestampImp(const char *const input, const int32_t nelement
   return nelements * longBytes;
 }
 
+/* --------------------------------------------Chimp128 Compression -------------------------------------------- */
+/*
+ * Chimp128 keeps the last 128 values and XORs the current value with the one among them sharing the most trailing
+ * bits (looked up through a hash of the low bits), or else with the previous value. Each value starts with a 2-bit
+ * control code, the layout below is for double, float uses a 5-bit significant count:
+ *   00: identical to the reference              [index : 7]
+ *   01: enough trailing zeros to skip them      [index : 7][leading : 3][significant : 6][significant bits]
+ *   10: same leading zeros as the last value    [64 - leading bits]
+ *   11: new leading zeros                       [leading : 3][64 - leading bits]
+ * The bit stream is little-endian, and the first value is stored as is.
+ */
+#define TS_CHIMP_INDICATOR     4  // head bytes 2 and 3 are taken by the SZ lossy stream
+#define TS_CHIMP_PREV_VALUES   128
+#define TS_CHIMP_PREV_LOG2     7
+#define TS_CHIMP_INDICES       (((int32_t)1) << (6 + TS_CHIMP_PREV_LOG2 + 1))
+#define TS_CHIMP_SAMPLE_VALUES 256
+
+bool tsFloatChimpCodec = false;
+
+static const uint8_t CHIMP_LEADING_VALUE[8] = {0, 8, 12, 16, 18, 20, 22, 24};
+
+typedef struct {
+  uint8_t *buf;
+  int32_t  cap;
+  int32_t  pos;
+  uint64_t acc;
+  int32_t  nAcc;
+} SChimpWriter;
+
+typedef struct {
+  const uint8_t *buf;
+  int32_t        pos;
+  uint64_t       acc;
+  int32_t        nAcc;
+} SChimpReader;
+
+static FORCE_INLINE int32_t chimpLeadingRepr(int32_t leading) {
+  if (leading < 8) return 0;
+  if (leading < 12) return 1;
+  if (leading < 16) return 2;
+  if (leading < 18) return 3;
+  if (leading < 20) return 4;
+  if (leading < 22) return 5;
+  if (leading < 24) return 6;
+  return 7;
+}
+
+static FORCE_INLINE void chimpWriteBits(SChimpWriter *pWriter, uint64_t val, int32_t nBits) {
+  pWriter->acc |= (val & INT64MASK(nBits)) << pWriter->nAcc;
+  pWriter->nAcc += nBits;
+  while (pWriter->nAcc >= BITS_PER_BYTE) {
+    if (pWriter->pos < pWriter->cap) pWriter->buf[pWriter->pos] = (uint8_t)pWriter->acc;
+    pWriter->pos++;
+    pWriter->acc >>= BITS_PER_BYTE;
+    pWriter->nAcc -= BITS_PER_BYTE;
+  }
+}
+
+// the accumulator keeps less than a byte between calls, so at most 32 bits are added at a time
+static FORCE_INLINE void chimpWrite(SChimpWriter *pWriter, uint64_t val, int32_t nBits) {
+  if (nBits > 32) {
+    chimpWriteBits(pWriter, val & INT64MASK(32), 32);
+    chimpWriteBits(pWriter, val >> 32, nBits - 32);
+  } else {
+    chimpWriteBits(pWriter, val, nBits);
+  }
+}
+
+static FORCE_INLINE uint64_t chimpReadBits(SChimpReader *pReader, int32_t nBits) {
+  while (pReader->nAcc < nBits) {
+    pReader->acc |= ((uint64_t)pReader->buf[pReader->pos++]) << pReader->nAcc;
+    pReader->nAcc += BITS_PER_BYTE;
+  }
+
+  uint64_t val = pReader->acc & INT64MASK(nBits);
+  pReader->acc >>= nBits;
+  pReader->nAcc -= nBits;
+  return val;
+}
+
+static FORCE_INLINE uint64_t chimpRead(SChimpReader *pReader, int32_t nBits) {
+  if (nBits > 32) {
+    uint64_t lo = chimpReadBits(pReader, 32);
+    return lo | (chimpReadBits(pReader, nBits - 32) << 32);
+  }
+  return chimpReadBits(pReader, nBits);
+}
+
+static FORCE_INLINE uint64_t chimpGetValue(const char *const input, int32_t idx, int32_t nBits) {
+  if (nBits == 64) {
+    uint64_t v;
+    memcpy(&v, input + idx * LONG_BYTES, LONG_BYTES);
+    return v;
+  } else {
+    uint32_t v;
+    memcpy(&v, input + idx * FLOAT_BYTES, FLOAT_BYTES);
+    return v;
+  }
+}
+
+static TdThreadOnce chimpIndicesInit = PTHREAD_ONCE_INIT;
+static TdThreadKey  chimpIndicesKey;
+static bool         chimpIndicesKeyValid = false;
+
+static void chimpIndicesKeyCreate(void) {
+  chimpIndicesKeyValid = (taosThreadKeyCreate(&chimpIndicesKey, taosMemoryFree) == 0);
+}
+
+// The value index table is kept per thread and never cleared: an entry left by an earlier call only counts when it
+// points into the window of the last 128 values, and then the XOR is taken with the value actually stored there.
+static int32_t *chimpGetIndices() {
+  taosThreadOnce(&chimpIndicesInit, chimpIndicesKeyCreate);
+  if (!chimpIndicesKeyValid) {
+    return NULL;
+  }
+
+  int32_t *indices = taosThreadGetSpecific(chimpIndicesKey);
+  if (indices == NULL) {
+    indices = taosMemoryCalloc(TS_CHIMP_INDICES, sizeof(int32_t));
+    if (indices != NULL && taosThreadSetSpecific(chimpIndicesKey, indices) != 0) {
+      taosMemoryFree(indices);
+      indices = NULL;
+    }
+  }
+  return indices;
+}
+
+// Encode nelements float (nBits = 32) or double (nBits = 64) values. Returns -1 if the output exceeds limit bytes.
+int32_t tsCompressChimpImp(const char *const input, const int32_t nelements, char *const output, int32_t limit,
+                           int32_t nBits) {
+  int32_t  threshold = ((nBits == 64) ? 6 : 5) + TS_CHIMP_PREV_LOG2;
+  int32_t  sigBits = (nBits == 64) ? 6 : 5;
+  uint64_t lsbMask = INT64MASK((threshold + 1));
+  uint64_t stored[TS_CHIMP_PREV_VALUES];
+  int32_t  storedLeading = nBits + 1;
+
+  int32_t *indices = chimpGetIndices();
+  if (indices == NULL) {
+    return -1;
+  }
+
+  SChimpWriter writer = {.buf = (uint8_t *)output, .cap = limit, .pos = 1};
+  if (nelements > 0) {
+    stored[0] = chimpGetValue(input, 0, nBits);
+    indices[stored[0] & lsbMask] = 0;
+    chimpWrite(&writer, stored[0], nBits);
+  }
+
+  for (int32_t i = 1; i < nelements && writer.pos <= limit; i++) {
+    uint64_t val = chimpGetValue(input, i, nBits);
+    uint64_t key = val & lsbMask;
+    int32_t  curIdx = indices[key];
+    int32_t  prevIdx = (i - 1) % TS_CHIMP_PREV_VALUES;
+    uint64_t xorVal = 0;
+    int32_t  trailing = 0;
+    bool     matched = false;
+
+    if (curIdx < i && i - curIdx < TS_CHIMP_PREV_VALUES) {
+      xorVal = val ^ stored[curIdx % TS_CHIMP_PREV_VALUES];
+      trailing = xorVal ? BUILDIN_CTZL(xorVal) : nBits;
+      if (trailing > threshold) {
+        prevIdx = curIdx % TS_CHIMP_PREV_VALUES;
+        matched = true;
+      }
+    }
+    if (!matched) {
+      xorVal = val ^ stored[prevIdx];
+      trailing = xorVal ? BUILDIN_CTZL(xorVal) : nBits;
+    }
+
+    if (xorVal == 0) {
+      chimpWrite(&writer, 0, 2);
+      chimpWrite(&writer, prevIdx, TS_CHIMP_PREV_LOG2);
+      storedLeading = nBits + 1;
+    } else {
+      int32_t repr = chimpLeadingRepr(BUILDIN_CLZL(xorVal) - (LONG_BYTES * BITS_PER_BYTE - nBits));
+      int32_t leading = CHIMP_LEADING_VALUE[repr];
+
+      if (trailing > threshold) {
+        int32_t significant = nBits - leading - trailing;
+        chimpWrite(&writer, 1, 2);
+        chimpWrite(&writer, prevIdx, TS_CHIMP_PREV_LOG2);
+        chimpWrite(&writer, repr, 3);
+        chimpWrite(&writer, significant, sigBits);
+        chimpWrite(&writer, xorVal >> trailing, significant);
+        storedLeading = nBits + 1;
+      } else if (leading == storedLeading) {
+        chimpWrite(&writer, 2, 2);
+        chimpWrite(&writer, xorVal, nBits - leading);
+      } else {
+        storedLeading = leading;
+        chimpWrite(&writer, 3, 2);
+        chimpWrite(&writer, repr, 3);
+        chimpWrite(&writer, xorVal, nBits - leading);
+      }
+    }
+
+    stored[i % TS_CHIMP_PREV_VALUES] = val;
+    indices[key] = i;
+  }
+
+  if (writer.nAcc > 0) {
+    chimpWrite(&writer, 0, BITS_PER_BYTE - writer.nAcc);
+  }
+  if (writer.pos > limit) {
+    return -1;
+  }
+
+  output[0] = TS_CHIMP_INDICATOR;
+  return writer.pos;
+}
+
+int32_t tsDecompressChimpImp(const char *const input, const int32_t nelements, char *const output, int32_t nBits) {
+  int32_t      sigBits = (nBits == 64) ? 6 : 5;
+  uint64_t     stored[TS_CHIMP_PREV_VALUES];
+  int32_t      storedLeading = nBits + 1;
+  SChimpReader reader = {.buf = (const uint8_t *)input, .pos = 1};
+
+  for (int32_t i = 0; i < nelements; i++) {
+    uint64_t val = 0;
+
+    if (i == 0) {
+      val = chimpRead(&reader, nBits);
+    } else {
+      switch (chimpRead(&reader, 2)) {
+        case 0:
+          val = stored[chimpRead(&reader, TS_CHIMP_PREV_LOG2)];
+          storedLeading = nBits + 1;
+          break;
+        case 1: {
+          int32_t idx = chimpRead(&reader, TS_CHIMP_PREV_LOG2);
+          int32_t leading = CHIMP_LEADING_VALUE[chimpRead(&reader, 3)];
+          int32_t significant = chimpRead(&reader, sigBits);
+          if (leading + significant > nBits) {
+            uError("Invalid chimp significant bits:%d, leading:%d", significant, leading);
+            return -1;
+          }
+          val = stored[idx] ^ (chimpRead(&reader, significant) << (nBits - leading - significant));
+          storedLeading = nBits + 1;
+        } break;
+        case 2:
+          if (storedLeading > nBits) {
+            uError("Invalid chimp stream, no leading zeros to reuse at %d", i);
+            return -1;
+          }
+          val = stored[(i - 1) % TS_CHIMP_PREV_VALUES] ^ chimpRead(&reader, nBits - storedLeading);
+          break;
+        default:
+          storedLeading = CHIMP_LEADING_VALUE[chimpRead(&reader, 3)];
+          val = stored[(i - 1) % TS_CHIMP_PREV_VALUES] ^ chimpRead(&reader, nBits - storedLeading);
+          break;
+      }
+    }
+
+    stored[i % TS_CHIMP_PREV_VALUES] = val;
+    if (nBits == 64) {
+      memcpy(output + i * LONG_BYTES, &val, LONG_BYTES);
+    } else {
+      uint32_t v = (uint32_t)val;
+      memcpy(output + i * FLOAT_BYTES, &v, FLOAT_BYTES);
+    }
+  }
+
+  return nelements * (nBits / BITS_PER_BYTE);
+}
+
+// Encode the first values of the block both ways and go on with chimp only if it wins on them. The chimp output is
+// bounded by the raw size of the values, the byte-granular XOR encoding is used if it gets larger.
+static int32_t tsCompressXorOrChimp(const char *const input, const int32_t nelements, char *const output,
+                                    int32_t nBits) {
+  if (!tsFloatChimpCodec) {
+    return (nBits == 64) ? tsCompressDoubleXorImp(input, nelements, output)
+                         : tsCompressFloatXorImp(input, nelements, output);
+  }
+
+  int32_t nSample = TMIN(nelements, TS_CHIMP_SAMPLE_VALUES);
+  char    xorBuf[TS_CHIMP_SAMPLE_VALUES * LONG_BYTES + 1];
+  char    chimpBuf[TS_CHIMP_SAMPLE_VALUES * LONG_BYTES + 1];
+
+  int32_t xorLen = (nBits == 64) ? tsCompressDoubleXorImp(input, nSample, xorBuf)
+                                 : tsCompressFloatXorImp(input, nSample, xorBuf);
+  int32_t chimpLen = tsCompressChimpImp(input, nSample, chimpBuf, xorLen - 1, nBits);
+
+  // the sample is the whole block
+  if (nSample == nelements) {
+    if (chimpLen > 0) {
+      memcpy(output, chimpBuf, chimpLen);
+      return chimpLen;
+    }
+    memcpy(output, xorBuf, xorLen);
+    return xorLen;
+  }
+
+  if (chimpLen > 0) {
+    chimpLen = tsCompressChimpImp(input, nelements, output, nelements * (nBits / BITS_PER_BYTE), nBits);
+    if (chimpLen > 0) {
+      return chimpLen;
+    }
+  }
+
+  return (nBits == 64) ? tsCompressDoubleXorImp(input, nelements, output)
+                       : tsCompressFloatXorImp(input, nelements, output);
+}
+
 /* --------------------------------------------Double Compression ---------------------------------------------- */
 void encodeDoubleValue(uint64_t diff, uint8_t flag, char *const output, int32_t *const pos) {
   int32_t longBytes = LONG_BYTES;
@@ -620,7 +1196,7 @@ void encodeDoubleValue(uint64_t diff, uint8_t flag, char *const output, int32_t
   }
 }
 
-int32_t tsCompressDoubleImp(const char *const input, const int32_t nelements, char *const output) {
+int32_t tsCompressDoubleXorImp(const char *const input, const int32_t nelements, char *const output) {
   int32_t byte_limit = nelements * DOUBLE_BYTES + 1;
   int32_t opos = 1;
 
@@ -704,6 +1280,10 @@ int32_t tsCompressDoubleImp(const char *const input, const int32_t nelements, ch
   return opos;
 }
 
+int32_t tsCompressDoubleImp(const char *const input, const int32_t nelements, char *const output) {
+  return tsCompressXorOrChimp(input, nelements, output, DOUBLE_BYTES * BITS_PER_BYTE);
+}
+
 FORCE_INLINE uint64_t decodeDoubleValue(const char *const input, int32_t *const ipos, uint8_t flag) {
   int32_t longBytes = LONG_BYTES;
 
@@ -727,6 +1307,17 @@ int32_t tsDecompressDoubleImp(const char *const input, const int32_t nelements,
     return nelements * DOUBLE_BYTES;
   }
 
+  if (input[0] == TS_CHIMP_INDICATOR) {
+    return tsDecompressChimpImp(input, nelements, output, DOUBLE_BYTES * BITS_PER_BYTE);
+  }
+
+#if __AVX2__
+  if (tsSIMDEnable && tsAVX2Enable) {
+    tsDecompressDoubleImplAvx2(input, nelements, output);
+    return nelements * DOUBLE_BYTES;
+  }
+#endif
+
   uint8_t  flags = 0;
   int32_t  ipos = 1;
   int32_t  opos = 0;
@@ -766,7 +1357,7 @@ void encodeFloatValue(uint32_t diff, uint8_t flag, char *const output, int32_t *
   }
 }
 
-int32_t tsCompressFloatImp(const char *const input, const int32_t nelements, char *const output) {
+int32_t tsCompressFloatXorImp(const char *const input, const int32_t nelements, char *const output) {
   float  *istream = (float *)input;
   int32_t byte_limit = nelements * FLOAT_BYTES + 1;
   int32_t opos = 1;
@@ -849,6 +1440,10 @@ int32_t tsCompressFloatImp(const char *const input, const int32_t nelements, cha
   return opos;
 }
 
+int32_t tsCompressFloatImp(const char *const input, const int32_t nelements, char *const output) {
+  return tsCompressXorOrChimp(input, nelements, output, FLOAT_BYTES * BITS_PER_BYTE);
+}
+
 uint32_t decodeFloatValue(const char *const input, int32_t *const ipos, uint8_t flag) {
   uint32_t diff = 0ul;
   int32_t  nbytes = (flag & INT8MASK(3)) + 1;
@@ -895,13 +1490,18 @@ int32_t tsDecompressFloatImp(const char *const input, const int32_t nelements, c
     return nelements * FLOAT_BYTES;
   }
 
+  if (input[0] == TS_CHIMP_INDICATOR) {
+    return tsDecompressChimpImp(input, nelements, output, FLOAT_BYTES * BITS_PER_BYTE);
+  }
+
+#if __AVX2__
   if (tsSIMDEnable && tsAVX2Enable) {
     tsDecompressFloatImplAvx2(input, nelements, output);
-  } else if (tsSIMDEnable && tsAVX512Enable) {
-    tsDecompressFloatImplAvx512(input, nelements, output);
-  } else { // alternative implementation without SIMD instructions.
-    tsDecompressFloatHelper(input, nelements, (float*)output);
+    return nelements * FLOAT_BYTES;
   }
+#endif
+  // alternative implementation without SIMD instructions.
+  tsDecompressFloatHelper(input, nelements, (float*)output);
 
   return nelements * FLOAT_BYTES;
 }
@@ -315,6 +315,35 @@ int32_t tsDecompressIntImpl_Hw(const char *const input, const int32_t nelements,
   return nelements * word_length;
 }
 
+// Unpack frame-of-reference values four at a time. Each lane gathers the 8 bytes holding its value, so only
+// bit widths up to 56 are handled and the tail that would read past the packed bytes is left to the caller.
+int32_t tsDecompressINTForUnpackAvx2(const uint8_t *const input, int32_t nBytes, int32_t nelements, int32_t bits,
+                                    int64_t ref, int64_t *const output) {
+  int32_t i = 0;
+#if __AVX2__
+  if (bits > 56) {
+    return i;
+  }
+
+  const __m256i mask = _mm256_set1_epi64x((int64_t)((((uint64_t)1) << bits) - 1));
+  const __m256i base = _mm256_set1_epi64x(ref);
+  const __m256i seq = _mm256_setr_epi64x(0, bits, 2 * bits, 3 * bits);
+  const __m256i seven = _mm256_set1_epi64x(7);
+
+  for (; i + 4 <= nelements; i += 4) {
+    if ((((i + 3) * bits) >> 3) + LONG_BYTES > nBytes) {
+      break;
+    }
+
+    __m256i bitPos = _mm256_add_epi64(_mm256_set1_epi64x((int64_t)i * bits), seq);
+    __m256i w = _mm256_i64gather_epi64((const long long *)input, _mm256_srli_epi64(bitPos, 3), 1);
+    w = _mm256_and_si256(_mm256_srlv_epi64(w, _mm256_and_si256(bitPos, seven)), mask);
+    _mm256_storeu_si256((__m256i *)(output + i), _mm256_add_epi64(w, base));
+  }
+#endif
+  return i;
+}
+
 int32_t tsDecompressFloatImplAvx512(const char *const input, const int32_t nelements, char *const output) {
 #if __AVX512F__
     // todo add it
@@ -322,11 +351,118 @@ int32_t tsDecompressFloatImplAvx512(const char *const input, const int32_t nelem
   return 0;
 }
 
-// todo add later
+// The byte-granular XOR stream of float and double is decoded in two passes: a scalar pass parses the flags and
+// bytes into XOR deltas, which do not depend on each other, then an AVX2 prefix XOR rebuilds the values.
+#define XOR_DECODE_BATCH 256
+
 int32_t tsDecompressFloatImplAvx2(const char *const input, const int32_t nelements, char *const output) {
 #if __AVX2__
+  const uint8_t *ip = (const uint8_t *)input + 1;
+  uint32_t      *ostream = (uint32_t *)output;
+  uint32_t       aDiff[XOR_DECODE_BATCH];
+  uint8_t        flags = 0;
+
+  const __m256i idx1 = _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6);
+  const __m256i idx2 = _mm256_setr_epi32(0, 0, 0, 1, 2, 3, 4, 5);
+  const __m256i idx4 = _mm256_setr_epi32(0, 0, 0, 0, 0, 1, 2, 3);
+  const __m256i mask1 = _mm256_setr_epi32(0, -1, -1, -1, -1, -1, -1, -1);
+  const __m256i mask2 = _mm256_setr_epi32(0, 0, -1, -1, -1, -1, -1, -1);
+  const __m256i mask4 = _mm256_setr_epi32(0, 0, 0, 0, -1, -1, -1, -1);
+  const __m256i lastLane = _mm256_set1_epi32(7);
+  __m256i       carry = _mm256_setzero_si256();
+
+  for (int32_t start = 0; start < nelements; start += XOR_DECODE_BATCH) {
+    int32_t num = TMIN(XOR_DECODE_BATCH, nelements - start);
+
+    for (int32_t i = 0; i < num; i++) {
+      if ((i & 0x01) == 0) {
+        flags = *(ip++);
+      }
+
+      uint8_t flag = flags & INT8MASK(4);
+      flags >>= 4;
+
+      int32_t  nbytes = (flag & INT8MASK(3)) + 1;
+      uint32_t diff = 0;
+      for (int32_t k = 0; k < nbytes; k++) {
+        diff |= ((uint32_t)ip[k]) << (BITS_PER_BYTE * k);
+      }
+      ip += nbytes;
+      aDiff[i] = diff << ((FLOAT_BYTES - nbytes) * BITS_PER_BYTE * (flag >> 3));
+    }
+
+    int32_t i = 0;
+    for (; i + 8 <= num; i += 8) {
+      __m256i x = _mm256_loadu_si256((__m256i *)(aDiff + i));
+      x = _mm256_xor_si256(x, _mm256_and_si256(_mm256_permutevar8x32_epi32(x, idx1), mask1));
+      x = _mm256_xor_si256(x, _mm256_and_si256(_mm256_permutevar8x32_epi32(x, idx2), mask2));
+      x = _mm256_xor_si256(x, _mm256_and_si256(_mm256_permutevar8x32_epi32(x, idx4), mask4));
+      x = _mm256_xor_si256(x, carry);
+      _mm256_storeu_si256((__m256i *)(ostream + start + i), x);
+      carry = _mm256_permutevar8x32_epi32(x, lastLane);
+    }
+
+    uint32_t prev = (uint32_t)_mm256_extract_epi32(carry, 0);
+    for (; i < num; i++) {
+      prev ^= aDiff[i];
+      ostream[start + i] = prev;
+    }
+    carry = _mm256_set1_epi32((int32_t)prev);
+  }
+#endif
+  return nelements * FLOAT_BYTES;
+}
+
+int32_t tsDecompressDoubleImplAvx2(const char *const input, const int32_t nelements, char *const output) {
+#if __AVX2__
+  const uint8_t *ip = (const uint8_t *)input + 1;
+  uint64_t      *ostream = (uint64_t *)output;
+  uint64_t       aDiff[XOR_DECODE_BATCH];
+  uint8_t        flags = 0;
+
+  const __m256i mask1 = _mm256_setr_epi64x(0, -1, -1, -1);
+  const __m256i mask2 = _mm256_setr_epi64x(0, 0, -1, -1);
+  __m256i       carry = _mm256_setzero_si256();
+
+  for (int32_t start = 0; start < nelements; start += XOR_DECODE_BATCH) {
+    int32_t num = TMIN(XOR_DECODE_BATCH, nelements - start);
+
+    for (int32_t i = 0; i < num; i++) {
+      if ((i & 0x01) == 0) {
+        flags = *(ip++);
+      }
+
+      uint8_t flag = flags & INT8MASK(4);
+      flags >>= 4;
+
+      int32_t  nbytes = (flag & INT8MASK(3)) + 1;
+      uint64_t diff = 0;
+      for (int32_t k = 0; k < nbytes; k++) {
+        diff |= ((uint64_t)ip[k]) << (BITS_PER_BYTE * k);
+      }
+      ip += nbytes;
+      aDiff[i] = diff << ((LONG_BYTES - nbytes) * BITS_PER_BYTE * (flag >> 3));
+    }
+
+    int32_t i = 0;
+    for (; i + 4 <= num; i += 4) {
+      __m256i x = _mm256_loadu_si256((__m256i *)(aDiff + i));
+      x = _mm256_xor_si256(x, _mm256_and_si256(_mm256_permute4x64_epi64(x, _MM_SHUFFLE(2, 1, 0, 0)), mask1));
+      x = _mm256_xor_si256(x, _mm256_and_si256(_mm256_permute4x64_epi64(x, _MM_SHUFFLE(1, 0, 0, 0)), mask2));
+      x = _mm256_xor_si256(x, carry);
+      _mm256_storeu_si256((__m256i *)(ostream + start + i), x);
+      carry = _mm256_permute4x64_epi64(x, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+
+    uint64_t prev = (uint64_t)_mm256_extract_epi64(carry, 0);
+    for (; i < num; i++) {
+      prev ^= aDiff[i];
+      ostream[start + i] = prev;
+    }
+    carry = _mm256_set1_epi64x((int64_t)prev);
+  }
 #endif
-  return 0;
+  return nelements * DOUBLE_BYTES;
 }
 
 int32_t tsDecompressTimestampAvx2(const char *const input, const int32_t nelements, char *const output,
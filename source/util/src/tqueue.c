@@ -16,20 +16,28 @@
 #define _DEFAULT_SOURCE
 #include "tqueue.h"
 #include "taoserror.h"
+#include "tlockfree.h"
 #include "tlog.h"
 
 int64_t tsRpcQueueMemoryAllowed = 0;
 int64_t tsRpcQueueMemoryUsed = 0;
 
+// Items are linked in an intrusive MPSC list (Vyukov): producers append with a single atomic exchange on tail and
+// take no lock, consumers pop from head and are serialized by mutex. The list always holds at least one node, the
+// stub is pushed back whenever the last item is popped. The item counters and qset are read and updated under the
+// read side of qsetLatch, so attaching the queue to a qset or detaching it, which takes the write side, sees every
+// item either before or after it counts in the qset.
 struct STaosQueue {
-  STaosQnode   *head;
-  STaosQnode   *tail;
+  STaosQnode   *head;  // consumer side
+  STaosQnode   *tail;  // producer side
+  STaosQnode   *stub;
   STaosQueue   *next;     // for queue set
   STaosQset    *qset;     // for queue set
   void         *ahandle;  // for queue set
   FItem         itemFp;
   FItems        itemsFp;
   TdThreadMutex mutex;
+  SRWLatch      qsetLatch;
   int64_t       memOfItems;
   int32_t       numOfItems;
   int64_t       threadId;
@@ -58,6 +66,47 @@ struct STaosQall {
 void taosSetQueueMemoryCapacity(STaosQueue *queue, int64_t cap) { queue->memLimit = cap; }
 void taosSetQueueCapacity(STaosQueue *queue, int64_t size) { queue->itemLimit = size; }
 
+static void taosQueuePush(STaosQueue *queue, STaosQnode *pNode) {
+  pNode->next = NULL;
+  STaosQnode *prev = atomic_exchange_ptr(&queue->tail, pNode);
+  atomic_store_ptr(&prev->next, pNode);
+}
+
+// a producer has swapped tail but not linked its node yet, it is only a few instructions away
+static STaosQnode *taosQueueWaitNext(STaosQnode *pNode) {
+  STaosQnode *next;
+  while ((next = atomic_load_ptr(&pNode->next)) == NULL) {
+    sched_yield();
+  }
+  return next;
+}
+
+// must be called with queue->mutex locked, returns NULL only if the queue is empty
+static STaosQnode *taosQueuePop(STaosQueue *queue) {
+  STaosQnode *head = queue->head;
+  STaosQnode *next = atomic_load_ptr(&head->next);
+
+  if (head == queue->stub) {
+    if (next == NULL) {
+      if (atomic_load_ptr(&queue->tail) == head) return NULL;
+      next = taosQueueWaitNext(head);
+    }
+    queue->head = next;
+    head = next;
+    next = atomic_load_ptr(&head->next);
+  }
+
+  if (next == NULL) {
+    if (atomic_load_ptr(&queue->tail) == head) {
+      taosQueuePush(queue, queue->stub);
+    }
+    next = taosQueueWaitNext(head);
+  }
+
+  queue->head = next;
+  return head;
+}
+
 STaosQueue *taosOpenQueue() {
   STaosQueue *queue = taosMemoryCalloc(1, sizeof(STaosQueue));
   if (queue == NULL) {
@@ -65,7 +114,19 @@ STaosQueue *taosOpenQueue() {
     return NULL;
   }
 
+  queue->stub = taosMemoryCalloc(1, sizeof(STaosQnode));
+  if (queue->stub == NULL) {
+    taosMemoryFree(queue);
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
+  }
+  queue->head = queue->stub;
+  queue->tail = queue->stub;
+  taosInitRWLatch(&queue->qsetLatch);
+
   if (taosThreadMutexInit(&queue->mutex, NULL) != 0) {
+    taosMemoryFree(queue->stub);
+    taosMemoryFree(queue);
     terrno = TSDB_CODE_OUT_OF_MEMORY;
     return NULL;
   }
@@ -85,23 +146,22 @@ void taosCloseQueue(STaosQueue *queue) {
   STaosQnode *pTemp;
   STaosQset  *qset;
 
-  taosThreadMutexLock(&queue->mutex);
-  STaosQnode *pNode = queue->head;
-  queue->head = NULL;
+  taosRLockLatch(&queue->qsetLatch);
   qset = queue->qset;
-  taosThreadMutexUnlock(&queue->mutex);
+  taosRUnLockLatch(&queue->qsetLatch);
 
-  if (queue->qset) {
+  if (qset) {
     taosRemoveFromQset(qset, queue);
   }
 
-  while (pNode) {
-    pTemp = pNode;
-    pNode = pNode->next;
+  taosThreadMutexLock(&queue->mutex);
+  while ((pTemp = taosQueuePop(queue)) != NULL) {
     taosMemoryFree(pTemp);
   }
+  taosThreadMutexUnlock(&queue->mutex);
 
   taosThreadMutexDestroy(&queue->mutex);
+  taosMemoryFree(queue->stub);
   taosMemoryFree(queue);
 
   uDebug("queue:%p is closed", queue);
@@ -110,40 +170,26 @@ void taosCloseQueue(STaosQueue *queue) {
 bool taosQueueEmpty(STaosQueue *queue) {
   if (queue == NULL) return true;
 
-  bool empty = false;
-  taosThreadMutexLock(&queue->mutex);
-  if (queue->head == NULL && queue->tail == NULL && queue->numOfItems == 0 /*&& queue->memOfItems == 0*/) {
-    empty = true;
-  }
-  taosThreadMutexUnlock(&queue->mutex);
-
-  return empty;
+  return atomic_load_32(&queue->numOfItems) == 0 && atomic_load_ptr(&queue->tail) == queue->stub &&
+         atomic_load_ptr(&queue->stub->next) == NULL;
 }
 
 void taosUpdateItemSize(STaosQueue *queue, int32_t items) {
   if (queue == NULL) return;
 
-  taosThreadMutexLock(&queue->mutex);
-  queue->numOfItems -= items;
-  taosThreadMutexUnlock(&queue->mutex);
+  atomic_sub_fetch_32(&queue->numOfItems, items);
 }
 
 int32_t taosQueueItemSize(STaosQueue *queue) {
   if (queue == NULL) return 0;
 
-  taosThreadMutexLock(&queue->mutex);
-  int32_t numOfItems = queue->numOfItems;
-  taosThreadMutexUnlock(&queue->mutex);
-
-  uTrace("queue:%p, numOfItems:%d memOfItems:%" PRId64, queue, queue->numOfItems, queue->memOfItems);
+  int32_t numOfItems = atomic_load_32(&queue->numOfItems);
+  uTrace("queue:%p, numOfItems:%d memOfItems:%" PRId64, queue, numOfItems, atomic_load_64(&queue->memOfItems));
   return numOfItems;
 }
 
 int64_t taosQueueMemorySize(STaosQueue *queue) {
-  taosThreadMutexLock(&queue->mutex);
-  int64_t memOfItems = queue->memOfItems;
-  taosThreadMutexUnlock(&queue->mutex);
-  return memOfItems;
+  return atomic_load_64(&queue->memOfItems);
 }
 
 void *taosAllocateQitem(int32_t size, EQItype itype, int64_t dataSize) {
@@ -193,41 +239,40 @@ void taosFreeQitem(void *pItem) {
 int32_t taosWriteQitem(STaosQueue *queue, void *pItem) {
   int32_t     code = 0;
   STaosQnode *pNode = (STaosQnode *)(((char *)pItem) - sizeof(STaosQnode));
+  int64_t     size = pNode->size + pNode->dataSize;
   pNode->timestamp = taosGetTimestampUs();
-  pNode->next = NULL;
 
-  taosThreadMutexLock(&queue->mutex);
-  if (queue->memLimit > 0 && (queue->memOfItems + pNode->size + pNode->dataSize) > queue->memLimit) {
+  taosRLockLatch(&queue->qsetLatch);
+
+  // reserve first, so that concurrent producers can not overshoot the limits together
+  int64_t memOfItems = atomic_add_fetch_64(&queue->memOfItems, size);
+  int32_t numOfItems = atomic_add_fetch_32(&queue->numOfItems, 1);
+  if (queue->memLimit > 0 && memOfItems > queue->memLimit) {
     code = TSDB_CODE_UTIL_QUEUE_OUT_OF_MEMORY;
     uError("item:%p failed to put into queue:%p, queue mem limit: %" PRId64 ", reason: %s" PRId64, pItem, queue,
            queue->memLimit, tstrerror(code));
-
-    taosThreadMutexUnlock(&queue->mutex);
-    return code;
-  } else if (queue->itemLimit > 0 && queue->numOfItems + 1 > queue->itemLimit) {
+  } else if (queue->itemLimit > 0 && numOfItems > queue->itemLimit) {
     code = TSDB_CODE_UTIL_QUEUE_OUT_OF_MEMORY;
     uError("item:%p failed to put into queue:%p, queue size limit: %" PRId64 ", reason: %s" PRId64, pItem, queue,
            queue->itemLimit, tstrerror(code));
-    taosThreadMutexUnlock(&queue->mutex);
+  }
+  if (code != 0) {
+    atomic_sub_fetch_64(&queue->memOfItems, size);
+    atomic_sub_fetch_32(&queue->numOfItems, 1);
+    taosRUnLockLatch(&queue->qsetLatch);
     return code;
   }
 
-  if (queue->tail) {
-    queue->tail->next = pNode;
-    queue->tail = pNode;
-  } else {
-    queue->head = pNode;
-    queue->tail = pNode;
-  }
-  queue->numOfItems++;
-  queue->memOfItems += (pNode->size + pNode->dataSize);
-  if (queue->qset) atomic_add_fetch_32(&queue->qset->numOfItems, 1);
+  STaosQset *qset = queue->qset;
+  if (qset) atomic_add_fetch_32(&qset->numOfItems, 1);
 
-  uTrace("item:%p is put into queue:%p, items:%d mem:%" PRId64, pItem, queue, queue->numOfItems, queue->memOfItems);
+  taosQueuePush(queue, pNode);
 
-  taosThreadMutexUnlock(&queue->mutex);
+  uTrace("item:%p is put into queue:%p, items:%d mem:%" PRId64, pItem, queue, numOfItems, memOfItems);
 
-  if (queue->qset) tsem_post(&queue->qset->sem);
+  // the qset can not be detached or closed before the post
+  if (qset) tsem_post(&qset->sem);
+  taosRUnLockLatch(&queue->qsetLatch);
   return code;
 }
 
@@ -236,25 +281,47 @@ int32_t taosReadQitem(STaosQueue *queue, void **ppItem) {
   int32_t     code = 0;
 
   taosThreadMutexLock(&queue->mutex);
+  pNode = taosQueuePop(queue);
+  taosThreadMutexUnlock(&queue->mutex);
 
-  if (queue->head) {
-    pNode = queue->head;
+  if (pNode) {
     *ppItem = pNode->item;
-    queue->head = pNode->next;
-    if (queue->head == NULL) queue->tail = NULL;
-    queue->numOfItems--;
-    queue->memOfItems -= (pNode->size + pNode->dataSize);
+    taosRLockLatch(&queue->qsetLatch);
+    int32_t numOfItems = atomic_sub_fetch_32(&queue->numOfItems, 1);
+    int64_t memOfItems = atomic_sub_fetch_64(&queue->memOfItems, pNode->size + pNode->dataSize);
     if (queue->qset) atomic_sub_fetch_32(&queue->qset->numOfItems, 1);
+    taosRUnLockLatch(&queue->qsetLatch);
     code = 1;
-    uTrace("item:%p is read out from queue:%p, items:%d mem:%" PRId64, *ppItem, queue, queue->numOfItems,
-           queue->memOfItems);
+    uTrace("item:%p is read out from queue:%p, items:%d mem:%" PRId64, *ppItem, queue, numOfItems, memOfItems);
   }
 
-  taosThreadMutexUnlock(&queue->mutex);
-
   return code;
 }
 
+// pop all the items linked so far into qall, must be called with queue->mutex locked
+static int32_t taosQueuePopAll(STaosQueue *queue, STaosQall *qall) {
+  STaosQnode *pNode;
+  STaosQnode *pLast = NULL;
+
+  memset(qall, 0, sizeof(STaosQall));
+  while ((pNode = taosQueuePop(queue)) != NULL) {
+    pNode->next = NULL;
+    if (pLast) {
+      pLast->next = pNode;
+    } else {
+      qall->start = pNode;
+    }
+    pLast = pNode;
+    qall->numOfItems++;
+    qall->memOfItems += (pNode->size + pNode->dataSize);
+  }
+
+  qall->current = qall->start;
+  qall->unAccessedNumOfItems = qall->numOfItems;
+  qall->unAccessMemOfItems = qall->memOfItems;
+  return qall->numOfItems;
+}
+
 STaosQall *taosAllocateQall() {
   STaosQall *qall = taosMemoryCalloc(1, sizeof(STaosQall));
   if (qall != NULL) {
@@ -267,40 +334,21 @@ void taosFreeQall(STaosQall *qall) { taosMemoryFree(qall); }
 
 int32_t taosReadAllQitems(STaosQueue *queue, STaosQall *qall) {
   int32_t numOfItems = 0;
-  bool    empty;
 
   taosThreadMutexLock(&queue->mutex);
-
-  empty = queue->head == NULL;
-  if (!empty) {
-    memset(qall, 0, sizeof(STaosQall));
-    qall->current = queue->head;
-    qall->start = queue->head;
-    qall->numOfItems = queue->numOfItems;
-    qall->memOfItems = queue->memOfItems;
-
-    qall->unAccessedNumOfItems = queue->numOfItems;
-    qall->unAccessMemOfItems = queue->memOfItems;
-
-    numOfItems = qall->numOfItems;
-
-    queue->head = NULL;
-    queue->tail = NULL;
-    queue->numOfItems = 0;
-    queue->memOfItems = 0;
-    uTrace("read %d items from queue:%p, items:%d mem:%" PRId64, numOfItems, queue, queue->numOfItems,
-           queue->memOfItems);
-    if (queue->qset) atomic_sub_fetch_32(&queue->qset->numOfItems, qall->numOfItems);
-  }
-
+  numOfItems = taosQueuePopAll(queue, qall);
   taosThreadMutexUnlock(&queue->mutex);
 
-  // if source queue is empty, we set destination qall to empty too.
-  if (empty) {
-    qall->current = NULL;
-    qall->start = NULL;
-    qall->numOfItems = 0;
+  if (numOfItems > 0) {
+    taosRLockLatch(&queue->qsetLatch);
+    atomic_sub_fetch_32(&queue->numOfItems, numOfItems);
+    atomic_sub_fetch_64(&queue->memOfItems, qall->memOfItems);
+    if (queue->qset) atomic_sub_fetch_32(&queue->qset->numOfItems, numOfItems);
+    taosRUnLockLatch(&queue->qsetLatch);
+    uTrace("read %d items from queue:%p, items:%d mem:%" PRId64, numOfItems, queue, atomic_load_32(&queue->numOfItems),
+           atomic_load_64(&queue->memOfItems));
   }
+
   return numOfItems;
 }
 
@@ -349,8 +397,10 @@ void taosCloseQset(STaosQset *qset) {
     STaosQueue *queue = qset->head;
     qset->head = qset->head->next;
 
+    taosWLockLatch(&queue->qsetLatch);
     queue->qset = NULL;
     queue->next = NULL;
+    taosWUnLockLatch(&queue->qsetLatch);
   }
   taosThreadMutexUnlock(&qset->mutex);
 
@@ -369,19 +419,24 @@ void taosQsetThreadResume(STaosQset *qset) {
 }
 
 int32_t taosAddIntoQset(STaosQset *qset, STaosQueue *queue, void *ahandle) {
-  if (queue->qset) return -1;
-
   taosThreadMutexLock(&qset->mutex);
 
+  // no producer or consumer is between updating the queue counters and the qset counter
+  taosWLockLatch(&queue->qsetLatch);
+  if (queue->qset) {
+    taosWUnLockLatch(&queue->qsetLatch);
+    taosThreadMutexUnlock(&qset->mutex);
+    return -1;
+  }
+
   queue->next = qset->head;
   queue->ahandle = ahandle;
   qset->head = queue;
   qset->numOfQueues++;
 
-  taosThreadMutexLock(&queue->mutex);
   atomic_add_fetch_32(&qset->numOfItems, queue->numOfItems);
   queue->qset = qset;
-  taosThreadMutexUnlock(&queue->mutex);
+  taosWUnLockLatch(&queue->qsetLatch);
 
   taosThreadMutexUnlock(&qset->mutex);
 
@@ -416,11 +471,11 @@ void taosRemoveFromQset(STaosQset *qset, STaosQueue *queue) {
       if (qset->current == queue) qset->current = tqueue->next;
       qset->numOfQueues--;
 
-      taosThreadMutexLock(&queue->mutex);
+      taosWLockLatch(&queue->qsetLatch);
       atomic_sub_fetch_32(&qset->numOfItems, queue->numOfItems);
       queue->qset = NULL;
       queue->next = NULL;
-      taosThreadMutexUnlock(&queue->mutex);
+      taosWUnLockLatch(&queue->qsetLatch);
     }
   }
 
@@ -429,12 +484,10 @@ void taosRemoveFromQset(STaosQset *qset, STaosQueue *queue) {
   uDebug("queue:%p is removed from qset:%p", queue, qset);
 }
 
-int32_t taosReadQitemFromQset(STaosQset *qset, void **ppItem, SQueueInfo *qinfo) {
+static int32_t taosReadQitemFromQsetImpl(STaosQset *qset, void **ppItem, SQueueInfo *qinfo) {
   STaosQnode *pNode = NULL;
   int32_t     code = 0;
 
-  tsem_wait(&qset->sem);
-
   taosThreadMutexLock(&qset->mutex);
 
   for (int32_t i = 0; i < qset->numOfQueues; ++i) {
@@ -442,30 +495,26 @@ int32_t taosReadQitemFromQset(STaosQset *qset, void **ppItem, SQueueInfo *qinfo)
     STaosQueue *queue = qset->current;
     if (queue) qset->current = queue->next;
     if (queue == NULL) break;
-    if (queue->head == NULL) continue;
 
     taosThreadMutexLock(&queue->mutex);
+    pNode = taosQueuePop(queue);
+    taosThreadMutexUnlock(&queue->mutex);
 
-    if (queue->head) {
-      pNode = queue->head;
+    if (pNode) {
       *ppItem = pNode->item;
       qinfo->ahandle = queue->ahandle;
       qinfo->fp = queue->itemFp;
       qinfo->queue = queue;
       qinfo->timestamp = pNode->timestamp;
 
-      queue->head = pNode->next;
-      if (queue->head == NULL) queue->tail = NULL;
-      // queue->numOfItems--;
-      queue->memOfItems -= (pNode->size + pNode->dataSize);
+      // queue->numOfItems is decreased by the consumer with taosUpdateItemSize
+      int64_t memOfItems = atomic_sub_fetch_64(&queue->memOfItems, pNode->size + pNode->dataSize);
       atomic_sub_fetch_32(&qset->numOfItems, 1);
       code = 1;
-      uTrace("item:%p is read out from queue:%p, items:%d mem:%" PRId64, *ppItem, queue, queue->numOfItems - 1,
-             queue->memOfItems);
+      uTrace("item:%p is read out from queue:%p, items:%d mem:%" PRId64, *ppItem, queue,
+             atomic_load_32(&queue->numOfItems) - 1, memOfItems);
+      break;
     }
-
-    taosThreadMutexUnlock(&queue->mutex);
-    if (pNode) break;
   }
 
   taosThreadMutexUnlock(&qset->mutex);
@@ -473,6 +522,22 @@ int32_t taosReadQitemFromQset(STaosQset *qset, void **ppItem, SQueueInfo *qinfo)
   return code;
 }
 
+int32_t taosReadQitemFromQset(STaosQset *qset, void **ppItem, SQueueInfo *qinfo) {
+  tsem_wait(&qset->sem);
+  return taosReadQitemFromQsetImpl(qset, ppItem, qinfo);
+}
+
+int32_t taosTryReadQitemFromQset(STaosQset *qset, void **ppItem, SQueueInfo *qinfo) {
+  if (tsem_timewait(&qset->sem, 0) != 0) return 0;
+
+  int32_t code = taosReadQitemFromQsetImpl(qset, ppItem, qinfo);
+  if (code == 0) {
+    // the post was a wakeup for the qset owner instead of an item, hand it back
+    tsem_post(&qset->sem);
+  }
+  return code;
+}
+
 int32_t taosReadAllQitemsFromQset(STaosQset *qset, STaosQall *qall, SQueueInfo *qinfo) {
   STaosQueue *queue;
   int32_t     code = 0;
@@ -485,37 +550,27 @@ int32_t taosReadAllQitemsFromQset(STaosQset *qset, STaosQall *qall, SQueueInfo *
     queue = qset->current;
     if (queue) qset->current = queue->next;
     if (queue == NULL) break;
-    if (queue->head == NULL) continue;
 
     taosThreadMutexLock(&queue->mutex);
+    code = taosQueuePopAll(queue, qall);
+    taosThreadMutexUnlock(&queue->mutex);
 
-    if (queue->head) {
-      qall->current = queue->head;
-      qall->start = queue->head;
-      qall->numOfItems = queue->numOfItems;
-      qall->memOfItems = queue->memOfItems;
-
-      code = qall->numOfItems;
+    if (code != 0) {
       qinfo->ahandle = queue->ahandle;
       qinfo->fp = queue->itemsFp;
       qinfo->queue = queue;
-      qinfo->timestamp = queue->head->timestamp;
+      qinfo->timestamp = qall->start->timestamp;
 
-      queue->head = NULL;
-      queue->tail = NULL;
-      // queue->numOfItems = 0;
-      queue->memOfItems = 0;
-      uTrace("read %d items from queue:%p, items:0 mem:%" PRId64, code, queue, queue->memOfItems);
+      // queue->numOfItems is decreased by the consumer with taosUpdateItemSize
+      int64_t memOfItems = atomic_sub_fetch_64(&queue->memOfItems, qall->memOfItems);
+      uTrace("read %d items from queue:%p, mem:%" PRId64, code, queue, memOfItems);
 
       atomic_sub_fetch_32(&qset->numOfItems, qall->numOfItems);
       for (int32_t j = 1; j < qall->numOfItems; ++j) {
         tsem_wait(&qset->sem);
       }
+      break;
     }
-
-    taosThreadMutexUnlock(&queue->mutex);
-
-    if (code != 0) break;
   }
 
   taosThreadMutexUnlock(&qset->mutex);
@@ -531,6 +586,15 @@ int64_t taosQallUnAccessedMemSize(STaosQall *qall) { return qall->unAccessMemOfI
 void    taosResetQitems(STaosQall *qall) { qall->current = qall->start; }
 int32_t taosGetQueueNumber(STaosQset *qset) { return qset->numOfQueues; }
 
+int32_t taosQsetItemSize(STaosQset *qset) { return atomic_load_32(&qset->numOfItems); }
+
+STaosQset *taosQueueGetQset(STaosQueue *queue) {
+  taosRLockLatch(&queue->qsetLatch);
+  STaosQset *qset = queue->qset;
+  taosRUnLockLatch(&queue->qsetLatch);
+  return qset;
+}
+
 void taosQueueSetThreadId(STaosQueue* pQueue, int64_t threadId) {
   pQueue->threadId = threadId;
 }
@@ -284,6 +284,237 @@ void tAutoQWorkerFreeQueue(SAutoQWorkerPool *pool, STaosQueue *queue) {
   taosCloseQueue(queue);
 }
 
+static void *tStealQWorkerThreadFp(SStealQWorker *worker);
+
+int32_t tStealQWorkerInit(SStealQWorkerPool *pool) {
+  pool->num = 0;
+  pool->stop = 0;
+  pool->workers = taosMemoryCalloc(pool->max, sizeof(SStealQWorker));
+  if (pool->workers == NULL) {
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return -1;
+  }
+
+  (void)taosThreadMutexInit(&pool->mutex, NULL);
+
+  for (int32_t i = 0; i < pool->max; ++i) {
+    SStealQWorker *worker = pool->workers + i;
+    worker->id = i;
+    worker->pool = pool;
+    worker->qset = taosOpenQset();
+    if (worker->qset == NULL) {
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      return -1;
+    }
+  }
+
+  // all workers are launched up front, an idle worker is useful as a thief even if it owns no queue
+  for (int32_t i = 0; i < pool->max; ++i) {
+    SStealQWorker *worker = pool->workers + i;
+
+    TdThreadAttr thAttr;
+    taosThreadAttrInit(&thAttr);
+    taosThreadAttrSetDetachState(&thAttr, PTHREAD_CREATE_JOINABLE);
+
+    if (taosThreadCreate(&worker->thread, &thAttr, (ThreadFp)tStealQWorkerThreadFp, worker) != 0) {
+      uError("worker:%s:%d failed to create thread, total:%d", pool->name, worker->id, pool->num);
+      taosThreadAttrDestroy(&thAttr);
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      return -1;
+    }
+
+    taosThreadAttrDestroy(&thAttr);
+    pool->num++;
+    uInfo("worker:%s:%d is launched, total:%d", pool->name, worker->id, pool->num);
+  }
+
+  uInfo("worker:%s is initialized as work stealing, max:%d", pool->name, pool->max);
+  return 0;
+}
+
+void tStealQWorkerCleanup(SStealQWorkerPool *pool) {
+  if (pool->workers == NULL) return;
+
+  atomic_store_8(&pool->stop, 1);
+  for (int32_t i = 0; i < pool->max; ++i) {
+    SStealQWorker *worker = pool->workers + i;
+    if (taosCheckPthreadValid(worker->thread)) {
+      taosQsetThreadResume(worker->qset);
+    }
+  }
+
+  for (int32_t i = 0; i < pool->max; ++i) {
+    SStealQWorker *worker = pool->workers + i;
+    if (taosCheckPthreadValid(worker->thread)) {
+      uInfo("worker:%s:%d is stopping", pool->name, worker->id);
+      taosThreadJoin(worker->thread, NULL);
+      taosThreadClear(&worker->thread);
+      uInfo("worker:%s:%d is stopped", pool->name, worker->id);
+    }
+  }
+
+  for (int32_t i = 0; i < pool->max; ++i) {
+    taosCloseQset(pool->workers[i].qset);
+  }
+
+  taosMemoryFreeClear(pool->workers);
+  taosThreadMutexDestroy(&pool->mutex);
+
+  uInfo("worker:%s is closed", pool->name);
+}
+
+// called when the queues of a busy worker have items waiting, wake up one idle worker to steal from it
+static void tStealQWorkerWakeIdle(SStealQWorkerPool *pool, SStealQWorker *worker) {
+  for (int32_t i = 1; i < pool->num; ++i) {
+    SStealQWorker *peer = pool->workers + (worker->id + i) % pool->num;
+    if (atomic_val_compare_exchange_8(&peer->idle, 1, 0) == 1) {
+      taosQsetThreadResume(peer->qset);
+      return;
+    }
+  }
+}
+
+static SStealQWorker *tStealQWorkerSteal(SStealQWorkerPool *pool, SStealQWorker *worker, void **msg,
+                                         SQueueInfo *qinfo) {
+  for (int32_t i = 1; i < pool->num; ++i) {
+    SStealQWorker *peer = pool->workers + (worker->id + i) % pool->num;
+    if (taosQsetItemSize(peer->qset) <= 0) continue;
+    if (taosTryReadQitemFromQset(peer->qset, msg, qinfo) != 0) return peer;
+  }
+  return NULL;
+}
+
+static void *tStealQWorkerThreadFp(SStealQWorker *worker) {
+  SStealQWorkerPool *pool = worker->pool;
+  SQueueInfo         qinfo = {0};
+  void              *msg = NULL;
+
+  taosBlockSIGPIPE();
+  setThreadName(pool->name);
+  worker->pid = taosGetSelfPthreadId();
+  uInfo("worker:%s:%d is running, thread:%08" PRId64, pool->name, worker->id, worker->pid);
+
+  while (1) {
+    SStealQWorker *owner = worker;
+
+    // own items first, then those of the peers before going to sleep: a writer only wakes a worker that is idle, so
+    // an item queued while every worker was busy is left for whoever gets here first. Being marked idle before the
+    // scan, an item queued after it wakes this worker up again.
+    atomic_store_8(&worker->idle, 1);
+    int32_t code = taosTryReadQitemFromQset(worker->qset, (void **)&msg, &qinfo);
+    if (code == 0) {
+      owner = tStealQWorkerSteal(pool, worker, (void **)&msg, &qinfo);
+      if (owner == NULL) {
+        owner = worker;
+        code = taosReadQitemFromQset(worker->qset, (void **)&msg, &qinfo);
+      }
+    }
+    atomic_store_8(&worker->idle, 0);
+
+    if (owner == worker && code == 0) {
+      // woken up without an item of its own, either to exit or to steal
+      if (atomic_load_8(&pool->stop)) {
+        uInfo("worker:%s:%d qset:%p, got no message and exiting, thread:%08" PRId64, pool->name, worker->id,
+              worker->qset, worker->pid);
+        break;
+      }
+
+      // another thief may have taken the item it was woken for, the loop scans once more before sleeping
+      owner = tStealQWorkerSteal(pool, worker, (void **)&msg, &qinfo);
+      if (owner == NULL) continue;
+    }
+
+    if (owner != worker) {
+      atomic_add_fetch_64(&worker->numOfStolen, 1);
+    }
+
+    if (taosQsetItemSize(owner->qset) > 0) {
+      tStealQWorkerWakeIdle(pool, worker);
+    }
+
+    int64_t startTs = taosGetTimestampUs();
+    if (qinfo.timestamp != 0) {
+      int64_t cost = startTs - qinfo.timestamp;
+      if (cost > QUEUE_THRESHOLD) {
+        uWarn("worker:%s,message has been queued for too long, cost: %" PRId64 "s", pool->name, cost / QUEUE_THRESHOLD);
+      }
+    }
+
+    if (qinfo.fp != NULL) {
+      qinfo.workerId = worker->id;
+      qinfo.threadNum = pool->num;
+      (*((FItem)qinfo.fp))(&qinfo, msg);
+    }
+
+    taosUpdateItemSize(qinfo.queue, 1);
+    atomic_add_fetch_64(&worker->numOfProcessed, 1);
+    atomic_add_fetch_64(&worker->busyTime, taosGetTimestampUs() - startTs);
+  }
+
+  destroyThreadLocalGeosCtx();
+
+  return NULL;
+}
+
+STaosQueue *tStealQWorkerAllocQueue(SStealQWorkerPool *pool, void *ahandle, FItem fp) {
+  STaosQueue *queue = taosOpenQueue();
+  if (queue == NULL) return NULL;
+
+  taosThreadMutexLock(&pool->mutex);
+  taosSetQueueFp(queue, fp, NULL);
+
+  // bind the queue to the worker owning the fewest queues
+  SStealQWorker *worker = pool->workers;
+  for (int32_t i = 1; i < pool->max; ++i) {
+    if (taosGetQueueNumber(pool->workers[i].qset) < taosGetQueueNumber(worker->qset)) {
+      worker = pool->workers + i;
+    }
+  }
+  taosAddIntoQset(worker->qset, queue, ahandle);
+
+  taosThreadMutexUnlock(&pool->mutex);
+  uInfo("worker:%s:%d, queue:%p is allocated, ahandle:%p", pool->name, worker->id, queue, ahandle);
+
+  return queue;
+}
+
+void tStealQWorkerFreeQueue(SStealQWorkerPool *pool, STaosQueue *queue) {
+  uInfo("worker:%s, queue:%p is freed", pool->name, queue);
+  taosCloseQueue(queue);
+}
+
+// an idle owner is woken by the item itself, a busy one would leave it waiting until its current item is done
+int32_t tStealQWorkerWriteQitem(SStealQWorkerPool *pool, STaosQueue *queue, void *pItem) {
+  int32_t code = taosWriteQitem(queue, pItem);
+  if (code != 0) return code;
+
+  STaosQset *qset = taosQueueGetQset(queue);
+  for (int32_t i = 0; i < pool->num; ++i) {
+    SStealQWorker *worker = pool->workers + i;
+    if (worker->qset == qset) {
+      if (!atomic_load_8(&worker->idle)) {
+        tStealQWorkerWakeIdle(pool, worker);
+      }
+      break;
+    }
+  }
+  return 0;
+}
+
+void tStealQWorkerGetStat(SStealQWorkerPool *pool, SArray *pStats) {
+  for (int32_t i = 0; i < pool->num; ++i) {
+    SStealQWorker    *worker = pool->workers + i;
+    SStealQWorkerStat stat = {
+        .id = worker->id,
+        .numOfQueues = taosGetQueueNumber(worker->qset),
+        .numOfProcessed = atomic_load_64(&worker->numOfProcessed),
+        .numOfStolen = atomic_load_64(&worker->numOfStolen),
+        .busyTime = atomic_load_64(&worker->busyTime),
+    };
+    taosArrayPush(pStats, &stat);
+  }
+}
+
 int32_t tWWorkerInit(SWWorkerPool *pool) {
   pool->nextId = 0;
   pool->workers = taosMemoryCalloc(pool->max, sizeof(SWWorker));
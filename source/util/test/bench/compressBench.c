@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Compare the compression ratio and decode throughput of the byte-granular XOR codec and chimp128 on
+// float/double series shaped like sensor data.
+// usage: compressBench [rows] [loops]
+
+#include "os.h"
+#include "tcompression.h"
+
+typedef struct {
+  const char *name;
+  double (*gen)(int32_t i, double prev, uint32_t *seed);
+} SBenchSeries;
+
+// temperature read with 0.01 resolution, drifting slowly
+static double benchTemperature(int32_t i, double prev, uint32_t *seed) {
+  double v = (i == 0) ? 23.5 : prev + ((int32_t)(taosRandR(seed) % 21) - 10) * 0.01;
+  return round(v * 100) / 100;
+}
+
+// humidity following a daily cycle with sensor noise
+static double benchHumidity(int32_t i, double prev, uint32_t *seed) {
+  return 55 + 20 * sin(i * 2 * M_PI / 8640) + (taosRandR(seed) % 1000) * 1e-4;
+}
+
+// mains voltage, mostly flat with rare jitter
+static double benchVoltage(int32_t i, double prev, uint32_t *seed) {
+  return (taosRandR(seed) % 50 == 0) ? 220.0 + (taosRandR(seed) % 7) * 0.1 : 220.0;
+}
+
+// energy meter, a monotonic counter stored as double
+static double benchEnergy(int32_t i, double prev, uint32_t *seed) {
+  return (i == 0) ? 12345.6 : prev + (taosRandR(seed) % 4) * 0.001;
+}
+
+static void benchRun(const SBenchSeries *pSeries, bool isDouble, int32_t rows, int32_t loops) {
+  int32_t  bytes = isDouble ? DOUBLE_BYTES : FLOAT_BYTES;
+  int32_t  nBits = bytes * 8;
+  char    *pIn = taosMemoryMalloc(rows * bytes);
+  char    *pCmpr = taosMemoryMalloc(rows * bytes + 1);
+  char    *pOut = taosMemoryMalloc(rows * bytes);
+  uint32_t seed = 1;
+  double   prev = 0;
+
+  for (int32_t i = 0; i < rows; ++i) {
+    prev = pSeries->gen(i, prev, &seed);
+    if (isDouble) {
+      ((double *)pIn)[i] = prev;
+    } else {
+      ((float *)pIn)[i] = (float)prev;
+    }
+  }
+
+  for (int32_t codec = 0; codec < 2; ++codec) {
+    int32_t len = 0;
+    if (codec == 0) {
+      len = isDouble ? tsCompressDoubleXorImp(pIn, rows, pCmpr) : tsCompressFloatXorImp(pIn, rows, pCmpr);
+    } else {
+      len = tsCompressChimpImp(pIn, rows, pCmpr, rows * bytes + 1, nBits);
+    }
+
+    if (len < 0) {
+      printf("%-12s %-6s %-8s exceeds the raw size\n", pSeries->name, isDouble ? "double" : "float",
+             codec ? "chimp" : "xor");
+      continue;
+    }
+
+    int64_t st = taosGetTimestampUs();
+    for (int32_t k = 0; k < loops; ++k) {
+      if (isDouble) {
+        tsDecompressDouble(pCmpr, len, rows, pOut, rows * bytes, ONE_STAGE_COMP, NULL, 0);
+      } else {
+        tsDecompressFloat(pCmpr, len, rows, pOut, rows * bytes, ONE_STAGE_COMP, NULL, 0);
+      }
+    }
+    int64_t el = TMAX(taosGetTimestampUs() - st, 1);
+
+    printf("%-12s %-6s %-8s ratio:%6.2f decode:%7.3f GB/s%s\n", pSeries->name, isDouble ? "double" : "float",
+           codec ? "chimp" : "xor", (double)rows * bytes / len, (double)rows * bytes * loops / el / 1e3,
+           memcmp(pIn, pOut, rows * bytes) ? " MISMATCH" : "");
+  }
+
+  taosMemoryFree(pIn);
+  taosMemoryFree(pCmpr);
+  taosMemoryFree(pOut);
+}
+
+int main(int argc, char *argv[]) {
+  int32_t rows = (argc > 1) ? atoi(argv[1]) : 4096;
+  int32_t loops = (argc > 2) ? atoi(argv[2]) : 2000;
+
+  taosGetSystemInfo();
+  tsSIMDEnable = 1;
+
+  SBenchSeries series[] = {
+      {"temperature", benchTemperature},
+      {"humidity", benchHumidity},
+      {"voltage", benchVoltage},
+      {"energy", benchEnergy},
+  };
+
+  printf("rows:%d loops:%d simd:%d avx2:%d\n", rows, loops, tsSIMDEnable, tsAVX2Enable);
+  for (int32_t i = 0; i < sizeof(series) / sizeof(series[0]); ++i) {
+    benchRun(&series[i], true, rows, loops);
+    benchRun(&series[i], false, rows, loops);
+  }
+
+  return 0;
+}
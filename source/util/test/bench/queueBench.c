@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Compare the enqueue/dequeue throughput of STaosQueue against a mutex protected list, the way the queue was built
+// before producers went lock-free, with 1 to 64 producer threads feeding one consumer.
+// usage: queueBench [itemsPerProducer] [maxProducers]
+
+#include "os.h"
+#include "tqueue.h"
+
+typedef struct SBenchNode {
+  struct SBenchNode *next;
+  int64_t            value;
+} SBenchNode;
+
+typedef struct {
+  TdThreadMutex mutex;
+  SBenchNode   *head;
+  SBenchNode   *tail;
+  int32_t       numOfItems;
+} SBenchMutexQueue;
+
+typedef struct {
+  int32_t           mode;  // 0: mutex list, 1: STaosQueue read all, 2: STaosQueue via qset
+  int32_t           items;
+  STaosQueue       *queue;
+  SBenchMutexQueue *mqueue;
+} SBenchProducer;
+
+static void benchMutexPush(SBenchMutexQueue *q, SBenchNode *pNode) {
+  pNode->next = NULL;
+  taosThreadMutexLock(&q->mutex);
+  if (q->tail) {
+    q->tail->next = pNode;
+  } else {
+    q->head = pNode;
+  }
+  q->tail = pNode;
+  q->numOfItems++;
+  taosThreadMutexUnlock(&q->mutex);
+}
+
+static int32_t benchMutexPopAll(SBenchMutexQueue *q) {
+  taosThreadMutexLock(&q->mutex);
+  SBenchNode *pNode = q->head;
+  q->head = q->tail = NULL;
+  q->numOfItems = 0;
+  taosThreadMutexUnlock(&q->mutex);
+
+  int32_t num = 0;
+  while (pNode) {
+    SBenchNode *pNext = pNode->next;
+    taosMemoryFree(pNode);
+    pNode = pNext;
+    num++;
+  }
+  return num;
+}
+
+static void *benchProduce(void *param) {
+  SBenchProducer *pProducer = param;
+  for (int32_t i = 0; i < pProducer->items; ++i) {
+    if (pProducer->mode == 0) {
+      SBenchNode *pNode = taosMemoryMalloc(sizeof(SBenchNode));
+      pNode->value = i;
+      benchMutexPush(pProducer->mqueue, pNode);
+    } else {
+      int64_t *pItem = taosAllocateQitem(sizeof(int64_t), DEF_QITEM, 0);
+      *pItem = i;
+      while (taosWriteQitem(pProducer->queue, pItem) != 0) {
+        sched_yield();
+      }
+    }
+  }
+  return NULL;
+}
+
+static int32_t benchConsume(int32_t mode, STaosQueue *queue, STaosQset *qset, SBenchMutexQueue *mqueue,
+                            STaosQall *qall) {
+  int32_t    num = 0;
+  void      *pItem = NULL;
+  SQueueInfo qinfo = {0};
+
+  if (mode == 0) return benchMutexPopAll(mqueue);
+
+  if (mode == 1) {
+    num = taosReadAllQitems(queue, qall);
+  } else {
+    num = taosReadAllQitemsFromQset(qset, qall, &qinfo);
+    if (num > 0) taosUpdateItemSize(queue, num);
+  }
+
+  for (int32_t i = 0; i < num; ++i) {
+    taosGetQitem(qall, &pItem);
+    taosFreeQitem(pItem);
+  }
+  return num;
+}
+
+static void benchRun(int32_t mode, int32_t nProducer, int32_t items) {
+  static const char *modes[] = {"mutex", "queue", "qset"};
+
+  SBenchMutexQueue mqueue = {0};
+  STaosQueue      *queue = taosOpenQueue();
+  STaosQset       *qset = taosOpenQset();
+  STaosQall       *qall = taosAllocateQall();
+  taosThreadMutexInit(&mqueue.mutex, NULL);
+  taosAddIntoQset(qset, queue, NULL);
+
+  SBenchProducer *producers = taosMemoryCalloc(nProducer, sizeof(SBenchProducer));
+  TdThread       *threads = taosMemoryCalloc(nProducer, sizeof(TdThread));
+
+  int64_t st = taosGetTimestampUs();
+  for (int32_t i = 0; i < nProducer; ++i) {
+    producers[i] = (SBenchProducer){.mode = mode, .items = items, .queue = queue, .mqueue = &mqueue};
+    taosThreadCreate(&threads[i], NULL, benchProduce, &producers[i]);
+  }
+
+  int64_t total = (int64_t)nProducer * items;
+  int64_t consumed = 0;
+  while (consumed < total) {
+    int32_t num = benchConsume(mode, queue, qset, &mqueue, qall);
+    if (num == 0 && mode != 2) sched_yield();
+    consumed += num;
+  }
+
+  for (int32_t i = 0; i < nProducer; ++i) {
+    taosThreadJoin(threads[i], NULL);
+  }
+  int64_t el = TMAX(taosGetTimestampUs() - st, 1);
+
+  printf("%-6s producers:%-3d items:%-10" PRId64 " %8.3f Mops/s\n", modes[mode], nProducer, total,
+         (double)total / el);
+
+  taosMemoryFree(threads);
+  taosMemoryFree(producers);
+  taosRemoveFromQset(qset, queue);
+  taosFreeQall(qall);
+  taosCloseQset(qset);
+  taosCloseQueue(queue);
+  taosThreadMutexDestroy(&mqueue.mutex);
+}
+
+int main(int argc, char *argv[]) {
+  int32_t items = (argc > 1) ? atoi(argv[1]) : 200000;
+  int32_t maxProducers = (argc > 2) ? atoi(argv[2]) : 64;
+
+  printf("items per producer:%d\n", items);
+  for (int32_t nProducer = 1; nProducer <= maxProducers; nProducer *= 2) {
+    for (int32_t mode = 0; mode < 3; ++mode) {
+      benchRun(mode, nProducer, items);
+    }
+  }
+
+  return 0;
+}
@@ -92,3 +92,119 @@ TEST(utilTest, decompress_perf_test) {
   taosMemoryFree(px);
 }
 
+
+TEST(utilTest, decompress_int_for_test) {
+  int32_t  num = 1000;
+  uint32_t seed = 100;
+
+  int32_t* pList = static_cast<int32_t*>(taosMemoryCalloc(num, sizeof(int32_t)));
+  for (int32_t i = 0; i < num; ++i) {
+    pList[i] = 100000 + taosRandR(&seed) % 200;
+  }
+
+  // not written unless enabled, older versions cannot read it
+  char*   px = static_cast<char*>(taosMemoryMalloc(num * sizeof(int32_t) + 1));
+  int32_t len = tsCompressInt(pList, num * sizeof(int32_t), num, px, num * sizeof(int32_t) + 1, ONE_STAGE_COMP, NULL, 0);
+  ASSERT_EQ(px[0], 0);
+
+  tsIntForCodec = true;
+  len = tsCompressInt(pList, num * sizeof(int32_t), num, px, num * sizeof(int32_t) + 1, ONE_STAGE_COMP, NULL, 0);
+  ASSERT_EQ(px[0], 2);
+  ASSERT_LT(len, (int32_t)(num * sizeof(int32_t)));
+
+  int32_t* pOutput = static_cast<int32_t*>(taosMemoryCalloc(num, sizeof(int32_t)));
+  tsDecompressInt(px, len, num, pOutput, num * sizeof(int32_t), ONE_STAGE_COMP, NULL, 0);
+  for (int32_t i = 0; i < num; ++i) {
+    ASSERT_EQ(pList[i], pOutput[i]);
+  }
+
+  // a counter has small deltas but a wide range, simple 8B is kept
+  for (int32_t i = 0; i < num; ++i) {
+    pList[i] = i * 3;
+  }
+  len = tsCompressInt(pList, num * sizeof(int32_t), num, px, num * sizeof(int32_t) + 1, ONE_STAGE_COMP, NULL, 0);
+  ASSERT_EQ(px[0], 0);
+  tsDecompressInt(px, len, num, pOutput, num * sizeof(int32_t), ONE_STAGE_COMP, NULL, 0);
+  for (int32_t i = 0; i < num; ++i) {
+    ASSERT_EQ(pList[i], pOutput[i]);
+  }
+
+  // bigint spanning the full range falls back to the raw copy, a constant block packs with zero bits
+  int64_t bigList[300] = {0};
+  for (int32_t i = 0; i < 300; ++i) {
+    bigList[i] = (i < 128) ? -7 : ((i & 1) ? INT64_MAX : INT64_MIN);
+  }
+
+  char    bigBuf[300 * sizeof(int64_t) + 1] = {0};
+  int64_t bigOut[300] = {0};
+  len = tsCompressBigint(bigList, sizeof(bigList), 300, bigBuf, sizeof(bigBuf), ONE_STAGE_COMP, NULL, 0);
+  tsDecompressBigint(bigBuf, len, 300, bigOut, sizeof(bigOut), ONE_STAGE_COMP, NULL, 0);
+  for (int32_t i = 0; i < 300; ++i) {
+    ASSERT_EQ(bigList[i], bigOut[i]);
+  }
+  tsIntForCodec = false;
+
+  taosMemoryFree(pList);
+  taosMemoryFree(pOutput);
+  taosMemoryFree(px);
+}
+
+TEST(utilTest, decompress_chimp_test) {
+  int32_t  num = 1000;
+  uint32_t seed = 100;
+
+  double* pList = static_cast<double*>(taosMemoryCalloc(num, sizeof(double)));
+  float*  pFList = static_cast<float*>(taosMemoryCalloc(num, sizeof(float)));
+  for (int32_t i = 0; i < num; ++i) {
+    pList[i] = (i % 10 == 0) ? 20.0 : 20.0 + (taosRandR(&seed) % 5) * 0.25;
+    pFList[i] = (float)pList[i];
+  }
+
+  // not written unless enabled, older versions cannot read it
+  char*   px = static_cast<char*>(taosMemoryMalloc(num * sizeof(double) + 1));
+  int32_t len = tsCompressDouble(pList, num * sizeof(double), num, px, num * sizeof(double) + 1, ONE_STAGE_COMP, NULL, 0);
+  ASSERT_NE(px[0], 4);
+
+  tsFloatChimpCodec = true;
+  len = tsCompressDouble(pList, num * sizeof(double), num, px, num * sizeof(double) + 1, ONE_STAGE_COMP, NULL, 0);
+  ASSERT_EQ(px[0], 4);
+
+  double* pOutput = static_cast<double*>(taosMemoryCalloc(num, sizeof(double)));
+  tsDecompressDouble(px, len, num, pOutput, num * sizeof(double), ONE_STAGE_COMP, NULL, 0);
+  ASSERT_EQ(memcmp(pList, pOutput, num * sizeof(double)), 0);
+
+  len = tsCompressFloat(pFList, num * sizeof(float), num, px, num * sizeof(float) + 1, ONE_STAGE_COMP, NULL, 0);
+  ASSERT_EQ(px[0], 4);
+
+  memset(pOutput, 0, num * sizeof(double));
+  tsDecompressFloat(px, len, num, pOutput, num * sizeof(float), ONE_STAGE_COMP, NULL, 0);
+  ASSERT_EQ(memcmp(pFList, pOutput, num * sizeof(float)), 0);
+
+  // the index table is reused from the calls above, a short block is decided on the whole of it
+  for (int32_t i = 0; i < 100; ++i) {
+    pList[i] = 30.0 + (taosRandR(&seed) % 3) * 0.5;
+  }
+  len = tsCompressDouble(pList, 100 * sizeof(double), 100, px, 100 * sizeof(double) + 1, ONE_STAGE_COMP, NULL, 0);
+  ASSERT_EQ(px[0], 4);
+
+  memset(pOutput, 0, num * sizeof(double));
+  tsDecompressDouble(px, len, 100, pOutput, 100 * sizeof(double), ONE_STAGE_COMP, NULL, 0);
+  ASSERT_EQ(memcmp(pList, pOutput, 100 * sizeof(double)), 0);
+
+  // values with few shared bits, whichever encoding is picked has to round trip
+  for (int32_t i = 0; i < num; ++i) {
+    pList[i] = (double)taosRandR(&seed) / (taosRandR(&seed) % 1000 + 3);
+  }
+  len = tsCompressDouble(pList, num * sizeof(double), num, px, num * sizeof(double) + 1, ONE_STAGE_COMP, NULL, 0);
+  ASSERT_LE(len, (int32_t)(num * sizeof(double) + 1));
+
+  memset(pOutput, 0, num * sizeof(double));
+  tsDecompressDouble(px, len, num, pOutput, num * sizeof(double), ONE_STAGE_COMP, NULL, 0);
+  ASSERT_EQ(memcmp(pList, pOutput, num * sizeof(double)), 0);
+  tsFloatChimpCodec = false;
+
+  taosMemoryFree(pList);
+  taosMemoryFree(pFList);
+  taosMemoryFree(pOutput);
+  taosMemoryFree(px);
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "tqueue.h"
+
+namespace {
+
+const int32_t kProducers = 8;
+const int32_t kItemsPerProducer = 20000;
+
+void produce(STaosQueue *queue) {
+  for (int32_t i = 0; i < kItemsPerProducer; i++) {
+    void *pItem = taosAllocateQitem(sizeof(int64_t), DEF_QITEM, 0);
+    ASSERT_NE(pItem, nullptr);
+    ASSERT_EQ(taosWriteQitem(queue, pItem), 0);
+  }
+}
+
+// attach the queue to the qset and detach it again until stopped, leaves it attached
+void toggleQset(STaosQset *qset, STaosQueue *queue, std::atomic<bool> *stop) {
+  while (!stop->load()) {
+    taosRemoveFromQset(qset, queue);
+    ASSERT_EQ(taosAddIntoQset(qset, queue, NULL), 0);
+  }
+}
+
+}  // namespace
+
+// the qset counts every item of an attached queue exactly once, however attaching races with producers
+TEST(queueTest, attachDuringWrites) {
+  STaosQueue *queue = taosOpenQueue();
+  STaosQset  *qset = taosOpenQset();
+  ASSERT_EQ(taosAddIntoQset(qset, queue, NULL), 0);
+  ASSERT_EQ(taosAddIntoQset(qset, queue, NULL), -1);
+
+  std::atomic<bool>        stop(false);
+  std::thread              toggler(toggleQset, qset, queue, &stop);
+  std::vector<std::thread> producers;
+  for (int32_t i = 0; i < kProducers; i++) {
+    producers.emplace_back(produce, queue);
+  }
+  for (auto &t : producers) t.join();
+  stop = true;
+  toggler.join();
+
+  int32_t total = kProducers * kItemsPerProducer;
+  EXPECT_EQ(taosQueueItemSize(queue), total);
+  EXPECT_EQ(taosQsetItemSize(qset), total);
+
+  void *pItem = NULL;
+  for (int32_t i = 0; i < total; i++) {
+    ASSERT_EQ(taosReadQitem(queue, &pItem), 1);
+    taosFreeQitem(pItem);
+  }
+  EXPECT_EQ(taosReadQitem(queue, &pItem), 0);
+  EXPECT_EQ(taosQueueItemSize(queue), 0);
+  EXPECT_EQ(taosQsetItemSize(qset), 0);
+
+  taosCloseQueue(queue);
+  taosCloseQset(qset);
+}
+
+// consumers drain the queue while producers write and the queue moves in and out of the qset
+TEST(queueTest, attachDuringReadsAndWrites) {
+  STaosQueue *queue = taosOpenQueue();
+  STaosQset  *qset = taosOpenQset();
+  ASSERT_EQ(taosAddIntoQset(qset, queue, NULL), 0);
+
+  int32_t              total = kProducers * kItemsPerProducer;
+  std::atomic<int32_t> nRead(0);
+  std::atomic<bool>    stop(false);
+
+  std::thread              toggler(toggleQset, qset, queue, &stop);
+  std::vector<std::thread> threads;
+  for (int32_t i = 0; i < kProducers; i++) {
+    threads.emplace_back(produce, queue);
+  }
+  for (int32_t i = 0; i < 2; i++) {
+    threads.emplace_back([&]() {
+      void *pItem = NULL;
+      while (nRead.load() < total) {
+        if (taosReadQitem(queue, &pItem)) {
+          taosFreeQitem(pItem);
+          nRead++;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto &t : threads) t.join();
+  stop = true;
+  toggler.join();
+
+  EXPECT_EQ(nRead.load(), total);
+  EXPECT_TRUE(taosQueueEmpty(queue));
+  EXPECT_EQ(taosQueueItemSize(queue), 0);
+  EXPECT_EQ(taosQueueMemorySize(queue), 0);
+  EXPECT_EQ(taosQsetItemSize(qset), 0);
+
+  taosCloseQueue(queue);
+  taosCloseQset(qset);
+}
+
+// closing a queue detaches it from the qset and frees the items left
+TEST(queueTest, closeAttachedQueue) {
+  STaosQueue *queue = taosOpenQueue();
+  STaosQset  *qset = taosOpenQset();
+  ASSERT_EQ(taosAddIntoQset(qset, queue, NULL), 0);
+
+  for (int32_t i = 0; i < 10; i++) {
+    ASSERT_EQ(taosWriteQitem(queue, taosAllocateQitem(sizeof(int64_t), DEF_QITEM, 0)), 0);
+  }
+  EXPECT_EQ(taosQsetItemSize(qset), 10);
+
+  taosCloseQueue(queue);
+  EXPECT_EQ(taosGetQueueNumber(qset), 0);
+  EXPECT_EQ(taosQsetItemSize(qset), 0);
+  taosCloseQset(qset);
+}
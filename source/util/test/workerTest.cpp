@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "tworker.h"
+
+namespace {
+
+typedef struct {
+  int32_t id;
+} SItem;
+
+std::atomic<int32_t> numOfProcessed;
+std::atomic<int32_t> workerOfItem[3];
+std::atomic<bool>    firstStarted;
+std::atomic<bool>    releaseFirst;
+std::atomic<int32_t> numOfStarted;
+std::atomic<bool>    releaseItem[2];
+
+void countItem(SQueueInfo *pInfo, void *pItem) {
+  numOfProcessed++;
+  taosFreeQitem(pItem);
+}
+
+// item 0 keeps its worker busy until released
+void blockFirstItem(SQueueInfo *pInfo, void *pItem) {
+  int32_t id = ((SItem *)pItem)->id;
+  workerOfItem[id] = pInfo->workerId;
+  if (id == 0) {
+    firstStarted = true;
+    while (!releaseFirst) taosMsleep(1);
+  }
+  numOfProcessed++;
+  taosFreeQitem(pItem);
+}
+
+// items 0 and 1 keep their workers busy until each is released
+void blockTwoItems(SQueueInfo *pInfo, void *pItem) {
+  int32_t id = ((SItem *)pItem)->id;
+  workerOfItem[id] = pInfo->workerId;
+  if (id < 2) {
+    numOfStarted++;
+    while (!releaseItem[id]) taosMsleep(1);
+  }
+  numOfProcessed++;
+  taosFreeQitem(pItem);
+}
+
+void writeItem(SStealQWorkerPool *pool, STaosQueue *queue, int32_t id) {
+  SItem *pItem = (SItem *)taosAllocateQitem(sizeof(SItem), DEF_QITEM, 0);
+  ASSERT_NE(pItem, nullptr);
+  pItem->id = id;
+  ASSERT_EQ(tStealQWorkerWriteQitem(pool, queue, pItem), 0);
+}
+
+bool waitFor(const std::atomic<int32_t> &counter, int32_t value) {
+  for (int32_t i = 0; i < 5000 && counter.load() < value; i++) taosMsleep(1);
+  return counter.load() >= value;
+}
+
+}  // namespace
+
+TEST(workerTest, stealQWorkerProcessAll) {
+  SStealQWorkerPool pool = {0};
+  pool.name = "test-steal";
+  pool.max = 4;
+  ASSERT_EQ(tStealQWorkerInit(&pool), 0);
+
+  const int32_t            numOfQueues = 8;
+  const int32_t            numOfItems = 1000;
+  std::vector<STaosQueue *> queues;
+  for (int32_t i = 0; i < numOfQueues; i++) {
+    queues.push_back(tStealQWorkerAllocQueue(&pool, NULL, countItem));
+    ASSERT_NE(queues.back(), nullptr);
+  }
+
+  numOfProcessed = 0;
+  std::vector<std::thread> producers;
+  for (int32_t p = 0; p < 2; p++) {
+    producers.emplace_back([&]() {
+      for (int32_t i = 0; i < numOfItems / 2; i++) {
+        for (STaosQueue *queue : queues) writeItem(&pool, queue, 0);
+      }
+    });
+  }
+  for (auto &t : producers) t.join();
+  ASSERT_TRUE(waitFor(numOfProcessed, numOfQueues * numOfItems));
+
+  // the processed counter is bumped after the handler returns
+  taosMsleep(10);
+
+  SArray *pStats = taosArrayInit(4, sizeof(SStealQWorkerStat));
+  tStealQWorkerGetStat(&pool, pStats);
+  ASSERT_EQ(taosArrayGetSize(pStats), pool.max);
+  int64_t processed = 0;
+  int32_t queueNum = 0;
+  for (int32_t i = 0; i < taosArrayGetSize(pStats); i++) {
+    SStealQWorkerStat *pStat = (SStealQWorkerStat *)taosArrayGet(pStats, i);
+    EXPECT_EQ(pStat->numOfQueues, numOfQueues / pool.max);
+    processed += pStat->numOfProcessed;
+    queueNum += pStat->numOfQueues;
+  }
+  EXPECT_EQ(processed, numOfQueues * numOfItems);
+  EXPECT_EQ(queueNum, numOfQueues);
+
+  // reading the counters does not reset them
+  SArray *pStats2 = taosArrayInit(4, sizeof(SStealQWorkerStat));
+  tStealQWorkerGetStat(&pool, pStats2);
+  for (int32_t i = 0; i < taosArrayGetSize(pStats); i++) {
+    SStealQWorkerStat *pStat = (SStealQWorkerStat *)taosArrayGet(pStats, i);
+    SStealQWorkerStat *pStat2 = (SStealQWorkerStat *)taosArrayGet(pStats2, i);
+    EXPECT_EQ(pStat->numOfProcessed, pStat2->numOfProcessed);
+    EXPECT_EQ(pStat->numOfStolen, pStat2->numOfStolen);
+    EXPECT_EQ(pStat->busyTime, pStat2->busyTime);
+  }
+  taosArrayDestroy(pStats);
+  taosArrayDestroy(pStats2);
+
+  for (STaosQueue *queue : queues) tStealQWorkerFreeQueue(&pool, queue);
+  tStealQWorkerCleanup(&pool);
+}
+
+// an item queued behind a busy owner is stolen by an idle worker right away
+TEST(workerTest, stealQWorkerStealOnEnqueue) {
+  SStealQWorkerPool pool = {0};
+  pool.name = "test-steal";
+  pool.max = 2;
+  ASSERT_EQ(tStealQWorkerInit(&pool), 0);
+
+  STaosQueue *queue = tStealQWorkerAllocQueue(&pool, NULL, blockFirstItem);
+  ASSERT_NE(queue, nullptr);
+
+  numOfProcessed = 0;
+  firstStarted = false;
+  releaseFirst = false;
+  workerOfItem[0] = -1;
+  workerOfItem[1] = -1;
+
+  writeItem(&pool, queue, 0);
+  for (int32_t i = 0; i < 5000 && !firstStarted; i++) taosMsleep(1);
+  ASSERT_TRUE(firstStarted.load());
+
+  writeItem(&pool, queue, 1);
+  EXPECT_TRUE(waitFor(numOfProcessed, 1));
+  EXPECT_FALSE(releaseFirst.load());
+  EXPECT_NE(workerOfItem[1].load(), workerOfItem[0].load());
+
+  releaseFirst = true;
+  ASSERT_TRUE(waitFor(numOfProcessed, 2));
+  taosMsleep(10);
+
+  SArray *pStats = taosArrayInit(2, sizeof(SStealQWorkerStat));
+  tStealQWorkerGetStat(&pool, pStats);
+  SStealQWorkerStat *pThief = (SStealQWorkerStat *)taosArrayGet(pStats, workerOfItem[1]);
+  EXPECT_EQ(pThief->numOfStolen, 1);
+  EXPECT_EQ(pThief->numOfQueues, 0);
+  taosArrayDestroy(pStats);
+
+  tStealQWorkerFreeQueue(&pool, queue);
+  tStealQWorkerCleanup(&pool);
+}
+
+// both workers are busy when an item is queued, nobody is idle to be woken for it; the first worker done with its own
+// item takes it instead of leaving it to the owner
+TEST(workerTest, stealQWorkerStealAfterBusy) {
+  SStealQWorkerPool pool = {0};
+  pool.name = "test-steal";
+  pool.max = 2;
+  ASSERT_EQ(tStealQWorkerInit(&pool), 0);
+
+  STaosQueue *queue0 = tStealQWorkerAllocQueue(&pool, NULL, blockTwoItems);
+  STaosQueue *queue1 = tStealQWorkerAllocQueue(&pool, NULL, blockTwoItems);
+  ASSERT_NE(queue0, nullptr);
+  ASSERT_NE(queue1, nullptr);
+
+  numOfProcessed = 0;
+  numOfStarted = 0;
+  releaseItem[0] = false;
+  releaseItem[1] = false;
+  for (int32_t i = 0; i < 3; i++) workerOfItem[i] = -1;
+
+  writeItem(&pool, queue0, 0);
+  writeItem(&pool, queue1, 1);
+  ASSERT_TRUE(waitFor(numOfStarted, 2));
+  ASSERT_NE(workerOfItem[0].load(), workerOfItem[1].load());
+
+  // queued behind the owner of item 0
+  writeItem(&pool, queue0, 2);
+  taosMsleep(20);
+  EXPECT_EQ(numOfProcessed.load(), 0);
+
+  releaseItem[1] = true;
+  EXPECT_TRUE(waitFor(numOfProcessed, 2));
+  EXPECT_EQ(workerOfItem[2].load(), workerOfItem[1].load());
+
+  releaseItem[0] = true;
+  ASSERT_TRUE(waitFor(numOfProcessed, 3));
+  taosMsleep(10);
+
+  SArray *pStats = taosArrayInit(2, sizeof(SStealQWorkerStat));
+  tStealQWorkerGetStat(&pool, pStats);
+  SStealQWorkerStat *pThief = (SStealQWorkerStat *)taosArrayGet(pStats, workerOfItem[1]);
+  EXPECT_EQ(pThief->numOfStolen, 1);
+  EXPECT_EQ(pThief->numOfProcessed, 2);
+  taosArrayDestroy(pStats);
+
+  tStealQWorkerFreeQueue(&pool, queue0);
+  tStealQWorkerFreeQueue(&pool, queue1);
+  tStealQWorkerCleanup(&pool);
+}